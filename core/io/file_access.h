@@ -150,6 +150,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+
+	virtual Error map_read_only() { return ERR_UNAVAILABLE; } ///< memory map the whole file for reading, if supported by the platform
+	virtual const uint8_t *get_mapped_data() const { return nullptr; } ///< read-only view of the whole file when it's memory mapped, nullptr otherwise
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
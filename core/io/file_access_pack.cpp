@@ -278,10 +278,26 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
 	}
 
+	// Mapping the pack lets files be read without opening the pack and seeking for each of them.
+	if (!mapped_packs.has(p_path)) {
+		Ref<FileAccess> mapped_pack = FileAccess::open(p_path, FileAccess::READ);
+		if (mapped_pack.is_valid() && mapped_pack->map_read_only() == OK) {
+			MappedPack &mapped = mapped_packs[p_path];
+			mapped.file = mapped_pack;
+			mapped.length = mapped_pack->get_length();
+		}
+	}
+
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (!p_file->encrypted) {
+		HashMap<String, MappedPack>::ConstIterator E = mapped_packs.find(p_file->pack);
+		if (E && p_file->offset + p_file->size <= E->value.length) {
+			return memnew(FileAccessPack(p_path, *p_file, E->value.file));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -296,12 +312,12 @@ bool FileAccessPack::is_open() const {
 	if (f.is_valid()) {
 		return f->is_open();
 	} else {
-		return false;
+		return mapped_data != nullptr;
 	}
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped_data, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -309,7 +325,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -330,7 +348,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped_data, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -348,16 +366,22 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (mapped_data) {
+		memcpy(p_dst, mapped_data + pos - to_read, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped_data, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -381,11 +405,24 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped_data = nullptr;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	if (p_mapped_pack.is_valid()) {
+		// Keep a reference to the pack, so the mapping outlives this file even if the pack is removed.
+		mapped_pack = p_mapped_pack;
+		mapped_data = mapped_pack->get_mapped_data() + pf.offset;
+		off = pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
@@ -407,8 +444,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
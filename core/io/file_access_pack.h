@@ -139,6 +139,15 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	struct MappedPack {
+		Ref<FileAccess> file;
+		// Recorded when the pack is mapped, so files can be checked against it without querying the shared file.
+		uint64_t length = 0;
+	};
+
+	// Packs that could be memory mapped, their unencrypted files are read straight from the mapping.
+	HashMap<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -152,6 +161,11 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+
+	// Set instead of f when the file is read from a memory mapped pack.
+	Ref<FileAccess> mapped_pack;
+	const uint8_t *mapped_data = nullptr;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -174,6 +188,8 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
 
+	virtual const uint8_t *get_mapped_data() const override { return mapped_data; }
+
 	virtual void set_big_endian(bool p_big_endian) override;
 
 	virtual Error get_error() const override;
@@ -186,7 +202,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>());
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -36,6 +36,7 @@
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
@@ -43,6 +44,14 @@
 #include <stdio.h>
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IMAGE_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IMAGE_SIMD_NEON
+#endif
+
 const char *Image::format_names[Image::FORMAT_MAX] = {
 	"Lum8", //luminance
 	"LumAlpha8", //luminance-alpha
@@ -459,13 +468,61 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+// Row kernels write the destination rows in [p_from_y, p_to_y), so large images can be split across the WorkerThreadPool.
+typedef void (*ImageRowFunc)(const uint8_t *p_src, uint8_t *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y);
+
+struct ImageRowTask {
+	ImageRowFunc func = nullptr;
+	const uint8_t *src = nullptr;
+	uint8_t *dst = nullptr;
+	uint32_t src_width = 0;
+	uint32_t src_height = 0;
+	uint32_t dst_width = 0;
+	uint32_t dst_height = 0;
+	uint32_t rows_per_chunk = 0;
+};
+
+// Smallest amount of destination pixels handled by a single task, below this threading costs more than it saves.
+static constexpr uint32_t IMAGE_ROW_CHUNK_MIN_PIXELS = 16384;
+
+static void _process_row_chunk(void *p_userdata, uint32_t p_index) {
+	const ImageRowTask *task = static_cast<const ImageRowTask *>(p_userdata);
+	const uint32_t from_y = p_index * task->rows_per_chunk;
+	const uint32_t to_y = MIN(from_y + task->rows_per_chunk, task->dst_height);
+	task->func(task->src, task->dst, task->src_width, task->src_height, task->dst_width, task->dst_height, from_y, to_y);
+}
+
+static void _process_rows(ImageRowFunc p_func, const uint8_t *p_src, uint8_t *p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint64_t pixels = uint64_t(p_dst_width) * p_dst_height;
+	// Waiting for a group task from a pool thread could starve the pool, so images processed inside tasks stay serial.
+	if (pool == nullptr || pool->get_thread_count() < 2 || WorkerThreadPool::get_thread_index() != -1 || p_dst_height < 2 || pixels < 2 * IMAGE_ROW_CHUNK_MIN_PIXELS) {
+		p_func(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, 0, p_dst_height);
+		return;
+	}
+
+	ImageRowTask task;
+	task.func = p_func;
+	task.src = p_src;
+	task.dst = p_dst;
+	task.src_width = p_src_width;
+	task.src_height = p_src_height;
+	task.dst_width = p_dst_width;
+	task.dst_height = p_dst_height;
+	task.rows_per_chunk = MAX(1u, IMAGE_ROW_CHUNK_MIN_PIXELS / p_dst_width);
+
+	const uint32_t chunk_count = (p_dst_height + task.rows_per_chunk - 1) / task.rows_per_chunk;
+	WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&_process_row_chunk, &task, chunk_count, -1, true, String("ImageProcessRows"));
+	pool->wait_for_group_task_completion(group_task);
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
-static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+static void _convert_rows(const uint8_t *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_height, uint32_t, uint32_t, uint32_t p_from_y, uint32_t p_to_y) {
 	constexpr uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
-	for (int y = 0; y < p_height; y++) {
-		for (int x = 0; x < p_width; x++) {
+	for (uint32_t y = p_from_y; y < p_to_y; y++) {
+		for (uint32_t x = 0; x < p_width; x++) {
 			const uint8_t *rofs = &p_src[((y * p_width) + x) * (read_bytes + (read_alpha ? 1 : 0))];
 			uint8_t *wofs = &p_dst[((y * p_width) + x) * (write_bytes + (write_alpha ? 1 : 0))];
 
@@ -502,14 +559,21 @@ static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p
 	}
 }
 
+template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
+static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+	_process_rows(&_convert_rows<read_bytes, read_alpha, write_bytes, write_alpha, read_gray, write_gray>, p_src, p_dst, p_width, p_height, p_width, p_height);
+}
+
 template <typename T, uint32_t read_channels, uint32_t write_channels, T def_zero, T def_one>
-static void _convert_fast(int p_width, int p_height, const T *p_src, T *p_dst) {
-	uint32_t dst_count = 0;
-	uint32_t src_count = 0;
+static void _convert_fast_rows(const uint8_t *p_src_bytes, uint8_t *p_dst_bytes, uint32_t p_width, uint32_t p_height, uint32_t, uint32_t, uint32_t p_from_y, uint32_t p_to_y) {
+	const T *p_src = reinterpret_cast<const T *>(p_src_bytes);
+	T *p_dst = reinterpret_cast<T *>(p_dst_bytes);
+	uint32_t dst_count = p_from_y * p_width * write_channels;
+	uint32_t src_count = p_from_y * p_width * read_channels;
 
-	const int resolution = p_width * p_height;
+	const uint32_t resolution = (p_to_y - p_from_y) * p_width;
 
-	for (int i = 0; i < resolution; i++) {
+	for (uint32_t i = 0; i < resolution; i++) {
 		memcpy(p_dst + dst_count, p_src + src_count, MIN(read_channels, write_channels) * sizeof(T));
 
 		if constexpr (write_channels > read_channels) {
@@ -522,6 +586,11 @@ static void _convert_fast(int p_width, int p_height, const T *p_src, T *p_dst) {
 	}
 }
 
+template <typename T, uint32_t read_channels, uint32_t write_channels, T def_zero, T def_one>
+static void _convert_fast(int p_width, int p_height, const T *p_src, T *p_dst) {
+	_process_rows(&_convert_fast_rows<T, read_channels, write_channels, def_zero, def_one>, reinterpret_cast<const uint8_t *>(p_src), reinterpret_cast<uint8_t *>(p_dst), p_width, p_height, p_width, p_height);
+}
+
 static bool _are_formats_compatible(Image::Format p_format0, Image::Format p_format1) {
 	if (p_format0 <= Image::FORMAT_RGBA8 && p_format1 <= Image::FORMAT_RGBA8) {
 		return true;
@@ -778,7 +847,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, typename T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y) {
 	// get source image size
 	int width = p_src_width;
 	int height = p_src_height;
@@ -793,7 +862,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_from_y; y < p_to_y; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -865,13 +934,18 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, typename T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(&_scale_cubic_rows<CC, T>, p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+}
+
+template <int CC, typename T>
+static void _scale_bilinear_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y) {
 	constexpr uint32_t FRAC_BITS = 8;
 	constexpr uint32_t FRAC_LEN = (1 << FRAC_BITS);
 	constexpr uint32_t FRAC_HALF = (FRAC_LEN >> 1);
 	constexpr uint32_t FRAC_MASK = FRAC_LEN - 1;
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_from_y; i < p_to_y; i++) {
 		// Add 0.5 in order to interpolate based on pixel center
 		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
 		// Calculate nearest src pixel center above current, and truncate to get y index
@@ -953,8 +1027,13 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, typename T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(&_scale_bilinear_rows<CC, T>, p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+}
+
+template <int CC, typename T>
+static void _scale_nearest_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y) {
+	for (uint32_t i = p_from_y; i < p_to_y; i++) {
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
 
@@ -973,123 +1052,141 @@ static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict
 	}
 }
 
+template <int CC, typename T>
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(&_scale_nearest_rows<CC, T>, p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height);
+}
+
 #define LANCZOS_TYPE 3
 
 static float _lanczos(float p_x) {
 	return Math::abs(p_x) >= LANCZOS_TYPE ? 0 : Math::sincn(p_x) * Math::sincn(p_x / LANCZOS_TYPE);
 }
 
+// First pass (horizontal), writes the columns [p_from_x, p_to_x) of the intermediate float buffer.
 template <int CC, typename T>
-static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_lanczos_columns(const uint8_t *__restrict p_src, uint8_t *__restrict p_buffer, uint32_t p_src_width, uint32_t p_src_height, uint32_t, uint32_t p_dst_width, uint32_t p_from_x, uint32_t p_to_x) {
 	int32_t src_width = p_src_width;
 	int32_t src_height = p_src_height;
-	int32_t dst_height = p_dst_height;
 	int32_t dst_width = p_dst_width;
 
-	uint32_t buffer_size = src_height * dst_width * CC;
-	float *buffer = memnew_arr(float, buffer_size); // Store the first pass in a buffer
-
-	{ // FIRST PASS (horizontal)
+	float *buffer = (float *)p_buffer;
 
-		float x_scale = float(src_width) / float(dst_width);
+	float x_scale = float(src_width) / float(dst_width);
 
-		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
+	float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
+	int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+	float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
-			// The corresponding point on the source image
-			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
-			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
-			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
+	for (int32_t buffer_x = p_from_x; buffer_x < int32_t(p_to_x); buffer_x++) {
+		// The corresponding point on the source image
+		float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
+		int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
+		int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
 
-			// Create the kernel used by all the pixels of the column
-			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
-			}
+		// Create the kernel used by all the pixels of the column
+		for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+			kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+		}
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+		for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
+			float pixel[CC] = { 0 };
+			float weight = 0;
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+				float lanczos_val = kernel[target_x - start_x];
+				weight += lanczos_val;
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+				const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
-						}
+				for (uint32_t i = 0; i < CC; i++) {
+					if constexpr (sizeof(T) == 2) { //half float
+						pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+					} else {
+						pixel[i] += src_data[i] * lanczos_val;
 					}
 				}
+			}
 
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
+			float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
-				}
+			for (uint32_t i = 0; i < CC; i++) {
+				dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
 			}
 		}
+	}
 
-		memdelete_arr(kernel);
-	} // End of first pass
+	memdelete_arr(kernel);
+}
 
-	{ // SECOND PASS (vertical + result)
+// Second pass (vertical + result), reads the intermediate float buffer and writes the rows [p_from_y, p_to_y).
+template <int CC, typename T>
+static void _scale_lanczos_rows(const uint8_t *__restrict p_buffer, uint8_t *__restrict p_dst, uint32_t, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_from_y, uint32_t p_to_y) {
+	int32_t src_height = p_src_height;
+	int32_t dst_height = p_dst_height;
+	int32_t dst_width = p_dst_width;
 
-		float y_scale = float(src_height) / float(dst_height);
+	const float *buffer = (const float *)p_buffer;
 
-		float scale_factor = MAX(y_scale, 1);
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
+	float y_scale = float(src_height) / float(dst_height);
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+	float scale_factor = MAX(y_scale, 1);
+	int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
+	float *kernel = memnew_arr(float, half_kernel * 2);
 
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
-			}
+	for (int32_t dst_y = p_from_y; dst_y < int32_t(p_to_y); dst_y++) {
+		float buffer_y = (dst_y + 0.5f) * y_scale;
+		int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
+		int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+		for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+			kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+		}
 
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+		for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
+			float pixel[CC] = { 0 };
+			float weight = 0;
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+				float lanczos_val = kernel[target_y - start_y];
+				weight += lanczos_val;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
-					}
+				const float *buffer_data = buffer + (target_y * dst_width + dst_x) * CC;
+
+				for (uint32_t i = 0; i < CC; i++) {
+					pixel[i] += buffer_data[i] * lanczos_val;
 				}
+			}
 
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
+			T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
-
-					if constexpr (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if constexpr (sizeof(T) == 2) { //half float
-						dst_data[i] = Math::make_half_float(pixel[i]);
-					} else { // float
-						dst_data[i] = pixel[i];
-					}
+			for (uint32_t i = 0; i < CC; i++) {
+				pixel[i] /= weight;
+
+				if constexpr (sizeof(T) == 1) { //byte
+					dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+				} else if constexpr (sizeof(T) == 2) { //half float
+					dst_data[i] = Math::make_half_float(pixel[i]);
+				} else { // float
+					dst_data[i] = pixel[i];
 				}
 			}
 		}
+	}
 
-		memdelete_arr(kernel);
-	} // End of second pass
+	memdelete_arr(kernel);
+}
+
+template <int CC, typename T>
+static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	uint32_t buffer_size = p_src_height * p_dst_width * CC;
+	float *buffer = memnew_arr(float, buffer_size); // Store the first pass in a buffer
+
+	// The first pass is split by buffer columns, each column being p_src_height pixels long.
+	_process_rows(&_scale_lanczos_columns<CC, T>, p_src, (uint8_t *)buffer, p_src_width, p_src_height, p_src_height, p_dst_width);
+	_process_rows(&_scale_lanczos_rows<CC, T>, (const uint8_t *)buffer, p_dst, p_dst_width, p_src_height, p_dst_width, p_dst_height);
 
 	memdelete_arr(buffer);
 }
@@ -1761,23 +1858,119 @@ bool Image::_can_modify(Format p_format) const {
 	return !Image::is_format_compressed(p_format);
 }
 
+#if defined(IMAGE_SIMD_SSE2) || defined(IMAGE_SIMD_NEON)
+// Averages 2x2 blocks of RGBA8 pixels, 4 destination pixels at a time. Returns how many pixels were written.
+// Matches Image::average_4_uint8() exactly: (a + b + c + d + 2) >> 2 per channel.
+static uint32_t _average_rgba8_row_simd(const uint8_t *p_up, const uint8_t *p_down, uint8_t *p_dst, uint32_t p_count) {
+	uint32_t done = 0;
+#ifdef IMAGE_SIMD_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i two = _mm_set1_epi16(2);
+	for (; done + 4 <= p_count; done += 4) {
+		const __m128i up0 = _mm_loadu_si128((const __m128i *)(p_up + done * 8));
+		const __m128i up1 = _mm_loadu_si128((const __m128i *)(p_up + done * 8 + 16));
+		const __m128i down0 = _mm_loadu_si128((const __m128i *)(p_down + done * 8));
+		const __m128i down1 = _mm_loadu_si128((const __m128i *)(p_down + done * 8 + 16));
+		// Vertical sums, each register holds two source pixels as 16-bit channels.
+		const __m128i v0 = _mm_add_epi16(_mm_unpacklo_epi8(up0, zero), _mm_unpacklo_epi8(down0, zero));
+		const __m128i v1 = _mm_add_epi16(_mm_unpackhi_epi8(up0, zero), _mm_unpackhi_epi8(down0, zero));
+		const __m128i v2 = _mm_add_epi16(_mm_unpacklo_epi8(up1, zero), _mm_unpacklo_epi8(down1, zero));
+		const __m128i v3 = _mm_add_epi16(_mm_unpackhi_epi8(up1, zero), _mm_unpackhi_epi8(down1, zero));
+		// Horizontal sums, the low half of each register ends up with one destination pixel.
+		const __m128i h0 = _mm_add_epi16(v0, _mm_srli_si128(v0, 8));
+		const __m128i h1 = _mm_add_epi16(v1, _mm_srli_si128(v1, 8));
+		const __m128i h2 = _mm_add_epi16(v2, _mm_srli_si128(v2, 8));
+		const __m128i h3 = _mm_add_epi16(v3, _mm_srli_si128(v3, 8));
+		const __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(h0, h1), two), 2);
+		const __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(h2, h3), two), 2);
+		_mm_storeu_si128((__m128i *)(p_dst + done * 4), _mm_packus_epi16(lo, hi));
+	}
+#else
+	for (; done + 4 <= p_count; done += 4) {
+		const uint8x16_t up0 = vld1q_u8(p_up + done * 8);
+		const uint8x16_t up1 = vld1q_u8(p_up + done * 8 + 16);
+		const uint8x16_t down0 = vld1q_u8(p_down + done * 8);
+		const uint8x16_t down1 = vld1q_u8(p_down + done * 8 + 16);
+		// Vertical sums, each register holds two source pixels as 16-bit channels.
+		const uint16x8_t v0 = vaddl_u8(vget_low_u8(up0), vget_low_u8(down0));
+		const uint16x8_t v1 = vaddl_u8(vget_high_u8(up0), vget_high_u8(down0));
+		const uint16x8_t v2 = vaddl_u8(vget_low_u8(up1), vget_low_u8(down1));
+		const uint16x8_t v3 = vaddl_u8(vget_high_u8(up1), vget_high_u8(down1));
+		// Horizontal sums, one destination pixel each.
+		const uint16x4_t h0 = vadd_u16(vget_low_u16(v0), vget_high_u16(v0));
+		const uint16x4_t h1 = vadd_u16(vget_low_u16(v1), vget_high_u16(v1));
+		const uint16x4_t h2 = vadd_u16(vget_low_u16(v2), vget_high_u16(v2));
+		const uint16x4_t h3 = vadd_u16(vget_low_u16(v3), vget_high_u16(v3));
+		// Rounding shift adds 2 before shifting by 2.
+		const uint8x8_t lo = vmovn_u16(vrshrq_n_u16(vcombine_u16(h0, h1), 2));
+		const uint8x8_t hi = vmovn_u16(vrshrq_n_u16(vcombine_u16(h2, h3), 2));
+		vst1q_u8(p_dst + done * 4, vcombine_u8(lo, hi));
+	}
+#endif
+	return done;
+}
+
+// Averages 2x2 blocks of RGBAF pixels, one destination pixel per iteration.
+// Matches Image::average_4_float() exactly, additions are done in the same order.
+static uint32_t _average_rgbaf_row_simd(const float *p_up, const float *p_down, float *p_dst, uint32_t p_count) {
+#ifdef IMAGE_SIMD_SSE2
+	const __m128 quarter = _mm_set1_ps(0.25f);
+	for (uint32_t i = 0; i < p_count; i++) {
+		const __m128 a = _mm_loadu_ps(p_up + i * 8);
+		const __m128 b = _mm_loadu_ps(p_up + i * 8 + 4);
+		const __m128 c = _mm_loadu_ps(p_down + i * 8);
+		const __m128 d = _mm_loadu_ps(p_down + i * 8 + 4);
+		_mm_storeu_ps(p_dst + i * 4, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(a, b), c), d), quarter));
+	}
+#else
+	for (uint32_t i = 0; i < p_count; i++) {
+		const float32x4_t a = vld1q_f32(p_up + i * 8);
+		const float32x4_t b = vld1q_f32(p_up + i * 8 + 4);
+		const float32x4_t c = vld1q_f32(p_down + i * 8);
+		const float32x4_t d = vld1q_f32(p_down + i * 8 + 4);
+		vst1q_f32(p_dst + i * 4, vmulq_n_f32(vaddq_f32(vaddq_f32(vaddq_f32(a, b), c), d), 0.25f));
+	}
+#endif
+	return p_count;
+}
+#endif // IMAGE_SIMD_SSE2 || IMAGE_SIMD_NEON
+
 template <typename Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+static void _generate_po2_mipmap_rows(const uint8_t *p_src_bytes, uint8_t *p_dst_bytes, uint32_t p_width, uint32_t p_height, uint32_t, uint32_t, uint32_t p_from_y, uint32_t p_to_y) {
 	//fast power of 2 mipmap generation
+	const Component *p_src = reinterpret_cast<const Component *>(p_src_bytes);
+	Component *p_dst = reinterpret_cast<Component *>(p_dst_bytes);
 	uint32_t dst_w = MAX(p_width >> 1, 1u);
-	uint32_t dst_h = MAX(p_height >> 1, 1u);
 
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+	for (uint32_t i = p_from_y; i < p_to_y; i++) {
 		const Component *rup_ptr = &p_src[i * 2 * down_step];
 		const Component *rdown_ptr = rup_ptr + down_step;
 		Component *dst_ptr = &p_dst[i * dst_w * CC];
 		uint32_t count = dst_w;
 
+#if defined(IMAGE_SIMD_SSE2) || defined(IMAGE_SIMD_NEON)
+		if constexpr (CC == 4 && !renormalize) {
+			if (right_step != 0) {
+				uint32_t done = 0;
+				// With four channels, byte components are always RGBA8 and 32-bit components are always RGBAF.
+				if constexpr (sizeof(Component) == 1) {
+					done = _average_rgba8_row_simd(rup_ptr, rdown_ptr, dst_ptr, count);
+				} else if constexpr (sizeof(Component) == 4) {
+					done = _average_rgbaf_row_simd(rup_ptr, rdown_ptr, dst_ptr, count);
+				}
+				count -= done;
+				dst_ptr += done * CC;
+				rup_ptr += done * CC * 2;
+				rdown_ptr += done * CC * 2;
+			}
+		}
+#endif
+
 		while (count) {
 			count--;
 			for (int j = 0; j < CC; j++) {
@@ -1795,6 +1988,13 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	}
 }
 
+template <typename Component, int CC, bool renormalize,
+		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
+		void (*renormalize_func)(Component *)>
+static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+	_process_rows(&_generate_po2_mipmap_rows<Component, CC, renormalize, average_func, renormalize_func>, reinterpret_cast<const uint8_t *>(p_src), reinterpret_cast<uint8_t *>(p_dst), p_width, p_height, MAX(p_width >> 1, 1u), MAX(p_height >> 1, 1u));
+}
+
 void Image::shrink_x2() {
 	ERR_FAIL_COND(data.is_empty());
 
@@ -46,38 +46,112 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-String JSON::_make_indent(const String &p_indent, int p_size) {
-	return p_indent.repeat(p_size);
+// Stringifying writes either into a String or into a UTF-8 byte buffer.
+
+static _FORCE_INLINE_ void _append(String &r_out, const String &p_str) {
+	r_out += p_str;
+}
+
+static _FORCE_INLINE_ void _append(String &r_out, const char *p_str) {
+	r_out += p_str;
+}
+
+// UTF-8 output, written straight into the PackedByteArray that is returned.
+// The array grows geometrically and is trimmed to the written size at the end.
+struct _JSONUTF8Buffer {
+	PackedByteArray data;
+	int64_t size = 0;
+
+	_FORCE_INLINE_ uint8_t *reserve(int64_t p_len) {
+		if (size + p_len > data.size()) {
+			data.resize(MAX(MAX(data.size() * 2, size + p_len), 256));
+		}
+		uint8_t *w = data.ptrw() + size;
+		size += p_len;
+		return w;
+	}
+};
+
+static void _append(_JSONUTF8Buffer &r_out, const char *p_str, int p_len) {
+	memcpy(r_out.reserve(p_len), p_str, p_len);
 }
 
-String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
-	ERR_FAIL_COND_V_MSG(p_cur_indent > Variant::MAX_RECURSION_DEPTH, "...", "JSON structure is too deep. Bailing.");
+static _FORCE_INLINE_ void _append(_JSONUTF8Buffer &r_out, const char *p_str) {
+	_append(r_out, p_str, strlen(p_str));
+}
+
+static void _append(_JSONUTF8Buffer &r_out, const String &p_str) {
+	const int len = p_str.length();
+	const char32_t *src = p_str.ptr();
+
+	// Worst case of 4 bytes per character, the unused part is reused by the next append.
+	uint8_t *dst = r_out.reserve(int64_t(len) * 4);
+	uint8_t *w = dst;
+	for (int i = 0; i < len; i++) {
+		const uint32_t c = src[i];
+		if (c <= 0x7f) {
+			*(w++) = c;
+		} else if (c <= 0x7ff) {
+			*(w++) = 0xc0 | ((c >> 6) & 0x1f);
+			*(w++) = 0x80 | (c & 0x3f);
+		} else if (c <= 0xffff) {
+			*(w++) = 0xe0 | ((c >> 12) & 0x0f);
+			*(w++) = 0x80 | ((c >> 6) & 0x3f);
+			*(w++) = 0x80 | (c & 0x3f);
+		} else if (c <= 0x001fffff) {
+			*(w++) = 0xf0 | ((c >> 18) & 0x07);
+			*(w++) = 0x80 | ((c >> 12) & 0x3f);
+			*(w++) = 0x80 | ((c >> 6) & 0x3f);
+			*(w++) = 0x80 | (c & 0x3f);
+		} else {
+			// Invalid code points, let String::utf8() encode and report them as usual.
+			r_out.size -= int64_t(len) * 4;
+			const CharString utf8 = p_str.utf8();
+			_append(r_out, utf8.get_data(), utf8.length());
+			return;
+		}
+	}
+	r_out.size -= int64_t(len) * 4 - (w - dst);
+}
 
-	String colon = ":";
-	String end_statement = "";
+template <typename T>
+static void _append_indent(T &r_out, const String &p_indent, int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		_append(r_out, p_indent);
+	}
+}
 
-	if (!p_indent.is_empty()) {
-		colon += " ";
-		end_statement += "\n";
+template <typename T>
+void JSON::_stringify(T &r_out, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
+	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
+		_append(r_out, "...");
+		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
 	}
 
+	const char *colon = p_indent.is_empty() ? ":" : ": ";
+	const char *end_statement = p_indent.is_empty() ? "" : "\n";
+
 	switch (p_var.get_type()) {
 		case Variant::NIL:
-			return "null";
+			_append(r_out, "null");
+			return;
 		case Variant::BOOL:
-			return p_var.operator bool() ? "true" : "false";
+			_append(r_out, p_var.operator bool() ? "true" : "false");
+			return;
 		case Variant::INT:
-			return itos(p_var);
+			_append(r_out, itos(p_var));
+			return;
 		case Variant::FLOAT: {
 			double num = p_var;
 			if (p_full_precision) {
 				// Store unreliable digits (17) instead of just reliable
 				// digits (14) so that the value can be decoded exactly.
-				return String::num(num, 17 - (int)floor(log10(num)));
+				_append(r_out, String::num(num, 17 - (int)floor(log10(num))));
 			} else {
 				// Store only reliable digits (14) by default.
-				return String::num(num, 14 - (int)floor(log10(num)));
+				_append(r_out, String::num(num, 14 - (int)floor(log10(num))));
 			}
+			return;
 		}
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
@@ -87,36 +161,48 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 		case Variant::ARRAY: {
 			Array a = p_var;
 			if (a.is_empty()) {
-				return "[]";
+				_append(r_out, "[]");
+				return;
 			}
-			String s = "[";
-			s += end_statement;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(a.id()), "\"[...]\"", "Converting circular structure to JSON.");
+			if (p_markers.has(a.id())) {
+				_append(r_out, "\"[...]\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(a.id());
 
+			_append(r_out, "[");
+			_append(r_out, end_statement);
+
 			bool first = true;
 			for (const Variant &var : a) {
 				if (first) {
 					first = false;
 				} else {
-					s += ",";
-					s += end_statement;
+					_append(r_out, ",");
+					_append(r_out, end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(var, p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_out, p_indent, p_cur_indent + 1);
+				_stringify(r_out, var, p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "]";
+			_append(r_out, end_statement);
+			_append_indent(r_out, p_indent, p_cur_indent);
+			_append(r_out, "]");
 			p_markers.erase(a.id());
-			return s;
+			return;
 		}
 		case Variant::DICTIONARY: {
-			String s = "{";
-			s += end_statement;
 			Dictionary d = p_var;
 
-			ERR_FAIL_COND_V_MSG(p_markers.has(d.id()), "\"{...}\"", "Converting circular structure to JSON.");
+			if (p_markers.has(d.id())) {
+				_append(r_out, "\"{...}\"");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
 			p_markers.insert(d.id());
 
+			_append(r_out, "{");
+			_append(r_out, end_statement);
+
 			List<Variant> keys;
 			d.get_key_list(&keys);
 
@@ -129,26 +215,127 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 				if (first_key) {
 					first_key = false;
 				} else {
-					s += ",";
-					s += end_statement;
+					_append(r_out, ",");
+					_append(r_out, end_statement);
 				}
-				s += _make_indent(p_indent, p_cur_indent + 1) + _stringify(String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
-				s += colon;
-				s += _stringify(d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append_indent(r_out, p_indent, p_cur_indent + 1);
+				_stringify(r_out, String(E), p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
+				_append(r_out, colon);
+				_stringify(r_out, d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers);
 			}
 
-			s += end_statement + _make_indent(p_indent, p_cur_indent) + "}";
+			_append(r_out, end_statement);
+			_append_indent(r_out, p_indent, p_cur_indent);
+			_append(r_out, "}");
 			p_markers.erase(d.id());
-			return s;
+			return;
 		}
 		default:
-			return "\"" + String(p_var).json_escape() + "\"";
+			_append(r_out, "\"");
+			_append(r_out, String(p_var).json_escape());
+			_append(r_out, "\"");
+			return;
+	}
+}
+
+// The parser works both on UTF-32 strings and on UTF-8 buffers, these helpers hide the difference.
+
+template <typename C>
+static _FORCE_INLINE_ char32_t _get_char(const C *p_str, int p_index, int p_len) {
+	// Buffers are not null terminated, so treat anything past the end as the terminator.
+	return p_index < p_len ? (char32_t)p_str[p_index] : 0;
+}
+
+static _FORCE_INLINE_ bool _read_string_char(const char32_t *p_str, int &r_index, int p_len, char32_t &r_char) {
+	r_char = p_str[r_index++];
+	return true;
+}
+
+static bool _read_string_char(const uint8_t *p_str, int &r_index, int p_len, char32_t &r_char) {
+	const uint8_t lead = p_str[r_index];
+	if (lead < 0x80) {
+		r_char = lead;
+		r_index++;
+		return true;
+	}
+
+	int size = 0;
+	char32_t c = 0;
+	if ((lead & 0xe0) == 0xc0) {
+		size = 2;
+		c = lead & 0x1f;
+	} else if ((lead & 0xf0) == 0xe0) {
+		size = 3;
+		c = lead & 0x0f;
+	} else if ((lead & 0xf8) == 0xf0) {
+		size = 4;
+		c = lead & 0x07;
+	} else {
+		return false;
+	}
+
+	if (r_index + size > p_len) {
+		return false;
+	}
+	for (int i = 1; i < size; i++) {
+		const uint8_t continuation = p_str[r_index + i];
+		if ((continuation & 0xc0) != 0x80) {
+			return false;
+		}
+		c = (c << 6) | (continuation & 0x3f);
+	}
+
+	// Reject overlong encodings, surrogates and values past the last code point.
+	static const char32_t min_char[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+	if (c < min_char[size] || (c >= 0xd800 && c <= 0xdfff) || c > 0x10ffff) {
+		return false;
 	}
+
+	r_char = c;
+	r_index += size;
+	return true;
+}
+
+static _FORCE_INLINE_ double _parse_number(const char32_t *p_str, int &r_index, int p_len) {
+	const char32_t *rptr;
+	double number = String::to_float(&p_str[r_index], &rptr);
+	r_index += (rptr - &p_str[r_index]);
+	return number;
+}
+
+static double _parse_number(const uint8_t *p_str, int &r_index, int p_len) {
+	// Numbers are ASCII only, widen them so they go through the same conversion as UTF-32 strings.
+	int len = 0;
+	while (r_index + len < p_len) {
+		const uint8_t c = p_str[r_index + len];
+		if (!is_digit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+			break;
+		}
+		len++;
+	}
+
+	const char32_t *rptr;
+	double number;
+	char32_t buffer[64];
+	if (len < 64) {
+		for (int i = 0; i < len; i++) {
+			buffer[i] = p_str[r_index + i];
+		}
+		buffer[len] = 0;
+		number = String::to_float(buffer, &rptr);
+		r_index += (rptr - buffer);
+	} else {
+		String str = String::utf8((const char *)&p_str[r_index], len);
+		number = String::to_float(str.ptr(), &rptr);
+		r_index += (rptr - str.ptr());
+	}
+	return number;
 }
 
-Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
+template <typename C>
+Error JSON::_get_token(const C *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str) {
 	while (p_len > 0) {
-		switch (p_str[index]) {
+		switch (_get_char(p_str, index, p_len)) {
 			case '\n': {
 				line++;
 				index++;
@@ -192,16 +379,16 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 				index++;
 				String str;
 				while (true) {
-					if (p_str[index] == 0) {
+					if (_get_char(p_str, index, p_len) == 0) {
 						r_err_str = "Unterminated String";
 						return ERR_PARSE_ERROR;
-					} else if (p_str[index] == '"') {
+					} else if (_get_char(p_str, index, p_len) == '"') {
 						index++;
 						break;
-					} else if (p_str[index] == '\\') {
+					} else if (_get_char(p_str, index, p_len) == '\\') {
 						//escaped characters...
 						index++;
-						char32_t next = p_str[index];
+						char32_t next = _get_char(p_str, index, p_len);
 						if (next == 0) {
 							r_err_str = "Unterminated String";
 							return ERR_PARSE_ERROR;
@@ -227,7 +414,7 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 							case 'u': {
 								// hex number
 								for (int j = 0; j < 4; j++) {
-									char32_t c = p_str[index + j + 1];
+									char32_t c = _get_char(p_str, index + j + 1, p_len);
 									if (c == 0) {
 										r_err_str = "Unterminated String";
 										return ERR_PARSE_ERROR;
@@ -256,14 +443,14 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 								index += 4; //will add at the end anyway
 
 								if ((res & 0xfffffc00) == 0xd800) {
-									if (p_str[index + 1] != '\\' || p_str[index + 2] != 'u') {
+									if (_get_char(p_str, index + 1, p_len) != '\\' || _get_char(p_str, index + 2, p_len) != 'u') {
 										r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
 										return ERR_PARSE_ERROR;
 									}
 									index += 2;
 									char32_t trail = 0;
 									for (int j = 0; j < 4; j++) {
-										char32_t c = p_str[index + j + 1];
+										char32_t c = _get_char(p_str, index + j + 1, p_len);
 										if (c == 0) {
 											r_err_str = "Unterminated String";
 											return ERR_PARSE_ERROR;
@@ -316,10 +503,16 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 						str += res;
 
 					} else {
-						if (p_str[index] == '\n') {
+						char32_t c;
+						if (!_read_string_char(p_str, index, p_len, c)) {
+							r_err_str = "Invalid UTF-8 sequence in string";
+							return ERR_PARSE_ERROR;
+						}
+						if (c == '\n') {
 							line++;
 						}
-						str += p_str[index];
+						str += c;
+						continue; // Already past the character.
 					}
 					index++;
 				}
@@ -330,25 +523,22 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 
 			} break;
 			default: {
-				if (p_str[index] <= 32) {
+				if (_get_char(p_str, index, p_len) <= 32) {
 					index++;
 					break;
 				}
 
-				if (p_str[index] == '-' || is_digit(p_str[index])) {
+				if (_get_char(p_str, index, p_len) == '-' || is_digit(_get_char(p_str, index, p_len))) {
 					//a number
-					const char32_t *rptr;
-					double number = String::to_float(&p_str[index], &rptr);
-					index += (rptr - &p_str[index]);
 					r_token.type = TK_NUMBER;
-					r_token.value = number;
+					r_token.value = _parse_number(p_str, index, p_len);
 					return OK;
 
-				} else if (is_ascii_alphabet_char(p_str[index])) {
+				} else if (is_ascii_alphabet_char(_get_char(p_str, index, p_len))) {
 					String id;
 
-					while (is_ascii_alphabet_char(p_str[index])) {
-						id += p_str[index];
+					while (is_ascii_alphabet_char(_get_char(p_str, index, p_len))) {
+						id += _get_char(p_str, index, p_len);
 						index++;
 					}
 
@@ -366,7 +556,8 @@ Error JSON::_get_token(const char32_t *p_str, int &index, int p_len, Token &r_to
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+template <typename C>
+Error JSON::_parse_value(Variant &value, Token &token, const C *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
 	if (p_depth > Variant::MAX_RECURSION_DEPTH) {
 		r_err_str = "JSON structure is too deep. Bailing.";
 		return ERR_OUT_OF_MEMORY;
@@ -410,7 +601,8 @@ Error JSON::_parse_value(Variant &value, Token &token, const char32_t *p_str, in
 	return OK;
 }
 
-Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+template <typename C>
+Error JSON::_parse_array(Array &array, const C *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
 	Token token;
 	bool need_comma = false;
 
@@ -448,7 +640,8 @@ Error JSON::_parse_array(Array &array, const char32_t *p_str, int &index, int p_
 	return ERR_PARSE_ERROR;
 }
 
-Error JSON::_parse_object(Dictionary &object, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
+template <typename C>
+Error JSON::_parse_object(Dictionary &object, const C *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str) {
 	bool at_key = true;
 	String key;
 	Token token;
@@ -516,25 +709,24 @@ void JSON::set_data(const Variant &p_data) {
 	text.clear();
 }
 
-Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
-	const char32_t *str = p_json.ptr();
+template <typename C>
+Error JSON::_parse_buffer(const C *p_str, int p_len, Variant &r_ret, String &r_err_str, int &r_err_line) {
 	int idx = 0;
-	int len = p_json.length();
 	Token token;
 	r_err_line = 0;
 	String aux_key;
 
-	Error err = _get_token(str, idx, len, token, r_err_line, r_err_str);
+	Error err = _get_token(p_str, idx, p_len, token, r_err_line, r_err_str);
 	if (err) {
 		return err;
 	}
 
-	err = _parse_value(r_ret, token, str, idx, len, r_err_line, 0, r_err_str);
+	err = _parse_value(r_ret, token, p_str, idx, p_len, r_err_line, 0, r_err_str);
 
 	// Check if EOF is reached
 	// or it's a type of the next token.
-	if (err == OK && idx < len) {
-		err = _get_token(str, idx, len, token, r_err_line, r_err_str);
+	if (err == OK && idx < p_len) {
+		err = _get_token(p_str, idx, p_len, token, r_err_line, r_err_str);
 
 		if (err || token.type != TK_EOF) {
 			r_err_str = "Expected 'EOF'";
@@ -547,6 +739,10 @@ Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_st
 	return err;
 }
 
+Error JSON::_parse_string(const String &p_json, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	return _parse_buffer(p_json.ptr(), p_json.length(), r_ret, r_err_str, r_err_line);
+}
+
 Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	Error err = _parse_string(p_json_string, data, err_str, err_line);
 	if (err == Error::OK) {
@@ -558,15 +754,44 @@ Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	return err;
 }
 
+Error JSON::parse_utf8_buffer(const PackedByteArray &p_json_buffer, bool p_keep_text) {
+	const uint8_t *str = p_json_buffer.ptr();
+	int len = p_json_buffer.size();
+
+	// Skip the byte order mark, like when decoding the buffer to a string.
+	if (len >= 3 && str[0] == 0xef && str[1] == 0xbb && str[2] == 0xbf) {
+		str += 3;
+		len -= 3;
+	}
+
+	Error err = _parse_buffer(str, len, data, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	if (p_keep_text) {
+		text.parse_utf8((const char *)str, len);
+	}
+	return err;
+}
+
 String JSON::get_parsed_text() const {
 	return text;
 }
 
 String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
-	Ref<JSON> jason;
-	jason.instantiate();
+	String json;
 	HashSet<const void *> markers;
-	return jason->_stringify(p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	_stringify(json, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+	return json;
+}
+
+PackedByteArray JSON::stringify_to_utf8_buffer(const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	_JSONUTF8Buffer json;
+	HashSet<const void *> markers;
+	_stringify(json, p_var, p_indent, 0, p_sort_keys, markers, p_full_precision);
+
+	json.data.resize(json.size);
+	return json.data;
 }
 
 Variant JSON::parse_string(const String &p_json_string) {
@@ -579,8 +804,10 @@ Variant JSON::parse_string(const String &p_json_string) {
 
 void JSON::_bind_methods() {
 	ClassDB::bind_static_method("JSON", D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_static_method("JSON", D_METHOD("stringify_to_utf8_buffer", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify_to_utf8_buffer, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_static_method("JSON", D_METHOD("parse_string", "json_string"), &JSON::parse_string);
 	ClassDB::bind_method(D_METHOD("parse", "json_text", "keep_text"), &JSON::parse, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("parse_utf8_buffer", "json_buffer", "keep_text"), &JSON::parse_utf8_buffer, DEFVAL(false));
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &JSON::set_data);
@@ -1354,7 +1581,13 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	// Parse the UTF-8 file contents directly, instead of decoding them to a string first.
+	Error err = json->parse_utf8_buffer(FileAccess::get_file_as_bytes(p_path), Engine::get_singleton()->is_editor_hint());
+	if (err != OK) {
+		// The buffer parser rejects invalid UTF-8, which the string path decodes leniently.
+		// Parse again that way, so files that loaded before still load.
+		err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	}
 	if (err != OK) {
 		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
 
@@ -1397,14 +1630,16 @@ Error ResourceFormatSaverJSON::save(const Ref<Resource> &p_resource, const Strin
 	Ref<JSON> json = p_resource;
 	ERR_FAIL_COND_V(json.is_null(), ERR_INVALID_PARAMETER);
 
-	String source = json->get_parsed_text().is_empty() ? JSON::stringify(json->get_data(), "\t", false, true) : json->get_parsed_text();
-
 	Error err;
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
 
 	ERR_FAIL_COND_V_MSG(err, err, "Cannot save json '" + p_path + "'.");
 
-	file->store_string(source);
+	if (json->get_parsed_text().is_empty()) {
+		file->store_buffer(JSON::stringify_to_utf8_buffer(json->get_data(), "\t", false, true));
+	} else {
+		file->store_string(json->get_parsed_text());
+	}
 	if (file->get_error() != OK && file->get_error() != ERR_FILE_EOF) {
 		return ERR_CANT_CREATE;
 	}
@@ -33,10 +33,13 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -448,8 +451,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+						const Ref<ResourceLoader::LoadToken> &load_token = external_resources[erindex].load_token;
+						if (external_resources[erindex].resource.is_valid()) {
+							r_v = external_resources[erindex].resource;
+						} else if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
 							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
 							if (res.is_null()) {
@@ -680,223 +685,426 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
+Error ResourceLoaderBinary::_instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource, String &r_path) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
 		}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (!external_resources[i].load_token.is_valid()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	uint64_t offset = internal_resources[p_index].offset;
 
-		//maybe it is loaded already
-		String path;
-		String id;
+	f->seek(offset);
+
+	String t = get_unicode_string();
 
-		if (!main) {
-			path = internal_resources[i].path;
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	MissingResource *missing_resource = nullptr;
 
-				internal_resources.write[i].path = path; // Update path.
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
+				} else {
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 				}
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	if (r) {
+		r->set_scene_unique_id(id);
+	}
 
-		f->seek(offset);
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		String t = get_unicode_string();
+	r_res = res;
+	r_missing_resource = missing_resource;
+	r_path = path;
+	return OK;
+}
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+void ResourceLoaderBinary::_set_internal_resource_path(const Ref<Resource> &p_res, const String &p_path) {
+	if (p_path.is_empty()) {
+		return;
+	}
+	// Setters may depend on the path (e.g. to resolve relative includes), so it's assigned before
+	// the properties, but the resource only enters the ResourceCache once it's filled.
+	p_res->set_path_cache(p_path);
+}
 
-		MissingResource *missing_resource = nullptr;
+void ResourceLoaderBinary::_register_internal_resource(const Ref<Resource> &p_res, const String &p_path) {
+	if (p_path.is_empty() || cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE) {
+		return;
+	}
+	p_res->set_path_cache(String()); // set_path() does nothing if the path is already assigned.
+	p_res->set_path(p_path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+}
+
+Error ResourceLoaderBinary::_read_properties(LocalVector<Pair<StringName, Variant>> &r_properties) {
+	int pc = f->get_32();
+
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+
+		Variant value;
+
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
+
+		r_properties.push_back(Pair<StringName, Variant>(name, value));
+	}
+
+	return OK;
+}
+
+void ResourceLoaderBinary::_set_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, LocalVector<Pair<StringName, Variant>> &p_properties) {
+	Dictionary missing_resource_properties;
+
+	for (Pair<StringName, Variant> &property : p_properties) {
+		const StringName &name = property.first;
+		Variant &value = property.second;
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
+
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-					}
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = p_res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
+			}
+		}
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = p_res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
 				}
-
-				res = Ref<Resource>(r);
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		if (set_valid) {
+			p_res->set(name, value);
+		}
+	}
+
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
+
+	if (!missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
+}
+
+void ResourceLoaderBinary::_finish_internal_resource(int p_index, const Ref<Resource> &p_res, MissingResource *p_missing_resource) {
+#ifdef TOOLS_ENABLED
+	p_res->set_edited(false);
+#endif
+
+	if (progress) {
+		*progress = (p_index + 1) / float(internal_resources.size());
+	}
+
+	resource_cache.push_back(p_res);
+
+	if (p_index == internal_resources.size() - 1) {
+		f.unref();
+		resource = p_res;
+		resource->set_as_translation_remapped(translation_remapped);
+	}
+}
+
+bool ResourceLoaderBinary::_can_load_parallel() const {
+#ifdef THREADS_ENABLED
+	// Only the current format refers to internal and external resources by index, which
+	// keeps decoding free of loader side effects.
+	if (!using_named_scene_ids || internal_resources.size() < PARALLEL_DECODE_MIN_RESOURCES) {
+		return false;
+	}
+	if (f->get_length() < PARALLEL_DECODE_MIN_BYTES) {
+		return false;
+	}
+	// Threaded and background loads run as pool tasks, which help run the decode while they wait.
+	// Loads nested inside a group task stay serial, so one group doesn't fan out into another.
+	return WorkerThreadPool::get_singleton()->get_thread_count() > 1 && WorkerThreadPool::get_caller_group_task_id() == WorkerThreadPool::INVALID_TASK_ID;
+#else
+	return false;
+#endif
+}
+
+void ResourceLoaderBinary::_decode_resource_properties(uint32_t p_task, ParallelDecode *p_decode) {
+	// Each task decodes a contiguous range of resources with its own decoder.
+	// Everything read below is left untouched by the loading thread until all tasks are done.
+	ResourceLoaderBinary decoder;
+	decoder.local_path = local_path;
+	decoder.res_path = res_path;
+	decoder.ver_format = ver_format;
+	decoder.using_named_scene_ids = using_named_scene_ids;
+	decoder.string_map = string_map;
+	decoder.external_resources = external_resources;
+	decoder.internal_resources = internal_resources;
+	decoder.internal_index_cache = internal_index_cache;
+	decoder.remaps = remaps;
+	decoder.cache_mode_for_external = cache_mode_for_external;
+
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(p_decode->data, p_decode->length);
+	fa->set_big_endian(f->is_big_endian());
+	fa->real_is_double = f->real_is_double;
+	decoder.f = fa;
+
+	const uint32_t count = p_decode->resources.size();
+	const uint32_t from = uint64_t(p_task) * count / p_decode->task_count;
+	const uint32_t to = uint64_t(p_task + 1) * count / p_decode->task_count;
+	for (uint32_t i = from; i < to; i++) {
+		DecodedResource &decoded = p_decode->resources[i];
+		decoder.f->seek(decoded.properties_offset);
+		decoded.error = decoder._read_properties(decoded.properties);
+	}
+}
+
+Error ResourceLoaderBinary::_load_parallel() {
+	uint64_t stage_begin = OS::get_singleton()->get_ticks_usec();
+
+	// Complete external loads up front so decoding never waits on the loader.
+	for (int i = 0; i < external_resources.size(); i++) {
+		ExtResource &er = external_resources.write[i];
+		if (er.load_token.is_null()) {
+			continue;
+		}
+		Error err;
+		Ref<Resource> res = ResourceLoader::_load_complete(*er.load_token.ptr(), &err);
+		if (res.is_null()) {
+			if (!ResourceLoader::is_cleaning_tasks()) {
+				if (!ResourceLoader::get_abort_on_missing_resources()) {
+					ResourceLoader::notify_dependency_error(local_path, er.path, er.type);
 				} else {
-					r->set_path_cache(path);
+					error = ERR_FILE_MISSING_DEPENDENCIES;
+					ERR_FAIL_V_MSG(error, "Can't load dependency: " + er.path + ".");
 				}
 			}
-			r->set_scene_unique_id(id);
+			// Already reported, references to it decode as null.
+			er.load_token.unref();
+		} else {
+			er.resource = res;
 		}
+	}
+
+	ParallelDecode decode;
+	decode.resources.reserve(internal_resources.size());
 
-		if (!main) {
-			internal_index_cache[path] = res;
+	for (int i = 0; i < internal_resources.size(); i++) {
+		DecodedResource decoded;
+		error = _instantiate_internal_resource(i, decoded.resource, decoded.missing_resource, decoded.path);
+		if (error) {
+			return error;
 		}
+		if (decoded.resource.is_null()) {
+			continue; // Reused from the cache.
+		}
+		decoded.index = i;
+		decoded.properties_offset = f->get_position();
+		decode.resources.push_back(decoded);
+	}
 
-		int pc = f->get_32();
+	uint64_t instantiate_end = OS::get_singleton()->get_ticks_usec();
 
-		//set properties
+	// Decoders read through their own FileAccessMemory, straight from the mapping when there is one.
+	Vector<uint8_t> file_data;
+	decode.data = f->get_mapped_data();
+	if (!decode.data && f->map_read_only() == OK) {
+		decode.data = f->get_mapped_data();
+	}
+	if (decode.data) {
+		decode.length = f->get_length();
+	} else {
+		f->seek(0);
+		file_data.resize(f->get_length());
+		decode.length = f->get_buffer(file_data.ptrw(), file_data.size());
+		decode.data = file_data.ptr();
+	}
 
-		Dictionary missing_resource_properties;
+	// Decoders copy the loader's tables, so a few ranges per thread balance the load without
+	// making one per resource.
+	decode.task_count = MIN(decode.resources.size(), (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count() * 4);
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ResourceLoaderBinary::_decode_resource_properties, &decode, decode.task_count, -1, true, SNAME("ResourceLoaderBinaryDecode"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+	uint64_t decode_end = OS::get_singleton()->get_ticks_usec();
 
-			Variant value;
+	// Sub-resources always precede the resources using them, so setting properties in file
+	// order hands every setter a fully loaded resource, as in the serial path.
+	// Resources only enter the ResourceCache once filled, so other threads never see them empty.
+	for (DecodedResource &decoded : decode.resources) {
+		if (decoded.error) {
+			error = decoded.error;
+			return error;
+		}
+		_set_internal_resource_path(decoded.resource, decoded.path);
+		_set_properties(decoded.resource, decoded.missing_resource, decoded.properties);
+		_register_internal_resource(decoded.resource, decoded.path);
+		_finish_internal_resource(decoded.index, decoded.resource, decoded.missing_resource);
+	}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+	uint64_t set_end = OS::get_singleton()->get_ticks_usec();
+	print_verbose(vformat("Loaded %s: %d internal resources, instantiate %d usec, decode %d usec, set properties %d usec.", local_path, decode.resources.size(), instantiate_end - stage_begin, decode_end - instantiate_end, set_end - decode_end));
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	if (resource.is_null()) {
+		return ERR_FILE_EOF;
+	}
+	error = OK;
+	return OK;
+}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
-				}
-			}
+		if (remaps.has(path)) {
+			path = remaps[path];
+		}
 
-			if (set_valid) {
-				res->set(name, value);
-			}
+		if (!path.contains("://") && path.is_relative_path()) {
+			// path is relative to file being loaded, so convert to a resource path
+			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+		if (!external_resources[i].load_token.is_valid()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
+			}
 		}
+	}
+
+	if (_can_load_parallel()) {
+		return _load_parallel();
+	}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	for (int i = 0; i < internal_resources.size(); i++) {
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+		String path;
+
+		error = _instantiate_internal_resource(i, res, missing_resource, path);
+		if (error) {
+			return error;
+		}
+		if (res.is_null()) {
+			continue; // Reused from the cache.
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		//set properties
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+		LocalVector<Pair<StringName, Variant>> properties;
+		error = _read_properties(properties);
+		if (error) {
+			return error;
 		}
 
-		resource_cache.push_back(res);
+		_set_internal_resource_path(res, path);
+		_set_properties(res, missing_resource, properties);
+		_register_internal_resource(res, path);
+		_finish_internal_resource(i, res, missing_resource);
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
+		if (resource.is_valid()) {
 			error = OK;
 			return OK;
 		}
@@ -34,6 +34,10 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -61,6 +65,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> resource; // Set when the load was completed ahead of decoding properties.
 	};
 
 	bool using_named_scene_ids = false;
@@ -93,6 +98,39 @@ class ResourceLoaderBinary {
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	// Internal resources are instantiated serially, their property lists can then be
+	// decoded on the WorkerThreadPool and are finally set in file order.
+	static constexpr int PARALLEL_DECODE_MIN_RESOURCES = 16;
+	static constexpr uint64_t PARALLEL_DECODE_MIN_BYTES = 16384;
+
+	struct DecodedResource {
+		int index = 0;
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		String path;
+		uint64_t properties_offset = 0;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	struct ParallelDecode {
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+		LocalVector<DecodedResource> resources;
+		uint32_t task_count = 0;
+	};
+
+	Error _instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource, String &r_path);
+	Error _read_properties(LocalVector<Pair<StringName, Variant>> &r_properties);
+	void _set_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource, LocalVector<Pair<StringName, Variant>> &p_properties);
+	void _set_internal_resource_path(const Ref<Resource> &p_res, const String &p_path);
+	void _register_internal_resource(const Ref<Resource> &p_res, const String &p_path);
+	void _finish_internal_resource(int p_index, const Ref<Resource> &p_res, MissingResource *p_missing_resource);
+
+	bool _can_load_parallel() const;
+	Error _load_parallel();
+	void _decode_resource_properties(uint32_t p_task, ParallelDecode *p_decode);
+
 public:
 	Ref<Resource> get_resource();
 	Error load();
@@ -33,6 +33,7 @@
 
 #include "core/math/geometry_3d.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 
 int64_t AStar3D::get_available_point_id() const {
 	if (points.has(last_free_id)) {
@@ -58,10 +59,13 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
 		pt->enabled = true;
+		if (free_point_indices.is_empty()) {
+			pt->index = point_index_count++;
+		} else {
+			pt->index = free_point_indices[free_point_indices.size() - 1];
+			free_point_indices.remove_at(free_point_indices.size() - 1);
+		}
 		points.set(p_id, pt);
 	} else {
 		found_pt->pos = p_pos;
@@ -123,6 +127,7 @@ void AStar3D::remove_point(int64_t p_id) {
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	free_point_indices.push_back(p->index);
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
@@ -249,6 +254,8 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+	point_index_count = 0;
+	free_point_indices.clear();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -319,31 +326,67 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
-	pass++;
+AStar3D::SolveContext *AStar3D::_acquire_solve_context() {
+	SolveContext *context = nullptr;
+	{
+		MutexLock lock(solve_contexts_mutex);
+		if (!free_solve_contexts.is_empty()) {
+			context = free_solve_contexts[free_solve_contexts.size() - 1];
+			free_solve_contexts.remove_at(free_solve_contexts.size() - 1);
+		}
+	}
+	if (!context) {
+		context = memnew(SolveContext);
+	}
+
+	// States from previous queries are told apart by their pass, so they don't need to be cleared.
+	if (context->states.size() < point_index_count) {
+		context->states.resize(point_index_count);
+	}
+	context->pass++;
+	context->last_closest_point = nullptr;
+
+	return context;
+}
+
+void AStar3D::_release_solve_context(SolveContext *p_context) {
+	MutexLock lock(solve_contexts_mutex);
+	free_solve_contexts.push_back(p_context);
+}
 
+bool AStar3D::_solve(SolveContext &r_context, Point *begin_point, Point *end_point, bool p_allow_partial_path) {
 	if (!end_point->enabled && !p_allow_partial_path) {
 		return false;
 	}
 
 	bool found_route = false;
+	const uint64_t pass = r_context.pass;
+	SolveContext::PointState *states = r_context.states.ptr();
 
 	LocalVector<Point *> open_list;
 	SortArray<Point *, SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
+	sorter.compare.states = states;
+
+	SolveContext::PointState &begin_state = states[begin_point->index];
+	begin_state.g_score = 0;
+	begin_state.f_score = _estimate_cost(begin_point->id, end_point->id);
+	begin_state.abs_g_score = 0;
+	begin_state.abs_f_score = begin_state.f_score;
+	begin_state.open_pass = pass;
 	open_list.push_back(begin_point);
 
 	while (!open_list.is_empty()) {
 		Point *p = open_list[0]; // The currently processed point.
+		SolveContext::PointState &p_state = states[p->index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (r_context.last_closest_point == nullptr) {
+			r_context.last_closest_point = p;
+		} else {
+			const SolveContext::PointState &closest_state = states[r_context.last_closest_point->index];
+			if (closest_state.abs_f_score > p_state.abs_f_score || (closest_state.abs_f_score >= p_state.abs_f_score && closest_state.abs_g_score > p_state.abs_g_score)) {
+				r_context.last_closest_point = p;
+			}
 		}
 
 		if (p == end_point) {
@@ -353,32 +396,33 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		p_state.closed_pass = pass; // Mark the point as closed.
 
 		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
 			Point *e = *(it.value); // The neighbor point.
+			SolveContext::PointState &e_state = states[e->index];
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!e->enabled || e_state.closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = p_state.g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			e_state.f_score = e_state.g_score + _estimate_cost(e->id, end_point->id);
+			e_state.abs_g_score = tentative_g_score;
+			e_state.abs_f_score = e_state.f_score - e_state.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -443,21 +487,25 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	SolveContext *context = _acquire_solve_context();
+	const SolveContext::PointState *states = context->states.ptr();
+
+	bool found_route = _solve(*context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || context->last_closest_point == nullptr) {
+			_release_solve_context(context);
 			return Vector<Vector3>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = context->last_closest_point;
 	}
 
 	Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p->index].prev_point;
 	}
 
 	Vector<Vector3> path;
@@ -470,12 +518,13 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 		int64_t idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+			p2 = states[p2->index].prev_point;
 		}
 
 		w[0] = p2->pos; // Assign first
 	}
 
+	_release_solve_context(context);
 	return path;
 }
 
@@ -497,21 +546,25 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	SolveContext *context = _acquire_solve_context();
+	const SolveContext::PointState *states = context->states.ptr();
+
+	bool found_route = _solve(*context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || context->last_closest_point == nullptr) {
+			_release_solve_context(context);
 			return Vector<int64_t>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = context->last_closest_point;
 	}
 
 	Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p->index].prev_point;
 	}
 
 	Vector<int64_t> path;
@@ -524,15 +577,48 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 		int64_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = states[p->index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
 	}
 
+	_release_solve_context(context);
 	return path;
 }
 
+void AStar3D::_solve_id_path_batch_item(uint32_t p_index, IdPathBatch *p_batch) {
+	p_batch->paths[p_index] = get_id_path(p_batch->from_ids[p_index], p_batch->to_ids[p_index], p_batch->allow_partial_path);
+}
+
+TypedArray<PackedInt64Array> AStar3D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. The number of start points (%d) and end points (%d) don't match.", p_from_ids.size(), p_to_ids.size()));
+
+	IdPathBatch batch;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.allow_partial_path = p_allow_partial_path;
+	batch.paths.resize(p_from_ids.size());
+
+	if (GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost)) {
+		// Script cost callbacks can't be assumed to be thread-safe.
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			_solve_id_path_batch_item(i, &batch);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStar3D::_solve_id_path_batch_item, &batch, batch.paths.size(), -1, false, SNAME("AStar3DGetIdPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		paths[i] = batch.paths[i];
+	}
+
+	return paths;
+}
+
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	Point *p = nullptr;
 	bool p_exists = points.lookup(p_id, p);
@@ -578,6 +664,7 @@ void AStar3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStar3D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -585,6 +672,9 @@ void AStar3D::_bind_methods() {
 
 AStar3D::~AStar3D() {
 	clear();
+	for (SolveContext *context : free_solve_contexts) {
+		memdelete(context);
+	}
 }
 
 /////////////////////////////////////////////////////////////
@@ -726,21 +816,25 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	AStar3D::Point *begin_point = a;
 	AStar3D::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	AStar3D::SolveContext *context = astar._acquire_solve_context();
+	const AStar3D::SolveContext::PointState *states = context->states.ptr();
+
+	bool found_route = _solve(*context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
+		if (!p_allow_partial_path || context->last_closest_point == nullptr) {
+			astar._release_solve_context(context);
 			return Vector<Vector2>();
 		}
 
 		// Use closest point instead.
-		end_point = astar.last_closest_point;
+		end_point = context->last_closest_point;
 	}
 
 	AStar3D::Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p->index].prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -753,12 +847,13 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 		int64_t idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+			p2 = states[p2->index].prev_point;
 		}
 
 		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
 	}
 
+	astar._release_solve_context(context);
 	return path;
 }
 
@@ -780,21 +875,25 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	AStar3D::Point *begin_point = a;
 	AStar3D::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	AStar3D::SolveContext *context = astar._acquire_solve_context();
+	const AStar3D::SolveContext::PointState *states = context->states.ptr();
+
+	bool found_route = _solve(*context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
+		if (!p_allow_partial_path || context->last_closest_point == nullptr) {
+			astar._release_solve_context(context);
 			return Vector<int64_t>();
 		}
 
 		// Use closest point instead.
-		end_point = astar.last_closest_point;
+		end_point = context->last_closest_point;
 	}
 
 	AStar3D::Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[p->index].prev_point;
 	}
 
 	Vector<int64_t> path;
@@ -807,40 +906,81 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 		int64_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = states[p->index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
 	}
 
+	astar._release_solve_context(context);
 	return path;
 }
 
-bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path) {
-	astar.last_closest_point = nullptr;
-	astar.pass++;
+void AStar2D::_solve_id_path_batch_item(uint32_t p_index, AStar3D::IdPathBatch *p_batch) {
+	p_batch->paths[p_index] = get_id_path(p_batch->from_ids[p_index], p_batch->to_ids[p_index], p_batch->allow_partial_path);
+}
+
+TypedArray<PackedInt64Array> AStar2D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. The number of start points (%d) and end points (%d) don't match.", p_from_ids.size(), p_to_ids.size()));
+
+	AStar3D::IdPathBatch batch;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.allow_partial_path = p_allow_partial_path;
+	batch.paths.resize(p_from_ids.size());
 
+	if (GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost)) {
+		// Script cost callbacks can't be assumed to be thread-safe.
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			_solve_id_path_batch_item(i, &batch);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStar2D::_solve_id_path_batch_item, &batch, batch.paths.size(), -1, false, SNAME("AStar2DGetIdPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		paths[i] = batch.paths[i];
+	}
+
+	return paths;
+}
+
+bool AStar2D::_solve(AStar3D::SolveContext &r_context, AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path) {
 	if (!end_point->enabled && !p_allow_partial_path) {
 		return false;
 	}
 
 	bool found_route = false;
+	const uint64_t pass = r_context.pass;
+	AStar3D::SolveContext::PointState *states = r_context.states.ptr();
 
 	LocalVector<AStar3D::Point *> open_list;
 	SortArray<AStar3D::Point *, AStar3D::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
+	sorter.compare.states = states;
+
+	AStar3D::SolveContext::PointState &begin_state = states[begin_point->index];
+	begin_state.g_score = 0;
+	begin_state.f_score = _estimate_cost(begin_point->id, end_point->id);
+	begin_state.abs_g_score = 0;
+	begin_state.abs_f_score = begin_state.f_score;
+	begin_state.open_pass = pass;
 	open_list.push_back(begin_point);
 
 	while (!open_list.is_empty()) {
 		AStar3D::Point *p = open_list[0]; // The currently processed point.
+		AStar3D::SolveContext::PointState &p_state = states[p->index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (astar.last_closest_point == nullptr || astar.last_closest_point->abs_f_score > p->abs_f_score || (astar.last_closest_point->abs_f_score >= p->abs_f_score && astar.last_closest_point->abs_g_score > p->abs_g_score)) {
-			astar.last_closest_point = p;
+		if (r_context.last_closest_point == nullptr) {
+			r_context.last_closest_point = p;
+		} else {
+			const AStar3D::SolveContext::PointState &closest_state = states[r_context.last_closest_point->index];
+			if (closest_state.abs_f_score > p_state.abs_f_score || (closest_state.abs_f_score >= p_state.abs_f_score && closest_state.abs_g_score > p_state.abs_g_score)) {
+				r_context.last_closest_point = p;
+			}
 		}
 
 		if (p == end_point) {
@@ -850,32 +990,33 @@ bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, boo
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed.
+		p_state.closed_pass = pass; // Mark the point as closed.
 
 		for (OAHashMap<int64_t, AStar3D::Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
 			AStar3D::Point *e = *(it.value); // The neighbor point.
+			AStar3D::SolveContext::PointState &e_state = states[e->index];
 
-			if (!e->enabled || e->closed_pass == astar.pass) {
+			if (!e->enabled || e_state.closed_pass == pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = p_state.g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			e_state.f_score = e_state.g_score + _estimate_cost(e->id, end_point->id);
+			e_state.abs_g_score = tentative_g_score;
+			e_state.abs_f_score = e_state.f_score - e_state.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -917,6 +1058,7 @@ void AStar2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStar2D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -33,7 +33,10 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
+#include "core/variant/typed_array.h"
 
 /**
 	A* pathfinding algorithm.
@@ -51,29 +54,46 @@ class AStar3D : public RefCounted {
 		real_t weight_scale = 0;
 		bool enabled = false;
 
+		// Dense index of the point, used to look up its search state in a `SolveContext`.
+		uint32_t index = 0;
+
 		OAHashMap<int64_t, Point *> neighbors = 4u;
 		OAHashMap<int64_t, Point *> unlinked_neighbours = 4u;
+	};
+
+	// Search state of a single pathfinding query. It is kept out of the points,
+	// so the same graph can be queried from several threads at once.
+	struct SolveContext {
+		struct PointState {
+			Point *prev_point = nullptr;
+			real_t g_score = 0;
+			real_t f_score = 0;
+			// Scores used to find the closest point for partial paths.
+			real_t abs_g_score = 0;
+			real_t abs_f_score = 0;
+			uint64_t open_pass = 0;
+			uint64_t closed_pass = 0;
+		};
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
-		real_t g_score = 0;
-		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
+		LocalVector<PointState> states;
+		uint64_t pass = 0;
 
-		// Used for getting closest_point_of_last_pathing_call.
-		real_t abs_g_score = 0;
-		real_t abs_f_score = 0;
+		// Used for partial paths, closest point to the end point that was reached.
+		Point *last_closest_point = nullptr;
 	};
 
 	struct SortPoints {
+		const SolveContext::PointState *states = nullptr;
+
 		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+			const SolveContext::PointState &a = states[A->index];
+			const SolveContext::PointState &b = states[B->index];
+			if (a.f_score > b.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (a.f_score < b.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return a.g_score < b.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
@@ -109,13 +129,29 @@ class AStar3D : public RefCounted {
 	};
 
 	int64_t last_free_id = 0;
-	uint64_t pass = 1;
 
 	OAHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
-	Point *last_closest_point = nullptr;
 
-	bool _solve(Point *begin_point, Point *end_point, bool p_allow_partial_path);
+	uint32_t point_index_count = 0;
+	LocalVector<uint32_t> free_point_indices;
+
+	Mutex solve_contexts_mutex;
+	LocalVector<SolveContext *> free_solve_contexts;
+
+	SolveContext *_acquire_solve_context();
+	void _release_solve_context(SolveContext *p_context);
+
+	bool _solve(SolveContext &r_context, Point *begin_point, Point *end_point, bool p_allow_partial_path);
+
+	struct IdPathBatch {
+		const int64_t *from_ids = nullptr;
+		const int64_t *to_ids = nullptr;
+		bool allow_partial_path = false;
+		LocalVector<Vector<int64_t>> paths;
+	};
+
+	void _solve_id_path_batch_item(uint32_t p_index, IdPathBatch *p_batch);
 
 protected:
 	static void _bind_methods();
@@ -162,6 +198,7 @@ public:
 
 	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false);
 
 	AStar3D() {}
 	~AStar3D();
@@ -171,7 +208,8 @@ class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
 	AStar3D astar;
 
-	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path);
+	bool _solve(AStar3D::SolveContext &r_context, AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path);
+	void _solve_id_path_batch_item(uint32_t p_index, AStar3D::IdPathBatch *p_batch);
 
 protected:
 	static void _bind_methods();
@@ -218,6 +256,7 @@ public:
 
 	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false);
 
 	AStar2D() {}
 	~AStar2D() {}
@@ -31,6 +31,7 @@
 #include "a_star_grid_2d.h"
 #include "a_star_grid_2d.compat.inc"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 static real_t heuristic_euclidean(const Vector2i &p_from, const Vector2i &p_to) {
@@ -269,7 +270,7 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
+AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to, Point *p_end) {
 	int32_t from_x = p_from->id.x;
 	int32_t from_y = p_from->id.y;
 
@@ -281,19 +282,19 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(to_x, to_y, dx, dy);
+			return _forced_successor(to_x, to_y, dx, dy, p_end);
 		}
 
 		while (_is_walkable(to_x, to_y) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || _is_walkable(to_x, to_y - dy) || _is_walkable(to_x - dx, to_y))) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (p_end->id.x == to_x && p_end->id.y == to_y) {
+				return p_end;
 			}
 
 			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x + dx, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y + dy, 0, dy) != nullptr) {
+			if (_forced_successor(to_x + dx, to_y, dx, 0, p_end) != nullptr || _forced_successor(to_x, to_y + dy, 0, dy, p_end) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -303,19 +304,19 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(from_x, from_y, dx, dy, true);
+			return _forced_successor(from_x, from_y, dx, dy, p_end, true);
 		}
 
 		while (_is_walkable(to_x, to_y) && _is_walkable(to_x, to_y - dy) && _is_walkable(to_x - dx, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (p_end->id.x == to_x && p_end->id.y == to_y) {
+				return p_end;
 			}
 
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y, 0, dy) != nullptr) {
+			if (_forced_successor(to_x, to_y, dx, 0, p_end) != nullptr || _forced_successor(to_x, to_y, 0, dy, p_end) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -325,19 +326,19 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else { // DIAGONAL_MODE_NEVER
 		if (dy == 0) {
-			return _forced_successor(from_x, from_y, dx, 0, true);
+			return _forced_successor(from_x, from_y, dx, 0, p_end, true);
 		}
 
 		while (_is_walkable(to_x, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (p_end->id.x == to_x && p_end->id.y == to_y) {
+				return p_end;
 			}
 
 			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x, to_y, 1, 0, true) != nullptr || _forced_successor(to_x, to_y, -1, 0, true) != nullptr) {
+			if (_forced_successor(to_x, to_y, 1, 0, p_end, true) != nullptr || _forced_successor(to_x, to_y, -1, 0, p_end, true) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -348,7 +349,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 	return nullptr;
 }
 
-AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
+AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Point *p_end, bool p_inclusive) {
 	// Remembering previous results can improve performance.
 	bool l_prev = false, r_prev = false, l = false, r = false;
 
@@ -362,8 +363,8 @@ AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int
 	int32_t r_x = p_x + p_dy, r_y = p_y + p_dx;
 
 	while (_is_walkable(o_x, o_y)) {
-		if (end->id.x == o_x && end->id.y == o_y) {
-			return end;
+		if (p_end->id.x == o_x && p_end->id.y == o_y) {
+			return p_end;
 		}
 
 		l_prev = l || _is_walkable(l_x, l_y);
@@ -491,32 +492,69 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
-	pass++;
+AStarGrid2D::SolveContext *AStarGrid2D::_acquire_solve_context() {
+	SolveContext *context = nullptr;
+	{
+		MutexLock lock(solve_contexts_mutex);
+		if (!free_solve_contexts.is_empty()) {
+			context = free_solve_contexts[free_solve_contexts.size() - 1];
+			free_solve_contexts.remove_at(free_solve_contexts.size() - 1);
+		}
+	}
+	if (!context) {
+		context = memnew(SolveContext);
+	}
+
+	// States from previous queries are told apart by their pass, so they don't need to be cleared.
+	const uint32_t point_count = region.size.x * region.size.y;
+	if (context->states.size() < point_count) {
+		context->states.resize(point_count);
+	}
+	context->pass++;
+	context->last_closest_point = nullptr;
+
+	return context;
+}
 
+void AStarGrid2D::_release_solve_context(SolveContext *p_context) {
+	MutexLock lock(solve_contexts_mutex);
+	free_solve_contexts.push_back(p_context);
+}
+
+bool AStarGrid2D::_solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
 	if (_get_solid_unchecked(p_end_point->id) && !p_allow_partial_path) {
 		return false;
 	}
 
 	bool found_route = false;
+	const uint64_t pass = r_context.pass;
+	SolveContext::PointState *states = r_context.states.ptr();
 
 	LocalVector<Point *> open_list;
 	SortArray<Point *, SortPoints> sorter;
-
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	sorter.compare.astar = this;
+	sorter.compare.states = states;
+
+	SolveContext::PointState &begin_state = states[_get_point_index(p_begin_point)];
+	begin_state.g_score = 0;
+	begin_state.f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	begin_state.abs_g_score = 0;
+	begin_state.abs_f_score = begin_state.f_score;
+	begin_state.open_pass = pass;
 	open_list.push_back(p_begin_point);
-	end = p_end_point;
 
 	while (!open_list.is_empty()) {
 		Point *p = open_list[0]; // The currently processed point.
+		SolveContext::PointState &p_state = states[_get_point_index(p)];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (r_context.last_closest_point == nullptr) {
+			r_context.last_closest_point = p;
+		} else {
+			const SolveContext::PointState &closest_state = states[_get_point_index(r_context.last_closest_point)];
+			if (closest_state.abs_f_score > p_state.abs_f_score || (closest_state.abs_f_score >= p_state.abs_f_score && closest_state.abs_g_score > p_state.abs_g_score)) {
+				r_context.last_closest_point = p;
+			}
 		}
 
 		if (p == p_end_point) {
@@ -526,7 +564,7 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		p_state.closed_pass = pass; // Mark the point as closed.
 
 		LocalVector<Point *> nbors;
 		_get_nbors(p, nbors);
@@ -536,34 +574,34 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e = _jump(p, e, p_end_point);
+				if (!e || states[_get_point_index(e)].closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (_get_solid_unchecked(e->id) || e->closed_pass == pass) {
+				if (_get_solid_unchecked(e->id) || states[_get_point_index(e)].closed_pass == pass) {
 					continue;
 				}
 				weight_scale = e->weight_scale;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			SolveContext::PointState &e_state = states[_get_point_index(e)];
+			real_t tentative_g_score = p_state.g_score + _compute_cost(p->id, e->id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
-
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			e_state.f_score = e_state.g_score + _estimate_cost(e->id, p_end_point->id);
+			e_state.abs_g_score = tentative_g_score;
+			e_state.abs_f_score = e_state.f_score - e_state.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -647,21 +685,25 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	SolveContext *context = _acquire_solve_context();
+	const SolveContext::PointState *states = context->states.ptr();
+
+	bool found_route = _solve(*context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || context->last_closest_point == nullptr) {
+			_release_solve_context(context);
 			return Vector<Vector2>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = context->last_closest_point;
 	}
 
 	Point *p = end_point;
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[_get_point_index(p)].prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -674,12 +716,13 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->pos;
-			p = p->prev_point;
+			p = states[_get_point_index(p)].prev_point;
 		}
 
 		w[0] = p->pos;
 	}
 
+	_release_solve_context(context);
 	return path;
 }
 
@@ -700,21 +743,25 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
+	SolveContext *context = _acquire_solve_context();
+	const SolveContext::PointState *states = context->states.ptr();
+
+	bool found_route = _solve(*context, begin_point, end_point, p_allow_partial_path);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || context->last_closest_point == nullptr) {
+			_release_solve_context(context);
 			return TypedArray<Vector2i>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = context->last_closest_point;
 	}
 
 	Point *p = end_point;
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = states[_get_point_index(p)].prev_point;
 	}
 
 	TypedArray<Vector2i> path;
@@ -725,15 +772,53 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
 			path[idx--] = p->id;
-			p = p->prev_point;
+			p = states[_get_point_index(p)].prev_point;
 		}
 
 		path[0] = p->id;
 	}
 
+	_release_solve_context(context);
 	return path;
 }
 
+void AStarGrid2D::_solve_id_path_batch_item(uint32_t p_index, IdPathBatch *p_batch) {
+	p_batch->paths[p_index] = get_id_path(p_batch->from_ids[p_index], p_batch->to_ids[p_index], p_batch->allow_partial_path);
+}
+
+TypedArray<Array> AStarGrid2D::get_id_paths(const TypedArray<Vector2i> &p_from, const TypedArray<Vector2i> &p_to, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Array>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), TypedArray<Array>(), vformat("Can't get id paths. The number of start points (%d) and end points (%d) don't match.", p_from.size(), p_to.size()));
+
+	IdPathBatch batch;
+	batch.from_ids.resize(p_from.size());
+	batch.to_ids.resize(p_to.size());
+	for (uint32_t i = 0; i < batch.from_ids.size(); i++) {
+		batch.from_ids[i] = p_from[i];
+		batch.to_ids[i] = p_to[i];
+	}
+	batch.allow_partial_path = p_allow_partial_path;
+	batch.paths.resize(batch.from_ids.size());
+
+	if (GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) || GDVIRTUAL_IS_OVERRIDDEN(_compute_cost)) {
+		// Script cost callbacks can't be assumed to be thread-safe.
+		for (uint32_t i = 0; i < batch.paths.size(); i++) {
+			_solve_id_path_batch_item(i, &batch);
+		}
+	} else {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStarGrid2D::_solve_id_path_batch_item, &batch, batch.paths.size(), -1, false, SNAME("AStarGrid2DGetIdPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	TypedArray<Array> paths;
+	paths.resize(batch.paths.size());
+	for (uint32_t i = 0; i < batch.paths.size(); i++) {
+		paths[i] = batch.paths[i];
+	}
+
+	return paths;
+}
+
 void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_region", "region"), &AStarGrid2D::set_region);
 	ClassDB::bind_method(D_METHOD("get_region"), &AStarGrid2D::get_region);
@@ -769,6 +854,7 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_data_in_region", "region"), &AStarGrid2D::get_point_data_in_region);
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStarGrid2D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -801,3 +887,9 @@ void AStarGrid2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(CELL_SHAPE_ISOMETRIC_DOWN);
 	BIND_ENUM_CONSTANT(CELL_SHAPE_MAX);
 }
+
+AStarGrid2D::~AStarGrid2D() {
+	for (SolveContext *context : free_solve_contexts) {
+		memdelete(context);
+	}
+}
@@ -33,8 +33,10 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
 
 class AStarGrid2D : public RefCounted {
 	GDCLASS(AStarGrid2D, RefCounted);
@@ -81,41 +83,62 @@ private:
 		Vector2 pos;
 		real_t weight_scale = 1.0;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
-		real_t g_score = 0;
-		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
-
-		// Used for getting last_closest_point.
-		real_t abs_g_score = 0;
-		real_t abs_f_score = 0;
-
 		Point() {}
 
 		Point(const Vector2i &p_id, const Vector2 &p_pos) :
 				id(p_id), pos(p_pos) {}
 	};
 
+	// Per-query search state, indexed like the points of the grid. Keeping it out of the points allows several
+	// queries to run at the same time on the same grid.
+	struct SolveContext {
+		struct PointState {
+			Point *prev_point = nullptr;
+			real_t g_score = 0;
+			real_t f_score = 0;
+			// Scores used to find the closest point for partial paths.
+			real_t abs_g_score = 0;
+			real_t abs_f_score = 0;
+			uint64_t open_pass = 0;
+			uint64_t closed_pass = 0;
+		};
+
+		LocalVector<PointState> states;
+		uint64_t pass = 0;
+
+		// Used for partial paths, closest point to the end point that was reached.
+		Point *last_closest_point = nullptr;
+	};
+
 	struct SortPoints {
+		const AStarGrid2D *astar = nullptr;
+		const SolveContext::PointState *states = nullptr;
+
 		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+			const SolveContext::PointState &a = states[astar->_get_point_index(A)];
+			const SolveContext::PointState &b = states[astar->_get_point_index(B)];
+			if (a.f_score > b.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (a.f_score < b.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return a.g_score < b.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	struct IdPathBatch {
+		LocalVector<Vector2i> from_ids;
+		LocalVector<Vector2i> to_ids;
+		bool allow_partial_path = false;
+		LocalVector<TypedArray<Vector2i>> paths;
+	};
+
 	LocalVector<bool> solid_mask;
 	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
 
-	uint64_t pass = 1;
+	Mutex solve_contexts_mutex;
+	LocalVector<SolveContext *> free_solve_contexts;
 
 private: // Internal routines.
 	_FORCE_INLINE_ size_t _to_mask_index(int32_t p_x, int32_t p_y) const {
@@ -126,6 +149,10 @@ private: // Internal routines.
 		return !solid_mask[_to_mask_index(p_x, p_y)];
 	}
 
+	_FORCE_INLINE_ uint32_t _get_point_index(const Point *p_point) const {
+		return (p_point->id.y - region.position.y) * region.size.x + p_point->id.x - region.position.x;
+	}
+
 	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
 		if (region.has_point(Vector2i(p_x, p_y))) {
 			return &points[p_y - region.position.y][p_x - region.position.x];
@@ -158,9 +185,12 @@ private: // Internal routines.
 	}
 
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
-	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
+	Point *_jump(Point *p_from, Point *p_to, Point *p_end);
+	SolveContext *_acquire_solve_context();
+	void _release_solve_context(SolveContext *p_context);
+	bool _solve(SolveContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
+	void _solve_id_path_batch_item(uint32_t p_index, IdPathBatch *p_batch);
+	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Point *p_end, bool p_inclusive = false);
 
 protected:
 	static void _bind_methods();
@@ -226,6 +256,9 @@ public:
 	TypedArray<Dictionary> get_point_data_in_region(const Rect2i &p_region) const;
 	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
 	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
+	TypedArray<Array> get_id_paths(const TypedArray<Vector2i> &p_from, const TypedArray<Vector2i> &p_to, bool p_allow_partial_path = false);
+
+	~AStarGrid2D();
 };
 
 VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
@@ -52,6 +52,7 @@
 // and pairable_mask is either 0 if static, or set to all if non static
 
 #include "bvh_tree.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -71,6 +72,19 @@ public:
 		_thread_safe = p_enable;
 	}
 
+	// Keeps the BVH from being modified across several queries made with the _unlocked functions.
+	void lock() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.lock();
+		}
+	}
+
+	void unlock() {
+		if (BVH_THREAD_SAFE && _thread_safe) {
+			_mutex.unlock();
+		}
+	}
+
 	// these 2 are crucial for fine tuning, and can be applied manually
 	// see the variable declarations for more info.
 	void params_set_node_expansion(real_t p_value) {
@@ -88,6 +102,13 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// When many items changed, the tree queries for pairing are spread over the WorkerThreadPool.
+	// The pair / unpair callbacks are still sent from the calling thread, in the same order as without it.
+	void params_set_parallel_pairing(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_parallel_pairing = p_enable;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -381,6 +402,31 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Culls up to BVHCommon::PACKET_SIZE_MAX segments in one traversal. For each result, the index of the
+	// segment within the packet is written to r_segment_array. Returns -1 if p_result_max was reached.
+	int cull_segment_packet(const POINT *p_from, const POINT *p_to, uint32_t p_count, T **p_result_array, uint32_t *r_segment_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		BVH_LOCKED_FUNCTION
+		return cull_segment_packet_unlocked(p_from, p_to, p_count, p_result_array, r_segment_array, p_result_max, p_tester, p_tree_collision_mask, p_subindex_array);
+	}
+
+	// Same as cull_segment_packet, for callers holding lock(). The traversal only reads the tree,
+	// so several threads can run it while the lock is held once for all of them.
+	int cull_segment_packet_unlocked(const POINT *p_from, const POINT *p_to, uint32_t p_count, T **p_result_array, uint32_t *r_segment_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
+		typename BVHTREE_CLASS::CullSegmentPacketParams params;
+
+		params.from = p_from;
+		params.to = p_to;
+		params.count = p_count;
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.segment_array = r_segment_array;
+
+		return tree.cull_segment_packet(params);
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -435,6 +481,11 @@ private:
 			return;
 		}
 
+		if (USE_PAIRS && _parallel_pairing && changed_items.size() > PAIRING_CHUNK_SIZE) {
+			_check_for_collisions_parallel(p_full_check);
+			return;
+		}
+
 		BOUNDS bb;
 
 		typename BVHTREE_CLASS::CullParams params;
@@ -480,6 +531,85 @@ private:
 		_reset();
 	}
 
+	// Each chunk of changed items is culled against the tree on a worker thread. The tree is not
+	// modified while pairing, so the culls can safely run side by side, each into its own hit list.
+	void _pairing_cull_chunk(uint32_t p_chunk, void *p_userdata) {
+		PairingChunk &chunk = _pairing_chunks[p_chunk];
+		chunk.hits.clear();
+		chunk.item_hit_ends.clear();
+
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+
+		uint32_t item_begin = p_chunk * PAIRING_CHUNK_SIZE;
+		uint32_t item_end = MIN(item_begin + PAIRING_CHUNK_SIZE, changed_items.size());
+
+		for (uint32_t i = item_begin; i < item_end; i++) {
+			const BVHHandle &h = changed_items[i];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+
+			tree.item_fill_cullparams(h, params);
+			params.abb = abb;
+
+			uint32_t hits_begin = chunk.hits.size();
+			tree.cull_aabb_hits(params, chunk.hits);
+
+			// Only keep the hits that can actually pair, so the serial part has less to go through.
+			uint32_t hits_end = hits_begin;
+			for (uint32_t n = hits_begin; n < chunk.hits.size(); n++) {
+				BVHHandle h_collidee;
+				h_collidee.set_id(chunk.hits[n]);
+
+				if (h_collidee.id() != h.id() && _pair_allowed(h, h_collidee)) {
+					chunk.hits[hits_end++] = h_collidee.id();
+				}
+			}
+			chunk.hits.resize(hits_end);
+			chunk.item_hit_ends.push_back(hits_end);
+		}
+	}
+
+	void _check_for_collisions_parallel(bool p_full_check) {
+		uint32_t chunk_count = (changed_items.size() + PAIRING_CHUNK_SIZE - 1) / PAIRING_CHUNK_SIZE;
+		if (_pairing_chunks.size() < chunk_count) {
+			_pairing_chunks.resize(chunk_count);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_pairing_cull_chunk, nullptr, chunk_count, -1, true, SNAME("BVHPairingCull"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Merge in changed item order, this sends exactly the same callbacks as the serial version.
+		for (uint32_t c = 0; c < chunk_count; c++) {
+			const PairingChunk &chunk = _pairing_chunks[c];
+			uint32_t item_begin = c * PAIRING_CHUNK_SIZE;
+			uint32_t hits_begin = 0;
+
+			for (uint32_t i = 0; i < chunk.item_hit_ends.size(); i++) {
+				const BVHHandle &h = changed_items[item_begin + i];
+
+				BVHABB_CLASS abb;
+				abb.from(tree._pairs[h.id()].expanded_aabb);
+
+				_find_leavers(h, abb, p_full_check);
+
+				uint32_t hits_end = chunk.item_hit_ends[i];
+				for (uint32_t n = hits_begin; n < hits_end; n++) {
+					BVHHandle h_collidee;
+					h_collidee.set_id(chunk.hits[n]);
+					_collide(h, h_collidee, true);
+				}
+				hits_begin = hits_end;
+			}
+		}
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -591,10 +721,8 @@ private:
 		}
 	}
 
-	// find NEW enterers, and send callbacks for them only
-	// handle a and b
-	void _collide(BVHHandle p_ha, BVHHandle p_hb) {
-		// only have to do this oneway, lower ID then higher ID
+	// checks that only depend on the two items, not on the current pairs
+	bool _pair_allowed(BVHHandle p_ha, BVHHandle p_hb) const {
 		tree._handle_sort(p_ha, p_hb);
 
 		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(p_ha);
@@ -602,14 +730,30 @@ private:
 
 		// user collision callback
 		if (!USER_PAIR_TEST_FUNCTION::user_pair_check(exa.userdata, exb.userdata)) {
-			return;
+			return false;
 		}
 
 		// if the userdata is the same, no collisions should occur
 		if ((exa.userdata == exb.userdata) && exa.userdata) {
+			return false;
+		}
+
+		return true;
+	}
+
+	// find NEW enterers, and send callbacks for them only
+	// handle a and b
+	void _collide(BVHHandle p_ha, BVHHandle p_hb, bool p_pair_allowed_checked = false) {
+		if (!p_pair_allowed_checked && !_pair_allowed(p_ha, p_hb)) {
 			return;
 		}
 
+		// only have to do this oneway, lower ID then higher ID
+		tree._handle_sort(p_ha, p_hb);
+
+		const typename BVHTREE_CLASS::ItemExtra &exa = _get_extra(p_ha);
+		const typename BVHTREE_CLASS::ItemExtra &exb = _get_extra(p_hb);
+
 		typename BVHTREE_CLASS::ItemPairs &p_from = tree._pairs[p_ha.id()];
 		typename BVHTREE_CLASS::ItemPairs &p_to = tree._pairs[p_hb.id()];
 
@@ -773,6 +917,15 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// per chunk results of the parallel pairing culls, kept between ticks to avoid reallocating
+	static const uint32_t PAIRING_CHUNK_SIZE = 64;
+	struct PairingChunk {
+		LocalVector<uint32_t, uint32_t, true> hits;
+		LocalVector<uint32_t, uint32_t, true> item_hit_ends;
+	};
+	LocalVector<PairingChunk> _pairing_chunks;
+	bool _parallel_pairing = false;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
@@ -202,6 +202,36 @@ struct BVH_ABB {
 		return bb.intersects_segment(p_s.from, p_s.to);
 	}
 
+	// Faster segment test used by ray packets. The caller precalculates the segment
+	// direction (to - from) and its reciprocal, and zero direction axes are tested separately.
+	bool intersects_segment_inv_dir(const POINT &p_from, const POINT &p_dir, const POINT &p_inv_dir) const {
+		real_t t_min = 0;
+		real_t t_max = 1;
+
+		for (int axis = 0; axis < POINT::AXIS_COUNT; axis++) {
+			if (p_dir[axis] == 0) {
+				if ((p_from[axis] < min[axis]) || (p_from[axis] > -neg_max[axis])) {
+					return false;
+				}
+				continue;
+			}
+
+			real_t t0 = (min[axis] - p_from[axis]) * p_inv_dir[axis];
+			real_t t1 = (-neg_max[axis] - p_from[axis]) * p_inv_dir[axis];
+			if (t0 > t1) {
+				SWAP(t0, t1);
+			}
+
+			t_min = MAX(t_min, t0);
+			t_max = MIN(t_max, t1);
+			if (t_max < t_min) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	bool intersects_point(const POINT &p_pt) const {
 		if (_any_lessthan(-p_pt, neg_max)) {
 			return false;
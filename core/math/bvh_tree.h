@@ -84,6 +84,10 @@ struct BVHCommon {
 	// or use zero for invalid and +1 based indices.
 	static const uint32_t INVALID = (0xffffffff);
 	static const uint32_t INACTIVE = (0xfffffffe);
+
+	// maximum number of segments culled together in a packet,
+	// one bit each in the active segment masks
+	static const uint32_t PACKET_SIZE_MAX = 32;
 };
 
 // really a handle, can be anything
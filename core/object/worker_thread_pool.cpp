@@ -70,6 +70,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// about to be run uses scripting, guarantees are held.
 		ScriptServer::thread_enter();
 
+		// Other threads read current_task under task_mutex when deciding which threads to notify.
 		task_mutex.lock();
 		p_task->pool_thread_index = pool_thread_index;
 		prev_task = curr_thread.current_task;
@@ -87,12 +88,13 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	if (p_task->group) {
 		// Handling a group
+		Group *group = p_task->group;
 		bool do_post = false;
 
 		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+			uint32_t work_index = group->index.postincrement();
 
-			if (work_index >= p_task->group->max) {
+			if (work_index >= group->max) {
 				break;
 			}
 			if (p_task->native_group_func) {
@@ -104,9 +106,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = group->completed_index.increment();
 
-			if (completed_amount == p_task->group->max) {
+			if (completed_amount == group->max) {
 				do_post = true;
 			}
 		}
@@ -116,22 +118,24 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
+			group->done_semaphore.post();
+			group->completed.set_to(true);
 		}
-		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
-		uint32_t finished_users = p_task->group->finished.increment();
 
-		if (finished_users == max_users) {
-			// Get rid of the group, because nobody else is using it.
-			MutexLock task_lock(task_mutex);
-			group_allocator.free(p_task->group);
-		}
+		// For groups, tasks are freed along with the group, so this thread must stop
+		// referring to this one before leaving it.
+		task_mutex.lock();
+#ifdef THREADS_ENABLED
+		curr_thread.current_task = prev_task;
+#endif
 
-		// For groups, tasks get rid of themselves.
+		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
+		uint32_t finished_users = group->finished.increment();
 
-		task_mutex.lock();
-		task_allocator.free(p_task);
+		if (finished_users == max_users) {
+			// Get rid of the group and its tasks, because nobody else is using them.
+			_free_group(group);
+		}
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -178,12 +182,21 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #endif
 }
 
+void WorkerThreadPool::_free_group(Group *p_group) {
+	for (Task *task : p_group->tasks) {
+		task_allocator.free(task);
+	}
+	p_group->tasks.clear();
+	group_allocator.free(p_group);
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Tasks posted by pool threads are reachable without touching task_mutex.
+		Task *task_to_process = singleton->_take_deque_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 
 			bool exit = singleton->_handle_runlevel(thread_data, lock);
@@ -197,7 +210,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
+				// Deques are filled while holding task_mutex, so this last look can't miss a post that skipped notifying.
+				task_to_process = singleton->_take_deque_task(thread_data);
+				if (!task_to_process) {
+					singleton->num_waiting_threads++;
+					thread_data->cond_var.wait(lock);
+					singleton->num_waiting_threads--;
+				}
 			}
 		}
 
@@ -230,6 +249,23 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	if (caller_pool_thread && p_high_priority) {
+		// Work spawned by a pool thread stays on its deque, where idle threads can steal it.
+		{
+			MutexLock deque_lock(caller_pool_thread->deque_mutex);
+			for (uint32_t i = 0; i < p_count; i++) {
+				p_tasks[i]->low_priority = false;
+				caller_pool_thread->deque.add(&p_tasks[i]->task_elem);
+			}
+			caller_pool_thread->deque_size.add(p_count);
+		}
+		// Busy threads look at the deques before sleeping, so only sleeping ones need waking.
+		if (num_waiting_threads) {
+			_notify_threads(caller_pool_thread, p_count, 0);
+		}
+		return;
+	}
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
@@ -324,6 +360,76 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_take_deque_task(ThreadData *p_thread_data) {
+	// Newest first from the own deque, it's the most likely to be hot in cache.
+	if (p_thread_data->deque_size.get()) {
+		MutexLock deque_lock(p_thread_data->deque_mutex);
+		SelfList<Task> *E = p_thread_data->deque.first();
+		if (E) {
+			p_thread_data->deque.remove(E);
+			p_thread_data->deque_size.decrement();
+			return E->self();
+		}
+	}
+
+	// Otherwise, steal the oldest task of another thread.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (!victim.deque_size.get()) {
+			continue;
+		}
+		MutexLock deque_lock(victim.deque_mutex);
+		SelfList<Task> *E = victim.deque.last();
+		if (E) {
+			victim.deque.remove(E);
+			victim.deque_size.decrement();
+			return E->self();
+		}
+	}
+
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_deque_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (threads[i].deque_size.get()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_take_group_task(ThreadData *p_thread_data, const Group *p_group) {
+	// Group tasks posted from a pool thread are on its own deque, unless they were stolen.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &th = threads[(p_thread_data->index + i) % thread_count];
+		if (!th.deque_size.get()) {
+			continue;
+		}
+		MutexLock deque_lock(th.deque_mutex);
+		for (SelfList<Task> *E = th.deque.first(); E; E = E->next()) {
+			if (E->self()->group == p_group) {
+				th.deque.remove(E);
+				th.deque_size.decrement();
+				return E->self();
+			}
+		}
+	}
+
+	// Posted from outside the pool, or as low priority and already admitted to run.
+	MutexLock lock(task_mutex);
+	for (SelfList<Task> *E = task_queue.first(); E; E = E->next()) {
+		if (E->self()->group == p_group) {
+			task_queue.remove(E);
+			return E->self();
+		}
+	}
+
+	return nullptr;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
@@ -479,7 +585,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = task_queue.first() || _has_deque_tasks() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -497,7 +603,10 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (singleton->task_queue.first()) {
+			// Own deque first, it likely holds what is being awaited.
+			task_to_process = _take_deque_task(p_caller_pool_thread);
+
+			if (!task_to_process && singleton->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
 			}
@@ -508,7 +617,9 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				_unlock_unlockable_mutexes();
 				relock_unlockables = true;
 
+				num_waiting_threads++;
 				p_caller_pool_thread->cond_var.wait(lock);
+				num_waiting_threads--;
 
 				p_caller_pool_thread->awaited_task = nullptr;
 			}
@@ -543,7 +654,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_deque_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -642,6 +753,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
 			tasks_posted[i] = task;
+			group->tasks.push_back(task);
 			// No task ID is used.
 		}
 	}
@@ -690,6 +802,22 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 	{
 		Group *group = *groupp;
 
+		int caller_index = get_thread_index();
+		if (caller_index != -1) {
+			// A pool thread runs the group's pending tasks while waiting, rather than blocking, so group
+			// tasks posted from pool tasks (e.g., threaded resource loads) can't starve the pool.
+			// Unrelated tasks are left alone, they could take arbitrarily long and delay the caller.
+			// Once none are left to take, the rest of the group is already running elsewhere.
+			ThreadData *caller_pool_thread = &threads[caller_index];
+			while (!group->completed.is_set()) {
+				Task *task_to_process = _take_group_task(caller_pool_thread, group);
+				if (!task_to_process) {
+					break;
+				}
+				_process_task(task_to_process);
+			}
+		}
+
 		_unlock_unlockable_mutexes();
 		group->done_semaphore.wait();
 		_lock_unlockable_mutexes();
@@ -700,7 +828,7 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		if (finished_users == max_users) {
 			// All tasks using this group are gone (finished before the group), so clear the group too.
 			MutexLock task_lock(task_mutex);
-			group_allocator.free(group);
+			_free_group(group);
 		}
 	}
 
@@ -723,6 +851,15 @@ WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() {
 	}
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::get_caller_group_task_id() {
+	int th_index = get_thread_index();
+	if (th_index != -1 && singleton->threads[th_index].current_task && singleton->threads[th_index].current_task->group) {
+		return singleton->threads[th_index].current_task->group->self;
+	} else {
+		return INVALID_TASK_ID;
+	}
+}
+
 #ifdef THREADS_ENABLED
 uint32_t WorkerThreadPool::_thread_enter_unlock_allowance_zone(THREADING_NAMESPACE::unique_lock<THREADING_NAMESPACE::mutex> &p_ulock) {
 	for (uint32_t i = 0; i < MAX_UNLOCKABLE_LOCKS; i++) {
@@ -809,6 +946,7 @@ void WorkerThreadPool::finish() {
 
 	for (ThreadData &data : threads) {
 		data.thread.wait_to_finish();
+		data.deque.clear();
 	}
 
 	{
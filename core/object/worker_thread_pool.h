@@ -69,6 +69,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> tasks; // Freed along with the group.
 	};
 
 	struct Task {
@@ -120,6 +121,12 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 
+		// High priority tasks posted from this thread. It takes the newest ones itself,
+		// other threads steal the oldest ones, without going through task_mutex.
+		BinaryMutex deque_mutex;
+		SelfList<Task>::List deque;
+		SafeNumeric<uint32_t> deque_size;
+
 		ThreadData() :
 				signaled(false),
 				yield_is_over(false),
@@ -163,18 +170,24 @@ private:
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	uint32_t num_waiting_threads = 0; // Threads sleeping on their condition variable. Guarded by task_mutex.
 
 	uint64_t last_task = 1;
 
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	void _free_group(Group *p_group);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
 
+	Task *_take_deque_task(ThreadData *p_thread_data);
+	bool _has_deque_tasks() const;
+	Task *_take_group_task(ThreadData *p_thread_data, const Group *p_group);
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -263,6 +276,7 @@ public:
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
 	static TaskID get_caller_task_id();
+	static GroupID get_caller_group_task_id();
 
 #ifdef THREADS_ENABLED
 	_ALWAYS_INLINE_ static uint32_t thread_enter_unlock_allowance_zone(const MutexLock<BinaryMutex> &p_lock) { return _thread_enter_unlock_allowance_zone(p_lock._get_lock()); }
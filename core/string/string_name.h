@@ -48,7 +48,10 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_LOCK_BITS = 6,
+		STRING_TABLE_LOCK_LEN = 1 << STRING_TABLE_LOCK_BITS,
+		STRING_TABLE_LOCK_MASK = STRING_TABLE_LOCK_LEN - 1,
 	};
 
 	struct _Data {
@@ -74,6 +77,18 @@ class StringName {
 
 	static inline _Data *_table[STRING_TABLE_LEN];
 
+	// Each bucket of the table is guarded by one of these locks, so threads
+	// interning or freeing unrelated names rarely contend with each other.
+	// Aligned to keep each lock on its own cache line.
+	struct alignas(64) TableLock {
+		Mutex mutex;
+	};
+	static inline TableLock _table_locks[STRING_TABLE_LOCK_LEN];
+
+	_FORCE_INLINE_ static Mutex &_get_table_lock(uint32_t p_idx) {
+		return _table_locks[p_idx & STRING_TABLE_LOCK_MASK].mutex;
+	}
+
 	_Data *_data = nullptr;
 
 	void unref();
@@ -322,12 +322,32 @@ public:
 			data[i] = p_from.data[i];
 		}
 	}
+	_FORCE_INLINE_ LocalVector(LocalVector &&p_from) :
+			count(p_from.count),
+			capacity(p_from.capacity),
+			data(p_from.data) {
+		p_from.count = 0;
+		p_from.capacity = 0;
+		p_from.data = nullptr;
+	}
 	inline void operator=(const LocalVector &p_from) {
 		resize(p_from.size());
 		for (U i = 0; i < p_from.count; i++) {
 			data[i] = p_from.data[i];
 		}
 	}
+	inline void operator=(LocalVector &&p_from) {
+		if (unlikely(this == &p_from)) {
+			return;
+		}
+		reset();
+		count = p_from.count;
+		capacity = p_from.capacity;
+		data = p_from.data;
+		p_from.count = 0;
+		p_from.capacity = 0;
+		p_from.data = nullptr;
+	}
 	inline void operator=(const Vector<T> &p_from) {
 		resize(p_from.size());
 		for (U i = 0; i < count; i++) {
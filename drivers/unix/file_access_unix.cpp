@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +143,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped_data) {
+		munmap(mapped_data, mapped_size);
+		mapped_data = nullptr;
+		mapped_size = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -228,6 +235,34 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+Error FileAccessUnix::map_read_only() {
+	ERR_FAIL_NULL_V_MSG(f, ERR_FILE_CANT_OPEN, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(flags != READ, ERR_UNAVAILABLE, "Only files opened for reading can be mapped.");
+
+	if (mapped_data) {
+		return OK;
+	}
+
+#ifdef WEB_ENABLED
+	// Mapping a file copies it into memory with Emscripten's file systems.
+	return ERR_UNAVAILABLE;
+#else
+	const uint64_t size = get_length();
+	if (size == 0 || (uint64_t)(size_t)size != size) {
+		return ERR_UNAVAILABLE;
+	}
+
+	void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (data == MAP_FAILED) {
+		return ERR_CANT_OPEN;
+	}
+
+	mapped_data = (uint8_t *)data;
+	mapped_size = size;
+	return OK;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	uint8_t *mapped_data = nullptr;
+	uint64_t mapped_size = 0;
+
 	void _close();
 
 public:
@@ -69,6 +72,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
 
+	virtual Error map_read_only() override;
+	virtual const uint8_t *get_mapped_data() const override { return mapped_data; }
+
 	virtual Error get_error() const override; ///< get last error
 
 	virtual Error resize(int64_t p_length) override;
@@ -807,73 +807,84 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
-	GDScriptParser parser;
+
+	// Scripts that were never compiled can be restored from the bytecode cache.
+	const bool use_bytecode_cache = !has_instances && member_functions.is_empty() && GDScriptCache::is_bytecode_cache_enabled(this);
 	Error err;
-	if (!binary_tokens.is_empty()) {
-		err = parser.parse_binary(binary_tokens, path);
+	if (use_bytecode_cache && GDScriptCache::load_bytecode(this) == OK) {
+		can_run = ScriptServer::is_scripting_enabled() || is_tool();
 	} else {
-		err = parser.parse(source, path, false);
-	}
-	if (err) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+		GDScriptParser parser;
+		if (!binary_tokens.is_empty()) {
+			err = parser.parse_binary(binary_tokens, path);
+		} else {
+			err = parser.parse(source, path, false);
+		}
+		if (err) {
+			if (EngineDebugger::is_active()) {
+				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			}
+			// TODO: Show all error messages.
+			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+			reloading = false;
+			return ERR_PARSE_ERROR;
 		}
-		// TODO: Show all error messages.
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-		reloading = false;
-		return ERR_PARSE_ERROR;
-	}
 
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
 
-	if (err) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
-		}
+		if (err) {
+			if (EngineDebugger::is_active()) {
+				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			}
 
-		const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
-		while (e != nullptr) {
-			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-			e = e->next();
+			const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
+			while (e != nullptr) {
+				_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+				e = e->next();
+			}
+			reloading = false;
+			return ERR_PARSE_ERROR;
 		}
-		reloading = false;
-		return ERR_PARSE_ERROR;
-	}
 
-	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
+		can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
 
-	GDScriptCompiler compiler;
-	err = compiler.compile(&parser, this, p_keep_state);
+		GDScriptCompiler compiler;
+		err = compiler.compile(&parser, this, p_keep_state);
 
-	if (err) {
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-		if (can_run) {
-			if (EngineDebugger::is_active()) {
-				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), compiler.get_error_line(), "Parser Error: " + compiler.get_error());
+		if (err) {
+			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+			if (can_run) {
+				if (EngineDebugger::is_active()) {
+					GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), compiler.get_error_line(), "Parser Error: " + compiler.get_error());
+				}
+				reloading = false;
+				return ERR_COMPILATION_FAILED;
+			} else {
+				reloading = false;
+				return err;
 			}
-			reloading = false;
-			return ERR_COMPILATION_FAILED;
-		} else {
-			reloading = false;
-			return err;
 		}
-	}
+
+		if (use_bytecode_cache) {
+			GDScriptCache::save_bytecode(this);
+		}
 
 #ifdef TOOLS_ENABLED
-	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
-	// which are made by calling make_scripts() within compiler.compile() above.
-	GDScriptDocGen::generate_docs(this, parser.get_tree());
+		// Done after compilation because it needs the GDScript object's inner class GDScript objects,
+		// which are made by calling make_scripts() within compiler.compile() above.
+		GDScriptDocGen::generate_docs(this, parser.get_tree());
 #endif
 
 #ifdef DEBUG_ENABLED
-	for (const GDScriptWarning &warning : parser.get_warnings()) {
-		if (EngineDebugger::is_active()) {
-			Vector<ScriptLanguage::StackInfo> si;
-			EngineDebugger::get_script_debugger()->send_error("", get_script_path(), warning.start_line, warning.get_name(), warning.get_message(), false, ERR_HANDLER_WARNING, si);
+		for (const GDScriptWarning &warning : parser.get_warnings()) {
+			if (EngineDebugger::is_active()) {
+				Vector<ScriptLanguage::StackInfo> si;
+				EngineDebugger::get_script_debugger()->send_error("", get_script_path(), warning.start_line, warning.get_name(), warning.get_message(), false, ERR_HANDLER_WARNING, si);
+			}
 		}
-	}
 #endif
+	}
 
 	if (can_run) {
 		err = _static_init();
@@ -2945,6 +2956,9 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+	GLOBAL_DEF("gdscript/bytecode_cache/enabled", false);
+	GLOBAL_DEF("gdscript/bytecode_cache/path", "user://gdscript_cache");
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
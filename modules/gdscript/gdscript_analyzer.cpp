@@ -2158,10 +2158,21 @@ void GDScriptAnalyzer::resolve_for(GDScriptParser::ForNode *p_for) {
 
 					Variant reduced;
 
+					// Multiple bounds are stored in Vector2i or Vector3i, leave larger values to `range()`.
+					if (can_reduce && args.size() > 1) {
+						for (const Variant &arg : args) {
+							int64_t value = arg;
+							if (value < INT32_MIN || value > INT32_MAX) {
+								can_reduce = false;
+								break;
+							}
+						}
+					}
+
 					if (can_reduce) {
 						switch (args.size()) {
 							case 1:
-								reduced = (int32_t)args[0];
+								reduced = (int64_t)args[0];
 								break;
 							case 2:
 								reduced = Vector2i(args[0], args[1]);
@@ -598,6 +598,14 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		if (Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type) == Variant::BOOL) {
+			fusable_operator.position = opcodes.size();
+			fusable_operator.target = p_target;
+			fusable_operator.op = p_operator;
+			fusable_operator.left_type = p_left_operand.type.builtin_type;
+			fusable_operator.right_type = p_right_operand.type.builtin_type;
+		}
+
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -675,18 +683,56 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 	}
 }
 
-void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+int GDScriptByteCodeGenerator::write_jump_if_not(const Address &p_condition) {
+	// If the condition was just computed by a validated operator, fuse both into a single instruction.
+	// The fused instruction keeps the operator operands in place and appends the jump target,
+	// so the addresses of temporaries recorded for the operator stay valid.
+	const int operator_pos = fusable_operator.position;
+	fusable_operator.position = -1;
+	if (operator_pos >= 0 && operator_pos + 5 == opcodes.size() && last_jump_target != opcodes.size() &&
+			p_condition.mode == fusable_operator.target.mode && p_condition.address == fusable_operator.target.address) {
+		GDScriptFunction::Opcode fused_opcode = GDScriptFunction::OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED;
+		switch (fusable_operator.op) {
+			case Variant::OP_EQUAL:
+			case Variant::OP_NOT_EQUAL:
+			case Variant::OP_LESS:
+			case Variant::OP_LESS_EQUAL:
+			case Variant::OP_GREATER:
+			case Variant::OP_GREATER_EQUAL:
+				if (fusable_operator.left_type == Variant::INT && fusable_operator.right_type == Variant::INT) {
+					fused_opcode = GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_INT;
+				} else if (fusable_operator.left_type == Variant::FLOAT && fusable_operator.right_type == Variant::FLOAT) {
+					fused_opcode = GDScriptFunction::OPCODE_JUMP_IF_NOT_COMPARE_FLOAT;
+				}
+				break;
+			default:
+				break;
+		}
+
+		opcodes.write[operator_pos] = fused_opcode;
+		if (fused_opcode != GDScriptFunction::OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED) {
+			// Typed comparisons are done inline, store the operator instead of the evaluator.
+			opcodes.write[operator_pos + 4] = fusable_operator.op;
+		}
+
+		int jump_pos = opcodes.size();
+		append(0); // Jump target, will be patched.
+		return jump_pos;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
-	logic_op_jump_pos1.push_back(opcodes.size());
+	append(p_condition);
+	int jump_pos = opcodes.size();
 	append(0); // Jump target, will be patched.
+	return jump_pos;
+}
+
+void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+	logic_op_jump_pos1.push_back(write_jump_if_not(p_left_operand));
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
-	logic_op_jump_pos2.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	logic_op_jump_pos2.push_back(write_jump_if_not(p_right_operand));
 }
 
 void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
@@ -740,10 +786,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	ternary_jump_fail_pos.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	ternary_jump_fail_pos.push_back(write_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
@@ -802,6 +845,33 @@ void GDScriptByteCodeGenerator::write_set(const Address &p_target, const Address
 
 void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_source)) {
+		if (IS_BUILTIN_TYPE(p_index, Variant::INT)) {
+			// Numeric packed arrays are read directly, without going through the indexed getter.
+			GDScriptFunction::Opcode packed_opcode = GDScriptFunction::OPCODE_END;
+			switch (p_source.type.builtin_type) {
+				case Variant::PACKED_INT32_ARRAY:
+					packed_opcode = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT32_ARRAY;
+					break;
+				case Variant::PACKED_INT64_ARRAY:
+					packed_opcode = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_INT64_ARRAY;
+					break;
+				case Variant::PACKED_FLOAT32_ARRAY:
+					packed_opcode = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY;
+					break;
+				case Variant::PACKED_FLOAT64_ARRAY:
+					packed_opcode = GDScriptFunction::OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY;
+					break;
+				default:
+					break;
+			}
+			if (packed_opcode != GDScriptFunction::OPCODE_END) {
+				append_opcode(packed_opcode);
+				append(p_source);
+				append(p_index);
+				append(p_target);
+				return;
+			}
+		}
 		if (IS_BUILTIN_TYPE(p_index, Variant::INT) && Variant::get_member_validated_indexed_getter(p_source.type.builtin_type)) {
 			// Use indexed getter instead.
 			Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(p_source.type.builtin_type);
@@ -1006,6 +1076,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	last_jump_target = opcodes.size();
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1495,10 +1566,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	if_jmp_addrs.push_back(opcodes.size());
-	append(0); // Jump destination, will be patched.
+	if_jmp_addrs.push_back(write_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_else() {
@@ -1706,10 +1774,7 @@ void GDScriptByteCodeGenerator::start_while_condition() {
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	while_jmp_addrs.push_back(opcodes.size());
-	append(0); // End of loop address, will be patched.
+	while_jmp_addrs.push_back(write_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_endwhile() {
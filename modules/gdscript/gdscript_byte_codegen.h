@@ -158,6 +158,17 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// The last operator returning a bool, which can be fused with a conditional jump on its result.
+	struct FusableOperator {
+		int position = -1;
+		Address target;
+		Variant::Operator op = Variant::OP_MAX;
+		Variant::Type left_type = Variant::NIL;
+		Variant::Type right_type = Variant::NIL;
+	} fusable_operator;
+	// Instructions can only be fused if no jump lands between them.
+	int last_jump_target = -1;
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -449,8 +460,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_jump_target = opcodes.size();
 	}
 
+	int write_jump_if_not(const Address &p_condition);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
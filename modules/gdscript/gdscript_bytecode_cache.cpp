@@ -0,0 +1,1385 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
+#include "core/version.h"
+
+Mutex GDScriptBytecodeCache::lookup_mutex;
+bool GDScriptBytecodeCache::lookup_initialized = false;
+RBMap<Variant::ValidatedOperatorEvaluator, Vector3i> GDScriptBytecodeCache::operator_lookup;
+RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> GDScriptBytecodeCache::setter_lookup;
+RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> GDScriptBytecodeCache::getter_lookup;
+RBMap<Variant::ValidatedKeyedSetter, Variant::Type> GDScriptBytecodeCache::keyed_setter_lookup;
+RBMap<Variant::ValidatedKeyedGetter, Variant::Type> GDScriptBytecodeCache::keyed_getter_lookup;
+RBMap<Variant::ValidatedIndexedSetter, Variant::Type> GDScriptBytecodeCache::indexed_setter_lookup;
+RBMap<Variant::ValidatedIndexedGetter, Variant::Type> GDScriptBytecodeCache::indexed_getter_lookup;
+RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> GDScriptBytecodeCache::builtin_method_lookup;
+RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> GDScriptBytecodeCache::constructor_lookup;
+RBMap<Variant::ValidatedUtilityFunction, StringName> GDScriptBytecodeCache::utility_lookup;
+RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> GDScriptBytecodeCache::gds_utility_lookup;
+
+// Builds the tables used to find the name of the validated functions referenced by compiled functions.
+// They are only needed when writing caches, so they are built on first use.
+void GDScriptBytecodeCache::_ensure_lookups() {
+	MutexLock lock(lookup_mutex);
+	if (lookup_initialized) {
+		return;
+	}
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = Variant::Type(i);
+
+		for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+			for (int k = 0; k < Variant::OP_MAX; k++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(k), type, Variant::Type(j));
+				if (evaluator && !operator_lookup.has(evaluator)) {
+					operator_lookup.insert(evaluator, Vector3i(k, i, j));
+				}
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+			if (setter && !setter_lookup.has(setter)) {
+				setter_lookup.insert(setter, Pair<Variant::Type, StringName>(type, member));
+			}
+			Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+			if (getter && !getter_lookup.has(getter)) {
+				getter_lookup.insert(getter, Pair<Variant::Type, StringName>(type, member));
+			}
+		}
+
+		Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+		if (keyed_setter && !keyed_setter_lookup.has(keyed_setter)) {
+			keyed_setter_lookup.insert(keyed_setter, type);
+		}
+		Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+		if (keyed_getter && !keyed_getter_lookup.has(keyed_getter)) {
+			keyed_getter_lookup.insert(keyed_getter, type);
+		}
+		Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+		if (indexed_setter && !indexed_setter_lookup.has(indexed_setter)) {
+			indexed_setter_lookup.insert(indexed_setter, type);
+		}
+		Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+		if (indexed_getter && !indexed_getter_lookup.has(indexed_getter)) {
+			indexed_getter_lookup.insert(indexed_getter, type);
+		}
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+			if (builtin_method && !builtin_method_lookup.has(builtin_method)) {
+				builtin_method_lookup.insert(builtin_method, Pair<Variant::Type, StringName>(type, method));
+			}
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+			if (constructor && !constructor_lookup.has(constructor)) {
+				constructor_lookup.insert(constructor, Pair<Variant::Type, int>(type, j));
+			}
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(utility);
+		if (function && !utility_lookup.has(function)) {
+			utility_lookup.insert(function, utility);
+		}
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		GDScriptUtilityFunctions::FunctionPtr function = GDScriptUtilityFunctions::get_function(utility);
+		if (function && !gds_utility_lookup.has(function)) {
+			gds_utility_lookup.insert(function, utility);
+		}
+	}
+
+	lookup_initialized = true;
+}
+
+bool GDScriptBytecodeCache::_encode_value(EncodeContext &p_context, const Variant &p_value, Variant &r_encoded) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *obj = p_value.get_validated_object();
+			if (obj == nullptr) {
+				Array encoded;
+				encoded.push_back(VALUE_NULL_OBJECT);
+				r_encoded = encoded;
+				return true;
+			}
+
+			Script *scr = Object::cast_to<Script>(obj);
+			if (scr != nullptr) {
+				return _encode_script(p_context, scr, r_encoded);
+			}
+
+			HashMap<const Object *, StringName>::ConstIterator global = p_context.globals.find(obj);
+			if (global) {
+				Array encoded;
+				encoded.push_back(VALUE_GLOBAL);
+				encoded.push_back(global->value);
+				r_encoded = encoded;
+				return true;
+			}
+
+			Resource *res = Object::cast_to<Resource>(obj);
+			if (res != nullptr && res->get_path().is_resource_file()) {
+				Array encoded;
+				encoded.push_back(VALUE_RESOURCE);
+				encoded.push_back(res->get_path());
+				r_encoded = encoded;
+				return true;
+			}
+
+			p_context.error = vformat(R"(Can't store a reference to an object of class "%s".)", obj->get_class());
+			return false;
+		}
+
+		case Variant::ARRAY: {
+			const Array array = p_value;
+
+			Variant typed_script;
+			if (!_encode_value(p_context, array.get_typed_script(), typed_script)) {
+				return false;
+			}
+
+			Array elements;
+			elements.resize(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				Variant element;
+				if (!_encode_value(p_context, array[i], element)) {
+					return false;
+				}
+				elements[i] = element;
+			}
+
+			Array encoded;
+			encoded.push_back(VALUE_ARRAY);
+			encoded.push_back(array.is_read_only());
+			encoded.push_back(array.get_typed_builtin());
+			encoded.push_back(array.get_typed_class_name());
+			encoded.push_back(typed_script);
+			encoded.push_back(elements);
+			r_encoded = encoded;
+			return true;
+		}
+
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+
+			Variant key_script;
+			Variant value_script;
+			if (!_encode_value(p_context, dictionary.get_typed_key_script(), key_script) || !_encode_value(p_context, dictionary.get_typed_value_script(), value_script)) {
+				return false;
+			}
+
+			const Array keys = dictionary.keys();
+			const Array values = dictionary.values();
+			Array elements;
+			elements.resize(keys.size() * 2);
+			for (int i = 0; i < keys.size(); i++) {
+				Variant key;
+				Variant value;
+				if (!_encode_value(p_context, keys[i], key) || !_encode_value(p_context, values[i], value)) {
+					return false;
+				}
+				elements[i * 2 + 0] = key;
+				elements[i * 2 + 1] = value;
+			}
+
+			Array encoded;
+			encoded.push_back(VALUE_DICTIONARY);
+			encoded.push_back(dictionary.is_read_only());
+			encoded.push_back(dictionary.get_typed_key_builtin());
+			encoded.push_back(dictionary.get_typed_key_class_name());
+			encoded.push_back(key_script);
+			encoded.push_back(dictionary.get_typed_value_builtin());
+			encoded.push_back(dictionary.get_typed_value_class_name());
+			encoded.push_back(value_script);
+			encoded.push_back(elements);
+			r_encoded = encoded;
+			return true;
+		}
+
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			p_context.error = vformat(R"(Can't store a constant of type "%s".)", Variant::get_type_name(p_value.get_type()));
+			return false;
+		}
+
+		default: {
+			// Everything else is stored as is, arrays are always tagged so they can't be confused with plain values.
+			r_encoded = p_value;
+			return true;
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::_encode_script(EncodeContext &p_context, const Script *p_script, Variant &r_encoded) {
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript == nullptr) {
+		if (!p_script->get_path().is_resource_file()) {
+			p_context.error = "Can't store a reference to a built-in script.";
+			return false;
+		}
+		Array encoded;
+		encoded.push_back(VALUE_RESOURCE);
+		encoded.push_back(p_script->get_path());
+		r_encoded = encoded;
+		return true;
+	}
+
+	// Inner classes are stored as the path of their root script followed by the class names leading to them.
+	PackedStringArray class_names;
+	const GDScript *root = gdscript;
+	while (root->_owner != nullptr) {
+		class_names.push_back(root->local_name);
+		root = root->_owner;
+	}
+	class_names.reverse();
+
+	String path;
+	if (root != p_context.root) {
+		if (!root->path.is_resource_file()) {
+			p_context.error = "Can't store a reference to a built-in script.";
+			return false;
+		}
+		path = root->path;
+		p_context.dependencies.insert(path);
+	}
+
+	Array encoded;
+	encoded.push_back(VALUE_SCRIPT);
+	encoded.push_back(path);
+	encoded.push_back(class_names);
+	r_encoded = encoded;
+	return true;
+}
+
+bool GDScriptBytecodeCache::_encode_data_type(EncodeContext &p_context, const GDScriptDataType &p_type, Variant &r_encoded) {
+	Variant script;
+	if (p_type.script_type != nullptr && !_encode_script(p_context, p_type.script_type, script)) {
+		return false;
+	}
+
+	Array container_element_types;
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		Variant encoded_element_type;
+		if (!_encode_data_type(p_context, element_type, encoded_element_type)) {
+			return false;
+		}
+		container_element_types.push_back(encoded_element_type);
+	}
+
+	Array encoded;
+	encoded.push_back(p_type.has_type);
+	encoded.push_back(p_type.kind);
+	encoded.push_back(p_type.builtin_type);
+	encoded.push_back(p_type.native_type);
+	encoded.push_back(script);
+	encoded.push_back(container_element_types);
+	r_encoded = encoded;
+	return true;
+}
+
+bool GDScriptBytecodeCache::_encode_method_info(EncodeContext &p_context, const MethodInfo &p_info, Variant &r_encoded) {
+	Array arguments;
+	for (const PropertyInfo &argument : p_info.arguments) {
+		arguments.push_back(Dictionary(argument));
+	}
+
+	Array default_arguments;
+	for (const Variant &default_argument : p_info.default_arguments) {
+		Variant encoded_default_argument;
+		if (!_encode_value(p_context, default_argument, encoded_default_argument)) {
+			return false;
+		}
+		default_arguments.push_back(encoded_default_argument);
+	}
+
+	Dictionary encoded;
+	encoded["name"] = p_info.name;
+	encoded["flags"] = p_info.flags;
+	encoded["return"] = Dictionary(p_info.return_val);
+	encoded["arguments"] = arguments;
+	encoded["default_arguments"] = default_arguments;
+	r_encoded = encoded;
+	return true;
+}
+
+bool GDScriptBytecodeCache::_encode_function(EncodeContext &p_context, const GDScript *p_script, const GDScriptFunction *p_function, Dictionary &r_encoded) {
+	r_encoded["name"] = p_function->name;
+	r_encoded["static"] = p_function->_static;
+	r_encoded["initial_line"] = p_function->_initial_line;
+	r_encoded["argument_count"] = p_function->_argument_count;
+	r_encoded["stack_size"] = p_function->_stack_size;
+	r_encoded["instruction_args_size"] = p_function->_instruction_args_size;
+	r_encoded["code"] = p_function->code;
+	r_encoded["default_arguments"] = p_function->default_arguments;
+
+	Array argument_types;
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		Variant encoded_type;
+		if (!_encode_data_type(p_context, argument_type, encoded_type)) {
+			return false;
+		}
+		argument_types.push_back(encoded_type);
+	}
+	r_encoded["argument_types"] = argument_types;
+
+	Variant return_type;
+	Variant method_info;
+	Variant rpc_config;
+	if (!_encode_data_type(p_context, p_function->return_type, return_type) ||
+			!_encode_method_info(p_context, p_function->method_info, method_info) ||
+			!_encode_value(p_context, p_function->rpc_config, rpc_config)) {
+		return false;
+	}
+	r_encoded["return_type"] = return_type;
+	r_encoded["method_info"] = method_info;
+	r_encoded["rpc_config"] = rpc_config;
+
+	Dictionary temporary_slots;
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		temporary_slots[E.key] = E.value;
+	}
+	r_encoded["temporary_slots"] = temporary_slots;
+
+	Array stack_debug;
+	for (const GDScriptFunction::StackDebug &E : p_function->stack_debug) {
+		Array entry;
+		entry.push_back(E.line);
+		entry.push_back(E.pos);
+		entry.push_back(E.added);
+		entry.push_back(E.identifier);
+		stack_debug.push_back(entry);
+	}
+	r_encoded["stack_debug"] = stack_debug;
+
+	Array constants;
+	for (const Variant &constant : p_function->constants) {
+		Variant encoded_constant;
+		if (!_encode_value(p_context, constant, encoded_constant)) {
+			return false;
+		}
+		constants.push_back(encoded_constant);
+	}
+	r_encoded["constants"] = constants;
+
+	Array global_names;
+	for (const StringName &global_name : p_function->global_names) {
+		global_names.push_back(global_name);
+	}
+	r_encoded["global_names"] = global_names;
+
+	// Validated functions are stored by name, the pointers are looked up again when loading.
+	Array operator_funcs;
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		RBMap<Variant::ValidatedOperatorEvaluator, Vector3i>::Element *E = operator_lookup.find(evaluator);
+		ERR_FAIL_NULL_V(E, false);
+		operator_funcs.push_back(E->get());
+	}
+	r_encoded["operator_funcs"] = operator_funcs;
+
+	Array setters;
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>>::Element *E = setter_lookup.find(setter);
+		ERR_FAIL_NULL_V(E, false);
+		setters.push_back(E->get().first);
+		setters.push_back(E->get().second);
+	}
+	r_encoded["setters"] = setters;
+
+	Array getters;
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>>::Element *E = getter_lookup.find(getter);
+		ERR_FAIL_NULL_V(E, false);
+		getters.push_back(E->get().first);
+		getters.push_back(E->get().second);
+	}
+	r_encoded["getters"] = getters;
+
+	Array keyed_setters;
+	for (Variant::ValidatedKeyedSetter setter : p_function->keyed_setters) {
+		RBMap<Variant::ValidatedKeyedSetter, Variant::Type>::Element *E = keyed_setter_lookup.find(setter);
+		ERR_FAIL_NULL_V(E, false);
+		keyed_setters.push_back(E->get());
+	}
+	r_encoded["keyed_setters"] = keyed_setters;
+
+	Array keyed_getters;
+	for (Variant::ValidatedKeyedGetter getter : p_function->keyed_getters) {
+		RBMap<Variant::ValidatedKeyedGetter, Variant::Type>::Element *E = keyed_getter_lookup.find(getter);
+		ERR_FAIL_NULL_V(E, false);
+		keyed_getters.push_back(E->get());
+	}
+	r_encoded["keyed_getters"] = keyed_getters;
+
+	Array indexed_setters;
+	for (Variant::ValidatedIndexedSetter setter : p_function->indexed_setters) {
+		RBMap<Variant::ValidatedIndexedSetter, Variant::Type>::Element *E = indexed_setter_lookup.find(setter);
+		ERR_FAIL_NULL_V(E, false);
+		indexed_setters.push_back(E->get());
+	}
+	r_encoded["indexed_setters"] = indexed_setters;
+
+	Array indexed_getters;
+	for (Variant::ValidatedIndexedGetter getter : p_function->indexed_getters) {
+		RBMap<Variant::ValidatedIndexedGetter, Variant::Type>::Element *E = indexed_getter_lookup.find(getter);
+		ERR_FAIL_NULL_V(E, false);
+		indexed_getters.push_back(E->get());
+	}
+	r_encoded["indexed_getters"] = indexed_getters;
+
+	Array builtin_methods;
+	for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+		RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>>::Element *E = builtin_method_lookup.find(method);
+		ERR_FAIL_NULL_V(E, false);
+		builtin_methods.push_back(E->get().first);
+		builtin_methods.push_back(E->get().second);
+	}
+	r_encoded["builtin_methods"] = builtin_methods;
+
+	Array constructors;
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>>::Element *E = constructor_lookup.find(constructor);
+		ERR_FAIL_NULL_V(E, false);
+		constructors.push_back(E->get().first);
+		constructors.push_back(E->get().second);
+	}
+	r_encoded["constructors"] = constructors;
+
+	Array utilities;
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		RBMap<Variant::ValidatedUtilityFunction, StringName>::Element *E = utility_lookup.find(utility);
+		ERR_FAIL_NULL_V(E, false);
+		utilities.push_back(E->get());
+	}
+	r_encoded["utilities"] = utilities;
+
+	Array gds_utilities;
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName>::Element *E = gds_utility_lookup.find(utility);
+		ERR_FAIL_NULL_V(E, false);
+		gds_utilities.push_back(E->get());
+	}
+	r_encoded["gds_utilities"] = gds_utilities;
+
+	Array methods;
+	for (const MethodBind *method : p_function->methods) {
+		methods.push_back(method->get_instance_class());
+		methods.push_back(method->get_name());
+	}
+	r_encoded["methods"] = methods;
+
+	Array lambdas;
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		Dictionary encoded_lambda;
+		if (!_encode_function(p_context, p_script, lambda, encoded_lambda)) {
+			return false;
+		}
+		const GDScript::LambdaInfo *info = p_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		if (info != nullptr) {
+			encoded_lambda["capture_count"] = info->capture_count;
+			encoded_lambda["use_self"] = info->use_self;
+		}
+		lambdas.push_back(encoded_lambda);
+	}
+	r_encoded["lambdas"] = lambdas;
+
+#ifdef DEBUG_ENABLED
+	r_encoded["operator_names"] = p_function->operator_names;
+	r_encoded["setter_names"] = p_function->setter_names;
+	r_encoded["getter_names"] = p_function->getter_names;
+	r_encoded["builtin_methods_names"] = p_function->builtin_methods_names;
+	r_encoded["constructors_names"] = p_function->constructors_names;
+	r_encoded["utilities_names"] = p_function->utilities_names;
+	r_encoded["gds_utilities_names"] = p_function->gds_utilities_names;
+#endif
+
+	return true;
+}
+
+bool GDScriptBytecodeCache::_encode_class(EncodeContext &p_context, const GDScript *p_script, Dictionary &r_encoded) {
+	r_encoded["fully_qualified_name"] = p_script->fully_qualified_name;
+	r_encoded["local_name"] = p_script->local_name;
+	r_encoded["global_name"] = p_script->global_name;
+	r_encoded["simplified_icon_path"] = p_script->simplified_icon_path;
+	r_encoded["tool"] = p_script->tool;
+	r_encoded["native"] = p_script->native.is_valid() ? p_script->native->get_name() : StringName();
+
+	if (p_script->base.is_valid()) {
+		Variant base;
+		if (!_encode_script(p_context, p_script->base.ptr(), base)) {
+			return false;
+		}
+		r_encoded["base"] = base;
+	}
+
+	const HashMap<StringName, GDScript::MemberInfo> *member_maps[] = { &p_script->member_indices, &p_script->static_variables_indices };
+	const char *member_map_keys[] = { "member_indices", "static_variables_indices" };
+	for (int i = 0; i < 2; i++) {
+		Array members;
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : *member_maps[i]) {
+			Variant data_type;
+			if (!_encode_data_type(p_context, E.value.data_type, data_type)) {
+				return false;
+			}
+			Array member;
+			member.push_back(E.key);
+			member.push_back(E.value.index);
+			member.push_back(E.value.setter);
+			member.push_back(E.value.getter);
+			member.push_back(data_type);
+			member.push_back(Dictionary(E.value.property_info));
+			members.push_back(member);
+		}
+		r_encoded[member_map_keys[i]] = members;
+	}
+
+	Array members;
+	for (const StringName &E : p_script->members) {
+		members.push_back(E);
+	}
+	r_encoded["members"] = members;
+
+	Array constants;
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		Variant value;
+		if (!_encode_value(p_context, E.value, value)) {
+			return false;
+		}
+		constants.push_back(E.key);
+		constants.push_back(value);
+	}
+	r_encoded["constants"] = constants;
+
+	Array signals;
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		Variant info;
+		if (!_encode_method_info(p_context, E.value, info)) {
+			return false;
+		}
+		signals.push_back(E.key);
+		signals.push_back(info);
+	}
+	r_encoded["signals"] = signals;
+
+	Variant rpc_config;
+	if (!_encode_value(p_context, p_script->rpc_config, rpc_config)) {
+		return false;
+	}
+	r_encoded["rpc_config"] = rpc_config;
+
+	Array functions;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		Dictionary function;
+		if (!_encode_function(p_context, p_script, E.value, function)) {
+			return false;
+		}
+		functions.push_back(function);
+	}
+	r_encoded["functions"] = functions;
+
+	const GDScriptFunction *implicit_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	const char *implicit_function_keys[] = { "implicit_initializer", "implicit_ready", "static_initializer" };
+	for (int i = 0; i < 3; i++) {
+		if (implicit_functions[i] == nullptr) {
+			continue;
+		}
+		Dictionary function;
+		if (!_encode_function(p_context, p_script, implicit_functions[i], function)) {
+			return false;
+		}
+		r_encoded[implicit_function_keys[i]] = function;
+	}
+
+#ifdef TOOLS_ENABLED
+	Array default_values;
+	for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+		Variant value;
+		if (!_encode_value(p_context, E.value, value)) {
+			return false;
+		}
+		default_values.push_back(E.key);
+		default_values.push_back(value);
+	}
+	r_encoded["member_default_values"] = default_values;
+#endif
+
+	Array subclasses;
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		Dictionary subclass;
+		if (!_encode_class(p_context, E.value.ptr(), subclass)) {
+			return false;
+		}
+		subclasses.push_back(subclass);
+	}
+	r_encoded["subclasses"] = subclasses;
+
+	return true;
+}
+
+bool GDScriptBytecodeCache::_decode_value(DecodeContext &p_context, const Variant &p_encoded, Variant &r_value) {
+	if (p_encoded.get_type() != Variant::ARRAY) {
+		r_value = p_encoded;
+		return true;
+	}
+
+	const Array encoded = p_encoded;
+	ERR_FAIL_COND_V(encoded.is_empty(), false);
+
+	switch (int(encoded[0])) {
+		case VALUE_ARRAY: {
+			ERR_FAIL_COND_V(encoded.size() != 6, false);
+			Array array;
+			const uint32_t typed_builtin = encoded[2];
+			if (typed_builtin != Variant::NIL) {
+				Variant typed_script;
+				if (!_decode_value(p_context, encoded[4], typed_script)) {
+					return false;
+				}
+				array.set_typed(typed_builtin, encoded[3], typed_script);
+			}
+
+			const Array elements = encoded[5];
+			array.resize(elements.size());
+			for (int i = 0; i < elements.size(); i++) {
+				Variant element;
+				if (!_decode_value(p_context, elements[i], element)) {
+					return false;
+				}
+				array[i] = element;
+			}
+
+			if (bool(encoded[1])) {
+				array.make_read_only();
+			}
+			r_value = array;
+			return true;
+		}
+
+		case VALUE_DICTIONARY: {
+			ERR_FAIL_COND_V(encoded.size() != 9, false);
+			Dictionary dictionary;
+			const uint32_t key_builtin = encoded[2];
+			const uint32_t value_builtin = encoded[5];
+			if (key_builtin != Variant::NIL || value_builtin != Variant::NIL) {
+				Variant key_script;
+				Variant value_script;
+				if (!_decode_value(p_context, encoded[4], key_script) || !_decode_value(p_context, encoded[7], value_script)) {
+					return false;
+				}
+				dictionary.set_typed(key_builtin, encoded[3], key_script, value_builtin, encoded[6], value_script);
+			}
+
+			const Array elements = encoded[8];
+			ERR_FAIL_COND_V(elements.size() % 2 != 0, false);
+			for (int i = 0; i < elements.size(); i += 2) {
+				Variant key;
+				Variant value;
+				if (!_decode_value(p_context, elements[i], key) || !_decode_value(p_context, elements[i + 1], value)) {
+					return false;
+				}
+				dictionary[key] = value;
+			}
+
+			if (bool(encoded[1])) {
+				dictionary.make_read_only();
+			}
+			r_value = dictionary;
+			return true;
+		}
+
+		case VALUE_NULL_OBJECT: {
+			r_value = (Object *)nullptr;
+			return true;
+		}
+
+		case VALUE_SCRIPT: {
+			Ref<Script> scr;
+			if (!_decode_script(p_context, encoded, scr)) {
+				return false;
+			}
+			r_value = scr;
+			return true;
+		}
+
+		case VALUE_RESOURCE: {
+			ERR_FAIL_COND_V(encoded.size() != 2, false);
+			const String path = encoded[1];
+			Ref<Resource> res = ResourceLoader::load(path);
+			if (res.is_null()) {
+				p_context.error = vformat(R"(Could not load resource "%s".)", path);
+				return false;
+			}
+			r_value = res;
+			return true;
+		}
+
+		case VALUE_GLOBAL: {
+			ERR_FAIL_COND_V(encoded.size() != 2, false);
+			const StringName name = encoded[1];
+			HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+			if (!E) {
+				p_context.error = vformat(R"(Could not find global "%s".)", name);
+				return false;
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+			return true;
+		}
+	}
+
+	ERR_FAIL_V_MSG(false, "Invalid value tag in GDScript bytecode cache.");
+}
+
+bool GDScriptBytecodeCache::_decode_script(DecodeContext &p_context, const Array &p_encoded, Ref<Script> &r_script) {
+	ERR_FAIL_COND_V(p_encoded.is_empty(), false);
+
+	if (int(p_encoded[0]) == VALUE_RESOURCE) {
+		Variant res;
+		if (!_decode_value(p_context, p_encoded, res)) {
+			return false;
+		}
+		r_script = res;
+		if (r_script.is_null()) {
+			p_context.error = vformat(R"(Resource "%s" is not a script.)", p_encoded[1]);
+			return false;
+		}
+		return true;
+	}
+
+	ERR_FAIL_COND_V(int(p_encoded[0]) != VALUE_SCRIPT || p_encoded.size() != 3, false);
+
+	const String path = p_encoded[1];
+	Ref<GDScript> root;
+	if (path.is_empty()) {
+		root = Ref<GDScript>(p_context.root);
+	} else {
+		// Like the compiler, only get a shallow script here. It's fully compiled once this script is done.
+		Error err = OK;
+		root = GDScriptCache::get_shallow_script(path, err, p_context.root->path);
+		if (err != OK || root.is_null()) {
+			p_context.error = vformat(R"(Could not load script "%s".)", path);
+			return false;
+		}
+	}
+
+	GDScript *result = root.ptr();
+	const PackedStringArray class_names = p_encoded[2];
+	for (const String &class_name : class_names) {
+		HashMap<StringName, Ref<GDScript>>::Iterator E = result->subclasses.find(class_name);
+		if (!E) {
+			p_context.error = vformat(R"(Could not find class "%s" in "%s".)", class_name, path);
+			return false;
+		}
+		result = E->value.ptr();
+	}
+
+	r_script = Ref<Script>(result);
+	return true;
+}
+
+bool GDScriptBytecodeCache::_decode_data_type(DecodeContext &p_context, const Variant &p_encoded, GDScriptDataType &r_type) {
+	const Array encoded = p_encoded;
+	ERR_FAIL_COND_V(encoded.size() != 6, false);
+
+	r_type.has_type = encoded[0];
+	r_type.kind = GDScriptDataType::Kind(int(encoded[1]));
+	r_type.builtin_type = Variant::Type(int(encoded[2]));
+	r_type.native_type = encoded[3];
+
+	if (encoded[4].get_type() == Variant::ARRAY) {
+		Ref<Script> scr;
+		if (!_decode_script(p_context, encoded[4], scr)) {
+			return false;
+		}
+		r_type.script_type = scr.ptr();
+		// Like the compiler, don't hold strong references to classes of the same script, they would never be freed.
+		const GDScript *gdscript = Object::cast_to<GDScript>(scr.ptr());
+		if (r_type.kind != GDScriptDataType::GDSCRIPT || gdscript == nullptr || const_cast<GDScript *>(gdscript)->get_root_script() != p_context.root) {
+			r_type.script_type_ref = scr;
+		}
+	}
+
+	const Array container_element_types = encoded[5];
+	for (int i = 0; i < container_element_types.size(); i++) {
+		GDScriptDataType element_type;
+		if (!_decode_data_type(p_context, container_element_types[i], element_type)) {
+			return false;
+		}
+		r_type.set_container_element_type(i, element_type);
+	}
+
+	return true;
+}
+
+bool GDScriptBytecodeCache::_decode_method_info(DecodeContext &p_context, const Variant &p_encoded, MethodInfo &r_info) {
+	const Dictionary encoded = p_encoded;
+
+	r_info.name = encoded["name"];
+	r_info.flags = encoded["flags"];
+	r_info.return_val = PropertyInfo::from_dict(encoded["return"]);
+
+	const Array arguments = encoded["arguments"];
+	for (const Variant &argument : arguments) {
+		r_info.arguments.push_back(PropertyInfo::from_dict(argument));
+	}
+
+	const Array default_arguments = encoded["default_arguments"];
+	for (const Variant &default_argument : default_arguments) {
+		Variant value;
+		if (!_decode_value(p_context, default_argument, value)) {
+			return false;
+		}
+		r_info.default_arguments.push_back(value);
+	}
+
+	return true;
+}
+
+void GDScriptBytecodeCache::_update_function_pointers(GDScriptFunction *p_function) {
+	p_function->_code_size = p_function->code.size();
+	p_function->_code_ptr = p_function->code.is_empty() ? nullptr : p_function->code.ptrw();
+
+	if (p_function->default_arguments.size()) {
+		p_function->_default_arg_count = p_function->default_arguments.size() - 1;
+		p_function->_default_arg_ptr = p_function->default_arguments.ptr();
+	} else {
+		p_function->_default_arg_count = 0;
+		p_function->_default_arg_ptr = nullptr;
+	}
+
+	p_function->_constant_count = p_function->constants.size();
+	p_function->_constants_ptr = p_function->constants.is_empty() ? nullptr : p_function->constants.ptrw();
+	p_function->_methods_count = p_function->methods.size();
+	p_function->_methods_ptr = p_function->methods.is_empty() ? nullptr : p_function->methods.ptrw();
+	p_function->_lambdas_count = p_function->lambdas.size();
+	p_function->_lambdas_ptr = p_function->lambdas.is_empty() ? nullptr : p_function->lambdas.ptrw();
+
+#define UPDATE_TABLE(m_table, m_ptr, m_count)    \
+	p_function->m_count = p_function->m_table.size(); \
+	p_function->m_ptr = p_function->m_table.is_empty() ? nullptr : p_function->m_table.ptr();
+
+	UPDATE_TABLE(global_names, _global_names_ptr, _global_names_count);
+	UPDATE_TABLE(operator_funcs, _operator_funcs_ptr, _operator_funcs_count);
+	UPDATE_TABLE(setters, _setters_ptr, _setters_count);
+	UPDATE_TABLE(getters, _getters_ptr, _getters_count);
+	UPDATE_TABLE(keyed_setters, _keyed_setters_ptr, _keyed_setters_count);
+	UPDATE_TABLE(keyed_getters, _keyed_getters_ptr, _keyed_getters_count);
+	UPDATE_TABLE(indexed_setters, _indexed_setters_ptr, _indexed_setters_count);
+	UPDATE_TABLE(indexed_getters, _indexed_getters_ptr, _indexed_getters_count);
+	UPDATE_TABLE(builtin_methods, _builtin_methods_ptr, _builtin_methods_count);
+	UPDATE_TABLE(constructors, _constructors_ptr, _constructors_count);
+	UPDATE_TABLE(utilities, _utilities_ptr, _utilities_count);
+	UPDATE_TABLE(gds_utilities, _gds_utilities_ptr, _gds_utilities_count);
+
+#undef UPDATE_TABLE
+}
+
+static bool _is_valid_type(int p_type) {
+	return p_type >= 0 && p_type < Variant::VARIANT_MAX;
+}
+
+bool GDScriptBytecodeCache::_decode_function(DecodeContext &p_context, GDScript *p_script, const Dictionary &p_encoded, GDScriptFunction *r_function) {
+	r_function->_static = p_encoded["static"];
+	r_function->_initial_line = p_encoded["initial_line"];
+	r_function->_argument_count = p_encoded["argument_count"];
+	r_function->_stack_size = p_encoded["stack_size"];
+	r_function->_instruction_args_size = p_encoded["instruction_args_size"];
+	r_function->code = p_encoded["code"];
+	r_function->default_arguments = p_encoded["default_arguments"];
+
+	const Array argument_types = p_encoded["argument_types"];
+	for (const Variant &E : argument_types) {
+		GDScriptDataType argument_type;
+		if (!_decode_data_type(p_context, E, argument_type)) {
+			return false;
+		}
+		r_function->argument_types.push_back(argument_type);
+	}
+
+	if (!_decode_data_type(p_context, p_encoded["return_type"], r_function->return_type) ||
+			!_decode_method_info(p_context, p_encoded["method_info"], r_function->method_info) ||
+			!_decode_value(p_context, p_encoded["rpc_config"], r_function->rpc_config)) {
+		return false;
+	}
+
+	const Dictionary temporary_slots = p_encoded["temporary_slots"];
+	const Array temporary_slot_keys = temporary_slots.keys();
+	for (const Variant &E : temporary_slot_keys) {
+		r_function->temporary_slots[E] = Variant::Type(int(temporary_slots[E]));
+	}
+
+	const Array stack_debug = p_encoded["stack_debug"];
+	for (const Variant &E : stack_debug) {
+		const Array entry = E;
+		ERR_FAIL_COND_V(entry.size() != 4, false);
+		GDScriptFunction::StackDebug debug;
+		debug.line = entry[0];
+		debug.pos = entry[1];
+		debug.added = entry[2];
+		debug.identifier = entry[3];
+		r_function->stack_debug.push_back(debug);
+	}
+
+	const Array constants = p_encoded["constants"];
+	for (const Variant &E : constants) {
+		Variant constant;
+		if (!_decode_value(p_context, E, constant)) {
+			return false;
+		}
+		r_function->constants.push_back(constant);
+	}
+
+	const Array global_names = p_encoded["global_names"];
+	for (const Variant &E : global_names) {
+		r_function->global_names.push_back(E);
+	}
+
+	const Array operator_funcs = p_encoded["operator_funcs"];
+	for (const Variant &E : operator_funcs) {
+		const Vector3i op = E;
+		ERR_FAIL_COND_V(op.x < 0 || op.x >= Variant::OP_MAX || !_is_valid_type(op.y) || !_is_valid_type(op.z), false);
+		Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op.x), Variant::Type(op.y), Variant::Type(op.z));
+		ERR_FAIL_NULL_V(evaluator, false);
+		r_function->operator_funcs.push_back(evaluator);
+	}
+
+	const Array setters = p_encoded["setters"];
+	const Array getters = p_encoded["getters"];
+	const Array builtin_methods = p_encoded["builtin_methods"];
+	const Array constructors = p_encoded["constructors"];
+	ERR_FAIL_COND_V(setters.size() % 2 != 0 || getters.size() % 2 != 0 || builtin_methods.size() % 2 != 0 || constructors.size() % 2 != 0, false);
+
+	for (int i = 0; i < setters.size(); i += 2) {
+		ERR_FAIL_COND_V(!_is_valid_type(setters[i]), false);
+		Variant::ValidatedSetter setter = Variant::get_member_validated_setter(Variant::Type(int(setters[i])), setters[i + 1]);
+		ERR_FAIL_NULL_V(setter, false);
+		r_function->setters.push_back(setter);
+	}
+
+	for (int i = 0; i < getters.size(); i += 2) {
+		ERR_FAIL_COND_V(!_is_valid_type(getters[i]), false);
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(Variant::Type(int(getters[i])), getters[i + 1]);
+		ERR_FAIL_NULL_V(getter, false);
+		r_function->getters.push_back(getter);
+	}
+
+	const Array keyed_setters = p_encoded["keyed_setters"];
+	for (const Variant &E : keyed_setters) {
+		ERR_FAIL_COND_V(!_is_valid_type(E), false);
+		Variant::ValidatedKeyedSetter setter = Variant::get_member_validated_keyed_setter(Variant::Type(int(E)));
+		ERR_FAIL_NULL_V(setter, false);
+		r_function->keyed_setters.push_back(setter);
+	}
+
+	const Array keyed_getters = p_encoded["keyed_getters"];
+	for (const Variant &E : keyed_getters) {
+		ERR_FAIL_COND_V(!_is_valid_type(E), false);
+		Variant::ValidatedKeyedGetter getter = Variant::get_member_validated_keyed_getter(Variant::Type(int(E)));
+		ERR_FAIL_NULL_V(getter, false);
+		r_function->keyed_getters.push_back(getter);
+	}
+
+	const Array indexed_setters = p_encoded["indexed_setters"];
+	for (const Variant &E : indexed_setters) {
+		ERR_FAIL_COND_V(!_is_valid_type(E), false);
+		Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(Variant::Type(int(E)));
+		ERR_FAIL_NULL_V(setter, false);
+		r_function->indexed_setters.push_back(setter);
+	}
+
+	const Array indexed_getters = p_encoded["indexed_getters"];
+	for (const Variant &E : indexed_getters) {
+		ERR_FAIL_COND_V(!_is_valid_type(E), false);
+		Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(Variant::Type(int(E)));
+		ERR_FAIL_NULL_V(getter, false);
+		r_function->indexed_getters.push_back(getter);
+	}
+
+	for (int i = 0; i < builtin_methods.size(); i += 2) {
+		ERR_FAIL_COND_V(!_is_valid_type(builtin_methods[i]), false);
+		Variant::ValidatedBuiltInMethod method = Variant::get_validated_builtin_method(Variant::Type(int(builtin_methods[i])), builtin_methods[i + 1]);
+		ERR_FAIL_NULL_V(method, false);
+		r_function->builtin_methods.push_back(method);
+	}
+
+	for (int i = 0; i < constructors.size(); i += 2) {
+		ERR_FAIL_COND_V(!_is_valid_type(constructors[i]), false);
+		const Variant::Type type = Variant::Type(int(constructors[i]));
+		const int index = constructors[i + 1];
+		ERR_FAIL_INDEX_V(index, Variant::get_constructor_count(type), false);
+		r_function->constructors.push_back(Variant::get_validated_constructor(type, index));
+	}
+
+	const Array utilities = p_encoded["utilities"];
+	for (const Variant &E : utilities) {
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(E);
+		ERR_FAIL_NULL_V(utility, false);
+		r_function->utilities.push_back(utility);
+	}
+
+	const Array gds_utilities = p_encoded["gds_utilities"];
+	for (const Variant &E : gds_utilities) {
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(E);
+		ERR_FAIL_NULL_V(utility, false);
+		r_function->gds_utilities.push_back(utility);
+	}
+
+	const Array methods = p_encoded["methods"];
+	ERR_FAIL_COND_V(methods.size() % 2 != 0, false);
+	for (int i = 0; i < methods.size(); i += 2) {
+		MethodBind *method = ClassDB::get_method(methods[i], methods[i + 1]);
+		if (method == nullptr) {
+			p_context.error = vformat(R"(Could not find method "%s.%s".)", methods[i], methods[i + 1]);
+			return false;
+		}
+		r_function->methods.push_back(method);
+	}
+
+	const Array lambdas = p_encoded["lambdas"];
+	for (const Variant &E : lambdas) {
+		const Dictionary encoded_lambda = E;
+		GDScriptFunction *lambda = _make_function(p_context, p_script, encoded_lambda);
+		if (lambda == nullptr) {
+			return false;
+		}
+		r_function->lambdas.push_back(lambda);
+		if (encoded_lambda.has("capture_count")) {
+			p_script->lambda_info.insert(lambda, { int(encoded_lambda["capture_count"]), bool(encoded_lambda["use_self"]) });
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	r_function->operator_names = p_encoded["operator_names"];
+	r_function->setter_names = p_encoded["setter_names"];
+	r_function->getter_names = p_encoded["getter_names"];
+	r_function->builtin_methods_names = p_encoded["builtin_methods_names"];
+	r_function->constructors_names = p_encoded["constructors_names"];
+	r_function->utilities_names = p_encoded["utilities_names"];
+	r_function->gds_utilities_names = p_encoded["gds_utilities_names"];
+#endif
+
+	_update_function_pointers(r_function);
+	return true;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_make_function(DecodeContext &p_context, GDScript *p_script, const Dictionary &p_encoded) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+
+	if (!_decode_function(p_context, p_script, p_encoded, function)) {
+		// The function is still unnamed, so deleting it won't unregister a member function with the same name.
+		memdelete(function);
+		return nullptr;
+	}
+
+	function->name = p_encoded["name"];
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_make_classes(GDScript *p_script, const Dictionary &p_encoded) {
+	p_script->fully_qualified_name = p_encoded["fully_qualified_name"];
+	p_script->local_name = p_encoded["local_name"];
+	p_script->global_name = p_encoded["global_name"];
+	p_script->simplified_icon_path = p_encoded["simplified_icon_path"];
+
+	// Like GDScriptCompiler::make_scripts(), reuse existing inner classes since other scripts may already point to them.
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	const Array subclasses = p_encoded["subclasses"];
+	for (const Variant &E : subclasses) {
+		const Dictionary encoded_subclass = E;
+		const StringName name = encoded_subclass["local_name"];
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(encoded_subclass["fully_qualified_name"]);
+		}
+
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_make_classes(subclass.ptr(), encoded_subclass);
+	}
+}
+
+bool GDScriptBytecodeCache::_decode_class(DecodeContext &p_context, GDScript *p_script, const Dictionary &p_encoded) {
+	p_script->tool = p_encoded["tool"];
+
+	const StringName native_name = p_encoded["native"];
+	HashMap<StringName, int>::ConstIterator native = GDScriptLanguage::get_singleton()->get_global_map().find(native_name);
+	if (!native) {
+		p_context.error = vformat(R"(Could not find native class "%s".)", native_name);
+		return false;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[native->value];
+	ERR_FAIL_COND_V(p_script->native.is_null(), false);
+
+	if (p_encoded.has("base")) {
+		Ref<Script> base;
+		if (!_decode_script(p_context, p_encoded["base"], base)) {
+			return false;
+		}
+		p_script->base = base;
+		ERR_FAIL_COND_V(p_script->base.is_null(), false);
+		p_script->_base = p_script->base.ptr();
+	}
+
+	HashMap<StringName, GDScript::MemberInfo> *member_maps[] = { &p_script->member_indices, &p_script->static_variables_indices };
+	const char *member_map_keys[] = { "member_indices", "static_variables_indices" };
+	for (int i = 0; i < 2; i++) {
+		const Array members = p_encoded[member_map_keys[i]];
+		for (const Variant &E : members) {
+			const Array member = E;
+			ERR_FAIL_COND_V(member.size() != 6, false);
+			GDScript::MemberInfo info;
+			info.index = member[1];
+			info.setter = member[2];
+			info.getter = member[3];
+			if (!_decode_data_type(p_context, member[4], info.data_type)) {
+				return false;
+			}
+			info.property_info = PropertyInfo::from_dict(member[5]);
+			member_maps[i]->insert(member[0], info);
+		}
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	const Array members = p_encoded["members"];
+	for (const Variant &E : members) {
+		p_script->members.insert(E);
+	}
+
+	const Array constants = p_encoded["constants"];
+	ERR_FAIL_COND_V(constants.size() % 2 != 0, false);
+	for (int i = 0; i < constants.size(); i += 2) {
+		Variant value;
+		if (!_decode_value(p_context, constants[i + 1], value)) {
+			return false;
+		}
+		p_script->constants.insert(constants[i], value);
+	}
+
+	const Array signals = p_encoded["signals"];
+	ERR_FAIL_COND_V(signals.size() % 2 != 0, false);
+	for (int i = 0; i < signals.size(); i += 2) {
+		MethodInfo info;
+		if (!_decode_method_info(p_context, signals[i + 1], info)) {
+			return false;
+		}
+		p_script->_signals[signals[i]] = info;
+	}
+
+	Variant rpc_config;
+	if (!_decode_value(p_context, p_encoded["rpc_config"], rpc_config)) {
+		return false;
+	}
+	p_script->rpc_config = rpc_config;
+
+	const Array functions = p_encoded["functions"];
+	for (const Variant &E : functions) {
+		GDScriptFunction *function = _make_function(p_context, p_script, E);
+		if (function == nullptr) {
+			return false;
+		}
+		p_script->member_functions[function->name] = function;
+	}
+
+	GDScriptFunction **implicit_functions[] = { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer };
+	const char *implicit_function_keys[] = { "implicit_initializer", "implicit_ready", "static_initializer" };
+	for (int i = 0; i < 3; i++) {
+		if (!p_encoded.has(implicit_function_keys[i])) {
+			continue;
+		}
+		*implicit_functions[i] = _make_function(p_context, p_script, p_encoded[implicit_function_keys[i]]);
+		if (*implicit_functions[i] == nullptr) {
+			return false;
+		}
+	}
+
+	HashMap<StringName, GDScriptFunction *>::Iterator initializer = p_script->member_functions.find(GDScriptLanguage::get_singleton()->strings._init);
+	if (initializer) {
+		p_script->initializer = initializer->value;
+	}
+
+#ifdef TOOLS_ENABLED
+	const Array default_values = p_encoded["member_default_values"];
+	ERR_FAIL_COND_V(default_values.size() % 2 != 0, false);
+	for (int i = 0; i < default_values.size(); i += 2) {
+		Variant value;
+		if (!_decode_value(p_context, default_values[i + 1], value)) {
+			return false;
+		}
+		p_script->member_default_values[default_values[i]] = value;
+	}
+#endif
+
+	const Array subclasses = p_encoded["subclasses"];
+	for (const Variant &E : subclasses) {
+		const Dictionary encoded_subclass = E;
+		HashMap<StringName, Ref<GDScript>>::Iterator subclass = p_script->subclasses.find(encoded_subclass["local_name"]);
+		ERR_FAIL_COND_V(!subclass, false);
+		if (!_decode_class(p_context, subclass->value.ptr(), encoded_subclass)) {
+			return false;
+		}
+	}
+
+	p_script->_static_default_init();
+
+	p_script->valid = true;
+	return true;
+}
+
+String GDScriptBytecodeCache::get_build_id() {
+	String build_id = vformat("%s.%s.%d", VERSION_FULL_BUILD, VERSION_HASH, FORMAT_VERSION);
+#ifdef DEBUG_ENABLED
+	build_id += ".debug";
+#endif
+#ifdef TOOLS_ENABLED
+	build_id += ".tools";
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	build_id += ".double";
+#endif
+	return build_id;
+}
+
+uint32_t GDScriptBytecodeCache::get_environment_hash() {
+	// Bytecode refers to autoloads by their index in the global array.
+	uint32_t hash = hash_murmur3_one_32(FORMAT_VERSION);
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		hash = hash_murmur3_one_32(E.key.hash(), hash);
+		hash = hash_murmur3_one_32(E.value, hash);
+	}
+
+	// Identifiers are resolved to global classes when compiling.
+	List<StringName> global_classes;
+	ScriptServer::get_global_class_list(&global_classes);
+	for (const StringName &E : global_classes) {
+		hash = hash_murmur3_one_32(E.hash(), hash);
+		hash = hash_murmur3_one_32(ScriptServer::get_global_class_path(E).hash(), hash);
+	}
+
+	hash = hash_murmur3_one_32(String(GLOBAL_GET("application/config/version")).hash(), hash);
+	return hash_fmix32(hash);
+}
+
+Error GDScriptBytecodeCache::serialize(GDScript *p_script, Vector<uint8_t> &r_buffer, HashSet<String> *r_dependencies) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!p_script->is_valid() || !p_script->is_root_script(), ERR_INVALID_PARAMETER);
+
+	_ensure_lookups();
+
+	EncodeContext context;
+	context.root = p_script;
+
+	// Singletons and native classes are stored by their global name.
+	const Variant *global_array = GDScriptLanguage::get_singleton()->get_global_array();
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		const Object *obj = global_array[E.value].get_validated_object();
+		if (obj != nullptr && !context.globals.has(obj)) {
+			context.globals.insert(obj, E.key);
+		}
+	}
+
+	Dictionary encoded;
+	if (!_encode_class(context, p_script, encoded)) {
+		print_verbose(vformat(R"(GDScript: Not caching bytecode of "%s": %s)", p_script->path, context.error));
+		return ERR_UNAVAILABLE;
+	}
+
+	int len = 0;
+	Error err = encode_variant(encoded, nullptr, len, false);
+	ERR_FAIL_COND_V(err != OK, err);
+	r_buffer.resize(len);
+	err = encode_variant(encoded, r_buffer.ptrw(), len, false);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	if (r_dependencies != nullptr) {
+		for (const String &E : context.dependencies) {
+			r_dependencies->insert(E);
+		}
+	}
+
+	return OK;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const uint8_t *p_buffer, int p_size) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_script->is_valid(), ERR_ALREADY_IN_USE);
+
+	Variant decoded;
+	Error err = decode_variant(decoded, p_buffer, p_size, nullptr, false);
+	ERR_FAIL_COND_V(err != OK || decoded.get_type() != Variant::DICTIONARY, ERR_FILE_CORRUPT);
+
+	// Create all inner classes first, so references between them can be resolved.
+	p_script->_owner = nullptr;
+	_make_classes(p_script, decoded);
+
+	DecodeContext context;
+	context.root = p_script;
+	if (!_decode_class(context, p_script, decoded)) {
+		print_verbose(vformat(R"(GDScript: Could not load cached bytecode of "%s": %s)", p_script->path, context.error));
+		return ERR_FILE_CORRUPT;
+	}
+
+	return OK;
+}
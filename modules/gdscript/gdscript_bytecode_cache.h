@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/templates/hash_set.h"
+
+// Stores compiled GDScript classes (bytecode, constants and member tables) so they
+// can be restored without parsing, analyzing and compiling the source again.
+// Validated function pointers and method binds are stored by name and resolved
+// again on load, script and resource references are stored by path.
+class GDScriptBytecodeCache {
+public:
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+private:
+	enum ValueTag {
+		VALUE_ARRAY,
+		VALUE_DICTIONARY,
+		VALUE_NULL_OBJECT,
+		VALUE_SCRIPT,
+		VALUE_RESOURCE,
+		VALUE_GLOBAL,
+	};
+
+	struct EncodeContext {
+		GDScript *root = nullptr;
+		HashMap<const Object *, StringName> globals;
+		HashSet<String> dependencies;
+		String error;
+	};
+
+	struct DecodeContext {
+		GDScript *root = nullptr;
+		String error;
+	};
+
+	static Mutex lookup_mutex;
+	static bool lookup_initialized;
+	static RBMap<Variant::ValidatedOperatorEvaluator, Vector3i> operator_lookup;
+	static RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setter_lookup;
+	static RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getter_lookup;
+	static RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setter_lookup;
+	static RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getter_lookup;
+	static RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setter_lookup;
+	static RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getter_lookup;
+	static RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_method_lookup;
+	static RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructor_lookup;
+	static RBMap<Variant::ValidatedUtilityFunction, StringName> utility_lookup;
+	static RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utility_lookup;
+
+	static void _ensure_lookups();
+
+	static bool _encode_value(EncodeContext &p_context, const Variant &p_value, Variant &r_encoded);
+	static bool _encode_script(EncodeContext &p_context, const Script *p_script, Variant &r_encoded);
+	static bool _encode_data_type(EncodeContext &p_context, const GDScriptDataType &p_type, Variant &r_encoded);
+	static bool _encode_method_info(EncodeContext &p_context, const MethodInfo &p_info, Variant &r_encoded);
+	static bool _encode_function(EncodeContext &p_context, const GDScript *p_script, const GDScriptFunction *p_function, Dictionary &r_encoded);
+	static bool _encode_class(EncodeContext &p_context, const GDScript *p_script, Dictionary &r_encoded);
+
+	static bool _decode_value(DecodeContext &p_context, const Variant &p_encoded, Variant &r_value);
+	static bool _decode_script(DecodeContext &p_context, const Array &p_encoded, Ref<Script> &r_script);
+	static bool _decode_data_type(DecodeContext &p_context, const Variant &p_encoded, GDScriptDataType &r_type);
+	static bool _decode_method_info(DecodeContext &p_context, const Variant &p_encoded, MethodInfo &r_info);
+	static bool _decode_function(DecodeContext &p_context, GDScript *p_script, const Dictionary &p_encoded, GDScriptFunction *r_function);
+	static GDScriptFunction *_make_function(DecodeContext &p_context, GDScript *p_script, const Dictionary &p_encoded);
+	static void _update_function_pointers(GDScriptFunction *p_function);
+	static void _make_classes(GDScript *p_script, const Dictionary &p_encoded);
+	static bool _decode_class(DecodeContext &p_context, GDScript *p_script, const Dictionary &p_encoded);
+
+public:
+	// Identifies the engine build, caches written by other builds are never used.
+	static String get_build_id();
+	// Hashes the global state compiled bytecode depends on (global constant indices and global classes).
+	static uint32_t get_environment_hash();
+
+	// Fails with ERR_UNAVAILABLE if the script holds something that can't be stored, like a constant
+	// object without a resource path. Other scripts referenced by the bytecode are added to r_dependencies.
+	static Error serialize(GDScript *p_script, Vector<uint8_t> &r_buffer, HashSet<String> *r_dependencies = nullptr);
+	// Restores a script serialized with serialize() into a script that hasn't been compiled yet.
+	static Error deserialize(GDScript *p_script, const uint8_t *p_buffer, int p_size);
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -32,10 +32,18 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -205,6 +213,7 @@ void GDScriptCache::remove_script(const String &p_path) {
 	remove_parser(p_path);
 
 	singleton->dependencies.erase(p_path);
+	singleton->content_hashes.erase(p_path);
 	singleton->shallow_gdscript_cache.erase(p_path);
 	singleton->full_gdscript_cache.erase(p_path);
 }
@@ -214,6 +223,7 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	Ref<GDScriptParserRef> ref;
 	if (!p_owner.is_empty()) {
 		singleton->dependencies[p_owner].insert(p_path);
+		singleton->compiled_dependencies[p_owner].insert(p_path);
 		singleton->parser_inverse_dependencies[p_path].insert(p_owner);
 	}
 	if (singleton->parser_map.has(p_path)) {
@@ -300,6 +310,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 
 	if (!p_owner.is_empty()) {
 		singleton->dependencies[p_owner].insert(p_path);
+		singleton->compiled_dependencies[p_owner].insert(p_path);
 	}
 	if (singleton->full_gdscript_cache.has(p_path)) {
 		return singleton->full_gdscript_cache[p_path];
@@ -342,6 +353,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 
 	if (!p_owner.is_empty()) {
 		singleton->dependencies[p_owner].insert(p_path);
+		singleton->compiled_dependencies[p_owner].insert(p_path);
 	}
 
 	Ref<GDScript> script;
@@ -444,6 +456,226 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+String GDScriptCache::get_content_hash(const String &p_path) {
+	MutexLock lock(singleton->mutex);
+
+	if (singleton->content_hashes.has(p_path)) {
+		return singleton->content_hashes[p_path];
+	}
+
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (!FileAccess::exists(remapped_path)) {
+		return String();
+	}
+
+	String hash;
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
+		unsigned char md5[16];
+		CryptoCore::md5(buffer.ptr(), buffer.size(), md5);
+		hash = String::md5(md5);
+	} else {
+		hash = get_source_code(remapped_path).md5_text();
+	}
+
+	singleton->content_hashes[p_path] = hash;
+	return hash;
+}
+
+bool GDScriptCache::is_bytecode_cache_enabled(const GDScript *p_script) {
+	if (!GLOBAL_GET("gdscript/bytecode_cache/enabled")) {
+		return false;
+	}
+	// The editor needs the parse tree (documentation, warnings) and the debugger needs parse errors.
+	if (Engine::get_singleton()->is_editor_hint() || EngineDebugger::is_active()) {
+		return false;
+	}
+	return p_script->_owner == nullptr && p_script->path.is_resource_file();
+}
+
+String GDScriptCache::_get_bytecode_cache_path(const String &p_path) {
+	return String(GLOBAL_GET("gdscript/bytecode_cache/path")).path_join(p_path.md5_text() + ".gdbc");
+}
+
+String GDScriptCache::_get_script_content_hash(const GDScript *p_script) {
+	if (!p_script->binary_tokens.is_empty()) {
+		unsigned char md5[16];
+		CryptoCore::md5(p_script->binary_tokens.ptr(), p_script->binary_tokens.size(), md5);
+		return String::md5(md5);
+	}
+	return p_script->source.md5_text();
+}
+
+Error GDScriptCache::load_bytecode(GDScript *p_script) {
+	const String cache_path = _get_bytecode_cache_path(p_script->path);
+	if (!FileAccess::exists(cache_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	Error err = OK;
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(cache_path, &err);
+	if (err != OK) {
+		return err;
+	}
+
+	// Magic, format version and header size, then the header and the serialized script.
+	if (buffer.size() < 12 || buffer[0] != 'G' || buffer[1] != 'D' || buffer[2] != 'B' || buffer[3] != 'C') {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (decode_uint32(&buffer[4]) != GDScriptBytecodeCache::FORMAT_VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	const uint32_t header_size = decode_uint32(&buffer[8]);
+	if (header_size > uint32_t(buffer.size() - 12)) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	Variant header_variant;
+	err = decode_variant(header_variant, &buffer[12], header_size, nullptr, false);
+	if (err != OK || header_variant.get_type() != Variant::DICTIONARY) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	const Dictionary header = header_variant;
+	if (String(header.get("build", String())) != GDScriptBytecodeCache::get_build_id()) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (uint32_t(header.get("environment", 0)) != GDScriptBytecodeCache::get_environment_hash()) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (String(header.get("hash", String())) != _get_script_content_hash(p_script)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	// Changing any script this one was analyzed against may change the compiled bytecode.
+	const Dictionary dependency_hashes = header.get("dependencies", Dictionary());
+	const Array dependency_paths = dependency_hashes.keys();
+	for (const Variant &E : dependency_paths) {
+		if (get_content_hash(E) != String(dependency_hashes[E])) {
+			return ERR_FILE_UNRECOGNIZED;
+		}
+	}
+
+	err = GDScriptBytecodeCache::deserialize(p_script, &buffer[12 + header_size], buffer.size() - 12 - header_size);
+	if (err != OK) {
+		return err;
+	}
+
+	{
+		MutexLock lock(singleton->mutex);
+		HashSet<String> &deps = singleton->compiled_dependencies[p_script->path];
+		for (const Variant &E : dependency_paths) {
+			deps.insert(E);
+		}
+	}
+
+	if (bool(header.get("static", false))) {
+		add_static_script(Ref<GDScript>(p_script));
+	}
+
+	print_verbose(vformat(R"(GDScript: Loaded "%s" from the bytecode cache.)", p_script->path));
+	return finish_compiling(p_script->path);
+}
+
+void GDScriptCache::save_bytecode(GDScript *p_script) {
+	Vector<uint8_t> body;
+	HashSet<String> references;
+	if (GDScriptBytecodeCache::serialize(p_script, body, &references) != OK) {
+		return;
+	}
+
+	Dictionary dependency_hashes;
+	bool is_static;
+	{
+		MutexLock lock(singleton->mutex);
+
+		// Collect every script this one depends on, directly or through other scripts.
+		HashSet<String> closure;
+		List<String> pending;
+		for (const String &E : references) {
+			pending.push_back(E);
+		}
+		if (singleton->compiled_dependencies.has(p_script->path)) {
+			for (const String &E : singleton->compiled_dependencies[p_script->path]) {
+				pending.push_back(E);
+			}
+		}
+		while (!pending.is_empty()) {
+			const String dependency = pending.front()->get();
+			pending.pop_front();
+			if (dependency == p_script->path || closure.has(dependency)) {
+				continue;
+			}
+			closure.insert(dependency);
+			if (singleton->compiled_dependencies.has(dependency)) {
+				for (const String &E : singleton->compiled_dependencies[dependency]) {
+					pending.push_back(E);
+				}
+			}
+		}
+
+		for (const String &E : closure) {
+			const String hash = get_content_hash(E);
+			if (hash.is_empty()) {
+				// Not a file, like a built-in script, so the cache couldn't be validated.
+				return;
+			}
+			dependency_hashes[E] = hash;
+		}
+		singleton->compiled_dependencies[p_script->path] = closure;
+
+		is_static = singleton->static_gdscript_cache.has(p_script->get_fully_qualified_name());
+	}
+
+	Dictionary header;
+	header["build"] = GDScriptBytecodeCache::get_build_id();
+	header["environment"] = GDScriptBytecodeCache::get_environment_hash();
+	header["hash"] = _get_script_content_hash(p_script);
+	header["dependencies"] = dependency_hashes;
+	header["static"] = is_static;
+
+	int header_size = 0;
+	Error err = encode_variant(header, nullptr, header_size, false);
+	ERR_FAIL_COND(err != OK);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(12 + header_size + body.size());
+	uint8_t *w = buffer.ptrw();
+	w[0] = 'G';
+	w[1] = 'D';
+	w[2] = 'B';
+	w[3] = 'C';
+	encode_uint32(GDScriptBytecodeCache::FORMAT_VERSION, &w[4]);
+	encode_uint32(header_size, &w[8]);
+	encode_variant(header, &w[12], header_size, false);
+	memcpy(&w[12 + header_size], body.ptr(), body.size());
+
+	const String cache_path = _get_bytecode_cache_path(p_script->path);
+	err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	if (err != OK && err != ERR_ALREADY_EXISTS) {
+		return;
+	}
+
+	// Written aside and renamed over the entry, so a concurrent or interrupted save never leaves a truncated one.
+	const String temp_path = vformat("%s.%d.%d.tmp", cache_path, OS::get_singleton()->get_process_id(), (int64_t)Thread::get_caller_id());
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		if (f.is_null()) {
+			print_verbose(vformat(R"(GDScript: Could not write the bytecode cache of "%s" to "%s".)", p_script->path, cache_path));
+			return;
+		}
+		f->store_buffer(buffer.ptr(), buffer.size());
+		err = f->get_error();
+	}
+	if (err == OK) {
+		err = DirAccess::rename_absolute(temp_path, cache_path);
+	}
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+		print_verbose(vformat(R"(GDScript: Could not write the bytecode cache of "%s" to "%s".)", p_script->path, cache_path));
+	}
+}
+
 void GDScriptCache::clear() {
 	if (singleton == nullptr) {
 		return;
@@ -86,6 +86,9 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	// Unlike `dependencies`, kept after compiling, to know which scripts a cached bytecode depends on.
+	HashMap<String, HashSet<String>> compiled_dependencies;
+	HashMap<String, String> content_hashes;
 
 	friend class GDScript;
 	friend class GDScriptParserRef;
@@ -102,6 +105,9 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static String _get_bytecode_cache_path(const String &p_path);
+	static String _get_script_content_hash(const GDScript *p_script);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -117,6 +123,11 @@ public:
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
 
+	static String get_content_hash(const String &p_path);
+	static bool is_bytecode_cache_enabled(const GDScript *p_script);
+	static Error load_bytecode(GDScript *p_script);
+	static void save_bytecode(GDScript *p_script);
+
 	static void clear();
 
 	GDScriptCache();
@@ -1878,6 +1878,40 @@ void GDScriptCompiler::_clear_block_locals(CodeGen &codegen, const List<GDScript
 	}
 }
 
+const GDScriptParser::CallNode *GDScriptCompiler::_get_int_range_call(const GDScriptParser::ExpressionNode *p_list) {
+	if (p_list->is_constant || p_list->type != GDScriptParser::Node::CALL) {
+		return nullptr;
+	}
+
+	const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(p_list);
+	if (call->is_super || call->get_callee_type() != GDScriptParser::Node::IDENTIFIER || call->function_name != SNAME("range")) {
+		return nullptr;
+	}
+
+	// Stepped ranges are left to `range()`, which reports a zero step.
+	if (call->arguments.size() < 1 || call->arguments.size() > 2) {
+		return nullptr;
+	}
+
+	// Vector2i bounds would truncate 64-bit ints, so only ranges starting at zero can be iterated as a
+	// plain int count. Other bounds are only known at runtime and are left to `range()`.
+	if (call->arguments.size() == 2) {
+		const GDScriptParser::ExpressionNode *from = call->arguments[0];
+		if (!from->is_constant || from->reduced_value.get_type() != Variant::INT || int64_t(from->reduced_value) != 0) {
+			return nullptr;
+		}
+	}
+
+	for (const GDScriptParser::ExpressionNode *argument : call->arguments) {
+		const GDScriptParser::DataType &argument_type = argument->get_datatype();
+		if (!argument_type.is_hard_type() || argument_type.kind != GDScriptParser::DataType::BUILTIN || argument_type.builtin_type != Variant::INT) {
+			return nullptr;
+		}
+	}
+
+	return call;
+}
+
 Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::SuiteNode *p_block, bool p_add_locals, bool p_clear_locals) {
 	Error err = OK;
 	GDScriptCodeGenerator *gen = codegen.generator;
@@ -2040,9 +2074,26 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 				GDScriptCodeGenerator::Address iterator = codegen.add_local(for_n->variable->name, _gdtype_from_datatype(for_n->variable->get_datatype(), codegen.script));
 
-				gen->start_for(iterator.type, _gdtype_from_datatype(for_n->list->get_datatype(), codegen.script));
+				// Like the analyzer does for constant arguments, iterate over `range()` with an int count
+				// as an int, so no array needs to be allocated.
+				const GDScriptParser::CallNode *range_call = _get_int_range_call(for_n->list);
+				GDScriptDataType list_type;
+				if (range_call) {
+					list_type.has_type = true;
+					list_type.kind = GDScriptDataType::BUILTIN;
+					list_type.builtin_type = Variant::INT;
+				} else {
+					list_type = _gdtype_from_datatype(for_n->list->get_datatype(), codegen.script);
+				}
+
+				gen->start_for(iterator.type, list_type);
 
-				GDScriptCodeGenerator::Address list = _parse_expression(codegen, err, for_n->list);
+				GDScriptCodeGenerator::Address list;
+				if (range_call) {
+					list = _parse_expression(codegen, err, range_call->arguments[range_call->arguments.size() - 1]);
+				} else {
+					list = _parse_expression(codegen, err, for_n->list);
+				}
 				if (err) {
 					return err;
 				}
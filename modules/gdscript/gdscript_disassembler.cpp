@@ -300,6 +300,25 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_GET_INDEXED_PACKED(m_type)         \
+	case OPCODE_GET_INDEXED_PACKED_##m_type##_ARRAY: { \
+		text += "get indexed (typed ";                 \
+		text += #m_type;                               \
+		text += " array) ";                            \
+		text += DADDR(3);                              \
+		text += " = ";                                 \
+		text += DADDR(1);                              \
+		text += "[";                                   \
+		text += DADDR(2);                              \
+		text += "]";                                   \
+		incr += 4;                                     \
+	} break
+
+				DISASSEMBLE_GET_INDEXED_PACKED(INT32);
+				DISASSEMBLE_GET_INDEXED_PACKED(INT64);
+				DISASSEMBLE_GET_INDEXED_PACKED(FLOAT32);
+				DISASSEMBLE_GET_INDEXED_PACKED(FLOAT64);
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -1046,6 +1065,35 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED: {
+				text += "jump-if-not validated operator ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr = 6;
+			} break;
+			case OPCODE_JUMP_IF_NOT_COMPARE_INT:
+			case OPCODE_JUMP_IF_NOT_COMPARE_FLOAT: {
+				text += _code_ptr[ip] == OPCODE_JUMP_IF_NOT_COMPARE_INT ? "jump-if-not compare int " : "jump-if-not compare float ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += Variant::get_operator_name(Variant::Operator(_code_ptr[ip + 4]));
+				text += " ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr = 6;
+			} break;
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
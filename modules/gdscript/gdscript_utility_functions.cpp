@@ -125,20 +125,21 @@ struct GDScriptUtilityFunctionsDefinitions {
 			} break;
 			case 1: {
 				VALIDATE_ARG_NUM(0);
-				int count = *p_args[0];
+				int64_t count = *p_args[0];
 				Array arr;
 				if (count <= 0) {
 					*r_ret = arr;
 					return;
 				}
-				Error err = arr.resize(count);
+				// Array sizes are int, larger counts must not wrap around.
+				Error err = count > INT32_MAX ? ERR_OUT_OF_MEMORY : arr.resize(count);
 				if (err != OK) {
 					*r_ret = RTR("Cannot resize array.");
 					r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
 					return;
 				}
 
-				for (int i = 0; i < count; i++) {
+				for (int64_t i = 0; i < count; i++) {
 					arr[i] = i;
 				}
 
@@ -148,22 +149,24 @@ struct GDScriptUtilityFunctionsDefinitions {
 				VALIDATE_ARG_NUM(0);
 				VALIDATE_ARG_NUM(1);
 
-				int from = *p_args[0];
-				int to = *p_args[1];
+				int64_t from = *p_args[0];
+				int64_t to = *p_args[1];
 
 				Array arr;
 				if (from >= to) {
 					*r_ret = arr;
 					return;
 				}
-				Error err = arr.resize(to - from);
+				// The span is computed unsigned, as it can exceed the range of int64_t.
+				const uint64_t count = uint64_t(to) - uint64_t(from);
+				Error err = count > INT32_MAX ? ERR_OUT_OF_MEMORY : arr.resize(count);
 				if (err != OK) {
 					*r_ret = RTR("Cannot resize array.");
 					r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
 					return;
 				}
-				for (int i = from; i < to; i++) {
-					arr[i - from] = i;
+				for (uint64_t i = 0; i < count; i++) {
+					arr[i] = int64_t(uint64_t(from) + i);
 				}
 				*r_ret = arr;
 			} break;
@@ -172,9 +175,9 @@ struct GDScriptUtilityFunctionsDefinitions {
 				VALIDATE_ARG_NUM(1);
 				VALIDATE_ARG_NUM(2);
 
-				int from = *p_args[0];
-				int to = *p_args[1];
-				int incr = *p_args[2];
+				int64_t from = *p_args[0];
+				int64_t to = *p_args[1];
+				int64_t incr = *p_args[2];
 				if (incr == 0) {
 					*r_ret = RTR("Step argument is zero!");
 					r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
@@ -191,15 +194,12 @@ struct GDScriptUtilityFunctionsDefinitions {
 					return;
 				}
 
-				// Calculate how many.
-				int count = 0;
-				if (incr > 0) {
-					count = Math::division_round_up(to - from, incr);
-				} else {
-					count = Math::division_round_up(from - to, -incr);
-				}
+				// Calculate how many. The span and step are computed unsigned, as they can exceed the range of int64_t.
+				const uint64_t span = incr > 0 ? uint64_t(to) - uint64_t(from) : uint64_t(from) - uint64_t(to);
+				const uint64_t step = incr > 0 ? uint64_t(incr) : 0 - uint64_t(incr);
+				const uint64_t count = span / step + (span % step != 0 ? 1 : 0);
 
-				Error err = arr.resize(count);
+				Error err = count > INT32_MAX ? ERR_OUT_OF_MEMORY : arr.resize(count);
 
 				if (err != OK) {
 					*r_ret = RTR("Cannot resize array.");
@@ -207,16 +207,9 @@ struct GDScriptUtilityFunctionsDefinitions {
 					return;
 				}
 
-				if (incr > 0) {
-					int idx = 0;
-					for (int i = from; i < to; i += incr) {
-						arr[idx++] = i;
-					}
-				} else {
-					int idx = 0;
-					for (int i = from; i > to; i += incr) {
-						arr[idx++] = i;
-					}
+				// Stepping by index, so the last increment can't overflow.
+				for (uint64_t i = 0; i < count; i++) {
+					arr[i] = int64_t(uint64_t(from) + i * uint64_t(incr));
 				}
 
 				*r_ret = arr;
@@ -115,6 +115,27 @@ void GDScriptFunction::_profile_native_call(uint64_t p_t_taken, const String &p_
 
 #endif // DEBUG_ENABLED
 
+// Used by the fused compare and jump opcodes, the compiler only emits them for comparison operators.
+template <typename T>
+static _FORCE_INLINE_ bool _compare_values(Variant::Operator p_operator, T p_a, T p_b) {
+	switch (p_operator) {
+		case Variant::OP_EQUAL:
+			return p_a == p_b;
+		case Variant::OP_NOT_EQUAL:
+			return p_a != p_b;
+		case Variant::OP_LESS:
+			return p_a < p_b;
+		case Variant::OP_LESS_EQUAL:
+			return p_a <= p_b;
+		case Variant::OP_GREATER:
+			return p_a > p_b;
+		case Variant::OP_GREATER_EQUAL:
+			return p_a >= p_b;
+		default:
+			return false;
+	}
+}
+
 Variant GDScriptFunction::_get_default_variant_for_data_type(const GDScriptDataType &p_data_type) {
 	if (p_data_type.kind == GDScriptDataType::BUILTIN) {
 		if (p_data_type.builtin_type == Variant::ARRAY) {
@@ -243,6 +264,10 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_KEYED,                              \
 		&&OPCODE_GET_KEYED_VALIDATED,                    \
 		&&OPCODE_GET_INDEXED_VALIDATED,                  \
+		&&OPCODE_GET_INDEXED_PACKED_INT32_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_INT64_ARRAY,         \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT32_ARRAY,       \
+		&&OPCODE_GET_INDEXED_PACKED_FLOAT64_ARRAY,       \
 		&&OPCODE_SET_NAMED,                              \
 		&&OPCODE_SET_NAMED_VALIDATED,                    \
 		&&OPCODE_GET_NAMED,                              \
@@ -292,6 +317,9 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                                   \
 		&&OPCODE_JUMP_IF,                                \
 		&&OPCODE_JUMP_IF_NOT,                            \
+		&&OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED,         \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_INT,                \
+		&&OPCODE_JUMP_IF_NOT_COMPARE_FLOAT,              \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
 		&&OPCODE_JUMP_IF_SHARED,                         \
 		&&OPCODE_RETURN,                                 \
@@ -1161,6 +1189,41 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#ifdef DEBUG_ENABLED
+#define OPCODE_GET_INDEXED_OOB_ERROR                                                                        \
+	err_text = "Out of bounds get index '" + itos(int_index) + "' (on base: '" + _get_var_type(src) + "')"; \
+	OPCODE_BREAK;
+#else
+#define OPCODE_GET_INDEXED_OOB_ERROR
+#endif
+
+#define OPCODE_GET_INDEXED_PACKED_ARRAY(m_var_type, m_get_func, m_ret_type, m_ret_get_func) \
+	OPCODE(OPCODE_GET_INDEXED_PACKED_##m_var_type##_ARRAY) {                                \
+		CHECK_SPACE(4);                                                                     \
+		GET_VARIANT_PTR(src, 0);                                                            \
+		GET_VARIANT_PTR(index, 1);                                                          \
+		GET_VARIANT_PTR(dst, 2);                                                            \
+		const auto *array = VariantInternal::m_get_func((const Variant *)src);              \
+		const int64_t size = array->size();                                                 \
+		int64_t int_index = *VariantInternal::get_int(index);                               \
+		if (int_index < 0) {                                                                \
+			int_index += size;                                                              \
+		}                                                                                   \
+		if (likely(int_index >= 0 && int_index < size)) {                                   \
+			VariantTypeChanger<m_ret_type>::change(dst);                                    \
+			*VariantInternal::m_ret_get_func(dst) = array->ptr()[int_index];                \
+		} else {                                                                            \
+			OPCODE_GET_INDEXED_OOB_ERROR                                                    \
+		}                                                                                   \
+		ip += 4;                                                                            \
+	}                                                                                       \
+	DISPATCH_OPCODE
+
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT32, get_int32_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(INT64, get_int64_array, int64_t, get_int);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT32, get_float32_array, double, get_float);
+			OPCODE_GET_INDEXED_PACKED_ARRAY(FLOAT64, get_float64_array, double, get_float);
+
 			OPCODE(OPCODE_SET_NAMED) {
 				CHECK_SPACE(3);
 
@@ -2700,6 +2763,70 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_NOT_OPERATOR_VALIDATED) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// Only emitted for operators returning a bool.
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_IF_NOT_COMPARE_INT) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				bool result = _compare_values(Variant::Operator(_code_ptr[ip + 4]), *VariantInternal::get_int(a), *VariantInternal::get_int(b));
+				*VariantInternal::get_bool(dst) = result;
+
+				if (!result) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_IF_NOT_COMPARE_FLOAT) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				bool result = _compare_values(Variant::Operator(_code_ptr[ip + 4]), *VariantInternal::get_float(a), *VariantInternal::get_float(b));
+				*VariantInternal::get_bool(dst) = result;
+
+				if (!result) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
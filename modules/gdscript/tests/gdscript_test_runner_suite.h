@@ -33,7 +33,15 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -70,6 +78,114 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE("[Modules][GDScript] Restore a compiled script from serialized bytecode") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+const FACTORS = [2, 3, 5]
+
+class Inner:
+	var value := 7
+
+func _init():
+	var total := 1
+	for factor in FACTORS:
+		total *= factor
+	var add_one := func(x): return x + 1
+	set_meta("result", total * 2 + add_one.call(10))
+	set_meta("inner", Inner.new().value)
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Vector<uint8_t> buffer;
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::serialize(gdscript.ptr(), buffer) == OK, "The compiled script should be serialized successfully.");
+	CHECK_FALSE(buffer.is_empty());
+
+	Ref<GDScript> restored = memnew(GDScript);
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::deserialize(restored.ptr(), buffer.ptr(), buffer.size()) == OK, "The serialized script should be restored successfully.");
+	CHECK(restored->is_valid());
+	CHECK(restored->get_instance_base_type() == SNAME("RefCounted"));
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(restored);
+	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 71, "The restored script should run its constants and lambdas.");
+	CHECK_MESSAGE(int(ref_counted->get_meta("inner")) == 7, "The restored script should instantiate its inner classes.");
+}
+
+static void write_script_file(const String &p_path, const String &p_source) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_source);
+}
+
+static Ref<GDScript> create_script_at(const String &p_path, const String &p_source) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	gdscript->set_path(p_path, true);
+	return gdscript;
+}
+
+TEST_CASE("[Modules][GDScript] Reject stale bytecode cache entries") {
+	const String dir = TestUtils::get_temp_path("gdscript_bytecode_cache");
+	DirAccess::make_dir_recursive_absolute(dir);
+	const String cache_dir = dir.path_join("cache");
+	const Variant old_cache_dir = GLOBAL_GET("gdscript/bytecode_cache/path");
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/path", cache_dir);
+
+	const String dependency_path = dir.path_join("dependency.gd");
+	write_script_file(dependency_path, "extends RefCounted\nconst VALUE = 1\n");
+	GDScriptCache::remove_script(dependency_path);
+
+	const String script_path = dir.path_join("script.gd");
+	const String source = "extends RefCounted\nconst Dependency = preload(\"dependency.gd\")\nfunc get_value():\n\treturn Dependency.VALUE\n";
+	{
+		Ref<GDScript> compiled = create_script_at(script_path, source);
+		REQUIRE_MESSAGE(compiled->reload() == OK, "The script should compile successfully.");
+		GDScriptCache::save_bytecode(compiled.ptr());
+	}
+	const String cache_path = cache_dir.path_join(script_path.md5_text() + ".gdbc");
+	REQUIRE_MESSAGE(FileAccess::exists(cache_path), "The compiled script should be written to the bytecode cache.");
+	// Entries are renamed into place, no temporary file is left behind.
+	CHECK(DirAccess::get_files_at(cache_dir).size() == 1);
+
+	SUBCASE("Unchanged scripts are restored from the cache") {
+		Ref<GDScript> restored = create_script_at(script_path, source);
+		CHECK(GDScriptCache::load_bytecode(restored.ptr()) == OK);
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(restored);
+		CHECK(int(ref_counted->call("get_value")) == 1);
+	}
+
+	SUBCASE("A changed script source rejects the cache entry") {
+		const String changed_source = source + "func get_other_value():\n\treturn 2\n";
+		Ref<GDScript> changed = create_script_at(script_path, changed_source);
+		CHECK(GDScriptCache::load_bytecode(changed.ptr()) == ERR_FILE_UNRECOGNIZED);
+		REQUIRE_MESSAGE(changed->reload() == OK, "The changed script should be compiled again.");
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(changed);
+		CHECK(int(ref_counted->call("get_other_value")) == 2);
+	}
+
+	SUBCASE("A changed dependency rejects the cache entry") {
+		write_script_file(dependency_path, "extends RefCounted\nconst VALUE = 1\nconst OTHER_VALUE = 2\n");
+		GDScriptCache::remove_script(dependency_path); // Drops the cached content hash.
+		Ref<GDScript> restored = create_script_at(script_path, source);
+		CHECK(GDScriptCache::load_bytecode(restored.ptr()) == ERR_FILE_UNRECOGNIZED);
+		CHECK_MESSAGE(restored->reload() == OK, "The script should be compiled again against the changed dependency.");
+	}
+
+	GDScriptCache::remove_script(script_path);
+	GDScriptCache::remove_script(dependency_path);
+	DirAccess::remove_absolute(cache_path);
+	DirAccess::remove_absolute(cache_dir);
+	DirAccess::remove_absolute(dependency_path);
+	ProjectSettings::get_singleton()->set_setting("gdscript/bytecode_cache/path", old_cache_dir);
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
@@ -0,0 +1,4 @@
+func test():
+	var from := 0
+	var to := 1 << 32
+	print(range(from, to).size()) # A span of 2^32 elements would wrap around to an empty array.
@@ -0,0 +1,23 @@
+# `range()` bounds outside the 32-bit range must not be truncated in for loops.
+
+func print_range(from: int, to: int):
+	for i in range(from, to):
+		print(i)
+
+func count_to(to: int):
+	for i in range(0, to):
+		print(i)
+
+func test():
+	print_range(3000000000, 3000000002)
+	print_range(-3000000002, -3000000000)
+	print_range(1 << 40, (1 << 40) - 1)
+	count_to(2)
+
+	for i in range(1 << 33, (1 << 33) + 2):
+		print(i)
+	for i in range(-5000000000, -4999999999):
+		print(i)
+	var big := 1 << 32
+	for i in range(big, big + 1):
+		print(i)
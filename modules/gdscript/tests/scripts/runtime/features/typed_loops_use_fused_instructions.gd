@@ -0,0 +1,66 @@
+# Typed comparisons used as conditions, `range()` with int arguments and
+# indexing numeric packed arrays are compiled to specialized instructions.
+
+func sum_range(from: int, to: int) -> int:
+	var total := 0
+	for i in range(from, to):
+		total += i
+	return total
+
+func test():
+	var n := 5
+	var total := 0
+	for k in range(n):
+		total += k
+	print(total)
+	print(sum_range(2, 6))
+	print(sum_range(6, 2))
+	print(sum_range(-3, 0))
+
+	var i := 0
+	while i < 4:
+		i += 1
+	print(i)
+	while i >= 2:
+		i -= 1
+	print(i)
+
+	var a := 3
+	var b := 3
+	print("==" if a == b else "!=")
+	if a != b:
+		print("wrong")
+	if a <= b and a >= b:
+		print("equal bounds")
+
+	var x := 0.5
+	var y := 1.5
+	if x < y:
+		print("float less")
+	if x > y or y <= x:
+		print("wrong")
+	# Mixed int and float comparison.
+	if a > x:
+		print("mixed greater")
+	var nan := NAN
+	if nan == nan:
+		print("wrong")
+	if nan != nan:
+		print("nan not equal")
+
+	var ints := PackedInt32Array([1, 2, 3])
+	var wide := PackedInt64Array([1 << 40, -7])
+	var floats := PackedFloat32Array([0.5, 0.25])
+	var doubles := PackedFloat64Array([1.0 / 3.0])
+	print(ints[0] + ints[2])
+	print(ints[-1])
+	print(wide[0], " ", wide[1])
+	print(floats[1])
+	print(is_equal_approx(doubles[0], 1.0 / 3.0))
+
+	var untyped = floats[0]
+	print(typeof(untyped) == TYPE_FLOAT)
+	var weighted := 0.0
+	for j in range(ints.size()):
+		weighted += ints[j] * floats[0]
+	print(weighted == 3.0)
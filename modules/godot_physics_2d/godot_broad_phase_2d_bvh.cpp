@@ -120,4 +120,6 @@ GodotBroadPhase2D *GodotBroadPhase2DBVH::_create() {
 GodotBroadPhase2DBVH::GodotBroadPhase2DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	// Pair callbacks are still sent in a deterministic order, only the tree queries run in parallel.
+	bvh.params_set_parallel_pairing(true);
 }
@@ -1329,6 +1329,7 @@ void GodotPhysicsServer2D::flush_queries() {
 		uint64_t total_time[GodotSpace2D::ELAPSED_TIME_MAX];
 		static const char *time_name[GodotSpace2D::ELAPSED_TIME_MAX] = {
 			"integrate_forces",
+			"broadphase",
 			"generate_islands",
 			"setup_constraints",
 			"solve_constraints",
@@ -474,6 +474,13 @@ bool GodotBody3D::is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const {
 }
 
 void GodotBody3D::integrate_forces(real_t p_step) {
+	integrate_forces_local(p_step);
+	integrate_forces_commit();
+}
+
+void GodotBody3D::integrate_forces_local(real_t p_step) {
+	pending_motion_update = false;
+
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
@@ -664,23 +671,35 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		pending_motion = motion;
+		pending_motion_update = true;
 	}
 
 	contact_count = 0;
 }
 
+void GodotBody3D::integrate_forces_commit() {
+	if (pending_motion_update) {
+		_update_shapes_with_motion(pending_motion);
+		pending_motion_update = false;
+	}
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
+	integrate_velocities_local(p_step);
+	integrate_velocities_commit();
+}
+
+void GodotBody3D::integrate_velocities_local(real_t p_step) {
+	pending_shapes_update = false;
+	pending_deactivation = false;
+
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
 	}
 
 	ERR_FAIL_NULL(get_space());
 
-	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
-	}
-
 	//apply axis lock linear
 	for (int i = 0; i < 3; i++) {
 		if (is_axis_locked((PhysicsServer3D::BodyAxis)(1 << i))) {
@@ -701,7 +720,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.size() == 0 && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			pending_deactivation = true; //stopped moving, deactivate
 		}
 
 		return;
@@ -730,12 +749,33 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	pending_shapes_update = true;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::integrate_velocities_commit() {
+	if (mode == PhysicsServer3D::BODY_MODE_STATIC || !get_space()) {
+		return;
+	}
+
+	if (fi_callback_data || body_state_callback.is_valid()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (pending_shapes_update) {
+		_update_shapes();
+		pending_shapes_update = false;
+	}
+
+	if (pending_deactivation) {
+		set_active(false);
+		pending_deactivation = false;
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -146,6 +146,12 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	// Deferred work from the `_local` integration steps.
+	Vector3 pending_motion;
+	bool pending_motion_update = false;
+	bool pending_shapes_update = false;
+	bool pending_deactivation = false;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
@@ -319,6 +325,14 @@ public:
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
 
+	// Split versions of the above, used by the parallel integration mode.
+	// The `_local` part only touches this body's own state and can run on any thread,
+	// the `_commit` part applies deferred broadphase and space list updates on the physics thread.
+	void integrate_forces_local(real_t p_step);
+	void integrate_forces_commit();
+	void integrate_velocities_local(real_t p_step);
+	void integrate_velocities_commit();
+
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
 	}
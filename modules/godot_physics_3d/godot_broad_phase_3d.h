@@ -44,6 +44,10 @@ public:
 
 	typedef uint32_t ID;
 
+	enum {
+		SEGMENT_PACKET_MAX = 32
+	};
+
 	typedef void *(*PairCallback)(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_userdata);
 	typedef void (*UnpairCallback)(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_userdata);
 
@@ -60,6 +64,13 @@ public:
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) = 0;
+	// Culls a packet of up to SEGMENT_PACKET_MAX segments at once, returns -1 if p_max_results is reached.
+	// The caller must hold lock_queries(), so several threads can cull packets without contending for the lock.
+	virtual int cull_segment_packet(const Vector3 *p_from, const Vector3 *p_to, uint32_t p_count, GodotCollisionObject3D **p_results, uint32_t *r_segment_indices, int p_max_results, int *p_result_indices = nullptr) = 0;
+
+	// Keeps the broadphase from being modified while packets are culled.
+	virtual void lock_queries() = 0;
+	virtual void unlock_queries() = 0;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) = 0;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) = 0;
@@ -32,6 +32,8 @@
 
 #include "godot_collision_object_3d.h"
 
+static_assert(GodotBroadPhase3D::SEGMENT_PACKET_MAX <= BVHCommon::PACKET_SIZE_MAX);
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -86,6 +88,18 @@ int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D *
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+int GodotBroadPhase3DBVH::cull_segment_packet(const Vector3 *p_from, const Vector3 *p_to, uint32_t p_count, GodotCollisionObject3D **p_results, uint32_t *r_segment_indices, int p_max_results, int *p_result_indices) {
+	return bvh.cull_segment_packet_unlocked(p_from, p_to, p_count, p_results, r_segment_indices, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
+void GodotBroadPhase3DBVH::lock_queries() {
+	bvh.lock();
+}
+
+void GodotBroadPhase3DBVH::unlock_queries() {
+	bvh.unlock();
+}
+
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
 	GodotBroadPhase3DBVH *bpo = static_cast<GodotBroadPhase3DBVH *>(self);
 	if (!bpo->pair_callback) {
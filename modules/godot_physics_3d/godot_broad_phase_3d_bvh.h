@@ -87,6 +87,10 @@ public:
 	virtual int cull_point(const Vector3 &p_point, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_segment(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
 	virtual int cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices = nullptr) override;
+	virtual int cull_segment_packet(const Vector3 *p_from, const Vector3 *p_to, uint32_t p_count, GodotCollisionObject3D **p_results, uint32_t *r_segment_indices, int p_max_results, int *p_result_indices = nullptr) override;
+
+	virtual void lock_queries() override;
+	virtual void unlock_queries() override;
 
 	virtual void set_pair_callback(PairCallback p_pair_callback, void *p_userdata) override;
 	virtual void set_unpair_callback(UnpairCallback p_unpair_callback, void *p_userdata) override;
@@ -33,7 +33,8 @@
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
-#include "core/templates/sort_array.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 
 // GodotHeightMapShape3D is based on Bullet btHeightfieldTerrainShape.
 
@@ -1345,40 +1346,82 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
+// Narrows [r_t_min, r_t_max] to the part of the segment inside the slab of one axis.
+static _FORCE_INLINE_ void _concave_bvh_clip_segment(real_t p_min, real_t p_max, real_t p_from, real_t p_rel, real_t p_inv_rel, real_t &r_t_min, real_t &r_t_max) {
+	if (p_rel == 0) {
+		if (p_from < p_min || p_from > p_max) {
+			r_t_max = -1;
+		}
+		return;
+	}
+
+	real_t t_near = ((p_rel > 0 ? p_min : p_max) - p_from) * p_inv_rel;
+	real_t t_far = ((p_rel > 0 ? p_max : p_min) - p_from) * p_inv_rel;
+	r_t_min = MAX(r_t_min, t_near);
+	r_t_max = MIN(r_t_max, t_far);
+}
+
 void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
 	const BVH *params_bvh = &p_params->bvh[p_idx];
 
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
+	// Find where the segment enters each child, then visit them nearest first
+	// so the closest hit found so far can skip the children behind it.
+	real_t t_enter[BVH_WIDTH];
+	int order[BVH_WIDTH];
+	int order_count = 0;
+
+	for (int i = 0; i < BVH_WIDTH; i++) {
+		real_t t_min = 0;
+		real_t t_max = p_params->t_max;
+		_concave_bvh_clip_segment(params_bvh->min_x[i], params_bvh->max_x[i], p_params->from.x, p_params->rel.x, p_params->inv_rel.x, t_min, t_max);
+		_concave_bvh_clip_segment(params_bvh->min_y[i], params_bvh->max_y[i], p_params->from.y, p_params->rel.y, p_params->inv_rel.y, t_min, t_max);
+		_concave_bvh_clip_segment(params_bvh->min_z[i], params_bvh->max_z[i], p_params->from.z, p_params->rel.z, p_params->inv_rel.z, t_min, t_max);
+		t_enter[i] = t_min;
+
+		if (t_min <= t_max) {
+			int j = order_count++;
+			while (j > 0 && t_enter[order[j - 1]] > t_min) {
+				order[j] = order[j - 1];
+				j--;
+			}
+			order[j] = i;
+		}
 	}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		int face_index = params_bvh->face_index;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->face_index = face_index;
-				p_params->collisions++;
-			}
+	for (int n = 0; n < order_count; n++) {
+		int i = order[n];
+		if (t_enter[i] > p_params->t_max) {
+			break;
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
+
+		if (params_bvh->face_count[i] == 0) {
+			_cull_segment(params_bvh->child[i], p_params);
+			continue;
 		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
+
+		for (int k = 0; k < params_bvh->face_count[i]; k++) {
+			int face_index = p_params->bvh_faces[params_bvh->child[i] + k];
+			const Face *f = &p_params->faces[face_index];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+
+			Vector3 res;
+			Vector3 normal;
+			if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
+				real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
+				if ((d > 0) && (d < p_params->min_d)) {
+					p_params->min_d = d;
+					p_params->result = res;
+					p_params->normal = normal;
+					p_params->face_index = face_index;
+					p_params->collisions++;
+					// Small margin so rounding doesn't skip a child touching the hit.
+					p_params->t_max = MIN(p_params->t_max, d / p_params->length + CMP_EPSILON);
+				}
+			}
 		}
 	}
 }
@@ -1399,11 +1442,17 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	_SegmentCullParams params;
 	params.from = p_begin;
 	params.to = p_end;
-	params.dir = (p_end - p_begin).normalized();
+	params.rel = p_end - p_begin;
+	params.length = params.rel.length();
+	params.dir = params.rel.normalized();
+	for (int i = 0; i < 3; i++) {
+		params.inv_rel[i] = params.rel[i] != 0 ? 1 / params.rel[i] : 0;
+	}
 
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_faces = bvh_faces.ptr();
 
 	params.face = &face;
 
@@ -1431,29 +1480,47 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
 	const BVH *params_bvh = &p_params->bvh[p_idx];
 
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
+	const Vector3 &aabb_min = p_params->aabb.position;
+	const Vector3 aabb_max = p_params->aabb.position + p_params->aabb.size;
+
+	// Test all children at once, this loop has no branches so it can be vectorized.
+	uint32_t hit_mask = 0;
+	for (int i = 0; i < BVH_WIDTH; i++) {
+		bool overlap = (params_bvh->min_x[i] < aabb_max.x) & (params_bvh->max_x[i] > aabb_min.x) &
+				(params_bvh->min_y[i] < aabb_max.y) & (params_bvh->max_y[i] > aabb_min.y) &
+				(params_bvh->min_z[i] < aabb_max.z) & (params_bvh->max_z[i] > aabb_min.z);
+		hit_mask |= uint32_t(overlap) << i;
 	}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
+	for (int i = 0; i < BVH_WIDTH; i++) {
+		if (!(hit_mask & (1 << i))) {
+			continue;
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
+
+		if (params_bvh->face_count[i] == 0) {
+			if (_cull(params_bvh->child[i], p_params)) {
 				return true;
 			}
+			continue;
 		}
 
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
+		for (int k = 0; k < params_bvh->face_count[i]; k++) {
+			const Face *f = &p_params->faces[p_params->bvh_faces[params_bvh->child[i] + k]];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+
+			// Leaves hold several faces, only send those overlapping the query.
+			AABB face_aabb(face->vertex[0], Vector3());
+			face_aabb.expand_to(face->vertex[1]);
+			face_aabb.expand_to(face->vertex[2]);
+			if (!p_params->aabb.intersects(face_aabb)) {
+				continue;
+			}
+
+			if (p_params->callback(p_params->userdata, face)) {
 				return true;
 			}
 		}
@@ -1485,6 +1552,7 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_faces = bvh_faces.ptr();
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
@@ -1502,111 +1570,259 @@ Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
 			(p_mass / 3.0) * (extents.x * extents.x + extents.y * extents.y));
 }
 
-struct _Volume_BVH_Element {
+// The BVH is built top-down, splitting faces with the surface area heuristic
+// evaluated on a fixed amount of bins per axis. On large meshes the top of the
+// tree is built first and the subtrees below it are then built in parallel.
+
+#define CONCAVE_BVH_BINS 16
+#define CONCAVE_BVH_PARALLEL_FACES_MIN 16384
+
+struct _ConcaveBVHElement {
 	AABB aabb;
 	Vector3 center;
 	int face_index = 0;
 };
 
-struct _Volume_BVH_CompareX {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.x < b.center.x;
-	}
+struct _ConcaveBVHSubtree {
+	int from = 0;
+	int to = 0;
+	// Slot of the parent node pointing to this subtree.
+	int parent = 0;
+	int parent_slot = 0;
+	LocalVector<GodotConcavePolygonShape3D::BVH> nodes;
 };
 
-struct _Volume_BVH_CompareY {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.y < b.center.y;
-	}
+struct _ConcaveBVHBuild {
+	_ConcaveBVHElement *elements = nullptr;
+	// Ranges with at most this amount of faces are left to the subtree tasks.
+	int subtree_faces_max = 0;
+	LocalVector<_ConcaveBVHSubtree> subtrees;
 };
 
-struct _Volume_BVH_CompareZ {
-	_FORCE_INLINE_ bool operator()(const _Volume_BVH_Element &a, const _Volume_BVH_Element &b) const {
-		return a.center.z < b.center.z;
+static _FORCE_INLINE_ real_t _concave_bvh_half_area(const AABB &p_aabb) {
+	const Vector3 &size = p_aabb.size;
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+// Reorders the elements in [p_from, p_to) into two groups and returns where the second one starts.
+static int _concave_bvh_split(_ConcaveBVHElement *p_elements, int p_from, int p_to) {
+	AABB center_bounds(p_elements[p_from].center, Vector3());
+	for (int i = p_from + 1; i < p_to; i++) {
+		center_bounds.expand_to(p_elements[i].center);
 	}
-};
 
-struct _Volume_BVH {
-	AABB aabb;
-	_Volume_BVH *left = nullptr;
-	_Volume_BVH *right = nullptr;
+	real_t best_cost = 0;
+	int best_axis = -1;
+	int best_bin = 0;
 
-	int face_index = 0;
-};
+	for (int axis = 0; axis < 3; axis++) {
+		real_t extent = center_bounds.size[axis];
+		if (extent <= 0) {
+			continue;
+		}
 
-_Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int &count) {
-	_Volume_BVH *bvh = memnew(_Volume_BVH);
-
-	if (p_size == 1) {
-		//leaf
-		bvh->aabb = p_elements[0].aabb;
-		bvh->left = nullptr;
-		bvh->right = nullptr;
-		bvh->face_index = p_elements->face_index;
-		count++;
-		return bvh;
-	} else {
-		bvh->face_index = -1;
+		AABB bin_bounds[CONCAVE_BVH_BINS];
+		int bin_counts[CONCAVE_BVH_BINS] = {};
+		real_t scale = CONCAVE_BVH_BINS / extent;
+
+		for (int i = p_from; i < p_to; i++) {
+			int bin = MIN(int((p_elements[i].center[axis] - center_bounds.position[axis]) * scale), CONCAVE_BVH_BINS - 1);
+			if (bin_counts[bin] == 0) {
+				bin_bounds[bin] = p_elements[i].aabb;
+			} else {
+				bin_bounds[bin].merge_with(p_elements[i].aabb);
+			}
+			bin_counts[bin]++;
+		}
+
+		// Area and count of everything right of each split, then sweep from the left.
+		real_t right_costs[CONCAVE_BVH_BINS];
+		AABB bounds;
+		int count = 0;
+		for (int bin = CONCAVE_BVH_BINS - 1; bin > 0; bin--) {
+			if (bin_counts[bin]) {
+				bounds = count ? bounds.merge(bin_bounds[bin]) : bin_bounds[bin];
+				count += bin_counts[bin];
+			}
+			right_costs[bin] = count ? _concave_bvh_half_area(bounds) * count : 0;
+		}
+
+		count = 0;
+		for (int bin = 0; bin < CONCAVE_BVH_BINS - 1; bin++) {
+			if (bin_counts[bin]) {
+				bounds = count ? bounds.merge(bin_bounds[bin]) : bin_bounds[bin];
+				count += bin_counts[bin];
+			}
+			if (count == 0 || count == p_to - p_from) {
+				continue;
+			}
+
+			real_t cost = _concave_bvh_half_area(bounds) * count + right_costs[bin + 1];
+			if (best_axis == -1 || cost < best_cost) {
+				best_cost = cost;
+				best_axis = axis;
+				best_bin = bin;
+			}
+		}
 	}
 
-	AABB aabb;
-	for (int i = 0; i < p_size; i++) {
-		if (i == 0) {
-			aabb = p_elements[i].aabb;
+	if (best_axis == -1) {
+		// All centers are in the same spot, any split is as good.
+		return (p_from + p_to) / 2;
+	}
+
+	real_t scale = CONCAVE_BVH_BINS / center_bounds.size[best_axis];
+	int left = p_from;
+	int right = p_to - 1;
+	while (left <= right) {
+		int bin = MIN(int((p_elements[left].center[best_axis] - center_bounds.position[best_axis]) * scale), CONCAVE_BVH_BINS - 1);
+		if (bin <= best_bin) {
+			left++;
 		} else {
-			aabb.merge_with(p_elements[i].aabb);
+			SWAP(p_elements[left], p_elements[right]);
+			right--;
 		}
 	}
-	bvh->aabb = aabb;
-	switch (aabb.get_longest_axis_index()) {
-		case 0: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareX> sort_x;
-			sort_x.sort(p_elements, p_size);
 
-		} break;
-		case 1: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareY> sort_y;
-			sort_y.sort(p_elements, p_size);
-		} break;
-		case 2: {
-			SortArray<_Volume_BVH_Element, _Volume_BVH_CompareZ> sort_z;
-			sort_z.sort(p_elements, p_size);
-		} break;
+	return left;
+}
+
+// Builds a node for the elements in [p_from, p_to) and its children, returning its index in r_nodes.
+static int _concave_bvh_build_node(_ConcaveBVHElement *p_elements, int p_from, int p_to, LocalVector<GodotConcavePolygonShape3D::BVH> &r_nodes, _ConcaveBVHBuild *p_build) {
+	typedef GodotConcavePolygonShape3D Shape;
+
+	// Split the largest range until there's one per child.
+	int range_from[Shape::BVH_WIDTH] = { p_from };
+	int range_to[Shape::BVH_WIDTH] = { p_to };
+	int range_count = 1;
+
+	while (range_count < Shape::BVH_WIDTH) {
+		int largest = -1;
+		for (int i = 0; i < range_count; i++) {
+			int size = range_to[i] - range_from[i];
+			if (size > Shape::BVH_LEAF_FACES_MAX && (largest == -1 || size > range_to[largest] - range_from[largest])) {
+				largest = i;
+			}
+		}
+		if (largest == -1) {
+			break;
+		}
+
+		int split = _concave_bvh_split(p_elements, range_from[largest], range_to[largest]);
+		for (int i = range_count; i > largest + 1; i--) {
+			range_from[i] = range_from[i - 1];
+			range_to[i] = range_to[i - 1];
+		}
+		range_from[largest + 1] = split;
+		range_to[largest + 1] = range_to[largest];
+		range_to[largest] = split;
+		range_count++;
 	}
 
-	int split = p_size / 2;
-	bvh->left = _volume_build_bvh(p_elements, split, count);
-	bvh->right = _volume_build_bvh(&p_elements[split], p_size - split, count);
+	int node_index = r_nodes.size();
+	r_nodes.push_back(Shape::BVH());
 
-	//printf("branch at %p - %i: %i\n",bvh,count,bvh->face_index);
-	count++;
-	return bvh;
-}
+	for (int i = 0; i < Shape::BVH_WIDTH; i++) {
+		Shape::BVH &node = r_nodes[node_index];
 
-void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
+		if (i >= range_count) {
+			// Unused child, inverted bounds so no query can hit it.
+			node.min_x[i] = node.min_y[i] = node.min_z[i] = FLT_MAX;
+			node.max_x[i] = node.max_y[i] = node.max_z[i] = -FLT_MAX;
+			node.child[i] = -1;
+			node.face_count[i] = 0;
+			continue;
+		}
+
+		AABB aabb = p_elements[range_from[i]].aabb;
+		for (int j = range_from[i] + 1; j < range_to[i]; j++) {
+			aabb.merge_with(p_elements[j].aabb);
+		}
+		const Vector3 aabb_end = aabb.get_end();
+		node.min_x[i] = aabb.position.x;
+		node.min_y[i] = aabb.position.y;
+		node.min_z[i] = aabb.position.z;
+		node.max_x[i] = aabb_end.x;
+		node.max_y[i] = aabb_end.y;
+		node.max_z[i] = aabb_end.z;
+
+		int size = range_to[i] - range_from[i];
+		if (size <= Shape::BVH_LEAF_FACES_MAX) {
+			node.child[i] = range_from[i];
+			node.face_count[i] = size;
+		} else if (p_build && size <= p_build->subtree_faces_max) {
+			node.child[i] = -1;
+			node.face_count[i] = 0;
+
+			_ConcaveBVHSubtree subtree;
+			subtree.from = range_from[i];
+			subtree.to = range_to[i];
+			subtree.parent = node_index;
+			subtree.parent_slot = i;
+			p_build->subtrees.push_back(subtree);
+		} else {
+			node.face_count[i] = 0;
+			// r_nodes may grow, so don't keep the node reference across the call.
+			int child = _concave_bvh_build_node(p_elements, range_from[i], range_to[i], r_nodes, p_build);
+			r_nodes[node_index].child[i] = child;
+		}
+	}
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+	return node_index;
+}
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+static void _concave_bvh_build_subtree(void *p_userdata, uint32_t p_index) {
+	_ConcaveBVHBuild *build = static_cast<_ConcaveBVHBuild *>(p_userdata);
+	_ConcaveBVHSubtree &subtree = build->subtrees[p_index];
+	_concave_bvh_build_node(build->elements, subtree.from, subtree.to, subtree.nodes, nullptr);
+}
 
-	} else {
-		p_bvh_array[p_idx].left = -1;
+void GodotConcavePolygonShape3D::_build_bvh(const AABB *p_face_aabbs, int p_face_count) {
+	LocalVector<_ConcaveBVHElement> elements;
+	elements.resize(p_face_count);
+	for (int i = 0; i < p_face_count; i++) {
+		elements[i].aabb = p_face_aabbs[i];
+		elements[i].center = p_face_aabbs[i].get_center();
+		elements[i].face_index = i;
 	}
 
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
-		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
+	_ConcaveBVHBuild build;
+	build.elements = elements.ptr();
 
-	} else {
-		p_bvh_array[p_idx].right = -1;
+	bool parallel = p_face_count >= CONCAVE_BVH_PARALLEL_FACES_MIN && WorkerThreadPool::get_singleton()->get_thread_index() == -1;
+	// Enough subtrees to keep all threads busy even if they are unbalanced.
+	build.subtree_faces_max = parallel ? MAX(p_face_count / (OS::get_singleton()->get_processor_count() * 8), CONCAVE_BVH_PARALLEL_FACES_MIN / 4) : 0;
+
+	LocalVector<BVH> nodes;
+	_concave_bvh_build_node(elements.ptr(), 0, p_face_count, nodes, parallel ? &build : nullptr);
+
+	if (build.subtrees.size()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_concave_bvh_build_subtree, &build, build.subtrees.size(), -1, true, SNAME("GodotConcavePolygonShape3DBuildBVH"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Append the subtrees in order, so the result doesn't depend on the threads.
+		for (_ConcaveBVHSubtree &subtree : build.subtrees) {
+			int offset = nodes.size();
+			nodes[subtree.parent].child[subtree.parent_slot] = offset;
+			for (BVH &node : subtree.nodes) {
+				for (int i = 0; i < BVH_WIDTH; i++) {
+					if (node.face_count[i] == 0 && node.child[i] >= 0) {
+						node.child[i] += offset;
+					}
+				}
+				nodes.push_back(node);
+			}
+		}
 	}
 
-	memdelete(p_bvh_tree);
+	bvh.resize(nodes.size());
+	memcpy(bvh.ptrw(), nodes.ptr(), sizeof(BVH) * nodes.size());
+
+	bvh_faces.resize(p_face_count);
+	int *bvh_facesw = bvh_faces.ptrw();
+	for (int i = 0; i < p_face_count; i++) {
+		bvh_facesw[i] = elements[i].face_index;
+	}
 }
 
 void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_backface_collision) {
@@ -1620,10 +1836,8 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 
 	const Vector3 *facesr = p_faces.ptr();
 
-	Vector<_Volume_BVH_Element> bvh_array;
-	bvh_array.resize(src_face_count);
-
-	_Volume_BVH_Element *bvh_arrayw = bvh_array.ptrw();
+	LocalVector<AABB> face_aabbs;
+	face_aabbs.resize(src_face_count);
 
 	faces.resize(src_face_count);
 	Face *facesw = faces.ptrw();
@@ -1637,9 +1851,7 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 	for (int i = 0; i < src_face_count; i++) {
 		Face3 face(facesr[i * 3 + 0], facesr[i * 3 + 1], facesr[i * 3 + 2]);
 
-		bvh_arrayw[i].aabb = face.get_aabb();
-		bvh_arrayw[i].center = bvh_arrayw[i].aabb.get_center();
-		bvh_arrayw[i].face_index = i;
+		face_aabbs[i] = face.get_aabb();
 		facesw[i].indices[0] = i * 3 + 0;
 		facesw[i].indices[1] = i * 3 + 1;
 		facesw[i].indices[2] = i * 3 + 2;
@@ -1648,21 +1860,13 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		verticesw[i * 3 + 1] = face.vertex[1];
 		verticesw[i * 3 + 2] = face.vertex[2];
 		if (i == 0) {
-			_aabb = bvh_arrayw[i].aabb;
+			_aabb = face_aabbs[i];
 		} else {
-			_aabb.merge_with(bvh_arrayw[i].aabb);
+			_aabb.merge_with(face_aabbs[i]);
 		}
 	}
 
-	int count = 0;
-	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
-
-	bvh.resize(count + 1);
-
-	BVH *bvh_arrayw2 = bvh.ptrw();
-
-	int idx = 0;
-	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	_build_bvh(face_aabbs.ptr(), src_face_count);
 
 	backface_collision = p_backface_collision;
 
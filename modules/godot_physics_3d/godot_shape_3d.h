@@ -302,7 +302,6 @@ public:
 	GodotConvexPolygonShape3D();
 };
 
-struct _Volume_BVH;
 struct GodotFaceShape3D;
 
 struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
@@ -316,15 +315,30 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
-	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
+	enum {
+		BVH_WIDTH = 4,
+		BVH_LEAF_FACES_MAX = 4,
+	};
 
-		int face_index = 0;
+	// 4-wide BVH node. The bounds of the children are stored per axis,
+	// so all children of a node are tested together.
+	struct BVH {
+		real_t min_x[BVH_WIDTH] = {};
+		real_t min_y[BVH_WIDTH] = {};
+		real_t min_z[BVH_WIDTH] = {};
+		real_t max_x[BVH_WIDTH] = {};
+		real_t max_y[BVH_WIDTH] = {};
+		real_t max_z[BVH_WIDTH] = {};
+
+		// Index of the child node, or of the first face in bvh_faces for leaves.
+		int child[BVH_WIDTH] = {};
+		// Amount of faces in leaves, 0 for child nodes.
+		int face_count[BVH_WIDTH] = {};
 	};
 
 	Vector<BVH> bvh;
+	// Face indices referenced by the leaves of the BVH.
+	Vector<int> bvh_faces;
 
 	struct _CullParams {
 		AABB aabb;
@@ -333,6 +347,7 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
 		const BVH *bvh = nullptr;
+		const int *bvh_faces = nullptr;
 		GodotFaceShape3D *face = nullptr;
 	};
 
@@ -340,9 +355,15 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		Vector3 from;
 		Vector3 to;
 		Vector3 dir;
+		Vector3 rel;
+		Vector3 inv_rel;
+		real_t length = 0;
+		// Fraction of the segment beyond which nodes can't contain a closer hit.
+		real_t t_max = 1;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
 		const BVH *bvh = nullptr;
+		const int *bvh_faces = nullptr;
 		GodotFaceShape3D *face = nullptr;
 
 		Vector3 result;
@@ -357,7 +378,7 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
 	bool _cull(int p_idx, _CullParams *p_params) const;
 
-	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
+	void _build_bvh(const AABB *p_face_aabbs, int p_face_count);
 
 	void _setup(const Vector<Vector3> &p_faces, bool p_backface_collision);
 
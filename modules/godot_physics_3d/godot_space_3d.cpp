@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -105,16 +106,11 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
-	Vector3 begin, end;
-	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
-	normal = (end - begin).normalized();
-
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+// Narrowphase of a ray against the candidates returned by the broadphase.
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) {
+	Vector3 begin = p_from;
+	Vector3 end = p_to;
+	Vector3 normal = (end - begin).normalized();
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -125,22 +121,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -205,6 +201,126 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_packet(uint32_t p_packet, const RayPacketQuery *p_query, RayPacketBuffers &r_buffers) {
+	const uint32_t first = p_packet * GodotBroadPhase3D::SEGMENT_PACKET_MAX;
+	const uint32_t count = MIN(GodotBroadPhase3D::SEGMENT_PACKET_MAX, p_query->count - first);
+	const Vector3 *from = p_query->from + first;
+	const Vector3 *to = p_query->to + first;
+
+	GodotCollisionObject3D **objects = r_buffers.objects.ptr();
+	int *subindices = r_buffers.subindices.ptr();
+	uint32_t *segments = r_buffers.segments.ptr();
+
+	int amount = space->broadphase->cull_segment_packet(from, to, count, objects, segments, GodotSpace3D::INTERSECTION_QUERY_MAX, subindices);
+
+	if (amount < 0) {
+		// Too many candidates for the whole packet, cull the rays one at a time instead
+		// so each one gets the same amount of candidates as intersect_ray().
+		for (uint32_t i = 0; i < count; i++) {
+			int ray_amount = space->broadphase->cull_segment_packet(&from[i], &to[i], 1, objects, segments, GodotSpace3D::INTERSECTION_QUERY_MAX, subindices);
+			if (ray_amount < 0) {
+				ray_amount = GodotSpace3D::INTERSECTION_QUERY_MAX;
+			}
+			p_query->collided[first + i] = _intersect_ray_candidates(*p_query->parameters, from[i], to[i], objects, subindices, ray_amount, p_query->results[first + i]);
+		}
+		return;
+	}
+
+	// Group the candidates by ray, keeping the order in which they were found.
+	uint32_t offsets[GodotBroadPhase3D::SEGMENT_PACKET_MAX + 1] = {};
+	for (int n = 0; n < amount; n++) {
+		offsets[segments[n] + 1]++;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+
+	GodotCollisionObject3D **ray_objects = r_buffers.ray_objects.ptr();
+	int *ray_subindices = r_buffers.ray_subindices.ptr();
+
+	uint32_t fill[GodotBroadPhase3D::SEGMENT_PACKET_MAX];
+	memcpy(fill, offsets, sizeof(uint32_t) * count);
+	for (int n = 0; n < amount; n++) {
+		uint32_t dst = fill[segments[n]]++;
+		ray_objects[dst] = objects[n];
+		ray_subindices[dst] = subindices[n];
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		p_query->collided[first + i] = _intersect_ray_candidates(*p_query->parameters, from[i], to[i], ray_objects + offsets[i], ray_subindices + offsets[i], offsets[i + 1] - offsets[i], p_query->results[first + i]);
+	}
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_packet_range(uint32_t p_task, RayPacketQuery *p_query) {
+	const uint32_t from = p_query->packet_count * p_task / p_query->task_count;
+	const uint32_t to = p_query->packet_count * (p_task + 1) / p_query->task_count;
+	for (uint32_t i = from; i < to; i++) {
+		_intersect_ray_packet(i, p_query, p_query->buffers[p_task]);
+	}
+}
+
+int GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) {
+	ERR_FAIL_COND_V(space->locked, 0);
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+	const uint32_t packet_count = (p_count + GodotBroadPhase3D::SEGMENT_PACKET_MAX - 1) / GodotBroadPhase3D::SEGMENT_PACKET_MAX;
+	uint32_t task_count = 1;
+	if (packet_count > 1 && thread_pool->get_thread_index() == -1) {
+		task_count = CLAMP(uint32_t(thread_pool->get_thread_count()), 1u, packet_count);
+	}
+
+	// Every task works through a contiguous range of packets with its own buffers, allocated once per call.
+	LocalVector<RayPacketBuffers> buffers;
+	buffers.resize(task_count);
+	for (RayPacketBuffers &task_buffers : buffers) {
+		task_buffers.objects.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		task_buffers.subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		task_buffers.segments.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		task_buffers.ray_objects.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		task_buffers.ray_subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	}
+
+	RayPacketQuery query;
+	query.parameters = &p_parameters;
+	query.from = p_from;
+	query.to = p_to;
+	query.count = p_count;
+	query.results = r_results;
+	query.collided = r_collided;
+	query.packet_count = packet_count;
+	query.task_count = task_count;
+	query.buffers = buffers.ptr();
+
+	// The lock is taken once for all packets, instead of by every packet on every task.
+	space->broadphase->lock_queries();
+	if (task_count > 1) {
+		WorkerThreadPool::GroupID group_task = thread_pool->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_packet_range, &query, task_count, -1, true, SNAME("GodotPhysicsIntersectRays"));
+		thread_pool->wait_for_group_task_completion(group_task);
+	} else {
+		_intersect_ray_packet_range(0, &query);
+	}
+	space->broadphase->unlock_queries();
+
+	int collided_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+	return collided_count;
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1258,6 +1374,7 @@ GodotSpace3D::GodotSpace3D() {
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
 	body_time_to_sleep = GLOBAL_GET("physics/3d/time_before_sleep");
 	solver_iterations = GLOBAL_GET("physics/3d/solver/solver_iterations");
+	parallel_body_integration = GLOBAL_GET("physics/3d/solver/parallel_body_integration");
 	contact_recycle_radius = GLOBAL_GET("physics/3d/solver/contact_recycle_radius");
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
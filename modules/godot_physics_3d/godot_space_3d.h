@@ -46,11 +46,37 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	// Candidate buffers of one task, the space query buffers are shared by all queries.
+	struct RayPacketBuffers {
+		LocalVector<GodotCollisionObject3D *> objects;
+		LocalVector<int> subindices;
+		LocalVector<uint32_t> segments;
+		LocalVector<GodotCollisionObject3D *> ray_objects;
+		LocalVector<int> ray_subindices;
+	};
+
+	struct RayPacketQuery {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		uint32_t count = 0;
+		RayResult *results = nullptr;
+		bool *collided = nullptr;
+		uint32_t packet_count = 0;
+		uint32_t task_count = 0;
+		RayPacketBuffers *buffers = nullptr;
+	};
+
+	bool _intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result);
+	void _intersect_ray_packet(uint32_t p_packet, const RayPacketQuery *p_query, RayPacketBuffers &r_buffers);
+	void _intersect_ray_packet_range(uint32_t p_task, RayPacketQuery *p_query);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual int intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -94,6 +120,7 @@ private:
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
+	bool parallel_body_integration = false;
 
 	real_t contact_recycle_radius = 0.0;
 	real_t contact_max_separation = 0.0;
@@ -161,6 +188,7 @@ public:
 	const HashSet<GodotCollisionObject3D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ bool is_using_parallel_body_integration() const { return parallel_body_integration; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
@@ -40,6 +40,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ACTIVE_BODY_COUNT_RESERVE 1024
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -182,6 +183,23 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 	}
 }
 
+void GodotStep3D::_collect_active_bodies(const SelfList<GodotBody3D>::List *p_body_list) {
+	active_bodies.clear();
+	const SelfList<GodotBody3D> *b = p_body_list->first();
+	while (b) {
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+}
+
+void GodotStep3D::_integrate_forces_body(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces_local(delta);
+}
+
+void GodotStep3D::_integrate_velocities_body(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities_local(delta);
+}
+
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
@@ -203,11 +221,27 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	int active_count = 0;
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	const bool parallel_integration = p_space->is_using_parallel_body_integration();
+
+	const SelfList<GodotBody3D> *b = nullptr;
+	if (parallel_integration) {
+		_collect_active_bodies(body_list);
+		active_count += active_bodies.size();
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces_body, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Broadphase updates are not thread-safe, apply them in body order.
+		for (GodotBody3D *body : active_bodies) {
+			body->integrate_forces_commit();
+		}
+	} else {
+		b = body_list->first();
+		while (b) {
+			b->self()->integrate_forces(p_delta);
+			b = b->next();
+			active_count++;
+		}
 	}
 
 	/* UPDATE SOFT BODY MOTION */
@@ -375,11 +409,26 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	if (parallel_integration) {
+		// Bodies may have been woken up while solving, collect them again.
+		_collect_active_bodies(body_list);
+
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities_body, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Can deactivate bodies, which modifies the active body list.
+		for (GodotBody3D *body : active_bodies) {
+			body->integrate_velocities_commit();
+		}
+
+		active_bodies.clear();
+	} else {
+		b = body_list->first();
+		while (b) {
+			const SelfList<GodotBody3D> *n = b->next();
+			b->self()->integrate_velocities(p_delta);
+			b = n;
+		}
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -412,6 +461,7 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(ACTIVE_BODY_COUNT_RESERVE);
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -0,0 +1,186 @@
+/**************************************************************************/
+/*  test_godot_concave_polygon_shape_3d.h                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_CONCAVE_POLYGON_SHAPE_3D_H
+#define TEST_GODOT_CONCAVE_POLYGON_SHAPE_3D_H
+
+#include "../godot_shape_3d.h"
+
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotConcavePolygonShape3D {
+
+// Terrain-like grid with random triangles on top, large enough to build the BVH in parallel.
+Vector<Vector3> create_test_faces() {
+	const int grid_size = 96;
+	Vector<Vector3> faces;
+	RandomPCG rng(1234);
+
+	for (int z = 0; z < grid_size; z++) {
+		for (int x = 0; x < grid_size; x++) {
+			Vector3 corners[4];
+			for (int i = 0; i < 4; i++) {
+				const real_t cx = x + (i & 1);
+				const real_t cz = z + (i >> 1);
+				corners[i] = Vector3(cx, Math::sin(cx * 0.3) + Math::cos(cz * 0.2), cz);
+			}
+			faces.push_back(corners[0]);
+			faces.push_back(corners[1]);
+			faces.push_back(corners[2]);
+			faces.push_back(corners[1]);
+			faces.push_back(corners[3]);
+			faces.push_back(corners[2]);
+		}
+	}
+
+	for (int i = 0; i < 2000; i++) {
+		const Vector3 position = Vector3(rng.random(0.0f, (float)grid_size), rng.random(0.0f, 5.0f), rng.random(0.0f, (float)grid_size));
+		faces.push_back(position);
+		faces.push_back(position + Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)));
+		faces.push_back(position + Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f)));
+	}
+
+	return faces;
+}
+
+GodotFaceShape3D get_face_shape(const Vector<Vector3> &p_faces, int p_face_index) {
+	GodotFaceShape3D face;
+	face.vertex[0] = p_faces[p_face_index * 3 + 0];
+	face.vertex[1] = p_faces[p_face_index * 3 + 1];
+	face.vertex[2] = p_faces[p_face_index * 3 + 2];
+	face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+	return face;
+}
+
+bool count_face(void *p_userdata, GodotShape3D *p_convex) {
+	(*static_cast<int *>(p_userdata))++;
+	return false;
+}
+
+TEST_CASE("[GodotConcavePolygonShape3D] Segment intersections should match testing every face") {
+	const Vector<Vector3> faces = create_test_faces();
+	const int face_count = faces.size() / 3;
+
+	GodotConcavePolygonShape3D shape;
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = false;
+	shape.set_data(data);
+
+	RandomPCG rng(4321);
+	int hits = 0;
+	int mismatches = 0;
+
+	for (int i = 0; i < 500; i++) {
+		const Vector3 from = Vector3(rng.random(0.0f, 96.0f), 10, rng.random(0.0f, 96.0f));
+		const Vector3 to = from + Vector3(rng.random(-20.0f, 20.0f), -20, rng.random(-20.0f, 20.0f));
+		const Vector3 dir = (to - from).normalized();
+
+		bool expected_hit = false;
+		Vector3 expected_point;
+		real_t expected_distance = 1e20;
+		for (int f = 0; f < face_count; f++) {
+			const GodotFaceShape3D face = get_face_shape(faces, f);
+			Vector3 point;
+			Vector3 normal;
+			int face_index = f;
+			if (face.intersect_segment(from, to, point, normal, face_index, true)) {
+				const real_t distance = dir.dot(point - from);
+				if (distance > 0 && distance < expected_distance) {
+					expected_distance = distance;
+					expected_point = point;
+					expected_hit = true;
+				}
+			}
+		}
+
+		Vector3 point;
+		Vector3 normal;
+		int face_index = -1;
+		const bool hit = shape.intersect_segment(from, to, point, normal, face_index, true);
+		if (hit != expected_hit || (hit && !point.is_equal_approx(expected_point))) {
+			mismatches++;
+		}
+		if (hit) {
+			hits++;
+			// The face index refers to the faces as they were given, not to the BVH order.
+			Vector3 face_point;
+			Vector3 face_normal;
+			int unused_index = face_index;
+			CHECK(get_face_shape(faces, face_index).intersect_segment(from, to, face_point, face_normal, unused_index, true));
+		}
+	}
+
+	CHECK_GT(hits, 0);
+	CHECK_MESSAGE(mismatches == 0, "Segments should hit the same closest point as testing every face.");
+}
+
+TEST_CASE("[GodotConcavePolygonShape3D] Culling should find the same faces as testing every face") {
+	const Vector<Vector3> faces = create_test_faces();
+	const int face_count = faces.size() / 3;
+
+	GodotConcavePolygonShape3D shape;
+	Dictionary data;
+	data["faces"] = faces;
+	data["backface_collision"] = false;
+	shape.set_data(data);
+
+	RandomPCG rng(5678);
+	int mismatches = 0;
+	int total = 0;
+
+	for (int i = 0; i < 200; i++) {
+		const Vector3 position = Vector3(rng.random(0.0f, 96.0f), rng.random(-2.0f, 4.0f), rng.random(0.0f, 96.0f));
+		const AABB aabb = AABB(position, Vector3(rng.random(0.5f, 4.0f), rng.random(0.5f, 4.0f), rng.random(0.5f, 4.0f)));
+
+		int expected_count = 0;
+		for (int f = 0; f < face_count; f++) {
+			if (aabb.intersects(Face3(faces[f * 3 + 0], faces[f * 3 + 1], faces[f * 3 + 2]).get_aabb())) {
+				expected_count++;
+			}
+		}
+
+		int count = 0;
+		shape.cull(aabb, count_face, &count, false);
+		if (count != expected_count) {
+			mismatches++;
+		}
+		total += count;
+	}
+
+	CHECK_GT(total, 0);
+	CHECK_MESSAGE(mismatches == 0, "Culling should send every overlapping face exactly once.");
+}
+
+} // namespace TestGodotConcavePolygonShape3D
+
+#endif // TEST_GODOT_CONCAVE_POLYGON_SHAPE_3D_H
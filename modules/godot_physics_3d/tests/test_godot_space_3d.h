@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  test_godot_space_3d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_SPACE_3D_H
+#define TEST_GODOT_SPACE_3D_H
+
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace3D {
+
+struct RayTestScene {
+	RID space;
+	RID box_shape;
+	RID sphere_shape;
+	LocalVector<RID> big_box_shapes;
+	LocalVector<RID> objects;
+};
+
+RayTestScene create_ray_test_scene() {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RayTestScene scene;
+	scene.space = physics_server->space_create();
+	physics_server->space_set_active(scene.space, true);
+
+	scene.box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(scene.box_shape, Vector3(0.5, 0.5, 0.5));
+	scene.sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(scene.sphere_shape, 0.4);
+
+	// A grid of bodies on different layers, every third one with a second shape.
+	for (int z = 0; z < 16; z++) {
+		for (int x = 0; x < 16; x++) {
+			RID body = physics_server->body_create();
+			physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+			physics_server->body_add_shape(body, scene.box_shape);
+			if ((x + z) % 3 == 0) {
+				physics_server->body_add_shape(body, scene.sphere_shape, Transform3D(Basis(), Vector3(0, 0.8, 0)));
+			}
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 2.0, (x * z) % 3 * 0.25, z * 2.0)));
+			physics_server->body_set_collision_layer(body, 1 << ((x + z * 3) % 3));
+			physics_server->body_set_space(body, scene.space);
+			scene.objects.push_back(body);
+		}
+	}
+
+	// Areas above the grid, only hit when areas are enabled.
+	for (int i = 0; i < 8; i++) {
+		RID area = physics_server->area_create();
+		physics_server->area_add_shape(area, scene.sphere_shape);
+		physics_server->area_set_transform(area, Transform3D(Basis(), Vector3(i * 4.0 + 1.0, 3.0, i * 4.0)));
+		physics_server->area_set_collision_layer(area, 1);
+		physics_server->area_set_space(area, scene.space);
+		scene.objects.push_back(area);
+	}
+
+	// A cluster of overlapping boxes that gives a packet of rays more candidates than fit in the query buffer.
+	// Sizes differ so the closest hit doesn't depend on the order of the candidates.
+	for (int i = 0; i < 100; i++) {
+		RID big_box_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(big_box_shape, Vector3(5.0, 5.0, 5.0) + Vector3(0.01, 0.02, 0.015) * i);
+		scene.big_box_shapes.push_back(big_box_shape);
+
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(body, big_box_shape);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(100.0, 0.0, 0.0)));
+		physics_server->body_set_collision_layer(body, i % 2 ? 1 : 4);
+		physics_server->body_set_space(body, scene.space);
+		scene.objects.push_back(body);
+	}
+
+	// Pending shape changes are applied on the next step.
+	physics_server->step(1.0 / 60.0);
+	return scene;
+}
+
+void free_ray_test_scene(const RayTestScene &p_scene) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	for (const RID &object : p_scene.objects) {
+		physics_server->free(object);
+	}
+	for (const RID &big_box_shape : p_scene.big_box_shapes) {
+		physics_server->free(big_box_shape);
+	}
+	physics_server->free(p_scene.box_shape);
+	physics_server->free(p_scene.sphere_shape);
+	physics_server->free(p_scene.space);
+}
+
+void check_rays_match_single_rays(PhysicsDirectSpaceState3D *p_space_state, const PhysicsDirectSpaceState3D::RayParameters &p_parameters, const Vector<Vector3> &p_from, const Vector<Vector3> &p_to) {
+	const int ray_count = p_from.size();
+	Vector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(ray_count);
+	Vector<bool> collided;
+	collided.resize(ray_count);
+	const int collided_count = p_space_state->intersect_rays(p_parameters, p_from.ptr(), p_to.ptr(), ray_count, results.ptrw(), collided.ptrw());
+
+	int expected_collided_count = 0;
+	int mismatch = -1;
+	for (int i = 0; i < ray_count; i++) {
+		PhysicsDirectSpaceState3D::RayParameters parameters = p_parameters;
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		PhysicsDirectSpaceState3D::RayResult expected;
+		const bool expected_collided = p_space_state->intersect_ray(parameters, expected);
+		if (expected_collided) {
+			expected_collided_count++;
+		}
+
+		if (mismatch != -1) {
+			continue;
+		}
+		const PhysicsDirectSpaceState3D::RayResult &result = results[i];
+		if (collided[i] != expected_collided) {
+			mismatch = i;
+		} else if (expected_collided && (result.position != expected.position || result.normal != expected.normal || result.rid != expected.rid || result.collider_id != expected.collider_id || result.shape != expected.shape || result.face_index != expected.face_index)) {
+			mismatch = i;
+		}
+	}
+
+	CHECK_GT(expected_collided_count, 0);
+	CHECK_EQ(collided_count, expected_collided_count);
+	CHECK_MESSAGE(mismatch == -1, vformat("Ray %d should hit the same as intersect_ray().", mismatch));
+}
+
+TEST_CASE("[SceneTree][GodotSpace3D] Batched rays should hit the same as single rays") {
+	RayTestScene scene = create_ray_test_scene();
+	PhysicsDirectSpaceState3D *space_state = PhysicsServer3D::get_singleton()->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	// Rays hitting different objects are mixed in the same packets, so their candidates have to be told apart.
+	Vector<Vector3> from;
+	Vector<Vector3> to;
+	for (int i = 0; i < 150; i++) {
+		const real_t x = (i * 7 % 37) * 0.9 - 1.0;
+		const real_t z = (i * 11 % 41) * 0.8 - 1.0;
+		from.push_back(Vector3(x, 10.0, z));
+		to.push_back(Vector3(x + (i % 5 - 2) * 0.5, -10.0, z + (i % 3 - 1) * 0.5));
+	}
+	for (int i = 0; i < 8; i++) {
+		from.push_back(Vector3(i * 4.0 + 1.0, 10.0, i * 4.0));
+		to.push_back(Vector3(i * 4.0 + 1.0, -10.0, i * 4.0));
+	}
+	for (int i = 0; i < 40; i++) {
+		from.push_back(Vector3(-5.0, 0.1 + (i % 4) * 0.2, i * 0.8));
+		to.push_back(Vector3(35.0, 0.3, 31.0 - i * 0.7));
+	}
+	// Every ray through the cluster finds all its boxes, more than a packet can hold. Some start inside.
+	for (int i = 0; i < 70; i++) {
+		from.push_back(Vector3(80.0 + i * 0.3, -1.0 + (i % 7) * 0.3, -2.0 + (i % 5)));
+		to.push_back(Vector3(120.0, 1.0 - (i % 3), 2.0 - (i % 4)));
+	}
+
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+
+	SUBCASE("Default parameters") {
+		check_rays_match_single_rays(space_state, parameters, from, to);
+	}
+
+	SUBCASE("Collision mask") {
+		parameters.collision_mask = 1 | 4;
+		check_rays_match_single_rays(space_state, parameters, from, to);
+	}
+
+	SUBCASE("Excluded objects") {
+		for (uint32_t i = 0; i < scene.objects.size(); i += 3) {
+			parameters.exclude.insert(scene.objects[i]);
+		}
+		check_rays_match_single_rays(space_state, parameters, from, to);
+	}
+
+	SUBCASE("Areas and hits from inside") {
+		parameters.collide_with_areas = true;
+		parameters.hit_from_inside = true;
+		check_rays_match_single_rays(space_state, parameters, from, to);
+	}
+
+	SUBCASE("Areas only") {
+		parameters.collide_with_bodies = false;
+		parameters.collide_with_areas = true;
+		check_rays_match_single_rays(space_state, parameters, from, to);
+	}
+
+	free_ray_test_scene(scene);
+}
+
+} // namespace TestGodotSpace3D
+
+#endif // TEST_GODOT_SPACE_3D_H
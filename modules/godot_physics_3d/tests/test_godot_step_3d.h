@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_STEP_3D_H
+#define TEST_GODOT_STEP_3D_H
+
+#include "core/config/project_settings.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotStep3D {
+
+struct StepTestScene {
+	RID space;
+	LocalVector<RID> bodies;
+};
+
+StepTestScene create_step_test_scene(RID p_floor_shape, RID p_box_shape, RID p_sphere_shape, bool p_parallel_body_integration) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	// Spaces read the setting when they are created.
+	const Variant parallel_body_integration = GLOBAL_GET("physics/3d/solver/parallel_body_integration");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_body_integration", p_parallel_body_integration);
+	StepTestScene scene;
+	scene.space = physics_server->space_create();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_body_integration", parallel_body_integration);
+	physics_server->space_set_active(scene.space, true);
+
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, p_floor_shape);
+	physics_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0, -0.5, 0.0)));
+	physics_server->body_set_space(floor, scene.space);
+	scene.bodies.push_back(floor);
+
+	// Stacks that collide with each other and the floor, and loose bodies that only fall.
+	// Varying damping and velocities exercise every term of the force integration.
+	for (int i = 0; i < 96; i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(body, i % 4 == 0 ? p_sphere_shape : p_box_shape);
+		physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_MASS, 1.0 + (i % 5) * 0.5);
+		physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP, (i % 3) * 0.1);
+		physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_ANGULAR_DAMP, (i % 4) * 0.2);
+		const Vector3 position = i < 64 ? Vector3((i % 8) * 1.5 - 6.0, 0.6 + (i / 8) * 1.05, (i % 3) * 0.2) : Vector3((i - 64) * 1.5 - 24.0, 5.0, 10.0);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0.0, 1.0, 0.0), i * 0.1), position));
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3((i % 5) - 2.0, 0.0, (i % 7) * 0.1));
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0.0, (i % 3) * 0.5, (i % 2) * 0.3));
+		physics_server->body_set_space(body, scene.space);
+		scene.bodies.push_back(body);
+	}
+	return scene;
+}
+
+void free_step_test_scene(const StepTestScene &p_scene) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	for (const RID &body : p_scene.bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(p_scene.space);
+}
+
+TEST_CASE("[SceneTree][GodotStep3D] Parallel body integration should match serial stepping") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(40.0, 0.5, 40.0));
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 0.5);
+
+	// Both spaces are built the same way, so their bodies, broadphase and islands line up.
+	StepTestScene serial = create_step_test_scene(floor_shape, box_shape, sphere_shape, false);
+	StepTestScene parallel = create_step_test_scene(floor_shape, box_shape, sphere_shape, true);
+
+	for (int i = 0; i < 180; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+
+	int mismatch = -1;
+	int fallen_count = 0;
+	for (uint32_t i = 1; i < serial.bodies.size(); i++) {
+		const RID serial_body = serial.bodies[i];
+		const RID parallel_body = parallel.bodies[i];
+		const Transform3D transform = physics_server->body_get_state(serial_body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		if (i > 64 && transform.origin.y < 4.0) {
+			fallen_count++;
+		}
+		// The integration has to produce the same bits, not just close values.
+		if (transform != Transform3D(physics_server->body_get_state(parallel_body, PhysicsServer3D::BODY_STATE_TRANSFORM)) ||
+				Vector3(physics_server->body_get_state(serial_body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) != Vector3(physics_server->body_get_state(parallel_body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) ||
+				Vector3(physics_server->body_get_state(serial_body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY)) != Vector3(physics_server->body_get_state(parallel_body, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY)) ||
+				bool(physics_server->body_get_state(serial_body, PhysicsServer3D::BODY_STATE_SLEEPING)) != bool(physics_server->body_get_state(parallel_body, PhysicsServer3D::BODY_STATE_SLEEPING))) {
+			mismatch = i;
+			break;
+		}
+	}
+
+	// The loose bodies fell, so the scene was actually simulated.
+	CHECK_EQ(fallen_count, 32);
+	CHECK_MESSAGE(mismatch == -1, vformat("Body %d should be in the same state after parallel and serial stepping.", mismatch));
+
+	free_step_test_scene(serial);
+	free_step_test_scene(parallel);
+	physics_server->free(floor_shape);
+	physics_server->free(box_shape);
+	physics_server->free(sphere_shape);
+}
+
+} // namespace TestGodotStep3D
+
+#endif // TEST_GODOT_STEP_3D_H
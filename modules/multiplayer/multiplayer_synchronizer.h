@@ -59,6 +59,7 @@ private:
 	VisibilityUpdateMode visibility_update_mode = VISIBILITY_PROCESS_IDLE;
 	HashSet<Callable> visibility_filters;
 	HashSet<int> peer_visibility;
+	bool spatial_interest = false;
 	Vector<Watcher> watchers;
 	uint64_t last_watch_usec = 0;
 
@@ -117,6 +118,9 @@ public:
 	void remove_visibility_filter(Callable p_callback);
 	VisibilityUpdateMode get_visibility_update_mode() const;
 
+	void set_spatial_interest_enabled(bool p_enabled);
+	bool is_spatial_interest_enabled() const;
+
 	List<Variant> get_delta_state(uint64_t p_cur_usec, uint64_t p_last_usec, uint64_t &r_indexes);
 	List<NodePath> get_delta_properties(uint64_t p_indexes);
 	SceneReplicationConfig *get_replication_config_ptr() const;
@@ -55,6 +55,20 @@ bool SceneReplicationConfig::_set(const StringName &p_name, const Variant &p_val
 			ERR_FAIL_COND_V(mode < REPLICATION_MODE_NEVER || mode > REPLICATION_MODE_ON_CHANGE, false);
 			property_set_replication_mode(prop.name, mode);
 			return true;
+		} else if (what == "quantization") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			QuantizationMode mode = (QuantizationMode)p_value.operator int();
+			ERR_FAIL_COND_V(mode < QUANTIZATION_NONE || mode > QUANTIZATION_SMALLEST_THREE, false);
+			property_set_quantization(prop.name, mode);
+			return true;
+		} else if (what == "quantization_bits") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::INT, false);
+			property_set_quantization_bits(prop.name, p_value);
+			return true;
+		} else if (what == "quantization_range") {
+			ERR_FAIL_COND_V(p_value.get_type() != Variant::VECTOR2, false);
+			property_set_quantization_range(prop.name, p_value);
+			return true;
 		}
 		ERR_FAIL_COND_V(p_value.get_type() != Variant::BOOL, false);
 		if (what == "spawn") {
@@ -90,16 +104,33 @@ bool SceneReplicationConfig::_get(const StringName &p_name, Variant &r_ret) cons
 		} else if (what == "replication_mode") {
 			r_ret = prop.mode;
 			return true;
+		} else if (what == "quantization") {
+			r_ret = prop.quantization.mode;
+			return true;
+		} else if (what == "quantization_bits") {
+			r_ret = prop.quantization.bits;
+			return true;
+		} else if (what == "quantization_range") {
+			r_ret = Vector2(prop.quantization.range_min, prop.quantization.range_max);
+			return true;
 		}
 	}
 	return false;
 }
 
 void SceneReplicationConfig::_get_property_list(List<PropertyInfo> *p_list) const {
-	for (int i = 0; i < properties.size(); i++) {
+	int i = 0;
+	for (const ReplicationProperty &prop : properties) {
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/path", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::STRING, "properties/" + itos(i) + "/spawn", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
 		p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/replication_mode", PROPERTY_HINT_ENUM, "Never,Always,On Change", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		// Only store quantization settings for quantized properties, so existing resources stay unchanged.
+		if (prop.quantization.mode != QUANTIZATION_NONE) {
+			p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/quantization", PROPERTY_HINT_ENUM, "None,Fixed Point,Smallest Three", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+			p_list->push_back(PropertyInfo(Variant::INT, "properties/" + itos(i) + "/quantization_bits", PROPERTY_HINT_RANGE, "1,32", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+			p_list->push_back(PropertyInfo(Variant::VECTOR2, "properties/" + itos(i) + "/quantization_range", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL));
+		}
+		i++;
 	}
 }
 
@@ -109,6 +140,9 @@ void SceneReplicationConfig::reset_state() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_quantizations.clear();
+	watch_quantizations.clear();
+	quantized = false;
 }
 
 TypedArray<NodePath> SceneReplicationConfig::get_properties() const {
@@ -225,6 +259,54 @@ void SceneReplicationConfig::property_set_replication_mode(const NodePath &p_pat
 	dirty = true;
 }
 
+SceneReplicationConfig::QuantizationMode SceneReplicationConfig::property_get_quantization(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, QUANTIZATION_NONE);
+	return E->get().quantization.mode;
+}
+
+void SceneReplicationConfig::property_set_quantization(const NodePath &p_path, QuantizationMode p_mode) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().quantization.mode == p_mode) {
+		return;
+	}
+	E->get().quantization.mode = p_mode;
+	dirty = true;
+}
+
+int SceneReplicationConfig::property_get_quantization_bits(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, 0);
+	return E->get().quantization.bits;
+}
+
+void SceneReplicationConfig::property_set_quantization_bits(const NodePath &p_path, int p_bits) {
+	ERR_FAIL_COND_MSG(p_bits < 1 || p_bits > 32, "Quantization bits must be between 1 and 32.");
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	if (E->get().quantization.bits == p_bits) {
+		return;
+	}
+	E->get().quantization.bits = p_bits;
+	dirty = true;
+}
+
+Vector2 SceneReplicationConfig::property_get_quantization_range(const NodePath &p_path) {
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND_V(!E, Vector2());
+	return Vector2(E->get().quantization.range_min, E->get().quantization.range_max);
+}
+
+void SceneReplicationConfig::property_set_quantization_range(const NodePath &p_path, const Vector2 &p_range) {
+	ERR_FAIL_COND_MSG(!(p_range.x < p_range.y), "Quantization range minimum must be less than its maximum.");
+	List<ReplicationProperty>::Element *E = properties.find(p_path);
+	ERR_FAIL_COND(!E);
+	E->get().quantization.range_min = p_range.x;
+	E->get().quantization.range_max = p_range.y;
+	dirty = true;
+}
+
 void SceneReplicationConfig::_update() {
 	if (!dirty) {
 		return;
@@ -233,6 +315,9 @@ void SceneReplicationConfig::_update() {
 	sync_props.clear();
 	spawn_props.clear();
 	watch_props.clear();
+	sync_quantizations.clear();
+	watch_quantizations.clear();
+	quantized = false;
 	for (const ReplicationProperty &prop : properties) {
 		if (prop.spawn) {
 			spawn_props.push_back(prop.name);
@@ -240,9 +325,13 @@ void SceneReplicationConfig::_update() {
 		switch (prop.mode) {
 			case REPLICATION_MODE_ALWAYS:
 				sync_props.push_back(prop.name);
+				sync_quantizations.push_back(prop.quantization);
+				quantized = quantized || prop.quantization.mode != QUANTIZATION_NONE;
 				break;
 			case REPLICATION_MODE_ON_CHANGE:
 				watch_props.push_back(prop.name);
+				watch_quantizations.push_back(prop.quantization);
+				quantized = quantized || prop.quantization.mode != QUANTIZATION_NONE;
 				break;
 			default:
 				break;
@@ -271,6 +360,258 @@ const List<NodePath> &SceneReplicationConfig::get_watch_properties() {
 	return watch_props;
 }
 
+const SceneReplicationConfig::Quantization *SceneReplicationConfig::get_sync_quantizations() {
+	if (dirty) {
+		_update();
+	}
+	return quantized ? sync_quantizations.ptr() : nullptr;
+}
+
+const SceneReplicationConfig::Quantization *SceneReplicationConfig::get_watch_quantizations() {
+	if (dirty) {
+		_update();
+	}
+	return quantized ? watch_quantizations.ptr() : nullptr;
+}
+
+// Quantized values are a Variant type byte followed by their components packed into as few bytes as possible.
+// Values whose type can't be quantized with the configured mode fall back to the regular variant encoding after a NIL type byte.
+
+struct QuantizedBitWriter {
+	uint8_t *buffer = nullptr;
+	int len = 0;
+	uint64_t bits = 0;
+	int bit_count = 0;
+
+	void write(uint32_t p_value, int p_bits) {
+		bits |= uint64_t(p_value) << bit_count;
+		bit_count += p_bits;
+		while (bit_count >= 8) {
+			if (buffer) {
+				buffer[len] = bits & 0xFF;
+			}
+			len++;
+			bits >>= 8;
+			bit_count -= 8;
+		}
+	}
+
+	void flush() {
+		if (bit_count > 0) {
+			if (buffer) {
+				buffer[len] = bits & 0xFF;
+			}
+			len++;
+			bits = 0;
+			bit_count = 0;
+		}
+	}
+};
+
+struct QuantizedBitReader {
+	const uint8_t *buffer = nullptr;
+	int len = 0;
+	int pos = 0;
+	uint64_t bits = 0;
+	int bit_count = 0;
+
+	bool read(uint32_t &r_value, int p_bits) {
+		while (bit_count < p_bits) {
+			if (pos >= len) {
+				return false;
+			}
+			bits |= uint64_t(buffer[pos++]) << bit_count;
+			bit_count += 8;
+		}
+		r_value = uint32_t(bits & ((uint64_t(1) << p_bits) - 1));
+		bits >>= p_bits;
+		bit_count -= p_bits;
+		return true;
+	}
+};
+
+static uint32_t _quantize_component(double p_value, double p_min, double p_max, int p_bits) {
+	double steps = double((uint64_t(1) << p_bits) - 1);
+	double t = (p_value - p_min) / (p_max - p_min);
+	if (!(t > 0.0)) {
+		return 0; // Also catches NaN.
+	}
+	if (t >= 1.0) {
+		return uint32_t(steps);
+	}
+	return uint32_t(Math::round(t * steps));
+}
+
+static double _dequantize_component(uint32_t p_value, double p_min, double p_max, int p_bits) {
+	double steps = double((uint64_t(1) << p_bits) - 1);
+	return p_min + (p_max - p_min) * (double(p_value) / steps);
+}
+
+static int _get_fixed_point_component_count(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::FLOAT:
+			return 1;
+		case Variant::VECTOR2:
+			return 2;
+		case Variant::VECTOR3:
+			return 3;
+		case Variant::VECTOR4:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+Error SceneReplicationConfig::encode_quantized_variant(const Variant &p_variant, const Quantization &p_quantization, uint8_t *r_buffer, int &r_len) {
+	ERR_FAIL_COND_V(p_quantization.bits < 1 || p_quantization.bits > 32, ERR_INVALID_PARAMETER);
+	Variant::Type type = p_variant.get_type();
+	int components = 0;
+	if (p_quantization.mode == QUANTIZATION_FIXED_POINT) {
+		components = _get_fixed_point_component_count(type);
+	} else if (p_quantization.mode == QUANTIZATION_SMALLEST_THREE && type == Variant::QUATERNION) {
+		components = 3;
+	}
+
+	if (components == 0) {
+		// Not quantizable.
+		int len = 0;
+		Error err = MultiplayerAPI::encode_and_compress_variant(p_variant, r_buffer ? r_buffer + 1 : nullptr, len, false);
+		ERR_FAIL_COND_V(err != OK, err);
+		if (r_buffer) {
+			r_buffer[0] = Variant::NIL;
+		}
+		r_len = len + 1;
+		return OK;
+	}
+
+	if (r_buffer) {
+		r_buffer[0] = type;
+	}
+	QuantizedBitWriter writer;
+	writer.buffer = r_buffer ? r_buffer + 1 : nullptr;
+	const int bits = p_quantization.bits;
+	if (type == Variant::QUATERNION) {
+		Quaternion q = p_variant;
+		q = q.is_finite() && q.length_squared() > 0 ? q.normalized() : Quaternion();
+		real_t c[4] = { q.x, q.y, q.z, q.w };
+		uint32_t largest = 0;
+		for (uint32_t i = 1; i < 4; i++) {
+			if (Math::abs(c[i]) > Math::abs(c[largest])) {
+				largest = i;
+			}
+		}
+		// q and -q are the same rotation, so the dropped component can always be positive.
+		real_t sign = c[largest] < 0 ? -1.0 : 1.0;
+		writer.write(largest, 2);
+		for (uint32_t i = 0; i < 4; i++) {
+			if (i != largest) {
+				writer.write(_quantize_component(c[i] * sign, -Math_SQRT12, Math_SQRT12, bits), bits);
+			}
+		}
+	} else {
+		real_t c[4] = {};
+		switch (type) {
+			case Variant::FLOAT: {
+				c[0] = p_variant;
+			} break;
+			case Variant::VECTOR2: {
+				Vector2 v = p_variant;
+				c[0] = v.x;
+				c[1] = v.y;
+			} break;
+			case Variant::VECTOR3: {
+				Vector3 v = p_variant;
+				c[0] = v.x;
+				c[1] = v.y;
+				c[2] = v.z;
+			} break;
+			case Variant::VECTOR4: {
+				Vector4 v = p_variant;
+				c[0] = v.x;
+				c[1] = v.y;
+				c[2] = v.z;
+				c[3] = v.w;
+			} break;
+			default:
+				break;
+		}
+		for (int i = 0; i < components; i++) {
+			writer.write(_quantize_component(c[i], p_quantization.range_min, p_quantization.range_max, bits), bits);
+		}
+	}
+	writer.flush();
+	r_len = writer.len + 1;
+	return OK;
+}
+
+Error SceneReplicationConfig::decode_quantized_variant(Variant &r_variant, const Quantization &p_quantization, const uint8_t *p_buffer, int p_len, int *r_len) {
+	ERR_FAIL_COND_V(p_quantization.bits < 1 || p_quantization.bits > 32, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_len < 1, ERR_INVALID_DATA);
+	Variant::Type type = Variant::Type(p_buffer[0]);
+	if (type == Variant::NIL) {
+		int len = 0;
+		Error err = MultiplayerAPI::decode_and_decompress_variant(r_variant, p_buffer + 1, p_len - 1, &len, false);
+		ERR_FAIL_COND_V(err != OK, err);
+		if (r_len) {
+			*r_len = len + 1;
+		}
+		return OK;
+	}
+
+	QuantizedBitReader reader;
+	reader.buffer = p_buffer + 1;
+	reader.len = p_len - 1;
+	const int bits = p_quantization.bits;
+	if (type == Variant::QUATERNION) {
+		ERR_FAIL_COND_V(p_quantization.mode != QUANTIZATION_SMALLEST_THREE, ERR_INVALID_DATA);
+		uint32_t largest = 0;
+		ERR_FAIL_COND_V(!reader.read(largest, 2), ERR_INVALID_DATA);
+		real_t c[4] = {};
+		real_t sum = 0;
+		for (uint32_t i = 0; i < 4; i++) {
+			if (i == largest) {
+				continue;
+			}
+			uint32_t value = 0;
+			ERR_FAIL_COND_V(!reader.read(value, bits), ERR_INVALID_DATA);
+			c[i] = _dequantize_component(value, -Math_SQRT12, Math_SQRT12, bits);
+			sum += c[i] * c[i];
+		}
+		c[largest] = Math::sqrt(MAX(0.0, 1.0 - sum));
+		r_variant = Quaternion(c[0], c[1], c[2], c[3]).normalized();
+	} else {
+		ERR_FAIL_COND_V(p_quantization.mode != QUANTIZATION_FIXED_POINT, ERR_INVALID_DATA);
+		int components = _get_fixed_point_component_count(type);
+		ERR_FAIL_COND_V(components == 0, ERR_INVALID_DATA);
+		real_t c[4] = {};
+		for (int i = 0; i < components; i++) {
+			uint32_t value = 0;
+			ERR_FAIL_COND_V(!reader.read(value, bits), ERR_INVALID_DATA);
+			c[i] = _dequantize_component(value, p_quantization.range_min, p_quantization.range_max, bits);
+		}
+		switch (type) {
+			case Variant::FLOAT: {
+				r_variant = c[0];
+			} break;
+			case Variant::VECTOR2: {
+				r_variant = Vector2(c[0], c[1]);
+			} break;
+			case Variant::VECTOR3: {
+				r_variant = Vector3(c[0], c[1], c[2]);
+			} break;
+			case Variant::VECTOR4: {
+				r_variant = Vector4(c[0], c[1], c[2], c[3]);
+			} break;
+			default:
+				break;
+		}
+	}
+	if (r_len) {
+		*r_len = reader.pos + 1;
+	}
+	return OK;
+}
+
 void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_properties"), &SceneReplicationConfig::get_properties);
 	ClassDB::bind_method(D_METHOD("add_property", "path", "index"), &SceneReplicationConfig::add_property, DEFVAL(-1));
@@ -281,11 +622,21 @@ void SceneReplicationConfig::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("property_set_spawn", "path", "enabled"), &SceneReplicationConfig::property_set_spawn);
 	ClassDB::bind_method(D_METHOD("property_get_replication_mode", "path"), &SceneReplicationConfig::property_get_replication_mode);
 	ClassDB::bind_method(D_METHOD("property_set_replication_mode", "path", "mode"), &SceneReplicationConfig::property_set_replication_mode);
+	ClassDB::bind_method(D_METHOD("property_get_quantization", "path"), &SceneReplicationConfig::property_get_quantization);
+	ClassDB::bind_method(D_METHOD("property_set_quantization", "path", "mode"), &SceneReplicationConfig::property_set_quantization);
+	ClassDB::bind_method(D_METHOD("property_get_quantization_bits", "path"), &SceneReplicationConfig::property_get_quantization_bits);
+	ClassDB::bind_method(D_METHOD("property_set_quantization_bits", "path", "bits"), &SceneReplicationConfig::property_set_quantization_bits);
+	ClassDB::bind_method(D_METHOD("property_get_quantization_range", "path"), &SceneReplicationConfig::property_get_quantization_range);
+	ClassDB::bind_method(D_METHOD("property_set_quantization_range", "path", "range"), &SceneReplicationConfig::property_set_quantization_range);
 
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_NEVER);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(REPLICATION_MODE_ON_CHANGE);
 
+	BIND_ENUM_CONSTANT(QUANTIZATION_NONE);
+	BIND_ENUM_CONSTANT(QUANTIZATION_FIXED_POINT);
+	BIND_ENUM_CONSTANT(QUANTIZATION_SMALLEST_THREE);
+
 	// Deprecated.
 	ClassDB::bind_method(D_METHOD("property_get_sync", "path"), &SceneReplicationConfig::property_get_sync);
 	ClassDB::bind_method(D_METHOD("property_set_sync", "path", "enabled"), &SceneReplicationConfig::property_set_sync);
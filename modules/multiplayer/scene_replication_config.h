@@ -46,11 +46,25 @@ public:
 		REPLICATION_MODE_ON_CHANGE,
 	};
 
+	enum QuantizationMode {
+		QUANTIZATION_NONE,
+		QUANTIZATION_FIXED_POINT,
+		QUANTIZATION_SMALLEST_THREE,
+	};
+
+	struct Quantization {
+		QuantizationMode mode = QUANTIZATION_NONE;
+		int bits = 16;
+		real_t range_min = -1.0;
+		real_t range_max = 1.0;
+	};
+
 private:
 	struct ReplicationProperty {
 		NodePath name;
 		bool spawn = true;
 		ReplicationMode mode = REPLICATION_MODE_ALWAYS;
+		Quantization quantization;
 
 		bool operator==(const ReplicationProperty &p_to) {
 			return name == p_to.name;
@@ -67,6 +81,9 @@ private:
 	List<NodePath> spawn_props;
 	List<NodePath> sync_props;
 	List<NodePath> watch_props;
+	LocalVector<Quantization> sync_quantizations;
+	LocalVector<Quantization> watch_quantizations;
+	bool quantized = false;
 	bool dirty = false;
 
 	void _update();
@@ -100,13 +117,30 @@ public:
 	ReplicationMode property_get_replication_mode(const NodePath &p_path);
 	void property_set_replication_mode(const NodePath &p_path, ReplicationMode p_mode);
 
+	QuantizationMode property_get_quantization(const NodePath &p_path);
+	void property_set_quantization(const NodePath &p_path, QuantizationMode p_mode);
+
+	int property_get_quantization_bits(const NodePath &p_path);
+	void property_set_quantization_bits(const NodePath &p_path, int p_bits);
+
+	Vector2 property_get_quantization_range(const NodePath &p_path);
+	void property_set_quantization_range(const NodePath &p_path, const Vector2 &p_range);
+
 	const List<NodePath> &get_spawn_properties();
 	const List<NodePath> &get_sync_properties();
 	const List<NodePath> &get_watch_properties();
 
+	// Aligned with the sync and watch properties, or nullptr when no property is quantized.
+	const Quantization *get_sync_quantizations();
+	const Quantization *get_watch_quantizations();
+
+	static Error encode_quantized_variant(const Variant &p_variant, const Quantization &p_quantization, uint8_t *r_buffer, int &r_len);
+	static Error decode_quantized_variant(Variant &r_variant, const Quantization &p_quantization, const uint8_t *p_buffer, int p_len, int *r_len);
+
 	SceneReplicationConfig() {}
 };
 
 VARIANT_ENUM_CAST(SceneReplicationConfig::ReplicationMode);
+VARIANT_ENUM_CAST(SceneReplicationConfig::QuantizationMode);
 
 #endif // SCENE_REPLICATION_CONFIG_H
@@ -34,8 +34,13 @@
 
 #include "core/debugger/engine_debugger.h"
 #include "core/io/marshalls.h"
+#include "scene/2d/node_2d.h"
 #include "scene/main/node.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif // _3D_DISABLED
+
 #define MAKE_ROOM(m_amount)             \
 	if (packet_cache.size() < m_amount) \
 		packet_cache.resize(m_amount);
@@ -52,6 +57,36 @@ _FORCE_INLINE_ void SceneReplicationInterface::_profile_node_data(const String &
 }
 #endif
 
+void SceneReplicationInterface::SyncHistory::push(uint16_t p_time, const Vector<Variant> &p_state) {
+	SyncSnapshot &snapshot = snapshots[count & (SYNC_HISTORY_SIZE - 1)];
+	snapshot.time = p_time;
+	snapshot.acked = false;
+	snapshot.state = p_state;
+	count++;
+}
+
+SceneReplicationInterface::SyncSnapshot *SceneReplicationInterface::SyncHistory::find(uint16_t p_time) {
+	const uint32_t size = MIN(count, SYNC_HISTORY_SIZE);
+	for (uint32_t i = 1; i <= size; i++) {
+		SyncSnapshot &snapshot = snapshots[(count - i) & (SYNC_HISTORY_SIZE - 1)];
+		if (snapshot.time == p_time) {
+			return &snapshot;
+		}
+	}
+	return nullptr;
+}
+
+const SceneReplicationInterface::SyncSnapshot *SceneReplicationInterface::SyncHistory::get_last_acked() const {
+	const uint32_t size = MIN(count, SYNC_HISTORY_SIZE);
+	for (uint32_t i = 1; i <= size; i++) {
+		const SyncSnapshot &snapshot = snapshots[(count - i) & (SYNC_HISTORY_SIZE - 1)];
+		if (snapshot.acked) {
+			return &snapshot;
+		}
+	}
+	return nullptr;
+}
+
 SceneReplicationInterface::TrackedNode &SceneReplicationInterface::_track(const ObjectID &p_id) {
 	if (!tracked_nodes.has(p_id)) {
 		tracked_nodes[p_id] = TrackedNode(p_id);
@@ -105,6 +140,7 @@ void SceneReplicationInterface::on_peer_change(int p_id, bool p_connected) {
 		ERR_FAIL_COND(!peers_info.has(p_id));
 		_free_remotes(peers_info[p_id]);
 		peers_info.erase(p_id);
+		peer_interests.erase(p_id);
 	}
 }
 
@@ -113,6 +149,9 @@ void SceneReplicationInterface::on_reset() {
 		_free_remotes(E.value);
 	}
 	peers_info.clear();
+	peer_interests.clear();
+	interest_entries.clear();
+	interest_cells.clear();
 	// Tracked nodes are cleared on deletion, here we only reset the ids so they can be later re-assigned.
 	for (KeyValue<ObjectID, TrackedNode> &E : tracked_nodes) {
 		TrackedNode &tobj = E.value;
@@ -141,9 +180,15 @@ void SceneReplicationInterface::on_network_process() {
 		spawn_queue.clear();
 	}
 
+	// Update spatial interest, which changes the synchronizers sent to each peer.
+	_update_interests();
+
 	// Process syncs.
 	uint64_t usec = OS::get_singleton()->get_ticks_usec();
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
+		if (!E.value.pending_acks.is_empty()) {
+			_send_sync_acks(E.key, E.value);
+		}
 		const HashSet<ObjectID> to_sync = E.value.sync_nodes;
 		if (to_sync.is_empty()) {
 			continue; // Nothing to sync
@@ -280,9 +325,15 @@ Error SceneReplicationInterface::on_replication_stop(Object *p_obj, Variant p_co
 	TrackedNode &tobj = _track(oid);
 	tobj.synchronizers.erase(sid);
 	sync_nodes.erase(sid);
+	_remove_interest_entry(sid);
+	for (KeyValue<int, PeerInterest> &E : peer_interests) {
+		E.value.relevant_syncs.erase(sid);
+	}
 	for (KeyValue<int, PeerInfo> &E : peers_info) {
 		E.value.sync_nodes.erase(sid);
 		E.value.last_watch_usecs.erase(sid);
+		E.value.sent_syncs.erase(sid);
+		E.value.recv_syncs.erase(sid);
 		if (sync->get_net_id()) {
 			E.value.recv_sync_ids.erase(sync->get_net_id());
 		}
@@ -352,7 +403,7 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 	if (p_peer == 0) {
 		for (KeyValue<int, PeerInfo> &E : peers_info) {
 			// Might be visible to this specific peer.
-			bool is_visible_to_peer = is_visible || p_sync->is_visible_to(E.key);
+			bool is_visible_to_peer = (is_visible || p_sync->is_visible_to(E.key)) && _is_relevant(E.key, p_sync);
 			if (is_visible_to_peer == E.value.sync_nodes.has(sid)) {
 				continue;
 			}
@@ -361,11 +412,13 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 			} else {
 				E.value.sync_nodes.erase(sid);
 				E.value.last_watch_usecs.erase(sid);
+				E.value.sent_syncs.erase(sid);
 			}
 		}
 		return OK;
 	} else {
 		ERR_FAIL_COND_V(!peers_info.has(p_peer), ERR_INVALID_PARAMETER);
+		is_visible = is_visible && _is_relevant(p_peer, p_sync);
 		if (is_visible == peers_info[p_peer].sync_nodes.has(sid)) {
 			return OK;
 		}
@@ -374,11 +427,187 @@ Error SceneReplicationInterface::_update_sync_visibility(int p_peer, Multiplayer
 		} else {
 			peers_info[p_peer].sync_nodes.erase(sid);
 			peers_info[p_peer].last_watch_usecs.erase(sid);
+			peers_info[p_peer].sent_syncs.erase(sid);
 		}
 		return OK;
 	}
 }
 
+static int64_t _get_interest_cell_coord(real_t p_value, real_t p_cell_size) {
+	// Clamped so the cell and the cell counts derived from it can't overflow.
+	const double limit = double(1LL << 52);
+	return int64_t(CLAMP(Math::floor(double(p_value) / double(p_cell_size)), -limit, limit));
+}
+
+SceneReplicationInterface::InterestCell SceneReplicationInterface::_get_interest_cell(const Vector3 &p_position) const {
+	InterestCell cell;
+	cell.x = _get_interest_cell_coord(p_position.x, interest_cell_size);
+	cell.y = _get_interest_cell_coord(p_position.y, interest_cell_size);
+	cell.z = _get_interest_cell_coord(p_position.z, interest_cell_size);
+	return cell;
+}
+
+void SceneReplicationInterface::_update_interests() {
+	if (peer_interests.is_empty()) {
+		return;
+	}
+	LocalVector<ObjectID> tracked;
+	_update_interest_grid(tracked);
+	for (KeyValue<int, PeerInterest> &E : peer_interests) {
+		if (peers_info.has(E.key)) {
+			_update_peer_interest(E.key, E.value);
+		}
+	}
+	// Synchronizers which started or stopped being tracked.
+	for (const ObjectID &sid : tracked) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		if (sync) {
+			_update_sync_visibility(0, sync);
+		}
+	}
+}
+
+void SceneReplicationInterface::_remove_interest_entry(const ObjectID &p_sid) {
+	const InterestEntry *entry = interest_entries.getptr(p_sid);
+	if (!entry) {
+		return;
+	}
+	LocalVector<ObjectID> *cell = interest_cells.getptr(entry->cell);
+	if (cell) {
+		cell->erase(p_sid);
+		if (cell->is_empty()) {
+			interest_cells.erase(entry->cell);
+		}
+	}
+	interest_entries.erase(p_sid);
+}
+
+void SceneReplicationInterface::_update_interest_grid(LocalVector<ObjectID> &r_tracked) {
+	// Only synchronizers that moved to another cell are touched in the grid.
+	for (const ObjectID &sid : sync_nodes) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		Node *node = sync && sync->is_spatial_interest_enabled() && _has_authority(sync) ? sync->get_root_node() : nullptr;
+		Vector3 position;
+		bool has_position = false;
+		if (node && node->is_inside_tree()) {
+#ifndef _3D_DISABLED
+			if (Node3D *node_3d = Object::cast_to<Node3D>(node)) {
+				position = node_3d->get_global_position();
+				has_position = true;
+			}
+#endif // _3D_DISABLED
+			if (Node2D *node_2d = Object::cast_to<Node2D>(node)) {
+				Vector2 position_2d = node_2d->get_global_position();
+				position = Vector3(position_2d.x, position_2d.y, 0);
+				has_position = true;
+			}
+		}
+		if (!has_position) {
+			if (interest_entries.has(sid)) {
+				_remove_interest_entry(sid);
+				r_tracked.push_back(sid);
+			}
+			continue;
+		}
+
+		InterestCell cell = _get_interest_cell(position);
+		InterestEntry *entry = interest_entries.getptr(sid);
+		if (entry && entry->cell == cell) {
+			entry->position = position;
+			continue;
+		}
+		if (entry) {
+			_remove_interest_entry(sid);
+		} else {
+			r_tracked.push_back(sid);
+		}
+		InterestEntry new_entry;
+		new_entry.cell = cell;
+		new_entry.position = position;
+		interest_entries.insert(sid, new_entry);
+		interest_cells[cell].push_back(sid);
+	}
+}
+
+void SceneReplicationInterface::_update_peer_interest(int p_peer, PeerInterest &r_interest) {
+	HashSet<ObjectID> relevant;
+	const real_t radius_squared = r_interest.radius * r_interest.radius;
+	const Vector3 extent = Vector3(r_interest.radius, r_interest.radius, r_interest.radius);
+	const InterestCell from = _get_interest_cell(r_interest.origin - extent);
+	const InterestCell to = _get_interest_cell(r_interest.origin + extent);
+	// Counted in floating point, the product of the spans can exceed 64 bits.
+	const double cell_count = double(to.x - from.x + 1) * double(to.y - from.y + 1) * double(to.z - from.z + 1);
+	if (cell_count > double(interest_cells.size())) {
+		// The radius covers more cells than are occupied, visit the occupied ones instead.
+		for (const KeyValue<InterestCell, LocalVector<ObjectID>> &E : interest_cells) {
+			for (const ObjectID &sid : E.value) {
+				if (interest_entries[sid].position.distance_squared_to(r_interest.origin) <= radius_squared) {
+					relevant.insert(sid);
+				}
+			}
+		}
+	} else {
+		InterestCell key;
+		for (key.z = from.z; key.z <= to.z; key.z++) {
+			for (key.y = from.y; key.y <= to.y; key.y++) {
+				for (key.x = from.x; key.x <= to.x; key.x++) {
+					const LocalVector<ObjectID> *cell = interest_cells.getptr(key);
+					if (!cell) {
+						continue;
+					}
+					for (const ObjectID &sid : *cell) {
+						if (interest_entries[sid].position.distance_squared_to(r_interest.origin) <= radius_squared) {
+							relevant.insert(sid);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Only synchronizers entering or leaving the radius need their visibility updated.
+	LocalVector<ObjectID> changed;
+	if (!r_interest.initialized) {
+		// Every tracked synchronizer was visible before the interest was set.
+		for (const KeyValue<ObjectID, InterestEntry> &E : interest_entries) {
+			changed.push_back(E.key);
+		}
+		r_interest.initialized = true;
+	} else {
+		for (const ObjectID &sid : relevant) {
+			if (!r_interest.relevant_syncs.has(sid)) {
+				changed.push_back(sid);
+			}
+		}
+		for (const ObjectID &sid : r_interest.relevant_syncs) {
+			if (!relevant.has(sid)) {
+				changed.push_back(sid);
+			}
+		}
+	}
+	r_interest.relevant_syncs = relevant;
+	for (const ObjectID &sid : changed) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(sid);
+		if (sync) {
+			_update_sync_visibility(p_peer, sync);
+		}
+	}
+}
+
+bool SceneReplicationInterface::_is_relevant(int p_peer, MultiplayerSynchronizer *p_sync) const {
+	if (!p_sync->is_spatial_interest_enabled()) {
+		return true;
+	}
+	const PeerInterest *interest = peer_interests.getptr(p_peer);
+	if (!interest) {
+		return true; // No interest set, everything is relevant.
+	}
+	if (!interest_entries.has(p_sync->get_instance_id())) {
+		return true; // Not tracked yet (e.g. outside the tree), keep the default visibility.
+	}
+	return interest->relevant_syncs.has(p_sync->get_instance_id());
+}
+
 Error SceneReplicationInterface::_update_spawn_visibility(int p_peer, const ObjectID &p_oid) {
 	const TrackedNode *tnode = tracked_nodes.getptr(p_oid);
 	ERR_FAIL_NULL_V(tnode, ERR_BUG);
@@ -465,6 +694,57 @@ Error SceneReplicationInterface::_send_raw(const uint8_t *p_buffer, int p_size,
 	return multiplayer->send_command(p_peer, p_buffer, p_size);
 }
 
+Error SceneReplicationInterface::_encode_state(const Variant **p_variants, int p_count, const SceneReplicationConfig::Quantization *p_quantizations, uint8_t *r_buffer, int &r_len) {
+	if (!p_quantizations) {
+		return MultiplayerAPI::encode_and_compress_variants(p_variants, p_count, r_buffer, r_len);
+	}
+	r_len = 0;
+	for (int i = 0; i < p_count; i++) {
+		int size = 0;
+		Error err;
+		if (p_quantizations[i].mode == SceneReplicationConfig::QUANTIZATION_NONE) {
+			err = MultiplayerAPI::encode_and_compress_variant(*p_variants[i], r_buffer ? r_buffer + r_len : nullptr, size, false);
+		} else {
+			err = SceneReplicationConfig::encode_quantized_variant(*p_variants[i], p_quantizations[i], r_buffer ? r_buffer + r_len : nullptr, size);
+		}
+		ERR_FAIL_COND_V(err != OK, err);
+		r_len += size;
+	}
+	return OK;
+}
+
+Error SceneReplicationInterface::_decode_state(Vector<Variant> &r_variants, const SceneReplicationConfig::Quantization *p_quantizations, const uint8_t *p_buffer, int p_len, int &r_len) {
+	if (!p_quantizations) {
+		return MultiplayerAPI::decode_and_decompress_variants(r_variants, p_buffer, p_len, r_len);
+	}
+	r_len = 0;
+	for (int i = 0; i < r_variants.size(); i++) {
+		ERR_FAIL_COND_V_MSG(r_len >= p_len, ERR_INVALID_DATA, "Invalid packet received. Size too small.");
+		int vlen = 0;
+		Error err;
+		if (p_quantizations[i].mode == SceneReplicationConfig::QUANTIZATION_NONE) {
+			err = MultiplayerAPI::decode_and_decompress_variant(r_variants.write[i], &p_buffer[r_len], p_len - r_len, &vlen, false);
+		} else {
+			err = SceneReplicationConfig::decode_quantized_variant(r_variants.write[i], p_quantizations[i], &p_buffer[r_len], p_len - r_len, &vlen);
+		}
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Invalid packet received. Unable to decode state variable.");
+		r_len += vlen;
+	}
+	return OK;
+}
+
+void SceneReplicationInterface::_get_delta_quantizations(const SceneReplicationConfig::Quantization *p_quantizations, int p_count, uint64_t p_indexes, LocalVector<SceneReplicationConfig::Quantization> &r_quantizations) {
+	r_quantizations.clear();
+	if (!p_quantizations) {
+		return;
+	}
+	for (int i = 0; i < p_count && i < 64; i++) {
+		if (p_indexes & (1ULL << i)) {
+			r_quantizations.push_back(p_quantizations[i]);
+		}
+	}
+}
+
 Error SceneReplicationInterface::_make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len) {
 	ERR_FAIL_COND_V(!multiplayer || !p_node || !p_spawner, ERR_BUG);
 
@@ -736,8 +1016,12 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			vptr[i] = &v;
 			i++;
 		}
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		LocalVector<SceneReplicationConfig::Quantization> quantizations;
+		_get_delta_quantizations(config->get_watch_quantizations(), config->get_watch_properties().size(), indexes, quantizations);
+		const SceneReplicationConfig::Quantization *quantizations_ptr = quantizations.is_empty() ? nullptr : quantizations.ptr();
 		int size;
-		Error err = MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), nullptr, size);
+		Error err = _encode_state(vptr, varp.size(), quantizations_ptr, nullptr, size);
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode delta state.");
 
 		ERR_CONTINUE_MSG(size > delta_mtu, vformat("Synchronizer delta bigger than MTU will not be sent (%d > %d): %s", size, delta_mtu, sync->get_path()));
@@ -751,7 +1035,7 @@ void SceneReplicationInterface::_send_delta(int p_peer, const HashSet<ObjectID>
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
 			ofs += encode_uint64(indexes, &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(vptr, varp.size(), &ptr[ofs], size);
+			_encode_state(vptr, varp.size(), quantizations_ptr, &ptr[ofs], size);
 			ofs += size;
 		}
 #ifdef DEBUG_ENABLED
@@ -783,10 +1067,13 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 		}
 		List<NodePath> props = sync->get_delta_properties(indexes);
 		ERR_FAIL_COND_V(props.is_empty(), ERR_INVALID_DATA);
+		SceneReplicationConfig *config = sync->get_replication_config_ptr();
+		LocalVector<SceneReplicationConfig::Quantization> quantizations;
+		_get_delta_quantizations(config->get_watch_quantizations(), config->get_watch_properties().size(), indexes, quantizations);
 		Vector<Variant> vars;
 		vars.resize(props.size());
 		int consumed = 0;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, p_buffer + ofs, size, consumed);
+		Error err = _decode_state(vars, quantizations.is_empty() ? nullptr : quantizations.ptr(), p_buffer + ofs, size, consumed);
 		ERR_FAIL_COND_V(err != OK, err);
 		ERR_FAIL_COND_V(uint32_t(consumed) != size, ERR_INVALID_DATA);
 		err = MultiplayerSynchronizer::set_state(props, node, vars);
@@ -801,11 +1088,15 @@ Error SceneReplicationInterface::on_delta_receive(int p_from, const uint8_t *p_b
 }
 
 void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec) {
-	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 4 + sync_mtu);
+	MAKE_ROOM(/* header */ 3 + /* element */ 4 + 2 + 4 + sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC;
 	int ofs = 1;
 	ofs += encode_uint16(p_sync_net_time, &ptr[1]);
+	PeerInfo &info = peers_info[p_peer];
+	SentSync &sent = info.sent_times[p_sync_net_time & (SYNC_HISTORY_SIZE - 1)];
+	sent.time = p_sync_net_time;
+	sent.synchronizers.clear();
 	// Can only send updates for already notified nodes.
 	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
 	for (const ObjectID &oid : p_synchronizers) {
@@ -826,22 +1117,58 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 		Vector<Variant> vars;
 		Vector<const Variant *> varp;
 		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
+		const SceneReplicationConfig::Quantization *quantizations = sync->get_replication_config_ptr()->get_sync_quantizations();
 		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
 		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
+
+		// Only send what changed since the last state the peer acknowledged, if any.
+		SyncHistory &history = info.sent_syncs[oid];
+		const SyncSnapshot *baseline = varp.size() <= 64 ? history.get_last_acked() : nullptr;
+		if (baseline && baseline->state.size() != vars.size()) {
+			baseline = nullptr; // The configuration changed.
+		}
+		uint16_t baseline_time = p_sync_net_time;
+		int mask_size = 0;
+		uint64_t indexes = 0;
+		LocalVector<const Variant *> changed;
+		LocalVector<SceneReplicationConfig::Quantization> changed_quantizations;
+		const Variant **state = varp.ptrw();
+		int state_count = varp.size();
+		if (baseline) {
+			baseline_time = baseline->time;
+			mask_size = (varp.size() + 7) / 8;
+			for (int i = 0; i < vars.size(); i++) {
+				if (!vars[i].hash_compare(baseline->state[i])) {
+					indexes |= 1ULL << i;
+					changed.push_back(state[i]);
+				}
+			}
+			_get_delta_quantizations(quantizations, vars.size(), indexes, changed_quantizations);
+			quantizations = changed_quantizations.is_empty() ? nullptr : changed_quantizations.ptr();
+			state = changed.ptr();
+			state_count = changed.size();
+		}
+		err = _encode_state(state, state_count, quantizations, nullptr, size);
 		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+		size += mask_size;
 		// TODO Handle single state above MTU.
 		ERR_CONTINUE_MSG(size > sync_mtu, vformat("Node states bigger than MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
-		if (ofs + 4 + 4 + size > sync_mtu) {
+		if (ofs + 4 + 2 + 4 + size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
 			ofs = 3;
 		}
 		if (size) {
 			ofs += encode_uint32(sync->get_net_id(), &ptr[ofs]);
+			ofs += encode_uint16(baseline_time, &ptr[ofs]);
 			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
-			ofs += size;
+			for (int i = 0; i < mask_size; i++) {
+				ptr[ofs++] = (indexes >> (i * 8)) & 0xFF;
+			}
+			_encode_state(state, state_count, quantizations, &ptr[ofs], size);
+			ofs += size - mask_size;
+			history.push(p_sync_net_time, vars);
+			sent.synchronizers.push_back(oid);
 		}
 #ifdef DEBUG_ENABLED
 		_profile_node_data("sync_out", oid, size);
@@ -853,17 +1180,63 @@ void SceneReplicationInterface::_send_sync(int p_peer, const HashSet<ObjectID> &
 	}
 }
 
+void SceneReplicationInterface::_send_sync_acks(int p_peer, PeerInfo &r_info) {
+	MAKE_ROOM(/* header */ 2 + /* element */ 4 * SYNC_HISTORY_SIZE);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = SceneMultiplayer::NETWORK_COMMAND_SYNC | (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT);
+	ptr[1] = r_info.pending_acks.size();
+	int ofs = 2;
+	for (const SyncAck &ack : r_info.pending_acks) {
+		ofs += encode_uint16(ack.time, &ptr[ofs]);
+		ofs += encode_uint16(ack.entries, &ptr[ofs]);
+	}
+	r_info.pending_acks.clear();
+	_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+}
+
+Error SceneReplicationInterface::on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 2 || p_buffer_len != 2 + p_buffer[1] * 4, ERR_INVALID_DATA, "Invalid sync acknowledgement received");
+	PeerInfo *info = peers_info.getptr(p_from);
+	ERR_FAIL_NULL_V(info, ERR_INVALID_DATA);
+	for (int ofs = 2; ofs < p_buffer_len; ofs += 4) {
+		uint16_t time = decode_uint16(&p_buffer[ofs]);
+		uint16_t entries = decode_uint16(&p_buffer[ofs + 2]);
+		const SentSync &sent = info->sent_times[time & (SYNC_HISTORY_SIZE - 1)];
+		if (sent.time != time || sent.synchronizers.size() != entries) {
+			// Too old, or some of the states never made it, so they can't be used as a baseline.
+			continue;
+		}
+		for (const ObjectID &oid : sent.synchronizers) {
+			SyncHistory *history = info->sent_syncs.getptr(oid);
+			SyncSnapshot *snapshot = history ? history->find(time) : nullptr;
+			if (snapshot) {
+				snapshot->acked = true;
+			}
+		}
+	}
+	return OK;
+}
+
 Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
-	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 1, ERR_INVALID_DATA, "Invalid sync packet received");
+	if (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_1_SHIFT)) {
+		return on_sync_ack_receive(p_from, p_buffer, p_buffer_len);
+	}
 	bool is_delta = (p_buffer[0] & (1 << SceneMultiplayer::CMD_FLAG_0_SHIFT)) != 0;
 	if (is_delta) {
+		ERR_FAIL_COND_V_MSG(p_buffer_len < 17, ERR_INVALID_DATA, "Invalid sync packet received");
 		return on_delta_receive(p_from, p_buffer, p_buffer_len);
 	}
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 13, ERR_INVALID_DATA, "Invalid sync packet received");
+	ERR_FAIL_COND_V(!peers_info.has(p_from), ERR_INVALID_DATA);
 	uint16_t time = decode_uint16(&p_buffer[1]);
+	uint16_t stored = 0;
 	int ofs = 3;
-	while (ofs + 8 < p_buffer_len) {
+	while (ofs + 10 < p_buffer_len) {
 		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
+		uint16_t baseline_time = decode_uint16(&p_buffer[ofs]);
+		ofs += 2;
 		uint32_t size = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
 		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
@@ -879,18 +1252,60 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 			ofs += size;
 			ERR_CONTINUE_MSG(true, "Ignoring sync data from non-authority or for missing node.");
 		}
+		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
+		SyncHistory &history = peers_info[p_from].recv_syncs[sync->get_instance_id()];
+		const SyncSnapshot *baseline = nullptr;
+		if (baseline_time != time) {
+			baseline = history.find(baseline_time);
+			if (!baseline || baseline->state.size() != props.size()) {
+				// Lost track of the baseline, the sender falls back to a full state once it runs out of history.
+				ofs += size;
+				continue;
+			}
+		}
 		if (!sync->update_inbound_sync_time(time)) {
 			// State is too old.
 			ofs += size;
 			continue;
 		}
-		const List<NodePath> props = sync->get_replication_config_ptr()->get_sync_properties();
+		const SceneReplicationConfig::Quantization *quantizations = sync->get_replication_config_ptr()->get_sync_quantizations();
 		Vector<Variant> vars;
-		vars.resize(props.size());
 		int consumed;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs], size, consumed);
-		ERR_FAIL_COND_V(err, err);
-		err = MultiplayerSynchronizer::set_state(props, node, vars);
+		if (baseline) {
+			// Only the changed properties are sent, the others are taken from the baseline.
+			const int mask_size = (props.size() + 7) / 8;
+			ERR_FAIL_COND_V(props.size() > 64 || size < uint32_t(mask_size), ERR_INVALID_DATA);
+			uint64_t indexes = 0;
+			for (int i = 0; i < mask_size; i++) {
+				indexes |= uint64_t(p_buffer[ofs + i]) << (i * 8);
+			}
+			ERR_FAIL_COND_V(props.size() < 64 && (indexes >> props.size()), ERR_INVALID_DATA);
+			LocalVector<SceneReplicationConfig::Quantization> changed_quantizations;
+			_get_delta_quantizations(quantizations, props.size(), indexes, changed_quantizations);
+			int changed_count = 0;
+			for (uint64_t bits = indexes; bits; bits &= bits - 1) {
+				changed_count++;
+			}
+			Vector<Variant> changed;
+			changed.resize(changed_count);
+			Error err = _decode_state(changed, changed_quantizations.is_empty() ? nullptr : changed_quantizations.ptr(), &p_buffer[ofs + mask_size], size - mask_size, consumed);
+			ERR_FAIL_COND_V(err, err);
+			vars = baseline->state;
+			Variant *vars_ptr = vars.ptrw();
+			int change = 0;
+			for (int i = 0; i < props.size(); i++) {
+				if (indexes & (1ULL << i)) {
+					vars_ptr[i] = changed[change++];
+				}
+			}
+		} else {
+			vars.resize(props.size());
+			Error err = _decode_state(vars, quantizations, &p_buffer[ofs], size, consumed);
+			ERR_FAIL_COND_V(err, err);
+		}
+		history.push(time, vars);
+		stored++;
+		Error err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err, err);
 		ofs += size;
 		sync->emit_signal(SNAME("synchronized"));
@@ -898,6 +1313,23 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 		_profile_node_data("sync_in", sync->get_instance_id(), size);
 #endif
 	}
+	PeerInfo *info = peers_info.getptr(p_from);
+	if (info && stored) {
+		// Acknowledged on the next network process. A sync might be split across packets, so add to its count.
+		for (SyncAck &ack : info->pending_acks) {
+			if (ack.time == time) {
+				ack.entries += stored;
+				return OK;
+			}
+		}
+		if (info->pending_acks.size() == SYNC_HISTORY_SIZE) {
+			info->pending_acks.remove_at(0);
+		}
+		SyncAck ack;
+		ack.time = time;
+		ack.entries = stored;
+		info->pending_acks.push_back(ack);
+	}
 	return OK;
 }
 
@@ -918,3 +1350,37 @@ void SceneReplicationInterface::set_max_delta_packet_size(int p_size) {
 int SceneReplicationInterface::get_max_delta_packet_size() const {
 	return delta_mtu;
 }
+
+Error SceneReplicationInterface::set_peer_interest(int p_peer, const Vector3 &p_origin, real_t p_radius) {
+	ERR_FAIL_COND_V_MSG(p_peer < 1, ERR_INVALID_PARAMETER, "Interest can only be set for a specific peer.");
+	ERR_FAIL_COND_V_MSG(p_radius <= 0, ERR_INVALID_PARAMETER, "Interest radius must be greater than zero.");
+	PeerInterest &interest = peer_interests[p_peer];
+	interest.origin = p_origin;
+	interest.radius = p_radius;
+	return OK;
+}
+
+void SceneReplicationInterface::remove_peer_interest(int p_peer) {
+	if (!peer_interests.erase(p_peer) || !peers_info.has(p_peer)) {
+		return;
+	}
+	// All spatial synchronizers become relevant again.
+	for (const KeyValue<ObjectID, InterestEntry> &E : interest_entries) {
+		MultiplayerSynchronizer *sync = get_id_as<MultiplayerSynchronizer>(E.key);
+		if (sync) {
+			_update_sync_visibility(p_peer, sync);
+		}
+	}
+}
+
+void SceneReplicationInterface::set_interest_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Interest cell size must be greater than zero.");
+	interest_cell_size = p_size;
+	// Rebuilt on the next update.
+	interest_entries.clear();
+	interest_cells.clear();
+}
+
+real_t SceneReplicationInterface::get_interest_cell_size() const {
+	return interest_cell_size;
+}
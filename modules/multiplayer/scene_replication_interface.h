@@ -60,6 +60,35 @@ private:
 		}
 	};
 
+	// Sync states are delta encoded against the last state the peer acknowledged.
+	// Both sides keep the states of the last SYNC_HISTORY_SIZE syncs of each synchronizer.
+	static constexpr uint32_t SYNC_HISTORY_SIZE = 32; // Must be a power of two.
+
+	struct SyncSnapshot {
+		uint16_t time = 0;
+		bool acked = false;
+		Vector<Variant> state;
+	};
+
+	struct SyncHistory {
+		SyncSnapshot snapshots[SYNC_HISTORY_SIZE];
+		uint32_t count = 0;
+
+		void push(uint16_t p_time, const Vector<Variant> &p_state);
+		SyncSnapshot *find(uint16_t p_time);
+		const SyncSnapshot *get_last_acked() const;
+	};
+
+	struct SentSync {
+		uint16_t time = 0;
+		LocalVector<ObjectID> synchronizers;
+	};
+
+	struct SyncAck {
+		uint16_t time = 0;
+		uint16_t entries = 0;
+	};
+
 	struct PeerInfo {
 		HashSet<ObjectID> sync_nodes;
 		HashSet<ObjectID> spawn_nodes;
@@ -67,6 +96,13 @@ private:
 		HashMap<uint32_t, ObjectID> recv_sync_ids;
 		HashMap<uint32_t, ObjectID> recv_nodes;
 		uint16_t last_sent_sync = 0;
+
+		// Sync states sent to this peer, and the synchronizers sent in each sync.
+		HashMap<ObjectID, SyncHistory> sent_syncs;
+		SentSync sent_times[SYNC_HISTORY_SIZE];
+		// Sync states received from this peer, and the acknowledgements to send back.
+		HashMap<ObjectID, SyncHistory> recv_syncs;
+		LocalVector<SyncAck> pending_acks;
 	};
 
 	// Replication state.
@@ -76,6 +112,42 @@ private:
 	HashSet<ObjectID> spawned_nodes;
 	HashSet<ObjectID> sync_nodes;
 
+	// Spatial interest management.
+	struct PeerInterest {
+		Vector3 origin;
+		real_t radius = 0.0;
+		bool initialized = false;
+		HashSet<ObjectID> relevant_syncs; // Spatial synchronizers within radius on the last update.
+	};
+
+	// Cell coordinates are 64-bit, Vector3i would overflow for far away positions with small cells.
+	struct InterestCell {
+		int64_t x = 0;
+		int64_t y = 0;
+		int64_t z = 0;
+
+		static uint32_t hash(const InterestCell &p_cell) {
+			uint32_t h = hash_murmur3_one_64(p_cell.x);
+			h = hash_murmur3_one_64(p_cell.y, h);
+			h = hash_murmur3_one_64(p_cell.z, h);
+			return hash_fmix32(h);
+		}
+
+		bool operator==(const InterestCell &p_other) const {
+			return x == p_other.x && y == p_other.y && z == p_other.z;
+		}
+	};
+
+	struct InterestEntry {
+		InterestCell cell;
+		Vector3 position;
+	};
+
+	HashMap<int, PeerInterest> peer_interests;
+	HashMap<ObjectID, InterestEntry> interest_entries; // Spatial synchronizers we have authority over.
+	HashMap<InterestCell, LocalVector<ObjectID>, InterestCell> interest_cells;
+	real_t interest_cell_size = 64.0;
+
 	// Pending local spawn information (handles spawning nested nodes during ready).
 	HashSet<ObjectID> spawn_queue;
 
@@ -102,16 +174,28 @@ private:
 	MultiplayerSynchronizer *_find_synchronizer(int p_peer, uint32_t p_net_ida);
 
 	void _send_sync(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint16_t p_sync_net_time, uint64_t p_usec);
+	void _send_sync_acks(int p_peer, PeerInfo &r_info);
 	void _send_delta(int p_peer, const HashSet<ObjectID> &p_synchronizers, uint64_t p_usec, const HashMap<ObjectID, uint64_t> &p_last_watch_usecs);
 	Error _make_spawn_packet(Node *p_node, MultiplayerSpawner *p_spawner, int &r_len);
 	Error _make_despawn_packet(Node *p_node, int &r_len);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
 
+	static Error _encode_state(const Variant **p_variants, int p_count, const SceneReplicationConfig::Quantization *p_quantizations, uint8_t *r_buffer, int &r_len);
+	static Error _decode_state(Vector<Variant> &r_variants, const SceneReplicationConfig::Quantization *p_quantizations, const uint8_t *p_buffer, int p_len, int &r_len);
+	static void _get_delta_quantizations(const SceneReplicationConfig::Quantization *p_quantizations, int p_count, uint64_t p_indexes, LocalVector<SceneReplicationConfig::Quantization> &r_quantizations);
+
 	void _visibility_changed(int p_peer, ObjectID p_oid);
 	Error _update_sync_visibility(int p_peer, MultiplayerSynchronizer *p_sync);
 	Error _update_spawn_visibility(int p_peer, const ObjectID &p_oid);
 	void _free_remotes(const PeerInfo &p_info);
 
+	InterestCell _get_interest_cell(const Vector3 &p_position) const;
+	void _remove_interest_entry(const ObjectID &p_sid);
+	void _update_interests();
+	void _update_interest_grid(LocalVector<ObjectID> &r_tracked);
+	void _update_peer_interest(int p_peer, PeerInterest &r_interest);
+	bool _is_relevant(int p_peer, MultiplayerSynchronizer *p_sync) const;
+
 	template <typename T>
 	static T *get_id_as(const ObjectID &p_id) {
 		return p_id.is_valid() ? Object::cast_to<T>(ObjectDB::get_instance(p_id)) : nullptr;
@@ -137,6 +221,7 @@ public:
 	Error on_despawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 	Error on_delta_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
+	Error on_sync_ack_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len);
 
 	bool is_rpc_visible(const ObjectID &p_oid, int p_peer) const;
 
@@ -146,6 +231,12 @@ public:
 	void set_max_delta_packet_size(int p_size);
 	int get_max_delta_packet_size() const;
 
+	Error set_peer_interest(int p_peer, const Vector3 &p_origin, real_t p_radius);
+	void remove_peer_interest(int p_peer);
+
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+
 	SceneReplicationInterface(SceneMultiplayer *p_multiplayer, SceneCacheInterface *p_cache) {
 		multiplayer = p_multiplayer;
 		multiplayer_cache = p_cache;
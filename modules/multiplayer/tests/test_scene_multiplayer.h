@@ -66,6 +66,7 @@ TEST_CASE("[Multiplayer][SceneMultiplayer] Defaults") {
 	CHECK(scene_multiplayer->is_server_relay_enabled());
 	CHECK_EQ(scene_multiplayer->get_max_sync_packet_size(), 1350);
 	CHECK_EQ(scene_multiplayer->get_max_delta_packet_size(), 65535);
+	CHECK_EQ(scene_multiplayer->get_interest_cell_size(), 64.0);
 	CHECK(scene_multiplayer->is_server());
 }
 
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  test_scene_replication_config.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_CONFIG_H
+#define TEST_SCENE_REPLICATION_CONFIG_H
+
+#include "tests/test_macros.h"
+
+#include "../scene_replication_config.h"
+
+namespace TestSceneReplicationConfig {
+
+static Variant quantize_round_trip(const Variant &p_value, const SceneReplicationConfig::Quantization &p_quantization, int &r_len) {
+	int len = 0;
+	Error err = SceneReplicationConfig::encode_quantized_variant(p_value, p_quantization, nullptr, len);
+	REQUIRE(err == OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	err = SceneReplicationConfig::encode_quantized_variant(p_value, p_quantization, buffer.ptrw(), r_len);
+	REQUIRE(err == OK);
+	REQUIRE(r_len == len);
+
+	Variant decoded;
+	int consumed = 0;
+	err = SceneReplicationConfig::decode_quantized_variant(decoded, p_quantization, buffer.ptr(), buffer.size(), &consumed);
+	REQUIRE(err == OK);
+	CHECK(consumed == len);
+	return decoded;
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Quantization settings") {
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(".:position"));
+	config->add_property(NodePath(".:name"));
+
+	CHECK(config->property_get_quantization(NodePath(".:position")) == SceneReplicationConfig::QUANTIZATION_NONE);
+	CHECK(config->get_sync_quantizations() == nullptr);
+
+	config->property_set_quantization(NodePath(".:position"), SceneReplicationConfig::QUANTIZATION_FIXED_POINT);
+	config->property_set_quantization_bits(NodePath(".:position"), 12);
+	config->property_set_quantization_range(NodePath(".:position"), Vector2(-100, 100));
+	CHECK(config->property_get_quantization_bits(NodePath(".:position")) == 12);
+	CHECK(config->property_get_quantization_range(NodePath(".:position")) == Vector2(-100, 100));
+
+	const SceneReplicationConfig::Quantization *quantizations = config->get_sync_quantizations();
+	REQUIRE(quantizations != nullptr);
+	CHECK(quantizations[0].mode == SceneReplicationConfig::QUANTIZATION_FIXED_POINT);
+	CHECK(quantizations[0].bits == 12);
+	CHECK(quantizations[1].mode == SceneReplicationConfig::QUANTIZATION_NONE);
+
+	ERR_PRINT_OFF;
+	config->property_set_quantization_bits(NodePath(".:position"), 33);
+	config->property_set_quantization_range(NodePath(".:position"), Vector2(1, 1));
+	ERR_PRINT_ON;
+	CHECK(config->property_get_quantization_bits(NodePath(".:position")) == 12);
+	CHECK(config->property_get_quantization_range(NodePath(".:position")) == Vector2(-100, 100));
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Fixed point quantization") {
+	SceneReplicationConfig::Quantization quantization;
+	quantization.mode = SceneReplicationConfig::QUANTIZATION_FIXED_POINT;
+	quantization.bits = 16;
+	quantization.range_min = -512;
+	quantization.range_max = 512;
+	const real_t precision = (quantization.range_max - quantization.range_min) / 65535;
+
+	int len = 0;
+	Vector3 decoded = quantize_round_trip(Vector3(1.5, -200.25, 511), quantization, len);
+	CHECK(len == 7);
+	CHECK(decoded.distance_to(Vector3(1.5, -200.25, 511)) <= precision);
+
+	// Out of range values are clamped.
+	decoded = quantize_round_trip(Vector3(1000, -1000, 0), quantization, len);
+	CHECK(decoded.is_equal_approx(Vector3(512, -512, decoded.z)));
+
+	double decoded_float = quantize_round_trip(3.25, quantization, len);
+	CHECK(len == 3);
+	CHECK(Math::abs(decoded_float - 3.25) <= precision);
+
+	// Unsupported types are sent unchanged.
+	Variant decoded_string = quantize_round_trip("text", quantization, len);
+	CHECK(decoded_string == Variant("text"));
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationConfig] Smallest three quaternion quantization") {
+	SceneReplicationConfig::Quantization quantization;
+	quantization.mode = SceneReplicationConfig::QUANTIZATION_SMALLEST_THREE;
+	quantization.bits = 10;
+
+	Quaternion rotation = Quaternion(Vector3(1, 2, 3).normalized(), 2.5);
+	int len = 0;
+	Quaternion decoded = quantize_round_trip(rotation, quantization, len);
+	// 2 bits for the dropped component and 3 * 10 bits.
+	CHECK(len == 5);
+	CHECK(decoded.is_normalized());
+	CHECK(Math::abs(decoded.dot(rotation)) > 0.999);
+
+	decoded = quantize_round_trip(-rotation, quantization, len);
+	CHECK(Math::abs(decoded.dot(rotation)) > 0.999);
+}
+
+} // namespace TestSceneReplicationConfig
+
+#endif // TEST_SCENE_REPLICATION_CONFIG_H
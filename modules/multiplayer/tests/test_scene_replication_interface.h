@@ -0,0 +1,348 @@
+/**************************************************************************/
+/*  test_scene_replication_interface.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_INTERFACE_H
+#define TEST_SCENE_REPLICATION_INTERFACE_H
+
+#include "tests/test_macros.h"
+
+#include "../multiplayer_synchronizer.h"
+#include "../scene_multiplayer.h"
+#include "../scene_replication_interface.h"
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
+
+// Delivers packets to the linked peer on the next poll. Unreliable packets can be dropped on purpose.
+class LoopbackMultiplayerPeer : public MultiplayerPeer {
+	GDCLASS(LoopbackMultiplayerPeer, MultiplayerPeer);
+
+	struct Packet {
+		Vector<uint8_t> data;
+		TransferMode mode = TRANSFER_MODE_RELIABLE;
+		int channel = 0;
+	};
+
+	int unique_id = 0;
+	LoopbackMultiplayerPeer *remote = nullptr;
+	List<Packet> incoming;
+	Packet current;
+
+public:
+	bool drop_unreliable = false;
+	uint64_t unreliable_bytes = 0; // Sent, including the dropped ones.
+
+	static void link(LoopbackMultiplayerPeer *p_server, LoopbackMultiplayerPeer *p_client, int p_client_id) {
+		p_server->unique_id = MultiplayerPeer::TARGET_PEER_SERVER;
+		p_server->remote = p_client;
+		p_client->unique_id = p_client_id;
+		p_client->remote = p_server;
+	}
+
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current = incoming.front()->get();
+		incoming.pop_front();
+		*r_buffer = current.data.ptr();
+		r_buffer_size = current.data.size();
+		return OK;
+	}
+
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		ERR_FAIL_NULL_V(remote, ERR_UNCONFIGURED);
+		if (get_transfer_mode() != TRANSFER_MODE_RELIABLE) {
+			unreliable_bytes += p_buffer_size;
+			if (drop_unreliable) {
+				return OK;
+			}
+		}
+		Packet packet;
+		packet.data.resize(p_buffer_size);
+		memcpy(packet.data.ptrw(), p_buffer, p_buffer_size);
+		packet.mode = get_transfer_mode();
+		packet.channel = get_transfer_channel();
+		remote->incoming.push_back(packet);
+		return OK;
+	}
+
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual void set_target_peer(int p_peer_id) override {}
+	virtual int get_packet_peer() const override { return remote ? remote->unique_id : 0; }
+	virtual TransferMode get_packet_mode() const override { return incoming.is_empty() ? TRANSFER_MODE_RELIABLE : incoming.front()->get().mode; }
+	virtual int get_packet_channel() const override { return incoming.is_empty() ? 0 : incoming.front()->get().channel; }
+	virtual void disconnect_peer(int p_peer, bool p_force = false) override {}
+	virtual bool is_server() const override { return unique_id == MultiplayerPeer::TARGET_PEER_SERVER; }
+	virtual void poll() override {}
+	virtual void close() override { remote = nullptr; }
+	virtual int get_unique_id() const override { return unique_id; }
+	virtual ConnectionStatus get_connection_status() const override { return remote ? CONNECTION_CONNECTED : CONNECTION_DISCONNECTED; }
+};
+
+namespace TestSceneReplicationInterface {
+
+// A server and a client in the same tree, under "/root/Server" and "/root/Client".
+struct ReplicationLoopback {
+	Ref<LoopbackMultiplayerPeer> server_peer;
+	Ref<LoopbackMultiplayerPeer> client_peer;
+	Ref<SceneMultiplayer> server;
+	Ref<SceneMultiplayer> client;
+	Node *server_root = nullptr;
+	Node *client_root = nullptr;
+
+	static Node *create_root(const String &p_name, const Ref<SceneMultiplayer> &p_multiplayer) {
+		Node *root = memnew(Node);
+		root->set_name(p_name);
+		SceneTree::get_singleton()->get_root()->add_child(root);
+		SceneTree::get_singleton()->set_multiplayer(p_multiplayer, root->get_path());
+		return root;
+	}
+
+	// Adds a player with a synchronizer at the same path on both sides.
+	Node2D *add_player(Node *p_root, const Ref<SceneReplicationConfig> &p_config) {
+		Node2D *player = memnew(Node2D);
+		player->set_name("Player");
+		MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+		sync->set_name("Sync");
+		sync->set_replication_config(p_config);
+		player->add_child(sync);
+		p_root->add_child(player);
+		return player;
+	}
+
+	// Polls the server then the client, returns the bytes of unreliable syncs sent by the server.
+	uint64_t tick() {
+		const uint64_t sent = server_peer->unreliable_bytes;
+		server->poll();
+		client->poll();
+		return server_peer->unreliable_bytes - sent;
+	}
+
+	ReplicationLoopback() {
+		GDREGISTER_CLASS(LoopbackMultiplayerPeer);
+		server.instantiate();
+		client.instantiate();
+		server_root = create_root("Server", server);
+		client_root = create_root("Client", client);
+
+		server_peer.instantiate();
+		client_peer.instantiate();
+		LoopbackMultiplayerPeer::link(server_peer.ptr(), client_peer.ptr(), 2);
+		server->set_multiplayer_peer(server_peer);
+		client->set_multiplayer_peer(client_peer);
+		server_peer->emit_signal(SNAME("peer_connected"), client_peer->get_unique_id());
+		client_peer->emit_signal(SNAME("peer_connected"), server_peer->get_unique_id());
+	}
+
+	~ReplicationLoopback() {
+		const NodePath server_path = server_root->get_path();
+		const NodePath client_path = client_root->get_path();
+		memdelete(server_root);
+		memdelete(client_root);
+		server->set_multiplayer_peer(Ref<MultiplayerPeer>());
+		client->set_multiplayer_peer(Ref<MultiplayerPeer>());
+		SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), server_path);
+		SceneTree::get_singleton()->set_multiplayer(Ref<MultiplayerAPI>(), client_path);
+		server_peer->close();
+		client_peer->close();
+	}
+};
+
+// Changes the rotation on the server, returns whether the client received it.
+static bool is_rotation_synced(ReplicationLoopback &p_loopback, Node2D *p_server_player, Node2D *p_client_player) {
+	p_server_player->set_rotation(p_server_player->get_rotation() + 0.25);
+	p_loopback.tick();
+	return p_client_player->get_rotation() == p_server_player->get_rotation();
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface][SceneTree] Spatial interest") {
+	ReplicationLoopback loopback;
+	loopback.server->set_interest_cell_size(64.0);
+	const int peer_id = loopback.client_peer->get_unique_id();
+
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":rotation"));
+
+	Node2D *server_player = loopback.add_player(loopback.server_root, config);
+	Node2D *client_player = loopback.add_player(loopback.client_root, config);
+	Object::cast_to<MultiplayerSynchronizer>(server_player->get_node(NodePath("Sync")))->set_spatial_interest_enabled(true);
+
+	// Without an interest area everything is sent, once the synchronizer path is confirmed.
+	loopback.tick();
+	CHECK(is_rotation_synced(loopback, server_player, client_player));
+
+	SUBCASE("Peer in range") {
+		server_player->set_position(Vector2(5, 0));
+		CHECK_EQ(loopback.server->set_peer_interest(peer_id, Vector3(0, 0, 0), 10.0), OK);
+		CHECK(is_rotation_synced(loopback, server_player, client_player));
+	}
+
+	SUBCASE("Peer out of range") {
+		server_player->set_position(Vector2(5, 0));
+		CHECK_EQ(loopback.server->set_peer_interest(peer_id, Vector3(30, 0, 0), 10.0), OK);
+		CHECK_FALSE(is_rotation_synced(loopback, server_player, client_player));
+
+		// Removing the interest area makes it relevant again.
+		loopback.server->remove_peer_interest(peer_id);
+		CHECK(is_rotation_synced(loopback, server_player, client_player));
+	}
+
+	SUBCASE("Peer moving between cells") {
+		server_player->set_position(Vector2(70, 0));
+		CHECK_EQ(loopback.server->set_peer_interest(peer_id, Vector3(0, 0, 0), 20.0), OK);
+		CHECK_FALSE(is_rotation_synced(loopback, server_player, client_player));
+
+		// The area now spans the cell boundary at 64.
+		loopback.server->set_peer_interest(peer_id, Vector3(55, 0, 0), 20.0);
+		CHECK(is_rotation_synced(loopback, server_player, client_player));
+
+		// Fully inside the next cell.
+		loopback.server->set_peer_interest(peer_id, Vector3(80, 0, 0), 20.0);
+		CHECK(is_rotation_synced(loopback, server_player, client_player));
+
+		// The node follows into another cell, and the peer moves away.
+		server_player->set_position(Vector2(-70, 0));
+		CHECK_FALSE(is_rotation_synced(loopback, server_player, client_player));
+		loopback.server->set_peer_interest(peer_id, Vector3(-60, 5, 0), 20.0);
+		CHECK(is_rotation_synced(loopback, server_player, client_player));
+	}
+
+	SUBCASE("Cells beyond the 32-bit range") {
+		// With 1 unit cells, these positions are far outside the range of Vector3i cell coordinates.
+		loopback.server->set_interest_cell_size(1.0);
+		server_player->set_position(Vector2(3e11, 0));
+		loopback.server->set_peer_interest(peer_id, Vector3(3e11, 0, 0), 10.0);
+		CHECK(is_rotation_synced(loopback, server_player, client_player));
+
+		loopback.server->set_peer_interest(peer_id, Vector3(-3e11, 0, 0), 10.0);
+		CHECK_FALSE(is_rotation_synced(loopback, server_player, client_player));
+	}
+
+	SUBCASE("Fails with a radius not greater than zero") {
+		ERR_PRINT_OFF;
+		CHECK_EQ(loopback.server->set_peer_interest(peer_id, Vector3(), 0.0), ERR_INVALID_PARAMETER);
+		CHECK_EQ(loopback.server->set_peer_interest(peer_id, Vector3(), -1.0), ERR_INVALID_PARAMETER);
+		CHECK_EQ(loopback.server->set_peer_interest(0, Vector3(), 1.0), ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+	}
+}
+
+static void check_player_synced(const Node2D *p_server_player, const Node2D *p_client_player) {
+	CHECK_EQ(p_client_player->get_position(), p_server_player->get_position());
+	CHECK_EQ(p_client_player->get_rotation(), p_server_player->get_rotation());
+	CHECK_EQ(p_client_player->get_scale(), p_server_player->get_scale());
+	CHECK_EQ(p_client_player->get_modulate(), p_server_player->get_modulate());
+}
+
+TEST_CASE("[Multiplayer][SceneReplicationInterface][SceneTree] Sync states are delta encoded against acknowledged states") {
+	ReplicationLoopback loopback;
+
+	Ref<SceneReplicationConfig> config;
+	config.instantiate();
+	config->add_property(NodePath(":position"));
+	config->add_property(NodePath(":rotation"));
+	config->add_property(NodePath(":scale"));
+	config->add_property(NodePath(":modulate"));
+
+	Node2D *server_player = loopback.add_player(loopback.server_root, config);
+	Node2D *client_player = loopback.add_player(loopback.client_root, config);
+	server_player->set_rotation(0.5);
+	server_player->set_scale(Vector2(2, 3));
+	server_player->set_modulate(Color(0.1, 0.2, 0.3, 0.4));
+
+	// The synchronizer path is confirmed first, then the whole state is sent.
+	uint64_t full_bytes = 0;
+	for (int i = 0; i < 4 && full_bytes == 0; i++) {
+		full_bytes = loopback.tick();
+	}
+	REQUIRE(full_bytes > 0);
+	check_player_synced(server_player, client_player);
+
+	// Header, synchronizer ID, baseline, size and a one byte mask of the changed properties.
+	const uint64_t unchanged_bytes = 3 + 4 + 2 + 4 + 1;
+
+	SUBCASE("Only changed properties are sent") {
+		uint64_t moving_bytes = 0;
+		for (int i = 0; i < 60; i++) {
+			server_player->set_position(Vector2(i, -i));
+			moving_bytes += loopback.tick();
+			check_player_synced(server_player, client_player);
+		}
+		// A Vector2 instead of the four properties.
+		CHECK(moving_bytes / 60 < full_bytes);
+
+		CHECK_EQ(loopback.tick(), unchanged_bytes);
+		server_player->set_rotation(1.5);
+		server_player->set_modulate(Color(1, 1, 1));
+		CHECK(loopback.tick() > unchanged_bytes);
+		check_player_synced(server_player, client_player);
+		CHECK_EQ(loopback.tick(), unchanged_bytes);
+	}
+
+	SUBCASE("Lost sync packets") {
+		loopback.server_peer->drop_unreliable = true;
+		for (int i = 0; i < 5; i++) {
+			server_player->set_position(Vector2(i, i));
+			loopback.tick();
+		}
+		CHECK_EQ(client_player->get_position(), Vector2());
+
+		// Encoded against the last state the client acknowledged, before the loss.
+		loopback.server_peer->drop_unreliable = false;
+		server_player->set_scale(Vector2(4, 4));
+		CHECK(loopback.tick() < full_bytes);
+		check_player_synced(server_player, client_player);
+		CHECK_EQ(loopback.tick(), unchanged_bytes);
+	}
+
+	SUBCASE("Lost acknowledgements") {
+		loopback.client_peer->drop_unreliable = true;
+		uint64_t bytes = 0;
+		for (int i = 0; i < 40; i++) {
+			server_player->set_position(Vector2(i, i));
+			bytes = loopback.tick();
+			check_player_synced(server_player, client_player);
+		}
+		// The acknowledged state is no longer in the history, so the whole state is sent.
+		CHECK_EQ(bytes, full_bytes);
+
+		loopback.client_peer->drop_unreliable = false;
+		loopback.tick();
+		CHECK_EQ(loopback.tick(), unchanged_bytes);
+		check_player_synced(server_player, client_player);
+	}
+}
+
+} // namespace TestSceneReplicationInterface
+
+#endif // TEST_SCENE_REPLICATION_INTERFACE_H
@@ -1161,6 +1161,16 @@ void GodotNavigationServer3D::bake_from_source_geometry_data_async(const Ref<Nav
 #endif // _3D_DISABLED
 }
 
+void GodotNavigationServer3D::rebake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData3D.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->rebake_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_dirty_aabb, p_callback);
+#endif // _3D_DISABLED
+}
+
 bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const {
 #ifdef _3D_DISABLED
 	return false;
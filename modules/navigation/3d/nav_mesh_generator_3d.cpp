@@ -34,6 +34,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/math/convex_hull.h"
+#include "core/object/object_id.h"
 #include "core/os/thread.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/multimesh_instance_3d.h"
@@ -74,6 +75,8 @@ HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
 RID_Owner<NavMeshGenerator3D::NavMeshGeometryParser3D> NavMeshGenerator3D::generator_parser_owner;
 LocalVector<NavMeshGenerator3D::NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D *> NavMeshGenerator3D::tile_caches;
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -149,6 +152,12 @@ void NavMeshGenerator3D::cleanup() {
 		generator_parsers.clear();
 		generator_rid_rwlock.write_unlock();
 	}
+
+	MutexLock tile_cache_lock(tile_cache_mutex);
+	for (KeyValue<ObjectID, NavMeshTileCache3D *> &E : tile_caches) {
+		memdelete(E.value);
+	}
+	tile_caches.clear();
 }
 
 void NavMeshGenerator3D::finish() {
@@ -199,6 +208,34 @@ void NavMeshGenerator3D::bake_from_source_geometry_data(Ref<NavigationMesh> p_na
 	}
 }
 
+void NavMeshGenerator3D::rebake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback) {
+	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+
+	if (p_navigation_mesh->get_tile_size() <= 0.0) {
+		// Without tiles there is nothing to rebuild partially.
+		bake_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_callback);
+		return;
+	}
+
+	if (is_baking(p_navigation_mesh)) {
+		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+	}
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	generator_bake_tiles(p_navigation_mesh, p_source_geometry_data, p_dirty_aabb, true);
+
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.erase(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	if (p_callback.is_valid()) {
+		generator_emit_callback(p_callback);
+	}
+}
+
 void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback) {
 	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
 	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
@@ -662,11 +699,64 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 	}
 };
 
+void NavMeshGenerator3D::generator_setup_config(NavigationMesh *p_navigation_mesh, rcConfig &r_cfg) {
+	r_cfg.cs = p_navigation_mesh->get_cell_size();
+	r_cfg.ch = p_navigation_mesh->get_cell_height();
+	if (p_navigation_mesh->get_border_size() > 0.0) {
+		r_cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / r_cfg.cs);
+	}
+	r_cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
+	r_cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / r_cfg.ch);
+	r_cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / r_cfg.ch);
+	r_cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / r_cfg.cs);
+	r_cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
+	r_cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
+	r_cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
+	r_cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
+	r_cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
+	r_cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
+	r_cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+
+	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
+		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.walkableHeight * r_cfg.ch, p_navigation_mesh->get_agent_height())) {
+		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.walkableClimb * r_cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
+		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.walkableRadius * r_cfg.cs, p_navigation_mesh->get_agent_radius())) {
+		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.maxEdgeLen * r_cfg.cs, p_navigation_mesh->get_edge_max_length())) {
+		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
+		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
+		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
+	}
+	if (!Math::is_equal_approx((float)r_cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
+		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
+	}
+	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
+		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
+	}
+}
+
 void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
 	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
 		return;
 	}
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiles(p_navigation_mesh, p_source_geometry_data, AABB(), false);
+		return;
+	}
+	generator_clear_tile_cache(p_navigation_mesh);
+
 	Vector<float> source_geometry_vertices;
 	Vector<int> source_geometry_indices;
 	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
@@ -680,13 +770,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
@@ -702,51 +785,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	rcConfig cfg;
 	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_navigation_mesh->get_cell_size();
-	cfg.ch = p_navigation_mesh->get_cell_height();
-	if (p_navigation_mesh->get_border_size() > 0.0) {
-		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
-	}
-	cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
-	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
-	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
-
-	if (p_navigation_mesh->get_border_size() > 0.0 && Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
-		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
-		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
-		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
-		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
-		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
-		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
-		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
-		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
-	}
-	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
-		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
-	}
+	generator_setup_config(p_navigation_mesh.ptr(), cfg);
 
 	cfg.bmin[0] = bmin[0];
 	cfg.bmin[1] = bmin[1];
@@ -780,48 +819,490 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!generator_build_recast_mesh(p_navigation_mesh.ptr(), cfg, verts, nverts, tris, ntris, projected_obstructions, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+	bake_state = "Baking finished."; // step #12
+}
+
+void NavMeshGenerator3D::generator_bake_tiles(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb, bool p_partial) {
+	Vector<float> source_geometry_vertices;
+	Vector<int> source_geometry_indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
+
+	p_source_geometry_data->get_data(
+			source_geometry_vertices,
+			source_geometry_indices,
+			projected_obstructions);
+
+	const float *verts = source_geometry_vertices.ptr();
+	const int nverts = source_geometry_vertices.size() / 3;
+	const int *tris = source_geometry_indices.ptr();
+	const int ntris = source_geometry_indices.size() / 3;
+
+	if (!p_partial && (nverts == 0 || ntris == 0)) {
+		return;
+	}
+
+	rcConfig cfg;
+	memset(&cfg, 0, sizeof(cfg));
+	generator_setup_config(p_navigation_mesh.ptr(), cfg);
+
+	// Every tile is rasterized with a border of extra voxels around it so that erosion by the agent radius
+	// and the region partitioning see the same neighborhood as a single big bake would along tile edges.
+	cfg.borderSize = MAX(cfg.borderSize, cfg.walkableRadius + 3);
+	cfg.tileSize = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / cfg.cs));
+	cfg.width = cfg.tileSize + cfg.borderSize * 2;
+	cfg.height = cfg.width;
+
+	// ~30000000 seems to be around sweetspot where Editor baking breaks
+	if ((cfg.width * cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
+		ERR_FAIL_MSG("Baking interrupted."
+					 "\nNavigationMesh baking process would likely crash the engine."
+					 "\nTile Size is suspiciously big for the current Cell Size in the NavMesh Resource bake settings."
+					 "\nIt is advised to reduce Tile Size or increase Cell Size in the NavMesh Resource bake settings."
+					 "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
+	}
+
+	const AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	const Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
+
+	// Cached tiles can only be reused when they were baked with the exact same settings.
+	uint32_t settings_hash = hash_murmur3_buffer(&cfg, sizeof(rcConfig));
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(HashMapHasherDefault::hash(baking_aabb), settings_hash);
+	settings_hash = hash_murmur3_one_32(HashMapHasherDefault::hash(baking_aabb_offset), settings_hash);
+
+	NavMeshTileCache3D *tile_cache = nullptr;
+	{
+		MutexLock tile_cache_lock(tile_cache_mutex);
+
+		NavMeshTileCache3D **tile_cache_ptr = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+		if (tile_cache_ptr) {
+			tile_cache = *tile_cache_ptr;
+		} else {
+			// Drop the caches of navigation meshes that no longer exist.
+			LocalVector<ObjectID> stale_ids;
+			for (const KeyValue<ObjectID, NavMeshTileCache3D *> &E : tile_caches) {
+				if (ObjectDB::get_instance(E.key) == nullptr) {
+					stale_ids.push_back(E.key);
+				}
+			}
+			for (const ObjectID &stale_id : stale_ids) {
+				memdelete(tile_caches[stale_id]);
+				tile_caches.erase(stale_id);
+			}
+
+			tile_cache = memnew(NavMeshTileCache3D);
+			tile_caches.insert(p_navigation_mesh->get_instance_id(), tile_cache);
+		}
+	}
+
+	if (tile_cache->settings_hash != settings_hash) {
+		p_partial = false;
+	}
+	if (!p_partial) {
+		tile_cache->tiles.clear();
+	}
+	tile_cache->settings_hash = settings_hash;
+
+	const real_t tile_world_size = cfg.tileSize * cfg.cs;
+	const real_t border_world_size = cfg.borderSize * cfg.cs;
+
+	LocalVector<NavMeshTileBuild3D> tile_builds;
+	HashMap<Vector2i, uint32_t> tile_build_indices;
+
+	if (p_partial) {
+		// Forget every cached tile that overlaps the changed area, tiles that still have geometry get rebuilt below.
+		LocalVector<Vector2i> dirty_tiles;
+		for (const KeyValue<Vector2i, NavMeshBakedTile3D> &E : tile_cache->tiles) {
+			const real_t tile_min_x = E.key.x * tile_world_size - border_world_size;
+			const real_t tile_min_z = E.key.y * tile_world_size - border_world_size;
+			const real_t tile_max_x = (E.key.x + 1) * tile_world_size + border_world_size;
+			const real_t tile_max_z = (E.key.y + 1) * tile_world_size + border_world_size;
+			if (p_dirty_aabb.position.x <= tile_max_x && p_dirty_aabb.position.x + p_dirty_aabb.size.x >= tile_min_x &&
+					p_dirty_aabb.position.z <= tile_max_z && p_dirty_aabb.position.z + p_dirty_aabb.size.z >= tile_min_z) {
+				dirty_tiles.push_back(E.key);
+			}
+		}
+		for (const Vector2i &dirty_tile : dirty_tiles) {
+			tile_cache->tiles.erase(dirty_tile);
+		}
+	}
+
+	if (nverts > 0 && ntris > 0) {
+		float bmin[3], bmax[3];
+		rcCalcBounds(verts, nverts, bmin, bmax);
+
+		if (baking_aabb.has_volume()) {
+			for (int i = 0; i < 3; i++) {
+				bmin[i] = baking_aabb.position[i] + baking_aabb_offset[i];
+				bmax[i] = bmin[i] + baking_aabb.size[i];
+			}
+			// Keep the clipped tiles on the same voxel grid as their unclipped neighbors, the border voxels
+			// around the clipped side are still rasterized but never end up in the navigation mesh.
+			bmin[0] = Math::floor(bmin[0] / cfg.cs) * cfg.cs;
+			bmin[2] = Math::floor(bmin[2] / cfg.cs) * cfg.cs;
+			bmax[0] = Math::ceil(bmax[0] / cfg.cs) * cfg.cs;
+			bmax[2] = Math::ceil(bmax[2] / cfg.cs) * cfg.cs;
+		}
+
+		const Vector2i tile_min = Vector2i(Math::floor(bmin[0] / tile_world_size), Math::floor(bmin[2] / tile_world_size));
+		const Vector2i tile_max = Vector2i(Math::floor(bmax[0] / tile_world_size), Math::floor(bmax[2] / tile_world_size));
+
+		for (int tile_z = tile_min.y; tile_z <= tile_max.y; tile_z++) {
+			for (int tile_x = tile_min.x; tile_x <= tile_max.x; tile_x++) {
+				real_t core_min_x = tile_x * tile_world_size;
+				real_t core_min_z = tile_z * tile_world_size;
+				real_t core_max_x = (tile_x + 1) * tile_world_size;
+				real_t core_max_z = (tile_z + 1) * tile_world_size;
+				if (baking_aabb.has_volume()) {
+					core_min_x = MAX(core_min_x, bmin[0]);
+					core_min_z = MAX(core_min_z, bmin[2]);
+					core_max_x = MIN(core_max_x, bmax[0]);
+					core_max_z = MIN(core_max_z, bmax[2]);
+				}
+				const Vector3 tile_position = Vector3(core_min_x - border_world_size, bmin[1], core_min_z - border_world_size);
+				const Vector3 tile_end = Vector3(core_max_x + border_world_size, bmax[1], core_max_z + border_world_size);
+
+				if (p_partial && (p_dirty_aabb.position.x > tile_end.x || p_dirty_aabb.position.x + p_dirty_aabb.size.x < tile_position.x ||
+										 p_dirty_aabb.position.z > tile_end.z || p_dirty_aabb.position.z + p_dirty_aabb.size.z < tile_position.z)) {
+					continue;
+				}
+
+				tile_build_indices.insert(Vector2i(tile_x, tile_z), tile_builds.size());
+
+				NavMeshTileBuild3D tile_build;
+				tile_build.coords = Vector2i(tile_x, tile_z);
+				tile_build.bounds = AABB(tile_position, tile_end - tile_position);
+				tile_builds.push_back(tile_build);
+			}
+		}
+
+		// Hand every triangle to the tiles whose bordered bounds it overlaps.
+		if (!tile_builds.is_empty()) {
+			for (int i = 0; i < ntris; i++) {
+				const float *v0 = &verts[tris[i * 3 + 0] * 3];
+				const float *v1 = &verts[tris[i * 3 + 1] * 3];
+				const float *v2 = &verts[tris[i * 3 + 2] * 3];
+
+				const real_t tri_min_x = MIN(v0[0], MIN(v1[0], v2[0])) - border_world_size;
+				const real_t tri_min_z = MIN(v0[2], MIN(v1[2], v2[2])) - border_world_size;
+				const real_t tri_max_x = MAX(v0[0], MAX(v1[0], v2[0])) + border_world_size;
+				const real_t tri_max_z = MAX(v0[2], MAX(v1[2], v2[2])) + border_world_size;
+
+				const int tri_tile_min_x = MAX((int)Math::floor(tri_min_x / tile_world_size), tile_min.x);
+				const int tri_tile_min_z = MAX((int)Math::floor(tri_min_z / tile_world_size), tile_min.y);
+				const int tri_tile_max_x = MIN((int)Math::floor(tri_max_x / tile_world_size), tile_max.x);
+				const int tri_tile_max_z = MIN((int)Math::floor(tri_max_z / tile_world_size), tile_max.y);
+
+				for (int tile_z = tri_tile_min_z; tile_z <= tri_tile_max_z; tile_z++) {
+					for (int tile_x = tri_tile_min_x; tile_x <= tri_tile_max_x; tile_x++) {
+						const uint32_t *tile_build_index = tile_build_indices.getptr(Vector2i(tile_x, tile_z));
+						if (tile_build_index) {
+							LocalVector<int> &tile_indices = tile_builds[*tile_build_index].indices;
+							tile_indices.push_back(tris[i * 3 + 0]);
+							tile_indices.push_back(tris[i * 3 + 1]);
+							tile_indices.push_back(tris[i * 3 + 2]);
+						}
+					}
+				}
+			}
+		}
+
+		NavMeshTileBuildData3D tile_build_data;
+		tile_build_data.navigation_mesh = p_navigation_mesh.ptr();
+		tile_build_data.config = &cfg;
+		tile_build_data.vertices = verts;
+		tile_build_data.vertex_count = nverts;
+		tile_build_data.projected_obstructions = &projected_obstructions;
+		tile_build_data.builds = tile_builds.ptr();
+
+		// Async bakes already run on a pool thread, waiting on more pool tasks from there would only tie up the pool.
+		if (tile_builds.size() > 1 && use_threads && WorkerThreadPool::get_thread_index() == -1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_build_tile_task, &tile_build_data, tile_builds.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < tile_builds.size(); i++) {
+				generator_build_tile_task(&tile_build_data, i);
+			}
+		}
+
+		for (NavMeshTileBuild3D &tile_build : tile_builds) {
+			if (tile_build.tile.polygons.is_empty()) {
+				tile_cache->tiles.erase(tile_build.coords);
+			} else {
+				tile_cache->tiles[tile_build.coords] = tile_build.tile;
+			}
+		}
+	}
+
+	// Stitch all tiles into a single navigation mesh. Tiles are cut along the same grid lines, but the polygons
+	// on both sides of a seam don't end at the same vertices, and the map only merges edges with matching ends.
+	// So vertices on a seam are snapped to it and merged across tiles, and every edge along a seam is split at
+	// the seam vertices of the other side.
+	const real_t seam_tolerance = cfg.cs * 0.01;
+	const real_t seam_height_tolerance = MAX(cfg.walkableClimb, 1) * cfg.ch;
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+
+	HashMap<Vector3, int> tile_vertex_to_native_index;
+	LocalVector<int> tile_index_to_native_index;
+
+	LocalVector<Vector2i> seam_vertex_tiles; // Tile each native vertex came from, seam vertices only merge across tiles.
+	HashMap<Vector2, LocalVector<int>> seam_vertices;
+	HashMap<real_t, LocalVector<int>> seam_x_lines;
+	HashMap<real_t, LocalVector<int>> seam_z_lines;
+
+	// Stitch the tiles in grid order, so a partial rebake gives the same navigation mesh as a full bake.
+	LocalVector<Vector2i> tile_coords;
+	tile_coords.reserve(tile_cache->tiles.size());
+	for (const KeyValue<Vector2i, NavMeshBakedTile3D> &E : tile_cache->tiles) {
+		tile_coords.push_back(E.key);
+	}
+	tile_coords.sort();
+
+	for (const Vector2i &tile_coord : tile_coords) {
+		const NavMeshBakedTile3D &baked_tile = tile_cache->tiles.get(tile_coord);
+		const real_t core_min_x = tile_coord.x * tile_world_size;
+		const real_t core_min_z = tile_coord.y * tile_world_size;
+		const real_t core_max_x = (tile_coord.x + 1) * tile_world_size;
+		const real_t core_max_z = (tile_coord.y + 1) * tile_world_size;
+
+		tile_index_to_native_index.resize(baked_tile.vertices.size());
+		for (int i = 0; i < baked_tile.vertices.size(); i++) {
+			Vector3 vertex = baked_tile.vertices[i];
+
+			bool on_x_seam = true;
+			if (Math::abs(vertex.x - core_min_x) <= seam_tolerance) {
+				vertex.x = core_min_x;
+			} else if (Math::abs(vertex.x - core_max_x) <= seam_tolerance) {
+				vertex.x = core_max_x;
+			} else {
+				on_x_seam = false;
+			}
+			bool on_z_seam = true;
+			if (Math::abs(vertex.z - core_min_z) <= seam_tolerance) {
+				vertex.z = core_min_z;
+			} else if (Math::abs(vertex.z - core_max_z) <= seam_tolerance) {
+				vertex.z = core_max_z;
+			} else {
+				on_z_seam = false;
+			}
+
+			if (!on_x_seam && !on_z_seam) {
+				int *existing_index_ptr = tile_vertex_to_native_index.getptr(vertex);
+				if (!existing_index_ptr) {
+					int new_index = nav_vertices.size();
+					tile_index_to_native_index[i] = new_index;
+					tile_vertex_to_native_index[vertex] = new_index;
+					nav_vertices.push_back(vertex);
+					seam_vertex_tiles.push_back(tile_coord);
+				} else {
+					tile_index_to_native_index[i] = *existing_index_ptr;
+				}
+				continue;
+			}
+
+			// The detail heights of both sides are sampled separately, so they only match within the climb height.
+			LocalVector<int> &same_position_vertices = seam_vertices[Vector2(vertex.x, vertex.z)];
+			int native_index = -1;
+			for (int candidate : same_position_vertices) {
+				if (seam_vertex_tiles[candidate] != tile_coord && Math::abs(nav_vertices[candidate].y - vertex.y) <= seam_height_tolerance) {
+					native_index = candidate;
+					break;
+				}
+			}
+			if (native_index == -1) {
+				native_index = nav_vertices.size();
+				nav_vertices.push_back(vertex);
+				seam_vertex_tiles.push_back(tile_coord);
+				same_position_vertices.push_back(native_index);
+				if (on_x_seam) {
+					seam_x_lines[vertex.x].push_back(native_index);
+				}
+				if (on_z_seam) {
+					seam_z_lines[vertex.z].push_back(native_index);
+				}
+			}
+			tile_index_to_native_index[i] = native_index;
+		}
+
+		for (const Vector<int> &tile_polygon : baked_tile.polygons) {
+			Vector<int> nav_indices;
+			nav_indices.resize(tile_polygon.size());
+			for (int i = 0; i < tile_polygon.size(); i++) {
+				nav_indices.write[i] = tile_index_to_native_index[tile_polygon[i]];
+			}
+			nav_polygons.push_back(nav_indices);
+		}
+	}
+
+	struct SeamSplit {
+		real_t weight = 0.0;
+		int index = -1;
+
+		bool operator<(const SeamSplit &p_other) const {
+			return weight < p_other.weight;
+		}
+	};
+	LocalVector<SeamSplit> seam_splits;
+
+	const Vector3 *nav_vertices_ptr = nav_vertices.ptr();
+	for (int p = 0; p < nav_polygons.size(); p++) {
+		const Vector<int> &polygon = nav_polygons[p];
+		Vector<int> split_polygon;
+		bool polygon_split = false;
+
+		for (int i = 0; i < polygon.size(); i++) {
+			const int from_index = polygon[i];
+			const int to_index = polygon[(i + 1) % polygon.size()];
+			split_polygon.push_back(from_index);
+
+			// Only seam vertices are snapped exactly onto the grid lines.
+			const Vector3 &from = nav_vertices_ptr[from_index];
+			const Vector3 &to = nav_vertices_ptr[to_index];
+			const LocalVector<int> *seam_line = nullptr;
+			int axis = Vector3::AXIS_X;
+			if (from.x == to.x) {
+				seam_line = seam_x_lines.getptr(from.x);
+				axis = Vector3::AXIS_Z;
+			} else if (from.z == to.z) {
+				seam_line = seam_z_lines.getptr(from.z);
+			}
+			if (!seam_line) {
+				continue;
+			}
+
+			seam_splits.clear();
+			for (int seam_index : *seam_line) {
+				const Vector3 &seam_vertex = nav_vertices_ptr[seam_index];
+				const real_t weight = (seam_vertex[axis] - from[axis]) / (to[axis] - from[axis]);
+				if (weight <= 0.0 || weight >= 1.0) {
+					continue;
+				}
+				if (Math::abs(seam_vertex.y - Math::lerp(from.y, to.y, weight)) > seam_height_tolerance) {
+					continue;
+				}
+				SeamSplit seam_split;
+				seam_split.weight = weight;
+				seam_split.index = seam_index;
+				seam_splits.push_back(seam_split);
+			}
+			if (seam_splits.is_empty()) {
+				continue;
+			}
+
+			seam_splits.sort();
+			for (const SeamSplit &seam_split : seam_splits) {
+				split_polygon.push_back(seam_split.index);
+			}
+			polygon_split = true;
+		}
+
+		if (polygon_split) {
+			nav_polygons.write[p] = split_polygon;
+		}
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+}
+
+void NavMeshGenerator3D::generator_build_tile_task(void *p_userdata, uint32_t p_index) {
+	NavMeshTileBuildData3D *tile_build_data = static_cast<NavMeshTileBuildData3D *>(p_userdata);
+	NavMeshTileBuild3D &tile_build = tile_build_data->builds[p_index];
+
+	if (tile_build.indices.is_empty()) {
+		return;
+	}
+
+	rcConfig cfg = *tile_build_data->config;
+	cfg.bmin[0] = tile_build.bounds.position.x;
+	cfg.bmin[1] = tile_build.bounds.position.y;
+	cfg.bmin[2] = tile_build.bounds.position.z;
+	cfg.bmax[0] = tile_build.bounds.position.x + tile_build.bounds.size.x;
+	cfg.bmax[1] = tile_build.bounds.position.y + tile_build.bounds.size.y;
+	cfg.bmax[2] = tile_build.bounds.position.z + tile_build.bounds.size.z;
+	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+	if (!generator_build_recast_mesh(tile_build_data->navigation_mesh, cfg, tile_build_data->vertices, tile_build_data->vertex_count, tile_build.indices.ptr(), tile_build.indices.size() / 3, *tile_build_data->projected_obstructions, tile_build.tile.vertices, tile_build.tile.polygons)) {
+		tile_build.tile.vertices.clear();
+		tile_build.tile.polygons.clear();
+	}
+}
+
+void NavMeshGenerator3D::generator_clear_tile_cache(const Ref<NavigationMesh> &p_navigation_mesh) {
+	MutexLock tile_cache_lock(tile_cache_mutex);
+
+	NavMeshTileCache3D **tile_cache_ptr = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+	if (tile_cache_ptr) {
+		memdelete(*tile_cache_ptr);
+		tile_caches.erase(p_navigation_mesh->get_instance_id());
+	}
+}
+
+bool NavMeshGenerator3D::generator_build_recast_mesh(NavigationMesh *p_navigation_mesh, rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
+
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
 	}
 
 	bake_state = "Constructing compact heightfield..."; // step #5
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (projected_obstruction.carve) {
 				continue;
 			}
@@ -838,11 +1319,11 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (!projected_obstruction.carve) {
 				continue;
 			}
@@ -860,30 +1341,30 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -892,8 +1373,8 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Converting to native navigation mesh..."; // step #10
 
-	Vector<Vector3> nav_vertices;
-	Vector<Vector<int>> nav_polygons;
+	r_vertices.clear();
+	r_polygons.clear();
 
 	HashMap<Vector3, int> recast_vertex_to_native_index;
 	LocalVector<int> recast_index_to_native_index;
@@ -907,7 +1388,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			int new_index = recast_vertex_to_native_index.size();
 			recast_index_to_native_index[i] = new_index;
 			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
+			r_vertices.push_back(vertex);
 		} else {
 			recast_index_to_native_index[i] = *existing_index_ptr;
 		}
@@ -931,12 +1412,10 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[1] = recast_index_to_native_index[index2];
 			nav_indices.write[2] = recast_index_to_native_index[index3];
 
-			nav_polygons.push_back(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
-	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
-
 	bake_state = "Cleanup..."; // step #11
 
 	rcFreePolyMesh(poly_mesh);
@@ -944,7 +1423,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	rcFreePolyMeshDetail(detail_mesh);
 	detail_mesh = nullptr;
 
-	bake_state = "Baking finished."; // step #12
+	return true;
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
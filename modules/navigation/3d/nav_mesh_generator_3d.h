@@ -37,10 +37,12 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/rid_owner.h"
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
+#include "scene/resources/3d/navigation_mesh_source_geometry_data_3d.h"
 
 class Node;
 class NavigationMesh;
-class NavigationMeshSourceGeometryData3D;
+
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -82,9 +84,44 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
+	// Baked output of a single tile, kept so that a rebake only has to rebuild the tiles touched by a change.
+	struct NavMeshBakedTile3D {
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct NavMeshTileCache3D {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, NavMeshBakedTile3D> tiles;
+	};
+
+	struct NavMeshTileBuild3D {
+		Vector2i coords;
+		AABB bounds;
+		LocalVector<int> indices;
+		NavMeshBakedTile3D tile;
+	};
+
+	struct NavMeshTileBuildData3D {
+		NavigationMesh *navigation_mesh = nullptr;
+		const rcConfig *config = nullptr;
+		const float *vertices = nullptr;
+		int vertex_count = 0;
+		const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> *projected_obstructions = nullptr;
+		NavMeshTileBuild3D *builds = nullptr;
+	};
+
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache3D *> tile_caches;
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_bake_tiles(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const AABB &p_dirty_aabb, bool p_partial);
+	static void generator_build_tile_task(void *p_userdata, uint32_t p_index);
+	static void generator_setup_config(NavigationMesh *p_navigation_mesh, rcConfig &r_cfg);
+	static bool generator_build_recast_mesh(NavigationMesh *p_navigation_mesh, rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+	static void generator_clear_tile_cache(const Ref<NavigationMesh> &p_navigation_mesh);
 
 	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
@@ -109,6 +146,7 @@ public:
 	static void parse_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
+	static void rebake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const AABB &p_dirty_aabb, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
 
 	static RID source_geometry_parser_create();
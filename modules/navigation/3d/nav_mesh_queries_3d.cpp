@@ -127,7 +127,7 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 	}
 }
 
-Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size) {
+Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const NavPolygonBVH *p_polygons_bvh) {
 	// Clear metadata outputs.
 	if (r_path_types) {
 		r_path_types->clear();
@@ -146,31 +146,46 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	Vector3 end_point;
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : p_polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
+	if (p_polygons_bvh) {
+		// Only consider polygons in regions with compatible layers.
+		const NavPolygonBVH::ClosestPolygonResult begin_result = p_polygons_bvh->get_closest_polygon(p_polygons, p_origin, true, p_navigation_layers);
+		if (begin_result.polygon_index >= 0) {
+			begin_poly = &p_polygons[begin_result.polygon_index];
+			begin_point = begin_result.point;
 		}
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
+		const NavPolygonBVH::ClosestPolygonResult end_result = p_polygons_bvh->get_closest_polygon(p_polygons, p_destination, true, p_navigation_layers);
+		if (end_result.polygon_index >= 0) {
+			end_poly = &p_polygons[end_result.polygon_index];
+			end_point = end_result.point;
+		}
+	} else {
+		// Find the initial poly and the end poly on this map.
+		for (const gd::Polygon &p : p_polygons) {
+			// Only consider the polygon if it in a region with compatible layers.
+			if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+				continue;
 			}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
+			// For each face check the distance between the origin/destination
+			for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+
+				Vector3 point = face.get_closest_point_to(p_origin);
+				real_t distance_to_point = point.distance_to(p_origin);
+				if (distance_to_point < begin_d) {
+					begin_d = distance_to_point;
+					begin_poly = &p;
+					begin_point = point;
+				}
+
+				point = face.get_closest_point_to(p_destination);
+				distance_to_point = point.distance_to(p_destination);
+				if (distance_to_point < end_d) {
+					end_d = distance_to_point;
+					end_poly = &p;
+					end_point = point;
+				}
 			}
 		}
 	}
@@ -642,18 +657,29 @@ Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVecto
 	return closest_point;
 }
 
-Vector3 NavMeshQueries3D::polygons_get_closest_point(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
-	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
+Vector3 NavMeshQueries3D::polygons_get_closest_point(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const NavPolygonBVH *p_polygons_bvh) {
+	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point, p_polygons_bvh);
 	return cp.point;
 }
 
-Vector3 NavMeshQueries3D::polygons_get_closest_point_normal(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
-	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
+Vector3 NavMeshQueries3D::polygons_get_closest_point_normal(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const NavPolygonBVH *p_polygons_bvh) {
+	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point, p_polygons_bvh);
 	return cp.normal;
 }
 
-gd::ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
+gd::ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const NavPolygonBVH *p_polygons_bvh) {
 	gd::ClosestPointQueryResult result;
+
+	if (p_polygons_bvh) {
+		const NavPolygonBVH::ClosestPolygonResult closest = p_polygons_bvh->get_closest_polygon(p_polygons, p_point);
+		if (closest.polygon_index >= 0) {
+			result.point = closest.point;
+			result.normal = closest.normal;
+			result.owner = p_polygons[closest.polygon_index].owner->get_self();
+		}
+		return result;
+	}
+
 	real_t closest_point_distance_squared = FLT_MAX;
 
 	for (const gd::Polygon &polygon : p_polygons) {
@@ -673,8 +699,8 @@ gd::ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(co
 	return result;
 }
 
-RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point) {
-	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
+RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, const NavPolygonBVH *p_polygons_bvh) {
+	gd::ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point, p_polygons_bvh);
 	return cp.owner;
 }
 
@@ -132,7 +132,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 	return NavMeshQueries3D::polygons_get_path(
 			polygons, p_origin, p_destination, p_optimize, p_navigation_layers,
-			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size());
+			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size(), &polygons_bvh);
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -152,7 +152,7 @@ Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point(polygons, p_point, &polygons_bvh);
 }
 
 Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
@@ -162,7 +162,7 @@ Vector3 NavMap::get_closest_point_normal(const Vector3 &p_point) const {
 		return Vector3();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_normal(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_normal(polygons, p_point, &polygons_bvh);
 }
 
 RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
@@ -172,38 +172,38 @@ RID NavMap::get_closest_point_owner(const Vector3 &p_point) const {
 		return RID();
 	}
 
-	return NavMeshQueries3D::polygons_get_closest_point_owner(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_owner(polygons, p_point, &polygons_bvh);
 }
 
 gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_point) const {
 	RWLockRead read_lock(map_rwlock);
 
-	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, p_point);
+	return NavMeshQueries3D::polygons_get_closest_point_info(polygons, p_point, &polygons_bvh);
 }
 
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+	regions_dirty = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+		regions_dirty = true;
 	}
 }
 
 void NavMap::add_link(NavLink *p_link) {
 	links.push_back(p_link);
-	regenerate_links = true;
+	links_dirty = true;
 }
 
 void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
-		regenerate_links = true;
+		links_dirty = true;
 	}
 }
 
@@ -375,315 +375,539 @@ void NavMap::sync() {
 		regenerate_links = true;
 	}
 
-	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
-		}
+	bool regions_changed = regions_dirty;
+	LocalVector<bool> changed_regions;
+	changed_regions.resize(regions.size());
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		changed_regions[i] = regions[i]->sync();
+		regions_changed = regions_changed || changed_regions[i];
 	}
 
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
-			regenerate_links = true;
+			links_dirty = true;
 		}
 	}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
+	if (regenerate_links || regions_changed) {
+		_sync_region_polygons(changed_regions, regenerate_links);
+
+		_new_pm_polygon_count = polygons.size();
 		_new_pm_edge_count = 0;
 		_new_pm_edge_merge_count = 0;
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
+		for (const RegionSlot &slot : region_slots) {
+			_new_pm_edge_count += slot.edge_count;
+			_new_pm_edge_merge_count += slot.merged_edge_count;
+			_new_pm_edge_free_count += slot.free_edges.size();
+		}
+		// Merged edges are counted once per polygon.
+		_new_pm_edge_merge_count /= 2;
+		_new_pm_edge_count -= _new_pm_edge_merge_count;
+		for (const KeyValue<NavRegion *, LocalVector<gd::Edge::Connection>> &E : region_external_connections) {
+			_new_pm_edge_connection_count += E.value.size();
+		}
+	}
 
-		// Remove regions connections.
-		region_external_connections.clear();
-		for (NavRegion *region : regions) {
-			region_external_connections[region] = LocalVector<gd::Edge::Connection>();
+	if (regenerate_links || regions_changed || links_dirty) {
+		_sync_link_polygons();
+
+		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
+		iteration_id = iteration_id % UINT32_MAX + 1;
+	}
+
+	// Do we have modified obstacle positions?
+	for (NavObstacle *obstacle : obstacles) {
+		if (obstacle->check_dirty()) {
+			obstacles_dirty = true;
+		}
+	}
+	// Do we have modified agent arrays?
+	for (NavAgent *agent : agents) {
+		if (agent->check_dirty()) {
+			agents_dirty = true;
 		}
+	}
 
-		// Resize the polygon count.
-		int polygon_count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+	// Update avoidance worlds.
+	if (obstacles_dirty || agents_dirty) {
+		_update_rvo_simulation();
+	}
+
+	regenerate_polygons = false;
+	regenerate_links = false;
+	regions_dirty = false;
+	links_dirty = false;
+	obstacles_dirty = false;
+	agents_dirty = false;
+
+	// Performance Monitor.
+	pm_region_count = _new_pm_region_count;
+	pm_agent_count = _new_pm_agent_count;
+	pm_link_count = _new_pm_link_count;
+	pm_polygon_count = _new_pm_polygon_count;
+	pm_edge_count = _new_pm_edge_count;
+	pm_edge_merge_count = _new_pm_edge_merge_count;
+	pm_edge_connection_count = _new_pm_edge_connection_count;
+	pm_edge_free_count = _new_pm_edge_free_count;
+	pm_obstacle_count = _new_pm_obstacle_count;
+}
+
+void NavMap::_sync_region_polygons(const LocalVector<bool> &p_regions_changed, bool p_relink_all) {
+	// Lay out the new polygon ranges. Changed regions are copied again, the others keep their polygons.
+	HashMap<NavRegion *, uint32_t> old_slot_indices;
+	for (uint32_t i = 0; i < region_slots.size(); i++) {
+		old_slot_indices.insert(region_slots[i].region, i);
+	}
+
+	LocalVector<RegionSlot> new_slots;
+	new_slots.resize(regions.size());
+	LocalVector<uint32_t> old_slot_to_new;
+	old_slot_to_new.resize(region_slots.size());
+	for (uint32_t &index : old_slot_to_new) {
+		index = UINT32_MAX;
+	}
+
+	LocalVector<bool> slot_changed;
+	slot_changed.resize(regions.size());
+	uint32_t polygon_count = 0;
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		NavRegion *region = regions[i];
+		RegionSlot &slot = new_slots[i];
+		HashMap<NavRegion *, uint32_t>::ConstIterator old_slot = old_slot_indices.find(region);
+
+		slot_changed[i] = p_regions_changed[i] || !old_slot;
+		if (slot_changed[i]) {
+			slot.region = region;
+			slot.polygon_count = region->get_enabled() ? region->get_polygons().size() : 0;
+		} else {
+			// Moved-from slots keep their range, which is still needed to move the polygons.
+			slot = std::move(region_slots[old_slot->value]);
+			old_slot_to_new[old_slot->value] = i;
+		}
+		slot.polygon_offset = polygon_count;
+		polygon_count += slot.polygon_count;
+	}
+
+	// Bounds of everything that appeared or disappeared.
+	LocalVector<AABB> changed_bounds;
+	for (uint32_t i = 0; i < region_slots.size(); i++) {
+		if (old_slot_to_new[i] == UINT32_MAX && region_slots[i].polygon_count > 0) {
+			changed_bounds.push_back(region_slots[i].bounds);
+		}
+	}
+
+	LocalVector<gd::Polygon> new_polygons;
+	new_polygons.resize(polygon_count);
+
+	// Any polygon that changed, or may gain or lose connections, is relinked from scratch.
+	// Regions can only connect to regions within the edge connection margin, so this is limited to
+	// regions overlapping a changed one. Their direct neighbors have connections towards them updated.
+	enum SlotState {
+		SLOT_KEEP,
+		SLOT_NEIGHBOR,
+		SLOT_RELINK,
+	};
+	LocalVector<SlotState> slot_states;
+	slot_states.resize(new_slots.size());
+
+	for (uint32_t i = 0; i < new_slots.size(); i++) {
+		RegionSlot &slot = new_slots[i];
+		if (!slot_changed[i]) {
+			continue;
+		}
+		const LocalVector<gd::Polygon> &region_polygons = slot.region->get_polygons();
+		slot.bounds = AABB();
+		for (uint32_t n = 0; n < slot.polygon_count; n++) {
+			gd::Polygon &polygon = new_polygons[slot.polygon_offset + n];
+			polygon = region_polygons[n];
+			polygon.id = slot.polygon_offset + n;
+			for (uint32_t p = 0; p < polygon.points.size(); p++) {
+				if (n == 0 && p == 0) {
+					slot.bounds.position = polygon.points[p].pos;
+				} else {
+					slot.bounds.expand_to(polygon.points[p].pos);
+				}
 			}
-			polygon_count += region->get_polygons().size();
 		}
-		polygons.resize(polygon_count);
+		if (slot.polygon_count > 0) {
+			changed_bounds.push_back(slot.bounds);
+		}
+	}
 
-		// Copy all region polygons in the map.
-		polygon_count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+	const real_t connection_margin = edge_connection_margin + MAX(merge_rasterizer_cell_size, merge_rasterizer_cell_height);
+	for (AABB &bounds : changed_bounds) {
+		bounds = bounds.grow(connection_margin);
+	}
+
+	LocalVector<AABB> relink_bounds;
+	for (uint32_t i = 0; i < new_slots.size(); i++) {
+		slot_states[i] = SLOT_KEEP;
+		if (p_relink_all || slot_changed[i]) {
+			slot_states[i] = SLOT_RELINK;
+		} else if (new_slots[i].polygon_count > 0) {
+			for (const AABB &bounds : changed_bounds) {
+				if (bounds.intersects(new_slots[i].bounds)) {
+					slot_states[i] = SLOT_RELINK;
+					break;
+				}
 			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[polygon_count] = polygons_source[n];
-				polygons[polygon_count].id = polygon_count;
-				polygon_count++;
+		}
+		if (slot_states[i] == SLOT_RELINK && new_slots[i].polygon_count > 0) {
+			relink_bounds.push_back(new_slots[i].bounds.grow(connection_margin));
+		}
+	}
+	for (uint32_t i = 0; i < new_slots.size(); i++) {
+		if (slot_states[i] != SLOT_KEEP || new_slots[i].polygon_count == 0) {
+			continue;
+		}
+		for (const AABB &bounds : relink_bounds) {
+			if (bounds.intersects(new_slots[i].bounds)) {
+				slot_states[i] = SLOT_NEIGHBOR;
+				break;
 			}
 		}
+	}
 
-		_new_pm_polygon_count = polygon_count;
+	// Move the kept polygons into their new range, and remember where they went so connections can follow.
+	// Connections towards relinked polygons are dropped and rebuilt below.
+	LocalVector<uint32_t> old_to_new;
+	old_to_new.resize(polygons.size());
+	for (uint32_t &index : old_to_new) {
+		index = UINT32_MAX;
+	}
+	for (uint32_t i = 0; i < region_slots.size(); i++) {
+		const uint32_t new_slot_index = old_slot_to_new[i];
+		if (new_slot_index == UINT32_MAX) {
+			continue;
+		}
+		const RegionSlot &old_slot = region_slots[i];
+		const RegionSlot &new_slot = new_slots[new_slot_index];
+		for (uint32_t n = 0; n < old_slot.polygon_count; n++) {
+			gd::Polygon &polygon = new_polygons[new_slot.polygon_offset + n];
+			polygon = std::move(polygons[old_slot.polygon_offset + n]);
+			polygon.id = new_slot.polygon_offset + n;
+			if (slot_states[new_slot_index] != SLOT_RELINK) {
+				old_to_new[old_slot.polygon_offset + n] = polygon.id;
+			}
+		}
+	}
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+	// Remapped connections still point into the old polygons, which keep their id after being moved from.
+	// Link connections point past the region polygons and are dropped too, links are rebuilt afterwards.
+	auto remap_connection = [&](gd::Edge::Connection &r_connection) -> bool {
+		const uint32_t old_id = r_connection.polygon->id;
+		if (old_id >= old_to_new.size() || old_to_new[old_id] == UINT32_MAX) {
+			return false;
+		}
+		r_connection.polygon = &new_polygons[old_to_new[old_id]];
+		return true;
+	};
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
+	for (uint32_t i = 0; i < new_slots.size(); i++) {
+		if (slot_changed[i]) {
+			continue;
+		}
+		const RegionSlot &slot = new_slots[i];
+		for (uint32_t n = 0; n < slot.polygon_count; n++) {
+			for (gd::Edge &edge : new_polygons[slot.polygon_offset + n].edges) {
+				if (slot_states[i] == SLOT_RELINK) {
+					edge.connections.clear();
+					continue;
 				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				int connection_count = 0;
+				gd::Edge::Connection *connections = edge.connections.ptrw();
+				for (int c = 0; c < edge.connections.size(); c++) {
+					if (remap_connection(connections[c])) {
+						connections[connection_count++] = connections[c];
+					}
 				}
+				edge.connections.resize(connection_count);
 			}
 		}
+	}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
-				}
+	for (uint32_t i = 0; i < region_slots.size(); i++) {
+		if (old_slot_to_new[i] == UINT32_MAX) {
+			region_external_connections.erase(region_slots[i].region);
+		}
+	}
+	for (uint32_t i = 0; i < new_slots.size(); i++) {
+		LocalVector<gd::Edge::Connection> &external_connections = region_external_connections[new_slots[i].region];
+		if (slot_states[i] == SLOT_RELINK) {
+			external_connections.clear();
+			continue;
+		}
+		uint32_t connection_count = 0;
+		for (uint32_t c = 0; c < external_connections.size(); c++) {
+			if (remap_connection(external_connections[c])) {
+				external_connections[connection_count++] = external_connections[c];
 			}
 		}
+		external_connections.resize(connection_count);
+	}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
+	polygons = std::move(new_polygons);
+	region_slots = std::move(new_slots);
 
-		real_t sqr_edge_connection_margin = edge_connection_margin * edge_connection_margin;
+	polygons_bvh.build(polygons);
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+	// Group the edges of relinked regions and their neighbors per key.
+	struct EdgeConnection {
+		gd::Edge::Connection connection;
+		uint32_t slot = 0;
+	};
+	HashMap<gd::EdgeKey, LocalVector<EdgeConnection>, gd::EdgeKey> connections;
+	for (uint32_t i = 0; i < region_slots.size(); i++) {
+		if (slot_states[i] == SLOT_KEEP) {
+			continue;
+		}
+		RegionSlot &slot = region_slots[i];
+		if (slot_states[i] == SLOT_RELINK) {
+			slot.edge_count = 0;
+			slot.merged_edge_count = 0;
+			slot.free_edges.clear();
+		}
+		for (uint32_t n = 0; n < slot.polygon_count; n++) {
+			gd::Polygon &poly = polygons[slot.polygon_offset + n];
+			for (uint32_t p = 0; p < poly.points.size(); p++) {
+				int next_point = (p + 1) % poly.points.size();
+				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
+				LocalVector<EdgeConnection> &key_connections = connections[ek];
+				if (key_connections.size() <= 1) {
+					// Add the polygon/edge tuple to this key.
+					EdgeConnection new_connection;
+					new_connection.connection.polygon = &poly;
+					new_connection.connection.edge = p;
+					new_connection.connection.pathway_start = poly.points[p].pos;
+					new_connection.connection.pathway_end = poly.points[next_point].pos;
+					new_connection.slot = i;
+					key_connections.push_back(new_connection);
+					if (slot_states[i] == SLOT_RELINK) {
+						slot.edge_count += 1;
+					}
+				} else {
+					// The edge is already connected with another edge, skip.
+					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 				}
+			}
+		}
+	}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
+	for (KeyValue<gd::EdgeKey, LocalVector<EdgeConnection>> &E : connections) {
+		if (E.value.size() == 2) {
+			const EdgeConnection &c1 = E.value[0];
+			const EdgeConnection &c2 = E.value[1];
+			if (slot_states[c1.slot] != SLOT_RELINK && slot_states[c2.slot] != SLOT_RELINK) {
+				// Both sides kept their connection.
+				continue;
+			}
+			// Connect edge that are shared in different polygons.
+			c1.connection.polygon->edges[c1.connection.edge].connections.push_back(c2.connection);
+			c2.connection.polygon->edges[c2.connection.edge].connections.push_back(c1.connection);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			for (const EdgeConnection &c : E.value) {
+				if (slot_states[c.slot] == SLOT_RELINK) {
+					region_slots[c.slot].merged_edge_count += 1;
 				}
+			}
+		} else {
+			CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
+			const EdgeConnection &c = E.value[0];
+			RegionSlot &slot = region_slots[c.slot];
+			if (slot_states[c.slot] == SLOT_RELINK && use_edge_connections && slot.region->get_use_edge_connections()) {
+				RegionFreeEdge free_edge;
+				free_edge.polygon = c.connection.polygon->id - slot.polygon_offset;
+				free_edge.edge = c.connection.edge;
+				slot.free_edges.push_back(free_edge);
+			}
+		}
+	}
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_squared_to(self1) > sqr_edge_connection_margin) {
-					continue;
-				}
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	LocalVector<EdgeConnection> free_edges;
+	for (uint32_t i = 0; i < region_slots.size(); i++) {
+		if (slot_states[i] == SLOT_KEEP) {
+			continue;
+		}
+		const RegionSlot &slot = region_slots[i];
+		for (const RegionFreeEdge &region_free_edge : slot.free_edges) {
+			EdgeConnection free_edge;
+			free_edge.connection.polygon = &polygons[slot.polygon_offset + region_free_edge.polygon];
+			free_edge.connection.edge = region_free_edge.edge;
+			free_edge.slot = i;
+			free_edges.push_back(free_edge);
+		}
+	}
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_squared_to(self2) > sqr_edge_connection_margin) {
-					continue;
-				}
+	real_t sqr_edge_connection_margin = edge_connection_margin * edge_connection_margin;
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+	for (uint32_t i = 0; i < free_edges.size(); i++) {
+		const gd::Edge::Connection &free_edge = free_edges[i].connection;
+		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
 
-				// Add the connection to the region_connection map.
-				region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+		for (uint32_t j = 0; j < free_edges.size(); j++) {
+			const gd::Edge::Connection &other_edge = free_edges[j].connection;
+			if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
+				continue;
+			}
+			if (slot_states[free_edges[i].slot] != SLOT_RELINK && slot_states[free_edges[j].slot] != SLOT_RELINK) {
+				// Connection between two neighbors, still valid.
+				continue;
 			}
-		}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
+			Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+			Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
+			// Compute the projection of the opposite edge on the current one
+			Vector3 edge_vector = edge_p2 - edge_p1;
+			real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+			real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+			if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
 				continue;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_sqr_dist = link_connection_radius * link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_sqr_dist = link_connection_radius * link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t sqr_dist = start_point.distance_squared_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_start_sqr_dist) {
-						closest_start_sqr_dist = sqr_dist;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+
+			// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+			Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other1;
+			if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+				other1 = other_edge_p1;
+			} else {
+				other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other1.distance_squared_to(self1) > sqr_edge_connection_margin) {
+				continue;
 			}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t sqr_dist = end_point.distance_squared_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_end_sqr_dist) {
-						closest_end_sqr_dist = sqr_dist;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other2;
+			if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+				other2 = other_edge_p2;
+			} else {
+				other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other2.distance_squared_to(self2) > sqr_edge_connection_margin) {
+				continue;
 			}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.id = polygon_count++;
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+			// The edges can now be connected.
+			gd::Edge::Connection new_connection = other_edge;
+			new_connection.pathway_start = (self1 + other1) / 2.0;
+			new_connection.pathway_end = (self2 + other2) / 2.0;
+			free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
-			}
+			// Add the connection to the region_connection map.
+			region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
 		}
-
-		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
-		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
+}
 
-	// Do we have modified obstacle positions?
-	for (NavObstacle *obstacle : obstacles) {
-		if (obstacle->check_dirty()) {
-			obstacles_dirty = true;
+void NavMap::_sync_link_polygons() {
+	// Remove the connections towards the previous link polygons, they are only added to the first edge.
+	for (gd::Polygon &polygon : polygons) {
+		if (polygon.edges.is_empty()) {
+			continue;
 		}
-	}
-	// Do we have modified agent arrays?
-	for (NavAgent *agent : agents) {
-		if (agent->check_dirty()) {
-			agents_dirty = true;
+		Vector<gd::Edge::Connection> &connections = polygon.edges[0].connections;
+		for (int c = connections.size() - 1; c >= 0; c--) {
+			if (connections[c].edge == -1) {
+				connections.remove_at(c);
+			}
 		}
 	}
 
-	// Update avoidance worlds.
-	if (obstacles_dirty || agents_dirty) {
-		_update_rvo_simulation();
-	}
+	uint32_t polygon_count = polygons.size();
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
 
-	regenerate_polygons = false;
-	regenerate_links = false;
-	obstacles_dirty = false;
-	agents_dirty = false;
+	const real_t sqr_link_connection_radius = link_connection_radius * link_connection_radius;
 
-	// Performance Monitor.
-	pm_region_count = _new_pm_region_count;
-	pm_agent_count = _new_pm_agent_count;
-	pm_link_count = _new_pm_link_count;
-	pm_polygon_count = _new_pm_polygon_count;
-	pm_edge_count = _new_pm_edge_count;
-	pm_edge_merge_count = _new_pm_edge_merge_count;
-	pm_edge_connection_count = _new_pm_edge_connection_count;
-	pm_edge_free_count = _new_pm_edge_free_count;
-	pm_obstacle_count = _new_pm_obstacle_count;
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		// Pick the polygons that are within our radius and closest to the link points.
+		gd::Polygon *closest_start_polygon = nullptr;
+		Vector3 closest_start_point;
+		const NavPolygonBVH::ClosestPolygonResult closest_start = polygons_bvh.get_closest_polygon(polygons, start, false, 0, sqr_link_connection_radius);
+		if (closest_start.polygon_index >= 0) {
+			closest_start_polygon = &polygons[closest_start.polygon_index];
+			closest_start_point = closest_start.point;
+		}
+
+		gd::Polygon *closest_end_polygon = nullptr;
+		Vector3 closest_end_point;
+		const NavPolygonBVH::ClosestPolygonResult closest_end = polygons_bvh.get_closest_polygon(polygons, end, false, 0, sqr_link_connection_radius);
+		if (closest_end.polygon_index >= 0) {
+			closest_end_polygon = &polygons[closest_end.polygon_index];
+			closest_end_point = closest_end.point;
+		}
+
+		// If we have both a start and end point, then create a synthetic polygon to route through.
+		if (closest_start_polygon && closest_end_polygon) {
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+			new_polygon.id = polygon_count++;
+			new_polygon.owner = link;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
+			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
+			}
+		}
+	}
 }
 
 void NavMap::_update_rvo_obstacles_tree_2d() {
@@ -31,6 +31,7 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -78,13 +79,43 @@ class NavMap : public NavRid {
 	/// Map regions
 	LocalVector<NavRegion *> regions;
 
+	/// Are regions added or removed?
+	bool regions_dirty = true;
+
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
 
+	/// Are links modified?
+	bool links_dirty = true;
+
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Free edge of a region, `polygon` is relative to the region range in `polygons`.
+	struct RegionFreeEdge {
+		uint32_t polygon = 0;
+		int edge = 0;
+	};
+
+	/// Range and connection state of a region in `polygons`, in `regions` order.
+	/// Only regions that changed, or that can connect to one that changed, are relinked on sync.
+	struct RegionSlot {
+		NavRegion *region = nullptr;
+		uint32_t polygon_offset = 0;
+		uint32_t polygon_count = 0;
+		AABB bounds;
+		LocalVector<RegionFreeEdge> free_edges;
+
+		// Performance Monitor
+		int edge_count = 0;
+		int merged_edge_count = 0;
+	};
+	LocalVector<RegionSlot> region_slots;
+
+	/// Spatial index over `polygons`, rebuilt with them
+	NavPolygonBVH polygons_bvh;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -238,6 +269,9 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	void _sync_region_polygons(const LocalVector<bool> &p_regions_changed, bool p_relink_all);
+	void _sync_link_polygons();
 };
 
 #endif // NAV_MAP_H
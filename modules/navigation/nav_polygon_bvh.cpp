@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "nav_base.h"
+
+#include "core/math/face3.h"
+#include "core/templates/sort_array.h"
+
+#define BVH_LEAF_SIZE 4
+#define BVH_STACK_SIZE 64
+
+static _FORCE_INLINE_ real_t _aabb_distance_squared_to(const AABB &p_aabb, const Vector3 &p_point) {
+	return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+}
+
+int32_t NavPolygonBVH::_build_node(LocalVector<BuildItem> &p_items, uint32_t p_from, uint32_t p_count) {
+	AABB aabb = p_items[p_from].aabb;
+	AABB center_aabb(p_items[p_from].center, Vector3());
+	for (uint32_t i = p_from + 1; i < p_from + p_count; i++) {
+		aabb.merge_with(p_items[i].aabb);
+		center_aabb.expand_to(p_items[i].center);
+	}
+
+	const int32_t node_index = nodes.size();
+	nodes.push_back(Node());
+	nodes[node_index].aabb = aabb;
+
+	if (p_count <= BVH_LEAF_SIZE) {
+		nodes[node_index].begin = polygon_indices.size();
+		nodes[node_index].count = p_count;
+		for (uint32_t i = p_from; i < p_from + p_count; i++) {
+			polygon_indices.push_back(p_items[i].polygon_index);
+		}
+		return node_index;
+	}
+
+	// Median split along the longest axis of the polygon centers.
+	const uint32_t half = p_count / 2;
+	SortArray<BuildItem, BuildItemCmp> sorter;
+	sorter.compare.axis = center_aabb.get_longest_axis_index();
+	sorter.nth_element(0, p_count, half, &p_items[p_from]);
+
+	const int32_t left = _build_node(p_items, p_from, half);
+	const int32_t right = _build_node(p_items, p_from + half, p_count - half);
+	nodes[node_index].left = left;
+	nodes[node_index].right = right;
+
+	return node_index;
+}
+
+void NavPolygonBVH::build(const LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	LocalVector<BuildItem> items;
+	items.reserve(p_polygons.size());
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &polygon = p_polygons[i];
+		if (polygon.points.size() < 3) {
+			// Polygons without faces can't be the result of a query.
+			continue;
+		}
+		BuildItem item;
+		item.aabb = AABB(polygon.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < polygon.points.size(); j++) {
+			item.aabb.expand_to(polygon.points[j].pos);
+		}
+		item.center = item.aabb.get_center();
+		item.polygon_index = i;
+		items.push_back(item);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(2 * (items.size() / BVH_LEAF_SIZE + 1));
+	polygon_indices.reserve(items.size());
+	_build_node(items, 0, items.size());
+}
+
+void NavPolygonBVH::clear() {
+	nodes.clear();
+	polygon_indices.clear();
+}
+
+NavPolygonBVH::ClosestPolygonResult NavPolygonBVH::get_closest_polygon(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, bool p_filter_layers, uint32_t p_navigation_layers, real_t p_max_distance_squared) const {
+	ClosestPolygonResult result;
+	result.distance_squared = p_max_distance_squared;
+
+	if (nodes.is_empty()) {
+		return result;
+	}
+
+	int32_t stack[BVH_STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+
+		// Equal distances are still visited, they may hold a polygon with a lower index.
+		if (_aabb_distance_squared_to(node.aabb, p_point) > result.distance_squared) {
+			continue;
+		}
+
+		if (node.left < 0) {
+			for (uint32_t i = node.begin; i < node.begin + node.count; i++) {
+				const uint32_t polygon_index = polygon_indices[i];
+				const gd::Polygon &polygon = p_polygons[polygon_index];
+				if (p_filter_layers && (p_navigation_layers & polygon.owner->get_navigation_layers()) == 0) {
+					continue;
+				}
+
+				for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+					const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+					const Vector3 closest_point_on_face = face.get_closest_point_to(p_point);
+					const real_t distance_squared = closest_point_on_face.distance_squared_to(p_point);
+					if (distance_squared < result.distance_squared || (distance_squared == result.distance_squared && (int64_t)polygon_index < result.polygon_index)) {
+						result.polygon_index = polygon_index;
+						result.point = closest_point_on_face;
+						result.normal = face.get_plane().normal;
+						result.distance_squared = distance_squared;
+					}
+				}
+			}
+			continue;
+		}
+
+		ERR_FAIL_COND_V_MSG(stack_size + 2 > BVH_STACK_SIZE, result, "Navigation polygon BVH is too deep.");
+
+		// Push the farthest child first so the nearest one is visited first.
+		const real_t left_distance = _aabb_distance_squared_to(nodes[node.left].aabb, p_point);
+		const real_t right_distance = _aabb_distance_squared_to(nodes[node.right].aabb, p_point);
+		if (left_distance < right_distance) {
+			stack[stack_size++] = node.right;
+			stack[stack_size++] = node.left;
+		} else {
+			stack[stack_size++] = node.left;
+			stack[stack_size++] = node.right;
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+
+/**
+ * Static bounding volume hierarchy over the polygons of a navigation map.
+ *
+ * It is rebuilt whenever the map polygons change and is only read afterwards,
+ * so it can be queried from any number of threads holding the map read lock.
+ */
+class NavPolygonBVH {
+	struct Node {
+		AABB aabb;
+		// Child node indices for inner nodes, -1 for leaves.
+		int32_t left = -1;
+		int32_t right = -1;
+		// Range in `polygon_indices` covered by leaves.
+		uint32_t begin = 0;
+		uint32_t count = 0;
+	};
+
+	struct BuildItem {
+		AABB aabb;
+		Vector3 center;
+		uint32_t polygon_index = 0;
+	};
+
+	struct BuildItemCmp {
+		int axis = 0;
+
+		bool operator()(const BuildItem &p_left, const BuildItem &p_right) const {
+			return p_left.center[axis] < p_right.center[axis];
+		}
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<uint32_t> polygon_indices;
+
+	int32_t _build_node(LocalVector<BuildItem> &p_items, uint32_t p_from, uint32_t p_count);
+
+public:
+	struct ClosestPolygonResult {
+		int64_t polygon_index = -1;
+		Vector3 point;
+		Vector3 normal;
+		real_t distance_squared = FLT_MAX;
+	};
+
+	void build(const LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+	bool is_empty() const { return nodes.is_empty(); }
+
+	// Finds the polygon closest to `p_point`, only considering polygons closer than `p_max_distance_squared`.
+	// If `p_filter_layers` is set, polygons whose owner shares no layer with `p_navigation_layers` are skipped.
+	// Ties are resolved towards the lowest polygon index, matching a linear scan over `p_polygons`.
+	ClosestPolygonResult get_closest_polygon(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, bool p_filter_layers = false, uint32_t p_navigation_layers = 0, real_t p_max_distance_squared = FLT_MAX) const;
+};
+
+#endif // NAV_POLYGON_BVH_H
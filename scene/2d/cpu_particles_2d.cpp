@@ -30,6 +30,8 @@
 
 #include "cpu_particles_2d.h"
 
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/resources/atlas_texture.h"
 #include "scene/resources/curve_texture.h"
@@ -48,16 +50,92 @@ void CPUParticles2D::set_emitting(bool p_emitting) {
 	}
 }
 
+void CPUParticles2D::ParticleData::resize(int p_count) {
+	int old_count = count;
+	count = p_count;
+
+	active.resize(p_count);
+	time.resize(p_count);
+	origin_x.resize(p_count);
+	origin_y.resize(p_count);
+	velocity_x.resize(p_count);
+	velocity_y.resize(p_count);
+	basis_x.resize(p_count);
+	basis_y.resize(p_count);
+	rotation.resize(p_count);
+	color.resize(p_count);
+	for (LocalVector<real_t> &c : custom) {
+		c.resize(p_count);
+	}
+	lifetime.resize(p_count);
+	angle_rand.resize(p_count);
+	scale_rand.resize(p_count);
+	hue_rot_rand.resize(p_count);
+	anim_offset_rand.resize(p_count);
+	start_color_rand.resize(p_count);
+	base_color.resize(p_count);
+	seed.resize(p_count);
+	step_action.resize(p_count);
+	step_delta.resize(p_count);
+
+	const Particle default_particle;
+	for (int i = old_count; i < p_count; i++) {
+		store(i, default_particle);
+		step_action[i] = PARTICLE_ACTION_SKIP;
+		step_delta[i] = 0.0;
+	}
+}
+
+void CPUParticles2D::ParticleData::load(int p_index, Particle &r_particle) const {
+	r_particle.transform = Transform2D(basis_x[p_index], basis_y[p_index], Vector2(origin_x[p_index], origin_y[p_index]));
+	r_particle.color = color[p_index];
+	for (int i = 0; i < 4; i++) {
+		r_particle.custom[i] = custom[i][p_index];
+	}
+	r_particle.rotation = rotation[p_index];
+	r_particle.velocity = Vector2(velocity_x[p_index], velocity_y[p_index]);
+	r_particle.active = active[p_index];
+	r_particle.angle_rand = angle_rand[p_index];
+	r_particle.scale_rand = scale_rand[p_index];
+	r_particle.hue_rot_rand = hue_rot_rand[p_index];
+	r_particle.anim_offset_rand = anim_offset_rand[p_index];
+	r_particle.start_color_rand = start_color_rand[p_index];
+	r_particle.time = time[p_index];
+	r_particle.lifetime = lifetime[p_index];
+	r_particle.base_color = base_color[p_index];
+	r_particle.seed = seed[p_index];
+}
+
+void CPUParticles2D::ParticleData::store(int p_index, const Particle &p_particle) {
+	basis_x[p_index] = p_particle.transform.columns[0];
+	basis_y[p_index] = p_particle.transform.columns[1];
+	origin_x[p_index] = p_particle.transform.columns[2].x;
+	origin_y[p_index] = p_particle.transform.columns[2].y;
+	color[p_index] = p_particle.color;
+	for (int i = 0; i < 4; i++) {
+		custom[i][p_index] = p_particle.custom[i];
+	}
+	rotation[p_index] = p_particle.rotation;
+	velocity_x[p_index] = p_particle.velocity.x;
+	velocity_y[p_index] = p_particle.velocity.y;
+	active[p_index] = p_particle.active;
+	angle_rand[p_index] = p_particle.angle_rand;
+	scale_rand[p_index] = p_particle.scale_rand;
+	hue_rot_rand[p_index] = p_particle.hue_rot_rand;
+	anim_offset_rand[p_index] = p_particle.anim_offset_rand;
+	start_color_rand[p_index] = p_particle.start_color_rand;
+	time[p_index] = p_particle.time;
+	lifetime[p_index] = p_particle.lifetime;
+	base_color[p_index] = p_particle.base_color;
+	seed[p_index] = p_particle.seed;
+}
+
 void CPUParticles2D::set_amount(int p_amount) {
 	ERR_FAIL_COND_MSG(p_amount < 1, "Amount of particles must be greater than 0.");
 
 	particles.resize(p_amount);
-	{
-		Particle *w = particles.ptrw();
-
-		for (int i = 0; i < p_amount; i++) {
-			w[i].active = false;
-		}
+	for (int i = 0; i < p_amount; i++) {
+		particles.active[i] = false;
 	}
 
 	particle_data.resize((8 + 4 + 4) * p_amount);
@@ -105,7 +183,7 @@ bool CPUParticles2D::is_emitting() const {
 }
 
 int CPUParticles2D::get_amount() const {
-	return particles.size();
+	return particles.count;
 }
 
 double CPUParticles2D::get_lifetime() const {
@@ -266,13 +344,8 @@ void CPUParticles2D::restart() {
 	cycle = 0;
 	emitting = false;
 
-	{
-		int pc = particles.size();
-		Particle *w = particles.ptrw();
-
-		for (int i = 0; i < pc; i++) {
-			w[i].active = false;
-		}
+	for (int i = 0; i < particles.count; i++) {
+		particles.active[i] = false;
 	}
 
 	set_emitting(true);
@@ -557,7 +630,7 @@ static real_t rand_from_seed(uint32_t &seed) {
 }
 
 void CPUParticles2D::_update_internal() {
-	if (particles.size() == 0 || !is_visible_in_tree()) {
+	if (particles.count == 0 || !is_visible_in_tree()) {
 		_set_do_redraw(false);
 		return;
 	}
@@ -620,10 +693,7 @@ void CPUParticles2D::_update_internal() {
 void CPUParticles2D::_particles_process(double p_delta) {
 	p_delta *= speed_scale;
 
-	int pcount = particles.size();
-	Particle *w = particles.ptrw();
-
-	Particle *parray = w;
+	int pcount = particles.count;
 
 	double prev_time = time;
 	time += p_delta;
@@ -646,370 +716,448 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 	double system_phase = time / lifetime;
 
+	ParticlesStep step;
+	step.count = pcount;
+	step.delta = p_delta;
+	step.prev_time = prev_time;
+	step.system_phase = system_phase;
+	step.emission_xform = emission_xform;
+	step.velocity_xform = velocity_xform;
+
+	// Restarted particles draw from the global random generator, so they're emitted serially and in
+	// order to keep its sequence. The rest of the update only depends on each particle's own state.
 	bool should_be_active = false;
 	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
+		should_be_active = _particle_emit(i, step) || should_be_active;
+	}
 
-		if (!emitting && !p.active) {
-			continue;
+	uint32_t chunk_count = Math::division_round_up(uint32_t(pcount), uint32_t(PARTICLES_PER_TASK));
+	bool parallel = pcount >= PARALLEL_PROCESS_THRESHOLD && WorkerThreadPool::get_singleton()->get_thread_count() > 1 && WorkerThreadPool::get_thread_index() == -1;
+	if (parallel && bool(GLOBAL_GET("rendering/particles/cpu_particles/threaded_processing"))) {
+		// Gradients sort their points lazily on first sample, make sure that doesn't happen from several threads at once.
+		if (color_ramp.is_valid()) {
+			(void)color_ramp->get_color_at_offset(0.0);
 		}
 
-		double local_delta = p_delta;
-
-		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
-		// While we use time in tests later on, for randomness we use the phase as done in the
-		// original shader code, and we later multiply by lifetime to get the time.
-		double restart_phase = double(i) / double(pcount);
-
-		if (randomness_ratio > 0.0) {
-			uint32_t seed = cycle;
-			if (restart_phase >= system_phase) {
-				seed -= uint32_t(1);
-			}
-			seed *= uint32_t(pcount);
-			seed += uint32_t(i);
-			double random = double(idhash(seed) % uint32_t(65536)) / 65536.0;
-			restart_phase += randomness_ratio * random * 1.0 / double(pcount);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_particles_process_chunk, (const ParticlesStep *)&step, chunk_count, -1, true, SNAME("CPUParticles2DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_particles_process_chunk(i, &step);
 		}
+	}
 
-		restart_phase *= (1.0 - explosiveness_ratio);
-		double restart_time = restart_phase * lifetime;
-		bool restart = false;
+	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
+		active = false;
+		emit_signal(SceneStringName(finished));
+	}
+}
 
-		if (time > prev_time) {
-			// restart_time >= prev_time is used so particles emit in the first frame they are processed
+bool CPUParticles2D::_particle_emit(int p_index, const ParticlesStep &p_step) {
+	particles.step_action[p_index] = PARTICLE_ACTION_SKIP;
+	particles.step_delta[p_index] = 0.0;
 
-			if (restart_time >= prev_time && restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
+	if (!emitting && !particles.active[p_index]) {
+		return false;
+	}
 
-		} else if (local_delta > 0.0) {
-			if (restart_time >= prev_time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = lifetime - restart_time + time;
-				}
+	double local_delta = p_step.delta;
 
-			} else if (restart_time < time) {
-				restart = true;
-				if (fractional_delta) {
-					local_delta = time - restart_time;
-				}
-			}
-		}
+	// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
+	// While we use time in tests later on, for randomness we use the phase as done in the
+	// original shader code, and we later multiply by lifetime to get the time.
+	double restart_phase = double(p_index) / double(p_step.count);
 
-		if (p.time * (1.0 - explosiveness_ratio) > p.lifetime) {
-			restart = true;
+	if (randomness_ratio > 0.0) {
+		uint32_t seed = cycle;
+		if (restart_phase >= p_step.system_phase) {
+			seed -= uint32_t(1);
 		}
+		seed *= uint32_t(p_step.count);
+		seed += uint32_t(p_index);
+		double random = double(idhash(seed) % uint32_t(65536)) / 65536.0;
+		restart_phase += randomness_ratio * random * 1.0 / double(p_step.count);
+	}
 
-		float tv = 0.0;
+	restart_phase *= (1.0 - explosiveness_ratio);
+	double restart_time = restart_phase * lifetime;
+	bool restart = false;
 
-		if (restart) {
-			if (!emitting) {
-				p.active = false;
-				continue;
-			}
-			p.active = true;
+	if (time > p_step.prev_time) {
+		// restart_time >= prev_time is used so particles emit in the first frame they are processed
 
-			/*real_t tex_linear_velocity = 0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(0);
-			}*/
+		if (restart_time >= p_step.prev_time && restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = time - restart_time;
+			}
+		}
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+	} else if (local_delta > 0.0) {
+		if (restart_time >= p_step.prev_time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = lifetime - restart_time + time;
 			}
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
+		} else if (restart_time < time) {
+			restart = true;
+			if (fractional_delta) {
+				local_delta = time - restart_time;
 			}
+		}
+	}
 
-			p.seed = Math::rand();
+	if (particles.time[p_index] * (1.0 - explosiveness_ratio) > particles.lifetime[p_index]) {
+		restart = true;
+	}
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+	if (restart) {
+		if (!emitting) {
+			particles.active[p_index] = false;
+			return false;
+		}
 
-			if (color_initial_ramp.is_valid()) {
-				p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
-			} else {
-				p.start_color_rand = Color(1, 1, 1, 1);
-			}
+		Particle p;
+		particles.load(p_index, p);
+		p.active = true;
+		_particle_restart(p, p_step);
+		particles.store(p_index, p);
+		particles.step_action[p_index] = PARTICLE_ACTION_RESTART;
+	} else if (!particles.active[p_index]) {
+		return false;
+	} else if (particles.time[p_index] > particles.lifetime[p_index]) {
+		particles.step_action[p_index] = PARTICLE_ACTION_EXPIRE;
+	} else {
+		particles.step_action[p_index] = PARTICLE_ACTION_UPDATE;
+	}
 
-			real_t angle1_rad = direction.angle() + Math::deg_to_rad((Math::randf() * 2.0 - 1.0) * spread);
-			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
-
-			real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			p.rotation = Math::deg_to_rad(base_angle);
-
-			p.custom[0] = 0.0; // unused
-			p.custom[1] = 0.0; // phase [0..1]
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand);
-			p.custom[3] = (1.0 - Math::randf() * lifetime_randomness);
-			p.transform = Transform2D();
-			p.time = 0;
-			p.lifetime = lifetime * p.custom[3];
-			p.base_color = Color(1, 1, 1, 1);
-
-			switch (emission_shape) {
-				case EMISSION_SHAPE_POINT: {
-					//do none
-				} break;
-				case EMISSION_SHAPE_SPHERE: {
-					real_t t = Math_TAU * Math::randf();
-					real_t radius = emission_sphere_radius * Math::randf();
-					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
-				} break;
-				case EMISSION_SHAPE_SPHERE_SURFACE: {
-					real_t s = Math::randf(), t = Math_TAU * Math::randf();
-					real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
-					p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
-				} break;
-				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
-				} break;
-				case EMISSION_SHAPE_POINTS:
-				case EMISSION_SHAPE_DIRECTED_POINTS: {
-					int pc = emission_points.size();
-					if (pc == 0) {
-						break;
-					}
+	particles.step_delta[p_index] = local_delta;
+	return true;
+}
 
-					int random_idx = Math::rand() % pc;
+void CPUParticles2D::_particle_restart(Particle &p, const ParticlesStep &p_step) {
+	float tv = 0.0;
 
-					p.transform[2] = emission_points.get(random_idx);
+	/*real_t tex_linear_velocity = 0;
+	if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+		tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(0);
+	}*/
 
-					if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
-						Vector2 normal = emission_normals.get(random_idx);
-						Transform2D m2;
-						m2.columns[0] = normal;
-						m2.columns[1] = normal.orthogonal();
-						p.velocity = m2.basis_xform(p.velocity);
-					}
+	real_t tex_angle = 1.0;
+	if (curve_parameters[PARAM_ANGLE].is_valid()) {
+		tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+	}
 
-					if (emission_colors.size() == pc) {
-						p.base_color = emission_colors.get(random_idx);
-					}
-				} break;
-				case EMISSION_SHAPE_MAX: { // Max value for validity check.
-					break;
-				}
-			}
+	real_t tex_anim_offset = 1.0;
+	if (curve_parameters[PARAM_ANGLE].is_valid()) {
+		tex_anim_offset = curve_parameters[PARAM_ANGLE]->sample(tv);
+	}
 
-			if (!local_coords) {
-				p.velocity = velocity_xform.xform(p.velocity);
-				p.transform = emission_xform * p.transform;
-			}
+	p.seed = Math::rand();
 
-		} else if (!p.active) {
-			continue;
-		} else if (p.time > p.lifetime) {
-			p.active = false;
-			tv = 1.0;
-		} else {
-			uint32_t alt_seed = p.seed;
+	p.angle_rand = Math::randf();
+	p.scale_rand = Math::randf();
+	p.hue_rot_rand = Math::randf();
+	p.anim_offset_rand = Math::randf();
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
-			tv = p.time / p.lifetime;
+	if (color_initial_ramp.is_valid()) {
+		p.start_color_rand = color_initial_ramp->get_color_at_offset(Math::randf());
+	} else {
+		p.start_color_rand = Color(1, 1, 1, 1);
+	}
 
-			real_t tex_linear_velocity = 1.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
+	real_t angle1_rad = direction.angle() + Math::deg_to_rad((Math::randf() * 2.0 - 1.0) * spread);
+	Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
+	p.velocity = rot * Math::lerp(parameters_min[PARAM_INITIAL_LINEAR_VELOCITY], parameters_max[PARAM_INITIAL_LINEAR_VELOCITY], (real_t)Math::randf());
+
+	real_t base_angle = tex_angle * Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+	p.rotation = Math::deg_to_rad(base_angle);
+
+	p.custom[0] = 0.0; // unused
+	p.custom[1] = 0.0; // phase [0..1]
+	p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand);
+	p.custom[3] = (1.0 - Math::randf() * lifetime_randomness);
+	p.transform = Transform2D();
+	p.time = 0;
+	p.lifetime = lifetime * p.custom[3];
+	p.base_color = Color(1, 1, 1, 1);
+
+	switch (emission_shape) {
+		case EMISSION_SHAPE_POINT: {
+			//do none
+		} break;
+		case EMISSION_SHAPE_SPHERE: {
+			real_t t = Math_TAU * Math::randf();
+			real_t radius = emission_sphere_radius * Math::randf();
+			p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
+		} break;
+		case EMISSION_SHAPE_SPHERE_SURFACE: {
+			real_t s = Math::randf(), t = Math_TAU * Math::randf();
+			real_t radius = emission_sphere_radius * Math::sqrt(1.0 - s * s);
+			p.transform[2] = Vector2(Math::cos(t), Math::sin(t)) * radius;
+		} break;
+		case EMISSION_SHAPE_RECTANGLE: {
+			p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
+		} break;
+		case EMISSION_SHAPE_POINTS:
+		case EMISSION_SHAPE_DIRECTED_POINTS: {
+			int pc = emission_points.size();
+			if (pc == 0) {
+				break;
 			}
 
-			real_t tex_orbit_velocity = 1.0;
-			if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-				tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
-			}
+			int random_idx = Math::rand() % pc;
 
-			real_t tex_angular_velocity = 1.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
-			}
+			p.transform[2] = emission_points.get(random_idx);
 
-			real_t tex_linear_accel = 1.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
+			if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
+				Vector2 normal = emission_normals.get(random_idx);
+				Transform2D m2;
+				m2.columns[0] = normal;
+				m2.columns[1] = normal.orthogonal();
+				p.velocity = m2.basis_xform(p.velocity);
 			}
 
-			real_t tex_tangential_accel = 1.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
+			if (emission_colors.size() == pc) {
+				p.base_color = emission_colors.get(random_idx);
 			}
+		} break;
+		case EMISSION_SHAPE_MAX: { // Max value for validity check.
+			break;
+		}
+	}
 
-			real_t tex_radial_accel = 1.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
-			}
+	if (!local_coords) {
+		p.velocity = p_step.velocity_xform.xform(p.velocity);
+		p.transform = p_step.emission_xform * p.transform;
+	}
+}
 
-			real_t tex_damping = 1.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
-			}
+void CPUParticles2D::_particle_process(int p_index, const ParticlesStep &p_step) {
+	ParticleAction action = ParticleAction(particles.step_action[p_index]);
+	if (action == PARTICLE_ACTION_SKIP) {
+		return;
+	}
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
-			real_t tex_anim_speed = 1.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
-			}
+	Particle p;
+	particles.load(p_index, p);
+	double local_delta = particles.step_delta[p_index];
+	float tv = 0.0;
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
-			}
+	if (action == PARTICLE_ACTION_EXPIRE) {
+		p.active = false;
+		tv = 1.0;
+	} else if (action == PARTICLE_ACTION_UPDATE) {
+		uint32_t alt_seed = p.seed;
 
-			Vector2 force = gravity;
-			Vector2 pos = p.transform[2];
-
-			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
-			//apply radial acceleration
-			Vector2 org = emission_xform[2];
-			Vector2 diff = pos - org;
-			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
-			//apply tangential acceleration;
-			Vector2 yx = Vector2(diff.y, diff.x);
-			force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector2();
-			//apply attractor forces
-			p.velocity += force * local_delta;
-			//orbit velocity
-			real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
-			if (orbit_amount != 0.0) {
-				real_t ang = orbit_amount * local_delta * Math_TAU;
-				// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
-				// but we use -ang here to reproduce its behavior.
-				Transform2D rot = Transform2D(-ang, Vector2());
-				p.transform[2] -= diff;
-				p.transform[2] += rot.basis_xform(diff);
-			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
-			}
+		p.time += local_delta;
+		p.custom[1] = p.time / lifetime;
+		tv = p.time / p.lifetime;
 
-			if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
-				real_t v = p.velocity.length();
-				real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
-				v -= damp * local_delta;
-				if (v < 0.0) {
-					p.velocity = Vector2();
-				} else {
-					p.velocity = p.velocity.normalized() * v;
-				}
-			}
-			real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
-			p.rotation = Math::deg_to_rad(base_angle); //angle
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed));
+		real_t tex_linear_velocity = 1.0;
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
 		}
-		//apply color
-		//apply hue rotation
 
-		Vector2 tex_scale = Vector2(1.0, 1.0);
-		if (split_scale) {
-			if (scale_curve_x.is_valid()) {
-				tex_scale.x = scale_curve_x->sample(tv);
-			} else {
-				tex_scale.x = 1.0;
-			}
-			if (scale_curve_y.is_valid()) {
-				tex_scale.y = scale_curve_y->sample(tv);
-			} else {
-				tex_scale.y = 1.0;
-			}
-		} else {
-			if (curve_parameters[PARAM_SCALE].is_valid()) {
-				real_t tmp_scale = curve_parameters[PARAM_SCALE]->sample(tv);
-				tex_scale.x = tmp_scale;
-				tex_scale.y = tmp_scale;
-			}
+		real_t tex_orbit_velocity = 1.0;
+		if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
+			tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
 		}
 
-		real_t tex_hue_variation = 0.0;
-		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->sample(tv);
+		real_t tex_angular_velocity = 1.0;
+		if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
+			tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
 		}
 
-		real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
-		real_t hue_rot_c = Math::cos(hue_rot_angle);
-		real_t hue_rot_s = Math::sin(hue_rot_angle);
+		real_t tex_linear_accel = 1.0;
+		if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
+			tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
+		}
 
-		Basis hue_rot_mat;
-		{
-			Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
-			Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
-			Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+		real_t tex_tangential_accel = 1.0;
+		if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
+			tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
+		}
 
-			for (int j = 0; j < 3; j++) {
-				hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
-			}
+		real_t tex_radial_accel = 1.0;
+		if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
+			tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
 		}
 
-		if (color_ramp.is_valid()) {
-			p.color = color_ramp->get_color_at_offset(tv) * color;
-		} else {
-			p.color = color;
+		real_t tex_damping = 1.0;
+		if (curve_parameters[PARAM_DAMPING].is_valid()) {
+			tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
+		}
+
+		real_t tex_angle = 1.0;
+		if (curve_parameters[PARAM_ANGLE].is_valid()) {
+			tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+		}
+		real_t tex_anim_speed = 1.0;
+		if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
+			tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
 		}
 
-		Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
-		p.color.r = color_rgb.x;
-		p.color.g = color_rgb.y;
-		p.color.b = color_rgb.z;
+		real_t tex_anim_offset = 1.0;
+		if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
+			tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
+		}
 
-		p.color *= p.base_color * p.start_color_rand;
+		Vector2 force = gravity;
+		Vector2 pos = p.transform[2];
+
+		//apply linear acceleration
+		force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
+		//apply radial acceleration
+		Vector2 org = p_step.emission_xform[2];
+		Vector2 diff = pos - org;
+		force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
+		//apply tangential acceleration;
+		Vector2 yx = Vector2(diff.y, diff.x);
+		force += yx.length() > 0.0 ? (yx * Vector2(-1.0, 1.0)).normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector2();
+		//apply attractor forces
+		p.velocity += force * local_delta;
+		//orbit velocity
+		real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
+		if (orbit_amount != 0.0) {
+			real_t ang = orbit_amount * local_delta * Math_TAU;
+			// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
+			// but we use -ang here to reproduce its behavior.
+			Transform2D rot = Transform2D(-ang, Vector2());
+			p.transform[2] -= diff;
+			p.transform[2] += rot.basis_xform(diff);
+		}
+		if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+			p.velocity = p.velocity.normalized() * tex_linear_velocity;
+		}
 
-		if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
-			if (p.velocity.length() > 0.0) {
-				p.transform.columns[1] = p.velocity.normalized();
-				p.transform.columns[0] = p.transform.columns[1].orthogonal();
+		if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
+			real_t v = p.velocity.length();
+			real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
+			v -= damp * local_delta;
+			if (v < 0.0) {
+				p.velocity = Vector2();
+			} else {
+				p.velocity = p.velocity.normalized() * v;
 			}
+		}
+		real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+		base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
+		p.rotation = Math::deg_to_rad(base_angle); //angle
+		p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed));
+	}
+	//apply color
+	//apply hue rotation
 
+	Vector2 tex_scale = Vector2(1.0, 1.0);
+	if (split_scale) {
+		if (scale_curve_x.is_valid()) {
+			tex_scale.x = scale_curve_x->sample(tv);
+		} else {
+			tex_scale.x = 1.0;
+		}
+		if (scale_curve_y.is_valid()) {
+			tex_scale.y = scale_curve_y->sample(tv);
 		} else {
-			p.transform.columns[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
-			p.transform.columns[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
+			tex_scale.y = 1.0;
 		}
+	} else {
+		if (curve_parameters[PARAM_SCALE].is_valid()) {
+			real_t tmp_scale = curve_parameters[PARAM_SCALE]->sample(tv);
+			tex_scale.x = tmp_scale;
+			tex_scale.y = tmp_scale;
+		}
+	}
+
+	real_t tex_hue_variation = 0.0;
+	if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
+		tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->sample(tv);
+	}
+
+	real_t hue_rot_angle = (tex_hue_variation)*Math_TAU * Math::lerp(parameters_min[PARAM_HUE_VARIATION], parameters_max[PARAM_HUE_VARIATION], p.hue_rot_rand);
+	real_t hue_rot_c = Math::cos(hue_rot_angle);
+	real_t hue_rot_s = Math::sin(hue_rot_angle);
 
-		//scale by scale
-		Vector2 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
-		if (base_scale.x < 0.00001) {
-			base_scale.x = 0.00001;
+	Basis hue_rot_mat;
+	{
+		Basis mat1(0.299, 0.587, 0.114, 0.299, 0.587, 0.114, 0.299, 0.587, 0.114);
+		Basis mat2(0.701, -0.587, -0.114, -0.299, 0.413, -0.114, -0.300, -0.588, 0.886);
+		Basis mat3(0.168, 0.330, -0.497, -0.328, 0.035, 0.292, 1.250, -1.050, -0.203);
+
+		for (int j = 0; j < 3; j++) {
+			hue_rot_mat[j] = mat1[j] + mat2[j] * hue_rot_c + mat3[j] * hue_rot_s;
 		}
-		if (base_scale.y < 0.00001) {
-			base_scale.y = 0.00001;
+	}
+
+	if (color_ramp.is_valid()) {
+		p.color = color_ramp->get_color_at_offset(tv) * color;
+	} else {
+		p.color = color;
+	}
+
+	Vector3 color_rgb = hue_rot_mat.xform_inv(Vector3(p.color.r, p.color.g, p.color.b));
+	p.color.r = color_rgb.x;
+	p.color.g = color_rgb.y;
+	p.color.b = color_rgb.z;
+
+	p.color *= p.base_color * p.start_color_rand;
+
+	if (particle_flags[PARTICLE_FLAG_ALIGN_Y_TO_VELOCITY]) {
+		if (p.velocity.length() > 0.0) {
+			p.transform.columns[1] = p.velocity.normalized();
+			p.transform.columns[0] = p.transform.columns[1].orthogonal();
 		}
-		p.transform.columns[0] *= base_scale.x;
-		p.transform.columns[1] *= base_scale.y;
 
-		p.transform[2] += p.velocity * local_delta;
+	} else {
+		p.transform.columns[0] = Vector2(Math::cos(p.rotation), -Math::sin(p.rotation));
+		p.transform.columns[1] = Vector2(Math::sin(p.rotation), Math::cos(p.rotation));
+	}
 
-		should_be_active = true;
+	//scale by scale
+	Vector2 base_scale = tex_scale * Math::lerp(parameters_min[PARAM_SCALE], parameters_max[PARAM_SCALE], p.scale_rand);
+	if (base_scale.x < 0.00001) {
+		base_scale.x = 0.00001;
 	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
-		active = false;
-		emit_signal(SceneStringName(finished));
+	if (base_scale.y < 0.00001) {
+		base_scale.y = 0.00001;
+	}
+	p.transform.columns[0] *= base_scale.x;
+	p.transform.columns[1] *= base_scale.y;
+
+	// Moved by the integration pass.
+	particles.store(p_index, p);
+}
+
+void CPUParticles2D::_particles_process_chunk(uint32_t p_chunk, const ParticlesStep *p_step) {
+	int from = p_chunk * PARTICLES_PER_TASK;
+	int to = MIN(from + PARTICLES_PER_TASK, p_step->count);
+	for (int i = from; i < to; i++) {
+		_particle_process(i, *p_step);
+	}
+
+	// Skipped particles have a zero delta, so this runs branchless over the whole chunk.
+	real_t *origin_x = particles.origin_x.ptr();
+	real_t *origin_y = particles.origin_y.ptr();
+	const real_t *velocity_x = particles.velocity_x.ptr();
+	const real_t *velocity_y = particles.velocity_y.ptr();
+	const double *step_delta = particles.step_delta.ptr();
+	for (int i = from; i < to; i++) {
+		real_t delta = step_delta[i];
+		origin_x[i] += velocity_x[i] * delta;
+		origin_y[i] += velocity_y[i] * delta;
 	}
 }
 
 void CPUParticles2D::_update_particle_data_buffer() {
 	MutexLock lock(update_mutex);
 
-	int pc = particles.size();
+	int pc = particles.count;
 
 	int *ow;
 	int *order = nullptr;
 
 	float *w = particle_data.ptrw();
-	const Particle *r = particles.ptr();
 	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
@@ -1021,21 +1169,29 @@ void CPUParticles2D::_update_particle_data_buffer() {
 		}
 		if (draw_order == DRAW_ORDER_LIFETIME) {
 			SortArray<int, SortLifetime> sorter;
-			sorter.compare.particles = r;
+			sorter.compare.time = particles.time.ptr();
 			sorter.sort(order, pc);
 		}
 	}
 
+	const uint8_t *active_r = particles.active.ptr();
+	const Vector2 *basis_x = particles.basis_x.ptr();
+	const Vector2 *basis_y = particles.basis_y.ptr();
+	const real_t *origin_x = particles.origin_x.ptr();
+	const real_t *origin_y = particles.origin_y.ptr();
+	const Color *color_r = particles.color.ptr();
+	const real_t *custom_r[4] = { particles.custom[0].ptr(), particles.custom[1].ptr(), particles.custom[2].ptr(), particles.custom[3].ptr() };
+
 	for (int i = 0; i < pc; i++) {
 		int idx = order ? order[i] : i;
 
-		Transform2D t = r[idx].transform;
+		if (active_r[idx]) {
+			Transform2D t(basis_x[idx], basis_y[idx], Vector2(origin_x[idx], origin_y[idx]));
 
-		if (!local_coords) {
-			t = inv_emission_transform * t;
-		}
+			if (!local_coords) {
+				t = inv_emission_transform * t;
+			}
 
-		if (r[idx].active) {
 			ptr[0] = t.columns[0][0];
 			ptr[1] = t.columns[1][0];
 			ptr[2] = 0;
@@ -1049,17 +1205,17 @@ void CPUParticles2D::_update_particle_data_buffer() {
 			memset(ptr, 0, sizeof(float) * 8);
 		}
 
-		Color c = r[idx].color;
+		Color c = color_r[idx];
 
 		ptr[8] = c.r;
 		ptr[9] = c.g;
 		ptr[10] = c.b;
 		ptr[11] = c.a;
 
-		ptr[12] = r[idx].custom[0];
-		ptr[13] = r[idx].custom[1];
-		ptr[14] = r[idx].custom[2];
-		ptr[15] = r[idx].custom[3];
+		ptr[12] = custom_r[0][idx];
+		ptr[13] = custom_r[1][idx];
+		ptr[14] = custom_r[2][idx];
+		ptr[15] = custom_r[3][idx];
 
 		ptr += 16;
 	}
@@ -1134,16 +1290,15 @@ void CPUParticles2D::_notification(int p_what) {
 			inv_emission_transform = get_global_transform().affine_inverse();
 
 			if (!local_coords) {
-				int pc = particles.size();
+				int pc = particles.count;
 
 				float *w = particle_data.ptrw();
-				const Particle *r = particles.ptr();
 				float *ptr = w;
 
 				for (int i = 0; i < pc; i++) {
-					Transform2D t = inv_emission_transform * r[i].transform;
+					if (particles.active[i]) {
+						Transform2D t = inv_emission_transform * Transform2D(particles.basis_x[i], particles.basis_y[i], Vector2(particles.origin_x[i], particles.origin_y[i]));
 
-					if (r[i].active) {
 						ptr[0] = t.columns[0][0];
 						ptr[1] = t.columns[1][0];
 						ptr[2] = 0;
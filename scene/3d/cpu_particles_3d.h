@@ -83,6 +83,7 @@ private:
 	bool emitting = false;
 	bool active = false;
 
+	// Working copy of one particle, for the parts of the update that branch per particle.
 	struct Particle {
 		Transform3D transform;
 		Color color;
@@ -108,23 +109,68 @@ private:
 
 	RID multimesh;
 
-	Vector<Particle> particles;
+	enum ParticleAction : uint8_t {
+		PARTICLE_ACTION_SKIP,
+		PARTICLE_ACTION_RESTART,
+		PARTICLE_ACTION_EXPIRE,
+		PARTICLE_ACTION_UPDATE,
+	};
+
+	// Particles are stored as a structure of arrays, so the passes running over all of them
+	// (integration, buffer fill and sorting) read contiguous components and vectorize.
+	struct ParticleData {
+		int count = 0;
+
+		LocalVector<uint8_t> active;
+		LocalVector<double> time;
+		LocalVector<real_t> origin_x;
+		LocalVector<real_t> origin_y;
+		LocalVector<real_t> origin_z;
+		LocalVector<real_t> velocity_x;
+		LocalVector<real_t> velocity_y;
+		LocalVector<real_t> velocity_z;
+		LocalVector<Basis> basis;
+		LocalVector<Color> color;
+		LocalVector<real_t> custom[4];
+
+		// Set when a particle restarts.
+		LocalVector<double> lifetime;
+		LocalVector<real_t> angle_rand;
+		LocalVector<real_t> scale_rand;
+		LocalVector<real_t> hue_rot_rand;
+		LocalVector<real_t> anim_offset_rand;
+		LocalVector<Color> start_color_rand;
+		LocalVector<Color> base_color;
+		LocalVector<uint32_t> seed;
+
+		// What happens to each particle in the current step, and the time it moves by.
+		LocalVector<uint8_t> step_action;
+		LocalVector<double> step_delta;
+
+		void resize(int p_count);
+		void load(int p_index, Particle &r_particle) const;
+		void store(int p_index, const Particle &p_particle);
+	};
+
+	ParticleData particles;
 	Vector<float> particle_data;
 	Vector<int> particle_order;
 
 	struct SortLifetime {
-		const Particle *particles = nullptr;
+		const double *time = nullptr;
 
 		bool operator()(int p_a, int p_b) const {
-			return particles[p_a].time > particles[p_b].time;
+			return time[p_a] > time[p_b];
 		}
 	};
 
 	struct SortAxis {
-		const Particle *particles = nullptr;
+		const real_t *origin_x = nullptr;
+		const real_t *origin_y = nullptr;
+		const real_t *origin_z = nullptr;
 		Vector3 axis;
 		bool operator()(int p_a, int p_b) const {
-			return axis.dot(particles[p_a].transform.origin) < axis.dot(particles[p_b].transform.origin);
+			return axis.x * origin_x[p_a] + axis.y * origin_y[p_a] + axis.z * origin_z[p_a] < axis.x * origin_x[p_b] + axis.y * origin_y[p_b] + axis.z * origin_z[p_b];
 		}
 	};
 
@@ -187,8 +233,27 @@ private:
 
 	Vector3 gravity = Vector3(0, -9.8, 0);
 
+	// Per-frame state shared by all particles during a processing step.
+	struct ParticlesStep {
+		int count = 0;
+		double delta = 0.0;
+		double prev_time = 0.0;
+		double system_phase = 0.0;
+		Transform3D emission_xform;
+		Basis velocity_xform;
+	};
+
+	enum {
+		PARTICLES_PER_TASK = 256,
+		PARALLEL_PROCESS_THRESHOLD = 1024,
+	};
+
 	void _update_internal();
 	void _particles_process(double p_delta);
+	bool _particle_emit(int p_index, const ParticlesStep &p_step);
+	void _particle_restart(Particle &p, const ParticlesStep &p_step);
+	void _particle_process(int p_index, const ParticlesStep &p_step);
+	void _particles_process_chunk(uint32_t p_chunk, const ParticlesStep *p_step);
 	void _update_particle_data_buffer();
 
 	Mutex update_mutex;
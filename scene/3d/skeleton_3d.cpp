@@ -272,13 +272,12 @@ void Skeleton3D::_update_process_order() {
 		}
 	}
 
-	bones_backup.resize(bones.size());
-
 	concatenated_bone_names = StringName();
 
 	_update_bones_nested_set();
 
 	process_order_dirty = false;
+	process_order_pass++;
 
 	emit_signal("bone_list_changed");
 }
@@ -339,16 +338,16 @@ void Skeleton3D::_notification(int p_what) {
 			int len = bones.size();
 
 			thread_local LocalVector<bool> bone_global_pose_dirty_backup;
+			thread_local LocalVector<Transform3D> bone_global_poses_backup;
 
 			// Process modifiers.
 			_find_modifiers();
 			if (!modifiers.is_empty()) {
 				// Store unmodified bone poses.
-				for (uint32_t i = 0; i < bones.size(); i++) {
-					bones_backup[i].save(bones[i]);
-				}
+				bone_pose_channels_backup = bone_pose_channels;
 				// Store dirty flags for global bone poses.
 				bone_global_pose_dirty_backup = bone_global_pose_dirty;
+				bone_global_poses_backup = bone_global_poses;
 
 				_process_modifiers();
 			}
@@ -410,22 +409,34 @@ void Skeleton3D::_notification(int p_what) {
 					}
 
 					E->skeleton_version = version;
+					E->skeleton_process_order_pass = 0;
+				}
+
+				if (E->skeleton_process_order_pass != process_order_pass) {
+					// Resolve binds to the global pose buffer once, instead of going through the bones on every update.
+					E->skin_bone_offsets.resize(bind_count);
+					for (uint32_t i = 0; i < bind_count; i++) {
+						uint32_t bone_index = E->skin_bone_indices_ptrs[i];
+						E->skin_bone_offsets[i] = bone_index < (uint32_t)len ? bonesptr[bone_index].nested_set_offset : UINT32_MAX;
+					}
+					E->skeleton_process_order_pass = process_order_pass;
 				}
 
+				const Transform3D *global_poses_ptr = bone_global_poses.ptr();
+				const uint32_t *offsets_ptr = E->skin_bone_offsets.ptr();
 				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].global_pose * skin->get_bind_pose(i));
+					uint32_t offset = offsets_ptr[i];
+					ERR_CONTINUE(offset >= (uint32_t)len);
+					rs->skeleton_bone_set_transform(skeleton, i, global_poses_ptr[offset] * skin->get_bind_pose(i));
 				}
 			}
 
 			if (!modifiers.is_empty()) {
 				// Restore unmodified bone poses.
-				for (uint32_t i = 0; i < bones.size(); i++) {
-					bones_backup[i].restore(bones[i]);
-				}
+				bone_pose_channels = bone_pose_channels_backup;
 				// Restore dirty flags for global bone poses.
 				bone_global_pose_dirty = bone_global_pose_dirty_backup;
+				bone_global_poses = bone_global_poses_backup;
 			}
 
 			updating = false;
@@ -471,12 +482,50 @@ void Skeleton3D::_make_modifiers_dirty() {
 void Skeleton3D::_update_bones_nested_set() {
 	nested_set_offset_to_bone_index.resize(bones.size());
 	bone_global_pose_dirty.resize(bones.size());
+	bone_parent_offsets.resize(bones.size());
+	bone_global_poses.resize(bones.size());
 	_make_bone_global_poses_dirty();
 
 	int offset = 0;
 	for (int bone : parentless_bones) {
 		offset += _update_bone_nested_set(bone, offset);
 	}
+
+	for (const Bone &bone : bones) {
+		bone_parent_offsets[bone.nested_set_offset] = bone.parent >= 0 ? bones[bone.parent].nested_set_offset : -1;
+	}
+
+	// Group offsets by depth. Parents precede their children in the nested set, so their depth is known first.
+	LocalVector<int> depths;
+	depths.resize(bones.size());
+	int depth_count = 0;
+	for (uint32_t offset = 0; offset < bones.size(); offset++) {
+		int parent_offset = bone_parent_offsets[offset];
+		depths[offset] = parent_offset >= 0 ? depths[parent_offset] + 1 : 0;
+		depth_count = MAX(depth_count, depths[offset] + 1);
+	}
+
+	// Counting sort, which keeps each depth in nested set order.
+	bone_depth_starts.resize(depth_count + 1);
+	for (int depth = 0; depth <= depth_count; depth++) {
+		bone_depth_starts[depth] = 0;
+	}
+	for (uint32_t offset = 0; offset < bones.size(); offset++) {
+		bone_depth_starts[depths[offset] + 1]++;
+	}
+	for (int depth = 1; depth <= depth_count; depth++) {
+		bone_depth_starts[depth] += bone_depth_starts[depth - 1];
+	}
+
+	LocalVector<int> depth_ends;
+	depth_ends.resize(depth_count);
+	for (int depth = 0; depth < depth_count; depth++) {
+		depth_ends[depth] = bone_depth_starts[depth];
+	}
+	bone_depth_offsets.resize(bones.size());
+	for (uint32_t offset = 0; offset < bones.size(); offset++) {
+		bone_depth_offsets[depth_ends[depths[offset]]++] = offset;
+	}
 }
 
 int Skeleton3D::_update_bone_nested_set(int p_bone, int p_offset) {
@@ -534,25 +583,25 @@ void Skeleton3D::_update_bone_global_pose(int p_bone) {
 		return;
 	}
 
-	thread_local LocalVector<int> bone_list;
-	bone_list.clear();
+	thread_local LocalVector<int> offset_list;
+	offset_list.clear();
 	Transform3D global_pose;
 
 	// Create list of parent bones for which the global pose needs to be recalculated.
-	for (int bone = p_bone; bone >= 0; bone = bones[bone].parent) {
-		int offset = bones[bone].nested_set_offset;
+	for (int offset = nested_set_offset; offset >= 0; offset = bone_parent_offsets[offset]) {
 		// Stop searching when global pose is not dirty.
 		if (!bone_global_pose_dirty[offset]) {
-			global_pose = bones[bone].global_pose;
+			global_pose = bone_global_poses[offset];
 			break;
 		}
 
-		bone_list.push_back(bone);
+		offset_list.push_back(offset);
 	}
 
 	// Calculate global poses for all parent bones and the current bone.
-	for (int i = bone_list.size() - 1; i >= 0; i--) {
-		int bone_idx = bone_list[i];
+	for (int i = offset_list.size() - 1; i >= 0; i--) {
+		int offset = offset_list[i];
+		int bone_idx = nested_set_offset_to_bone_index[offset];
 		Bone &bone = bones[bone_idx];
 		bool bone_enabled = bone.enabled && !show_rest_only;
 		Transform3D bone_pose = bone_enabled ? get_bone_pose(bone_idx) : get_bone_rest(bone_idx);
@@ -564,8 +613,8 @@ void Skeleton3D::_update_bone_global_pose(int p_bone) {
 		}
 #endif // _DISABLE_DEPRECATED
 
-		bone.global_pose = global_pose;
-		bone_global_pose_dirty[bone.nested_set_offset] = false;
+		bone_global_poses[offset] = global_pose;
+		bone_global_pose_dirty[offset] = false;
 	}
 }
 
@@ -573,7 +622,7 @@ Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	const_cast<Skeleton3D *>(this)->_update_bone_global_pose(p_bone);
-	return bones[p_bone].global_pose;
+	return bone_global_poses[bones[p_bone].nested_set_offset];
 }
 
 void Skeleton3D::set_bone_global_pose(int p_bone, const Transform3D &p_pose) {
@@ -614,6 +663,7 @@ int Skeleton3D::add_bone(const String &p_name) {
 	Bone b;
 	b.name = p_name;
 	bones.push_back(b);
+	bone_pose_channels.push_back();
 	int new_idx = bones.size() - 1;
 	name_to_bone_index.insert(p_name, new_idx);
 	process_order_dirty = true;
@@ -830,6 +880,7 @@ bool Skeleton3D::is_show_rest_only() const {
 
 void Skeleton3D::clear_bones() {
 	bones.clear();
+	bone_pose_channels.clear();
 	name_to_bone_index.clear();
 	process_order_dirty = true;
 	version++;
@@ -842,10 +893,10 @@ void Skeleton3D::set_bone_pose(int p_bone, const Transform3D &p_pose) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone, bone_size);
 
-	bones[p_bone].pose_position = p_pose.origin;
-	bones[p_bone].pose_rotation = p_pose.basis.get_rotation_quaternion();
-	bones[p_bone].pose_scale = p_pose.basis.get_scale();
-	bones[p_bone].pose_cache_dirty = true;
+	bone_pose_channels.positions[p_bone] = p_pose.origin;
+	bone_pose_channels.rotations[p_bone] = p_pose.basis.get_rotation_quaternion();
+	bone_pose_channels.scales[p_bone] = p_pose.basis.get_scale();
+	bone_pose_channels.cache_dirty[p_bone] = true;
 	if (is_inside_tree()) {
 		_make_dirty();
 		_make_bone_global_pose_subtree_dirty(p_bone);
@@ -856,8 +907,8 @@ void Skeleton3D::set_bone_pose_position(int p_bone, const Vector3 &p_position) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone, bone_size);
 
-	bones[p_bone].pose_position = p_position;
-	bones[p_bone].pose_cache_dirty = true;
+	bone_pose_channels.positions[p_bone] = p_position;
+	bone_pose_channels.cache_dirty[p_bone] = true;
 	if (is_inside_tree()) {
 		_make_dirty();
 		_make_bone_global_pose_subtree_dirty(p_bone);
@@ -867,8 +918,8 @@ void Skeleton3D::set_bone_pose_rotation(int p_bone, const Quaternion &p_rotation
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone, bone_size);
 
-	bones[p_bone].pose_rotation = p_rotation;
-	bones[p_bone].pose_cache_dirty = true;
+	bone_pose_channels.rotations[p_bone] = p_rotation;
+	bone_pose_channels.cache_dirty[p_bone] = true;
 	if (is_inside_tree()) {
 		_make_dirty();
 		_make_bone_global_pose_subtree_dirty(p_bone);
@@ -878,8 +929,8 @@ void Skeleton3D::set_bone_pose_scale(int p_bone, const Vector3 &p_scale) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone, bone_size);
 
-	bones[p_bone].pose_scale = p_scale;
-	bones[p_bone].pose_cache_dirty = true;
+	bone_pose_channels.scales[p_bone] = p_scale;
+	bone_pose_channels.cache_dirty[p_bone] = true;
 	if (is_inside_tree()) {
 		_make_dirty();
 		_make_bone_global_pose_subtree_dirty(p_bone);
@@ -889,19 +940,19 @@ void Skeleton3D::set_bone_pose_scale(int p_bone, const Vector3 &p_scale) {
 Vector3 Skeleton3D::get_bone_pose_position(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Vector3());
-	return bones[p_bone].pose_position;
+	return bone_pose_channels.positions[p_bone];
 }
 
 Quaternion Skeleton3D::get_bone_pose_rotation(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Quaternion());
-	return bones[p_bone].pose_rotation;
+	return bone_pose_channels.rotations[p_bone];
 }
 
 Vector3 Skeleton3D::get_bone_pose_scale(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Vector3());
-	return bones[p_bone].pose_scale;
+	return bone_pose_channels.scales[p_bone];
 }
 
 void Skeleton3D::reset_bone_pose(int p_bone) {
@@ -921,8 +972,8 @@ void Skeleton3D::reset_bone_poses() {
 Transform3D Skeleton3D::get_bone_pose(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
-	const_cast<Skeleton3D *>(this)->bones[p_bone].update_pose_cache();
-	return bones[p_bone].pose_cache;
+	const_cast<Skeleton3D *>(this)->bone_pose_channels.update_cache(p_bone);
+	return bone_pose_channels.caches[p_bone];
 }
 
 void Skeleton3D::_make_dirty() {
@@ -1057,61 +1108,74 @@ void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
 
 	Bone *bonesptr = bones.ptr();
+	const int *parent_offsets_ptr = bone_parent_offsets.ptr();
+	Transform3D *global_poses_ptr = bone_global_poses.ptr();
+
+	// Refresh local poses first. This only walks the pose channels and doesn't depend on the hierarchy.
+	for (int i = 0; i < bone_size; i++) {
+		bone_pose_channels.update_cache(i);
+	}
+	const Transform3D *pose_caches_ptr = bone_pose_channels.caches.ptr();
+
+	// Compose depth by depth. Bones of one depth only read global poses of the previous one, which are ready.
+	const int *depth_offsets_ptr = bone_depth_offsets.ptr();
+	for (uint32_t depth = 0; depth + 1 < bone_depth_starts.size(); depth++) {
+		const int depth_end = bone_depth_starts[depth + 1];
+		for (int depth_index = bone_depth_starts[depth]; depth_index < depth_end; depth_index++) {
+			const int offset = depth_offsets_ptr[depth_index];
+			if (!bone_global_pose_dirty[offset]) {
+				continue;
+			}
 
-	// Loop through nested set.
-	for (int offset = 0; offset < bone_size; offset++) {
-		if (!bone_global_pose_dirty[offset]) {
-			continue;
-		}
-
-		int current_bone_idx = nested_set_offset_to_bone_index[offset];
-		Bone &b = bonesptr[current_bone_idx];
-		bool bone_enabled = b.enabled && !show_rest_only;
+			int current_bone_idx = nested_set_offset_to_bone_index[offset];
+			Bone &b = bonesptr[current_bone_idx];
+			bool bone_enabled = b.enabled && !show_rest_only;
+			int parent_offset = parent_offsets_ptr[offset];
 
-		if (bone_enabled) {
-			b.update_pose_cache();
-			Transform3D pose = b.pose_cache;
+			if (bone_enabled) {
+				const Transform3D &pose = pose_caches_ptr[current_bone_idx];
 
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * pose;
+				if (parent_offset >= 0) {
+					global_poses_ptr[offset] = global_poses_ptr[parent_offset] * pose;
+				} else {
+					global_poses_ptr[offset] = pose;
+				}
 			} else {
-				b.global_pose = pose;
+				if (parent_offset >= 0) {
+					global_poses_ptr[offset] = global_poses_ptr[parent_offset] * b.rest;
+				} else {
+					global_poses_ptr[offset] = b.rest;
+				}
 			}
-		} else {
-			if (b.parent >= 0) {
-				b.global_pose = bonesptr[b.parent].global_pose * b.rest;
-			} else {
-				b.global_pose = b.rest;
+			if (rest_dirty) {
+				b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
 			}
-		}
-		if (rest_dirty) {
-			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
-		}
 
 #ifndef DISABLE_DEPRECATED
-		if (bone_enabled) {
-			Transform3D pose = b.pose_cache;
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
+			if (bone_enabled) {
+				const Transform3D &pose = pose_caches_ptr[current_bone_idx];
+				if (b.parent >= 0) {
+					b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
+				} else {
+					b.pose_global_no_override = pose;
+				}
 			} else {
-				b.pose_global_no_override = pose;
+				if (b.parent >= 0) {
+					b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
+				} else {
+					b.pose_global_no_override = b.rest;
+				}
 			}
-		} else {
-			if (b.parent >= 0) {
-				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
-			} else {
-				b.pose_global_no_override = b.rest;
+			if (b.global_pose_override_amount >= CMP_EPSILON) {
+				global_poses_ptr[offset] = global_poses_ptr[offset].interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+			}
+			if (b.global_pose_override_reset) {
+				b.global_pose_override_amount = 0.0;
 			}
-		}
-		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.global_pose = b.global_pose.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
-		}
-		if (b.global_pose_override_reset) {
-			b.global_pose_override_amount = 0.0;
-		}
 #endif // _DISABLE_DEPRECATED
 
-		bone_global_pose_dirty[offset] = false;
+			bone_global_pose_dirty[offset] = false;
+		}
 	}
 }
 
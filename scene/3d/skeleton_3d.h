@@ -50,6 +50,8 @@ class SkinReference : public RefCounted {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs = nullptr;
+	uint64_t skeleton_process_order_pass = 0;
+	LocalVector<uint32_t> skin_bone_offsets; // Offsets into the global pose buffer of the skeleton.
 
 protected:
 	static void _bind_methods();
@@ -101,23 +103,9 @@ private:
 		Transform3D global_rest;
 
 		bool enabled = true;
-		bool pose_cache_dirty = true;
-		Transform3D pose_cache;
-		Vector3 pose_position;
-		Quaternion pose_rotation;
-		Vector3 pose_scale = Vector3(1, 1, 1);
-		Transform3D global_pose;
 		int nested_set_offset = 0; // Offset in nested set of bone hierarchy.
 		int nested_set_span = 0; // Subtree span in nested set of bone hierarchy.
 
-		void update_pose_cache() {
-			if (pose_cache_dirty) {
-				pose_cache.basis.set_quaternion_scale(pose_rotation, pose_scale);
-				pose_cache.origin = pose_position;
-				pose_cache_dirty = false;
-			}
-		}
-
 		HashMap<StringName, Variant> metadata;
 
 #ifndef DISABLE_DEPRECATED
@@ -128,27 +116,37 @@ private:
 #endif // _DISABLE_DEPRECATED
 	};
 
-	struct BonePoseBackup {
-		Transform3D pose_cache;
-		Vector3 pose_position;
-		Quaternion pose_rotation;
-		Vector3 pose_scale = Vector3(1, 1, 1);
-		Transform3D global_pose;
-
-		void save(const Bone &p_bone) {
-			pose_cache = p_bone.pose_cache;
-			pose_position = p_bone.pose_position;
-			pose_rotation = p_bone.pose_rotation;
-			pose_scale = p_bone.pose_scale;
-			global_pose = p_bone.global_pose;
+	// Local pose channels, indexable with the bone index. Kept apart from Bone as structure of arrays,
+	// so the global pose pass refreshes local poses without touching the rest of each bone.
+	struct BonePoseChannels {
+		LocalVector<Vector3> positions;
+		LocalVector<Quaternion> rotations;
+		LocalVector<Vector3> scales;
+		LocalVector<Transform3D> caches;
+		LocalVector<bool> cache_dirty;
+
+		void push_back() {
+			positions.push_back(Vector3());
+			rotations.push_back(Quaternion());
+			scales.push_back(Vector3(1, 1, 1));
+			caches.push_back(Transform3D());
+			cache_dirty.push_back(true);
 		}
 
-		void restore(Bone &r_bone) {
-			r_bone.pose_cache = pose_cache;
-			r_bone.pose_position = pose_position;
-			r_bone.pose_rotation = pose_rotation;
-			r_bone.pose_scale = pose_scale;
-			r_bone.global_pose = global_pose;
+		void clear() {
+			positions.clear();
+			rotations.clear();
+			scales.clear();
+			caches.clear();
+			cache_dirty.clear();
+		}
+
+		_FORCE_INLINE_ void update_cache(int p_bone) {
+			if (cache_dirty[p_bone]) {
+				caches[p_bone].basis.set_quaternion_scale(rotations[p_bone], scales[p_bone]);
+				caches[p_bone].origin = positions[p_bone];
+				cache_dirty[p_bone] = false;
+			}
 		}
 	};
 
@@ -156,7 +154,9 @@ private:
 	void _skin_changed();
 
 	LocalVector<Bone> bones;
+	BonePoseChannels bone_pose_channels;
 	bool process_order_dirty = false;
+	uint64_t process_order_pass = 1;
 
 	Vector<int> parentless_bones;
 	HashMap<String, int> name_to_bone_index;
@@ -183,11 +183,18 @@ private:
 	void _process_modifiers();
 	void _process_changed();
 	void _make_modifiers_dirty();
-	LocalVector<BonePoseBackup> bones_backup;
+	BonePoseChannels bone_pose_channels_backup;
 
 	// Global bone pose calculation.
 	LocalVector<int> nested_set_offset_to_bone_index; // Map from Bone::nested_set_offset to bone index.
 	LocalVector<bool> bone_global_pose_dirty; // Indexable with Bone::nested_set_offset.
+	// Global pose buffer in process order, kept apart from Bone so the global pose pass and the skin upload walk contiguous memory.
+	LocalVector<int> bone_parent_offsets; // Indexable with Bone::nested_set_offset, -1 for parentless bones.
+	LocalVector<Transform3D> bone_global_poses; // Indexable with Bone::nested_set_offset.
+	// Nested set offsets grouped by depth in the hierarchy. Bones of the same depth don't depend on each other,
+	// so the global pose pass composes them level by level, each level only reading the previous one.
+	LocalVector<int> bone_depth_offsets;
+	LocalVector<int> bone_depth_starts; // Start of each depth in bone_depth_offsets, plus the end.
 	void _update_bones_nested_set();
 	int _update_bone_nested_set(int p_bone, int p_offset);
 	void _make_bone_global_poses_dirty();
@@ -473,6 +473,14 @@ bool AnimationMixer::is_deterministic() const {
 	return deterministic;
 }
 
+void AnimationMixer::set_parallel_blending_enabled(bool p_enabled) {
+	parallel_blending = p_enabled;
+}
+
+bool AnimationMixer::is_parallel_blending_enabled() const {
+	return parallel_blending;
+}
+
 void AnimationMixer::set_callback_mode_process(AnimationCallbackModeProcess p_mode) {
 	if (callback_mode_process == p_mode) {
 		return;
@@ -1113,6 +1121,11 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 #ifdef TOOLS_ENABLED
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 #endif // TOOLS_ENABLED
+	// A script override of _post_process_key_value() can't be called from worker threads, so it forces serial blending.
+	bool parallel = parallel_blending && !GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value);
+	if (parallel) {
+		is_GDVIRTUAL_CALL_post_process_key_value = false;
+	}
 	for (const AnimationInstance &ai : animation_instances) {
 		Ref<Animation> a = ai.animation_data.animation;
 		double time = ai.playback_info.time;
@@ -1160,6 +1173,41 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			}
 			Animation::TrackType ttype = animation_track->type;
 			track->root_motion = root_motion_track == animation_track->path;
+			if (parallel && !track->root_motion && !Math::is_zero_approx(blend)) {
+				// Tracks that only accumulate into their own cache are blended later on the WorkerThreadPool.
+				bool deferred = false;
+				switch (ttype) {
+#ifndef _3D_DISABLED
+					case Animation::TYPE_POSITION_3D:
+					case Animation::TYPE_ROTATION_3D:
+					case Animation::TYPE_SCALE_3D:
+					case Animation::TYPE_BLEND_SHAPE:
+#endif // _3D_DISABLED
+					case Animation::TYPE_BEZIER: {
+						deferred = true;
+					} break;
+					case Animation::TYPE_VALUE: {
+						deferred = a->value_track_get_update_mode(i) != Animation::UPDATE_DISCRETE || callback_mode_discrete == ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS;
+					} break;
+					default:
+						break;
+				}
+				if (deferred) {
+					if (track->parallel_blend_group < 0) {
+						if (parallel_blend_group_count == parallel_blend_groups.size()) {
+							parallel_blend_groups.push_back(ParallelBlendGroup());
+						}
+						track->parallel_blend_group = parallel_blend_group_count++;
+						parallel_blend_groups[track->parallel_blend_group].track_cache = track;
+					}
+					ParallelBlendItem item;
+					item.instance = &ai;
+					item.track = i;
+					item.blend = blend;
+					parallel_blend_groups[track->parallel_blend_group].items.push_back(item);
+					continue;
+				}
+			}
 			switch (ttype) {
 				case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
@@ -1238,15 +1286,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 						root_motion_cache.loc += (loc[1] - loc[0]) * blend;
 						prev_time = !backward ? start : end;
 					}
-					{
-						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
-						if (err != OK) {
-							continue;
-						}
-						loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
-						t->loc += (loc - t->init_loc) * blend;
-					}
+					_blend_track(track, a, i, ttype, time, backward, blend);
 #endif // _3D_DISABLED
 				} break;
 				case Animation::TYPE_ROTATION_3D: {
@@ -1325,15 +1365,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 						root_motion_cache.rot = (root_motion_cache.rot * Quaternion().slerp(rot[0].inverse() * rot[1], blend)).normalized();
 						prev_time = !backward ? start : end;
 					}
-					{
-						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
-						if (err != OK) {
-							continue;
-						}
-						rot = post_process_key_value(a, i, rot, t->object_id, t->bone_idx);
-						t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
-					}
+					_blend_track(track, a, i, ttype, time, backward, blend);
 #endif // _3D_DISABLED
 				} break;
 				case Animation::TYPE_SCALE_3D: {
@@ -1413,15 +1445,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 						root_motion_cache.scale += (scale[1] - scale[0]) * blend;
 						prev_time = !backward ? start : end;
 					}
-					{
-						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
-						if (err != OK) {
-							continue;
-						}
-						scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
-						t->scale += (scale - t->init_scale) * blend;
-					}
+					_blend_track(track, a, i, ttype, time, backward, blend);
 #endif // _3D_DISABLED
 				} break;
 				case Animation::TYPE_BLEND_SHAPE: {
@@ -1429,15 +1453,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					if (Math::is_zero_approx(blend)) {
 						continue; // Nothing to blend.
 					}
-					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
-					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
-					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
-					if (err != OK) {
-						continue;
-					}
-					value = post_process_key_value(a, i, value, t->object_id, t->shape_index);
-					t->value += (value - t->init_value) * blend;
+					_blend_track(track, a, i, ttype, time, backward, blend);
 #endif // _3D_DISABLED
 				} break;
 				case Animation::TYPE_BEZIER:
@@ -1450,60 +1466,7 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					bool is_discrete = is_value && a->value_track_get_update_mode(i) == Animation::UPDATE_DISCRETE;
 					bool force_continuous = callback_mode_discrete == ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS;
 					if (!is_discrete || force_continuous) {
-						t->use_continuous = true;
-
-						Variant value;
-						if (t->is_variant_interpolatable) {
-							value = is_value ? a->value_track_interpolate(i, time, is_discrete && force_continuous ? backward : false) : Variant(a->bezier_track_interpolate(i, time));
-							value = post_process_key_value(a, i, value, t->object_id);
-							if (value == Variant()) {
-								continue;
-							}
-						} else {
-							// Discrete track sets the value in the current _blend_process() function,
-							// but Force Continuous track does not set the value here because the value must be set in the _blend_apply() function later.
-							int idx = a->track_find_key(i, time, Animation::FIND_MODE_NEAREST, false, backward);
-							if (idx < 0) {
-								continue;
-							}
-							value = a->track_get_key_value(i, idx);
-							value = post_process_key_value(a, i, value, t->object_id);
-							if (value == Variant()) {
-								continue;
-							}
-							t->value = value;
-							continue;
-						}
-
-						// Special case for angle interpolation.
-						if (t->is_using_angle) {
-							// For blending consistency, it prevents rotation of more than 180 degrees from init_value.
-							// This is the same as for Quaternion blends.
-							float rot_a = t->value;
-							float rot_b = value;
-							float rot_init = t->init_value;
-							rot_a = Math::fposmod(rot_a, (float)Math_TAU);
-							rot_b = Math::fposmod(rot_b, (float)Math_TAU);
-							rot_init = Math::fposmod(rot_init, (float)Math_TAU);
-							if (rot_init < Math_PI) {
-								rot_a = rot_a > rot_init + Math_PI ? rot_a - Math_TAU : rot_a;
-								rot_b = rot_b > rot_init + Math_PI ? rot_b - Math_TAU : rot_b;
-							} else {
-								rot_a = rot_a < rot_init - Math_PI ? rot_a + Math_TAU : rot_a;
-								rot_b = rot_b < rot_init - Math_PI ? rot_b + Math_TAU : rot_b;
-							}
-							t->value = Math::fposmod(rot_a + (rot_b - rot_init) * (float)blend, (float)Math_TAU);
-						} else {
-							value = Animation::cast_to_blendwise(value);
-							if (t->init_value.is_array()) {
-								t->element_size = MAX(t->element_size.operator int(), (value.operator Array()).size());
-							} else if (t->init_value.is_string()) {
-								real_t length = Animation::subtract_variant((real_t)(value.operator Array()).size(), (real_t)(t->init_value.operator String()).length());
-								t->element_size = Animation::blend_variant(t->element_size, length, blend);
-							}
-							value = Animation::subtract_variant(value, Animation::cast_to_blendwise(t->init_value));
-							t->value = Animation::blend_variant(t->value, value, blend);
-						}
+						_blend_track(track, a, i, ttype, time, backward, blend);
 					} else {
 						if (seeked) {
 							int idx = a->track_find_key(i, time, is_external_seeking ? Animation::FIND_MODE_NEAREST : Animation::FIND_MODE_EXACT, false, seeked_backward);
@@ -1736,9 +1699,155 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 			}
 		}
 	}
+	if (parallel_blend_group_count > 0) {
+		if (parallel_blend_group_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AnimationMixer::_blend_process_parallel_group, (void *)nullptr, parallel_blend_group_count, -1, true, SNAME("AnimationMixerBlend"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			_blend_process_parallel_group(0, nullptr);
+		}
+		for (uint32_t i = 0; i < parallel_blend_group_count; i++) {
+			parallel_blend_groups[i].track_cache->parallel_blend_group = -1;
+			parallel_blend_groups[i].track_cache = nullptr;
+			parallel_blend_groups[i].items.clear();
+		}
+		parallel_blend_group_count = 0;
+	}
 	is_GDVIRTUAL_CALL_post_process_key_value = true;
 }
 
+void AnimationMixer::_blend_process_parallel_group(uint32_t p_index, void *p_userdata) {
+	const ParallelBlendGroup &group = parallel_blend_groups[p_index];
+	// Items are kept in the order of the animation instances, so the result matches the serial blend.
+	for (const ParallelBlendItem &item : group.items) {
+		const AnimationInstance &ai = *item.instance;
+		const Ref<Animation> &a = ai.animation_data.animation;
+		_blend_track(group.track_cache, a, item.track, a->track_get_type(item.track), ai.playback_info.time, signbit(ai.playback_info.delta), item.blend);
+	}
+}
+
+void AnimationMixer::_blend_track(TrackCache *p_track, const Ref<Animation> &p_animation, int p_track_idx, Animation::TrackType p_type, double p_time, bool p_backward, real_t p_blend) {
+	// Only writes to p_track, so different track caches can be blended at the same time.
+	const Ref<Animation> &a = p_animation;
+	int i = p_track_idx;
+	double time = p_time;
+	real_t blend = p_blend;
+	switch (p_type) {
+		case Animation::TYPE_POSITION_3D: {
+#ifndef _3D_DISABLED
+			TrackCacheTransform *t = static_cast<TrackCacheTransform *>(p_track);
+			Vector3 loc;
+			Error err = a->try_position_track_interpolate(i, time, &loc);
+			if (err != OK) {
+				return;
+			}
+			loc = post_process_key_value(a, i, loc, t->object_id, t->bone_idx);
+			t->loc += (loc - t->init_loc) * blend;
+#endif // _3D_DISABLED
+		} break;
+		case Animation::TYPE_ROTATION_3D: {
+#ifndef _3D_DISABLED
+			TrackCacheTransform *t = static_cast<TrackCacheTransform *>(p_track);
+			Quaternion rot;
+			Error err = a->try_rotation_track_interpolate(i, time, &rot);
+			if (err != OK) {
+				return;
+			}
+			rot = post_process_key_value(a, i, rot, t->object_id, t->bone_idx);
+			t->rot = (t->rot * Quaternion().slerp(t->init_rot.inverse() * rot, blend)).normalized();
+#endif // _3D_DISABLED
+		} break;
+		case Animation::TYPE_SCALE_3D: {
+#ifndef _3D_DISABLED
+			TrackCacheTransform *t = static_cast<TrackCacheTransform *>(p_track);
+			Vector3 scale;
+			Error err = a->try_scale_track_interpolate(i, time, &scale);
+			if (err != OK) {
+				return;
+			}
+			scale = post_process_key_value(a, i, scale, t->object_id, t->bone_idx);
+			t->scale += (scale - t->init_scale) * blend;
+#endif // _3D_DISABLED
+		} break;
+		case Animation::TYPE_BLEND_SHAPE: {
+#ifndef _3D_DISABLED
+			TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(p_track);
+			float value;
+			Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+			if (err != OK) {
+				return;
+			}
+			value = post_process_key_value(a, i, value, t->object_id, t->shape_index);
+			t->value += (value - t->init_value) * blend;
+#endif // _3D_DISABLED
+		} break;
+		case Animation::TYPE_BEZIER:
+		case Animation::TYPE_VALUE: {
+			TrackCacheValue *t = static_cast<TrackCacheValue *>(p_track);
+			bool is_value = p_type == Animation::TYPE_VALUE;
+			bool is_discrete = is_value && a->value_track_get_update_mode(i) == Animation::UPDATE_DISCRETE;
+			bool force_continuous = callback_mode_discrete == ANIMATION_CALLBACK_MODE_DISCRETE_FORCE_CONTINUOUS;
+			bool backward = p_backward;
+			t->use_continuous = true;
+
+			Variant value;
+			if (t->is_variant_interpolatable) {
+				value = is_value ? a->value_track_interpolate(i, time, is_discrete && force_continuous ? backward : false) : Variant(a->bezier_track_interpolate(i, time));
+				value = post_process_key_value(a, i, value, t->object_id);
+				if (value == Variant()) {
+					return;
+				}
+			} else {
+				// Discrete track sets the value in the current _blend_process() function,
+				// but Force Continuous track does not set the value here because the value must be set in the _blend_apply() function later.
+				int idx = a->track_find_key(i, time, Animation::FIND_MODE_NEAREST, false, backward);
+				if (idx < 0) {
+					return;
+				}
+				value = a->track_get_key_value(i, idx);
+				value = post_process_key_value(a, i, value, t->object_id);
+				if (value == Variant()) {
+					return;
+				}
+				t->value = value;
+				return;
+			}
+
+			// Special case for angle interpolation.
+			if (t->is_using_angle) {
+				// For blending consistency, it prevents rotation of more than 180 degrees from init_value.
+				// This is the same as for Quaternion blends.
+				float rot_a = t->value;
+				float rot_b = value;
+				float rot_init = t->init_value;
+				rot_a = Math::fposmod(rot_a, (float)Math_TAU);
+				rot_b = Math::fposmod(rot_b, (float)Math_TAU);
+				rot_init = Math::fposmod(rot_init, (float)Math_TAU);
+				if (rot_init < Math_PI) {
+					rot_a = rot_a > rot_init + Math_PI ? rot_a - Math_TAU : rot_a;
+					rot_b = rot_b > rot_init + Math_PI ? rot_b - Math_TAU : rot_b;
+				} else {
+					rot_a = rot_a < rot_init - Math_PI ? rot_a + Math_TAU : rot_a;
+					rot_b = rot_b < rot_init - Math_PI ? rot_b + Math_TAU : rot_b;
+				}
+				t->value = Math::fposmod(rot_a + (rot_b - rot_init) * (float)blend, (float)Math_TAU);
+			} else {
+				value = Animation::cast_to_blendwise(value);
+				if (t->init_value.is_array()) {
+					t->element_size = MAX(t->element_size.operator int(), (value.operator Array()).size());
+				} else if (t->init_value.is_string()) {
+					real_t length = Animation::subtract_variant((real_t)(value.operator Array()).size(), (real_t)(t->init_value.operator String()).length());
+					t->element_size = Animation::blend_variant(t->element_size, length, blend);
+				}
+				value = Animation::subtract_variant(value, Animation::cast_to_blendwise(t->init_value));
+				t->value = Animation::blend_variant(t->value, value, blend);
+			}
+		} break;
+		default:
+			break;
+	}
+}
+
 void AnimationMixer::_blend_apply() {
 	// Finally, set the tracks.
 	for (const KeyValue<Animation::TypeHash, TrackCache *> &K : track_cache) {
@@ -2285,6 +2394,9 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_deterministic", "deterministic"), &AnimationMixer::set_deterministic);
 	ClassDB::bind_method(D_METHOD("is_deterministic"), &AnimationMixer::is_deterministic);
 
+	ClassDB::bind_method(D_METHOD("set_parallel_blending_enabled", "enabled"), &AnimationMixer::set_parallel_blending_enabled);
+	ClassDB::bind_method(D_METHOD("is_parallel_blending_enabled"), &AnimationMixer::is_parallel_blending_enabled);
+
 	ClassDB::bind_method(D_METHOD("set_root_node", "path"), &AnimationMixer::set_root_node);
 	ClassDB::bind_method(D_METHOD("get_root_node"), &AnimationMixer::get_root_node);
 
@@ -2326,6 +2438,7 @@ void AnimationMixer::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "deterministic"), "set_deterministic", "is_deterministic");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "parallel_blending"), "set_parallel_blending_enabled", "is_parallel_blending_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "reset_on_save", PROPERTY_HINT_NONE, ""), "set_reset_on_save_enabled", "is_reset_on_save_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_node"), "set_root_node", "get_root_node");
 
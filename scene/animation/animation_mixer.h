@@ -150,6 +150,7 @@ protected:
 		NodePath path;
 		ObjectID object_id;
 		real_t total_weight = 0.0;
+		int parallel_blend_group = -1;
 
 		TrackCache() = default;
 		TrackCache(const TrackCache &p_other) :
@@ -327,6 +328,20 @@ protected:
 	HashMap<NodePath, int> track_map;
 	int track_count = 0;
 	bool deterministic = false;
+	bool parallel_blending = false;
+
+	// Tracks whose blending is deferred to the WorkerThreadPool, grouped by track cache so that each cache is only written by one thread.
+	struct ParallelBlendItem {
+		const AnimationInstance *instance = nullptr;
+		int track = -1;
+		real_t blend = 0.0;
+	};
+	struct ParallelBlendGroup {
+		TrackCache *track_cache = nullptr;
+		LocalVector<ParallelBlendItem> items;
+	};
+	LocalVector<ParallelBlendGroup> parallel_blend_groups;
+	uint32_t parallel_blend_group_count = 0;
 
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
@@ -368,6 +383,8 @@ protected:
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For undeterministic blending.
 	void _blend_process(double p_delta, bool p_update_only = false);
+	void _blend_track(TrackCache *p_track, const Ref<Animation> &p_animation, int p_track_idx, Animation::TrackType p_type, double p_time, bool p_backward, real_t p_blend);
+	void _blend_process_parallel_group(uint32_t p_index, void *p_userdata);
 	void _blend_apply();
 	virtual void _blend_post_process();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred);
@@ -422,6 +439,9 @@ public:
 	void set_deterministic(bool p_deterministic);
 	bool is_deterministic() const;
 
+	void set_parallel_blending_enabled(bool p_enabled);
+	bool is_parallel_blending_enabled() const;
+
 	void set_root_node(const NodePath &p_path);
 	NodePath get_root_node() const;
 
@@ -81,6 +81,7 @@ protected:
 	float cell_size = NavigationDefaults3D::navmesh_cell_size;
 	float cell_height = NavigationDefaults3D::navmesh_cell_height;
 	float border_size = 0.0f;
+	float tile_size = 0.0f;
 	float agent_height = 1.5f;
 	float agent_radius = 0.5f;
 	float agent_max_climb = 0.25f;
@@ -135,6 +136,9 @@ public:
 	void set_border_size(float p_value);
 	float get_border_size() const;
 
+	void set_tile_size(float p_value);
+	float get_tile_size() const;
+
 	void set_agent_height(float p_value);
 	float get_agent_height() const;
 
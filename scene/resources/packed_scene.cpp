@@ -124,6 +124,113 @@ Ref<Resource> SceneState::get_remap_resource(const Ref<Resource> &p_resource, Ha
 	return remap_resource;
 }
 
+void SceneState::_build_instantiation_plan() const {
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan_ready.is_set()) {
+		return;
+	}
+
+	instantiation_plan.nodes.resize(nodes.size());
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::NodePlan &node_plan = instantiation_plan.nodes[i];
+		node_plan.create = nullptr;
+		node_plan.properties.clear();
+
+		// Only nodes created by this scene have a class known in advance.
+		if ((i == 0 && base_scene_idx >= 0) || n.instance >= 0 || n.type == TYPE_INSTANTIATED || n.type < 0 || n.type >= names.size()) {
+			continue;
+		}
+		const StringName &type = names[n.type];
+		if (!ClassDB::is_parent_class(type, SNAME("Node"))) {
+			continue;
+		}
+		node_plan.create = ClassDB::get_native_creation_func(type);
+		if (!node_plan.create) {
+			continue;
+		}
+
+		bool has_script = false;
+		for (const NodeData::Property &prop : n.properties) {
+			if (!(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name >= 0 && prop.name < names.size() && names[prop.name] == CoreStringName(script)) {
+				has_script = true;
+				break;
+			}
+		}
+		if (has_script) {
+			continue; // The script instance gets the first say on every property set after it.
+		}
+
+		node_plan.properties.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			InstantiationPlan::Property &prop_plan = node_plan.properties[j];
+			prop_plan = InstantiationPlan::Property();
+
+			if ((prop.name & FLAG_PATH_PROPERTY_IS_NODE) || prop.name < 0 || prop.name >= names.size() || prop.value < 0 || prop.value >= variants.size()) {
+				continue;
+			}
+
+			// Resources and containers may need to be made local to the scene or retyped first.
+			const Variant &value = variants[prop.value];
+			if (value.get_type() == Variant::OBJECT || value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+				continue;
+			}
+
+			const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(type, names[prop.name]);
+			if (!psg || !psg->_setptr) {
+				continue;
+			}
+
+			MethodBind *setter = psg->_setptr;
+			int value_arg = psg->index >= 0 ? 1 : 0;
+			if (setter->is_vararg() || setter->get_argument_count() != value_arg + 1) {
+				continue;
+			}
+
+			prop_plan.setter = setter;
+			prop_plan.index = psg->index;
+			prop_plan.validated = setter->get_argument_type(value_arg) == value.get_type() && (value_arg == 0 || setter->get_argument_type(0) == Variant::INT);
+		}
+	}
+
+	instantiation_plan.connection_binds.resize(connections.size());
+	for (int i = 0; i < connections.size(); i++) {
+		const ConnectionData &c = connections[i];
+		Vector<Variant> &binds = instantiation_plan.connection_binds[i];
+		binds.clear();
+		if (c.unbinds > 0) {
+			continue;
+		}
+		for (int j = 0; j < c.binds.size(); j++) {
+			binds.push_back(c.binds[j] >= 0 && c.binds[j] < variants.size() ? variants[c.binds[j]] : Variant());
+		}
+	}
+
+	instantiation_plan_ready.set();
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_ready.clear();
+	instantiation_plan.nodes.clear();
+	instantiation_plan.connection_binds.clear();
+}
+
+void SceneState::_set_property_from_plan(Object *p_object, const InstantiationPlan::Property &p_property, const Variant &p_value) {
+	Variant index = p_property.index;
+	const Variant *args[2] = { &index, &p_value };
+	const Variant **argptrs = p_property.index >= 0 ? args : args + 1;
+
+	if (p_property.validated) {
+		Variant ret;
+		p_property.setter->validated_call(p_object, argptrs, &ret);
+	} else {
+		Callable::CallError ce;
+		p_property.setter->call(p_object, argptrs, p_property.index >= 0 ? 2 : 1, ce);
+	}
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
@@ -165,8 +272,17 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
 
+	const InstantiationPlan *plan = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		if (!instantiation_plan_ready.is_set()) {
+			_build_instantiation_plan();
+		}
+		plan = &instantiation_plan;
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
+		const InstantiationPlan::NodePlan *node_plan = plan ? &plan->nodes[i] : nullptr;
 
 		Node *parent = nullptr;
 		String old_parent_path;
@@ -257,7 +373,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			}
 		} else {
 			// Node belongs to this scene and must be created.
-			Object *obj = ClassDB::instantiate(snames[n.type]);
+			Object *obj = node_plan && node_plan->create ? node_plan->create(true) : ClassDB::instantiate(snames[n.type]);
 
 			node = Object::cast_to<Node>(obj);
 
@@ -304,6 +420,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			int nprop_count = n.properties.size();
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
+				const InstantiationPlan::Property *planned_props = node_plan && (int)node_plan->properties.size() == nprop_count ? node_plan->properties.ptr() : nullptr;
 
 				Dictionary missing_resource_properties;
 				HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_sub_scene; // Record the mappings in the sub-scene.
@@ -337,7 +454,9 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 					ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
 
-					if (snames[nprops[j].name] == CoreStringName(script)) {
+					if (planned_props && planned_props[j].setter && !node->get_script_instance()) {
+						_set_property_from_plan(node, planned_props[j], props[nprops[j].value]);
+					} else if (snames[nprops[j].name] == CoreStringName(script)) {
 						//work around to avoid old script variables from disappearing, should be the proper fix to:
 						//https://github.com/godotengine/godot/issues/2958
 
@@ -590,6 +709,13 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		Callable callable(cto, snames[c.method]);
 		if (c.unbinds > 0) {
 			callable = callable.unbind(c.unbinds);
+		} else if (plan && !plan->connection_binds[i].is_empty()) {
+			const Vector<Variant> &binds = plan->connection_binds[i];
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * binds.size());
+			for (int j = 0; j < binds.size(); j++) {
+				argptrs[j] = &binds[j];
+			}
+			callable = callable.bindp(argptrs, binds.size());
 		} else if (!c.binds.is_empty()) {
 			Vector<Variant> binds;
 			if (c.binds.size()) {
@@ -1302,6 +1428,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1493,6 +1620,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_clear_instantiation_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1961,11 +2090,13 @@ Ref<Resource> SceneState::get_sub_resource(const String &p_path) {
 //add
 
 int SceneState::add_name(const StringName &p_name) {
+	_clear_instantiation_plan();
 	names.push_back(p_name);
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_clear_instantiation_plan();
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
@@ -1976,6 +2107,7 @@ int SceneState::add_node_path(const NodePath &p_path) {
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiation_plan();
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -2001,6 +2133,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_clear_instantiation_plan();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -2012,6 +2145,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
+	_clear_instantiation_plan();
 }
 
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, int p_unbinds, const Vector<int> &p_binds) {
@@ -2030,6 +2164,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	c.unbinds = p_unbinds;
 	c.binds = p_binds;
 	connections.push_back(c);
+	_clear_instantiation_plan();
 }
 
 void SceneState::add_editable_instance(const NodePath &p_path) {
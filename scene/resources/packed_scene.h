@@ -32,6 +32,9 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +92,32 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Built by the first runtime instantiate() and reused by the following ones, so spawning
+	// the same scene over and over skips the class and property setter lookups.
+	struct InstantiationPlan {
+		struct Property {
+			MethodBind *setter = nullptr; // When null, the property is set through Object::set().
+			int index = -1;
+			bool validated = false;
+		};
+
+		struct NodePlan {
+			Object *(*create)(bool) = nullptr;
+			LocalVector<Property> properties;
+		};
+
+		LocalVector<NodePlan> nodes;
+		LocalVector<Vector<Variant>> connection_binds;
+	};
+
+	mutable Mutex instantiation_plan_mutex;
+	mutable SafeFlag instantiation_plan_ready;
+	mutable InstantiationPlan instantiation_plan;
+
+	void _build_instantiation_plan() const;
+	void _clear_instantiation_plan();
+	static void _set_property_from_plan(Object *p_object, const InstantiationPlan::Property &p_property, const Variant &p_value);
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
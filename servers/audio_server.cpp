@@ -36,6 +36,7 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/math/audio_frame.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
@@ -46,12 +47,119 @@
 
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUDIO_SERVER_SIMD_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define AUDIO_SERVER_SIMD_NEON
+#endif
+
 #ifdef TOOLS_ENABLED
 #define MARK_EDITED set_edited(true);
 #else
 #define MARK_EDITED
 #endif
 
+// The vector paths of the mixing kernels perform the same operations in the same order as the scalar ones, so results are identical.
+
+void AudioServer::mix_ramp_accumulate(AudioFrame *p_out, const AudioFrame *p_source, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames) {
+	uint32_t frame_idx = 0;
+#if defined(AUDIO_SERVER_SIMD_SSE2)
+	const __m128 frames = _mm_set1_ps((float)p_frames);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 vol_start = _mm_setr_ps(p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right);
+	const __m128 vol_final = _mm_setr_ps(p_vol_final.left, p_vol_final.right, p_vol_final.left, p_vol_final.right);
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		__m128 lerp = _mm_div_ps(_mm_setr_ps((float)frame_idx, (float)frame_idx, (float)(frame_idx + 1), (float)(frame_idx + 1)), frames);
+		__m128 vol = _mm_add_ps(_mm_mul_ps(vol_final, lerp), _mm_mul_ps(_mm_sub_ps(one, lerp), vol_start));
+		float *out = &p_out[frame_idx].left;
+		_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_mul_ps(vol, _mm_loadu_ps(&p_source[frame_idx].left))));
+	}
+#elif defined(AUDIO_SERVER_SIMD_NEON)
+	const float32x4_t frames = vdupq_n_f32((float)p_frames);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float vol_start_data[4] = { p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right };
+	const float vol_final_data[4] = { p_vol_final.left, p_vol_final.right, p_vol_final.left, p_vol_final.right };
+	const float32x4_t vol_start = vld1q_f32(vol_start_data);
+	const float32x4_t vol_final = vld1q_f32(vol_final_data);
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		const float lerp_data[4] = { (float)frame_idx, (float)frame_idx, (float)(frame_idx + 1), (float)(frame_idx + 1) };
+		float32x4_t lerp = vdivq_f32(vld1q_f32(lerp_data), frames);
+		float32x4_t vol = vaddq_f32(vmulq_f32(vol_final, lerp), vmulq_f32(vsubq_f32(one, lerp), vol_start));
+		float *out = &p_out[frame_idx].left;
+		vst1q_f32(out, vaddq_f32(vld1q_f32(out), vmulq_f32(vol, vld1q_f32(&p_source[frame_idx].left))));
+	}
+#endif
+	for (; frame_idx < p_frames; frame_idx++) {
+		float lerp_param = (float)frame_idx / p_frames;
+		p_out[frame_idx] += (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_source[frame_idx];
+	}
+}
+
+void AudioServer::mix_accumulate(AudioFrame *p_out, const AudioFrame *p_source, uint32_t p_frames) {
+	uint32_t frame_idx = 0;
+#if defined(AUDIO_SERVER_SIMD_SSE2)
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		float *out = &p_out[frame_idx].left;
+		_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), _mm_loadu_ps(&p_source[frame_idx].left)));
+	}
+#elif defined(AUDIO_SERVER_SIMD_NEON)
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		float *out = &p_out[frame_idx].left;
+		vst1q_f32(out, vaddq_f32(vld1q_f32(out), vld1q_f32(&p_source[frame_idx].left)));
+	}
+#endif
+	for (; frame_idx < p_frames; frame_idx++) {
+		p_out[frame_idx] += p_source[frame_idx];
+	}
+}
+
+// Scales the buffer by the volume and returns the absolute peak of each side.
+AudioFrame AudioServer::mix_apply_volume(AudioFrame *p_buf, float p_volume, uint32_t p_frames) {
+	AudioFrame peak = AudioFrame(0, 0);
+	uint32_t frame_idx = 0;
+#if defined(AUDIO_SERVER_SIMD_SSE2)
+	const __m128 volume = _mm_set1_ps(p_volume);
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	__m128 peak4 = _mm_setzero_ps();
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		float *buf = &p_buf[frame_idx].left;
+		__m128 v = _mm_mul_ps(_mm_loadu_ps(buf), volume);
+		_mm_storeu_ps(buf, v);
+		peak4 = _mm_max_ps(peak4, _mm_and_ps(v, abs_mask));
+	}
+	peak4 = _mm_max_ps(peak4, _mm_movehl_ps(peak4, peak4));
+	float peak_data[4];
+	_mm_storeu_ps(peak_data, peak4);
+	peak = AudioFrame(peak_data[0], peak_data[1]);
+#elif defined(AUDIO_SERVER_SIMD_NEON)
+	const float32x4_t volume = vdupq_n_f32(p_volume);
+	float32x4_t peak4 = vdupq_n_f32(0.0f);
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		float *buf = &p_buf[frame_idx].left;
+		float32x4_t v = vmulq_f32(vld1q_f32(buf), volume);
+		vst1q_f32(buf, v);
+		peak4 = vmaxq_f32(peak4, vabsq_f32(v));
+	}
+	float32x2_t peak2 = vmax_f32(vget_low_f32(peak4), vget_high_f32(peak4));
+	peak = AudioFrame(vget_lane_f32(peak2, 0), vget_lane_f32(peak2, 1));
+#endif
+	for (; frame_idx < p_frames; frame_idx++) {
+		p_buf[frame_idx] *= p_volume;
+
+		float l = ABS(p_buf[frame_idx].left);
+		if (l > peak.left) {
+			peak.left = l;
+		}
+		float r = ABS(p_buf[frame_idx].right);
+		if (r > peak.right) {
+			peak.right = r;
+		}
+	}
+	return peak;
+}
+
 AudioDriver *AudioDriver::singleton = nullptr;
 AudioDriver *AudioDriver::get_singleton() {
 	return singleton;
@@ -518,131 +626,168 @@ void AudioServer::_mix_step() {
 		}
 	}
 
-	for (int i = buses.size() - 1; i >= 0; i--) {
-		//go bus by bus
-		Bus *bus = buses[i];
-
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (bus->channels[k].active && !bus->channels[k].used) {
-				//buffer was not used, but it's still active, so it must be cleaned
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+	// Build the send graph. Every bus sends to a bus with a lower index (or to master),
+	// so walking backwards visits all sources of a bus before the bus itself.
+	int bus_count = buses.size();
+	bus_mix_sources.resize(bus_count);
+	bus_mix_level.resize(bus_count);
+	for (int i = 0; i < bus_count; i++) {
+		bus_mix_sources[i].clear();
+	}
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					buf[j] = AudioFrame(0, 0);
-				}
-			}
+	int level_count = 0;
+	for (int i = bus_count - 1; i >= 0; i--) {
+		int level = 0;
+		for (int source_idx : bus_mix_sources[i]) {
+			level = MAX(level, bus_mix_level[source_idx] + 1);
 		}
+		bus_mix_level[i] = level;
+		level_count = MAX(level_count, level + 1);
 
-		//process effects
-		if (!bus->bypass) {
-			for (int j = 0; j < bus->effects.size(); j++) {
-				if (!bus->effects[j].enabled) {
-					continue;
-				}
-
-#ifdef DEBUG_ENABLED
-				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
-#endif
-
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
-				}
+		if (i > 0) {
+			//everything has a send save for master bus
+			int send_idx = 0;
+			HashMap<StringName, Bus *>::ConstIterator E = bus_map.find(buses[i]->send);
+			if (E && E->value->index_cache < buses[i]->index_cache) {
+				send_idx = E->value->index_cache;
+			} // Otherwise invalid, send to master.
+			bus_mix_sources[send_idx].push_back(i);
+		}
+	}
 
-				//swap buffers, so internal buffer always has the right data
-				for (int k = 0; k < bus->channels.size(); k++) {
-					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
-						continue;
-					}
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
-				}
+	if (!threaded_bus_mixing || level_count == bus_count || WorkerThreadPool::get_thread_index() != -1) {
+		for (int i = bus_count - 1; i >= 0; i--) {
+			_mix_bus(i, solo_mode);
+		}
+	} else {
+		// Bucket buses by level, then mix level by level. Buses within a level only read
+		// from buses of earlier levels and only write to themselves.
+		bus_mix_level_offsets.resize(level_count + 1);
+		for (int l = 0; l <= level_count; l++) {
+			bus_mix_level_offsets[l] = 0;
+		}
+		for (int i = 0; i < bus_count; i++) {
+			bus_mix_level_offsets[bus_mix_level[i] + 1]++;
+		}
+		for (int l = 0; l < level_count; l++) {
+			bus_mix_level_offsets[l + 1] += bus_mix_level_offsets[l];
+		}
+		bus_mix_order.resize(bus_count);
+		for (int i = bus_count - 1; i >= 0; i--) {
+			bus_mix_order[bus_mix_level_offsets[bus_mix_level[i]]++] = i;
+		}
+		for (int l = level_count; l > 0; l--) {
+			bus_mix_level_offsets[l] = bus_mix_level_offsets[l - 1];
+		}
+		bus_mix_level_offsets[0] = 0;
 
-#ifdef DEBUG_ENABLED
-				bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
-#endif
+		bus_mix_solo_mode = solo_mode;
+		for (int l = 0; l < level_count; l++) {
+			uint32_t from = bus_mix_level_offsets[l];
+			uint32_t count = bus_mix_level_offsets[l + 1] - from;
+			if (count == 1) {
+				_mix_bus(bus_mix_order[from], solo_mode);
+				continue;
 			}
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AudioServer::_mix_bus_task, (const int *)&bus_mix_order[from], count, -1, true, SNAME("AudioServerMixBuses"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		}
+	}
 
-		//process send
+	mix_frames += buffer_size;
+	to_mix = buffer_size;
+}
 
-		Bus *send = nullptr;
+void AudioServer::_mix_bus_task(uint32_t p_index, const int *p_buses) {
+	_mix_bus(p_buses[p_index], bus_mix_solo_mode);
+}
 
-		if (i > 0) {
-			//everything has a send save for master bus
-			if (!bus_map.has(bus->send)) {
-				send = buses[0];
-			} else {
-				send = bus_map[bus->send];
-				if (send->index_cache >= bus->index_cache) { //invalid, send to master
-					send = buses[0];
-				}
-			}
-		}
+void AudioServer::_mix_bus(int p_bus, bool p_solo_mode) {
+	Bus *bus = buses[p_bus];
 
-		for (int k = 0; k < bus->channels.size(); k++) {
-			if (!bus->channels[k].active) {
-				bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+	// Gather the buses sending here. They were mixed already, and the ones that went silent are inactive.
+	for (int source_idx : bus_mix_sources[p_bus]) {
+		const Bus *source = buses[source_idx];
+		for (int k = 0; k < source->channels.size(); k++) {
+			if (!source->channels[k].active) {
 				continue;
 			}
+			mix_accumulate(_get_bus_channel_mix_buffer(bus, k), source->channels[k].buffer.ptr(), buffer_size);
+		}
+	}
 
+	for (int k = 0; k < bus->channels.size(); k++) {
+		if (bus->channels[k].active && !bus->channels[k].used) {
+			//buffer was not used, but it's still active, so it must be cleaned
 			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
 
-			AudioFrame peak = AudioFrame(0, 0);
-
-			float volume = Math::db_to_linear(bus->volume_db);
+			for (uint32_t j = 0; j < buffer_size; j++) {
+				buf[j] = AudioFrame(0, 0);
+			}
+		}
+	}
 
-			if (solo_mode) {
-				if (!bus->soloed) {
-					volume = 0.0;
-				}
-			} else {
-				if (bus->mute) {
-					volume = 0.0;
-				}
+	//process effects
+	if (!bus->bypass) {
+		for (int j = 0; j < bus->effects.size(); j++) {
+			if (!bus->effects[j].enabled) {
+				continue;
 			}
 
-			//apply volume and compute peak
-			for (uint32_t j = 0; j < buffer_size; j++) {
-				buf[j] *= volume;
+#ifdef DEBUG_ENABLED
+			uint64_t ticks = OS::get_singleton()->get_ticks_usec();
+#endif
 
-				float l = ABS(buf[j].left);
-				if (l > peak.left) {
-					peak.left = l;
-				}
-				float r = ABS(buf[j].right);
-				if (r > peak.right) {
-					peak.right = r;
+			for (int k = 0; k < bus->channels.size(); k++) {
+				if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
+					continue;
 				}
+				Bus::Channel &channel = bus->channels.write[k];
+				channel.effect_instances.write[j]->process(channel.buffer.ptr(), channel.temp_buffer.ptrw(), buffer_size);
+
+				//swap buffers, so internal buffer always has the right data
+				SWAP(channel.buffer, channel.temp_buffer);
 			}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
+#ifdef DEBUG_ENABLED
+			bus->effects.write[j].prof_time += OS::get_singleton()->get_ticks_usec() - ticks;
+#endif
+		}
+	}
 
-			if (!bus->channels[k].used) {
-				//see if any audio is contained, because channel was not used
+	for (int k = 0; k < bus->channels.size(); k++) {
+		if (!bus->channels[k].active) {
+			bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+			continue;
+		}
 
-				if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
-				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
-					continue; //went inactive, don't mix.
-				}
+		float volume = Math::db_to_linear(bus->volume_db);
+
+		if (p_solo_mode) {
+			if (!bus->soloed) {
+				volume = 0.0;
 			}
+		} else {
+			if (bus->mute) {
+				volume = 0.0;
+			}
+		}
 
-			if (send) {
-				//if not master bus, send
-				AudioFrame *target_buf = thread_get_channel_mix_buffer(send->index_cache, k);
+		//apply volume and compute peak
+		AudioFrame peak = mix_apply_volume(bus->channels.write[k].buffer.ptrw(), volume, buffer_size);
 
-				for (uint32_t j = 0; j < buffer_size; j++) {
-					target_buf[j] += buf[j];
-				}
+		bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
+
+		if (!bus->channels[k].used) {
+			//see if any audio is contained, because channel was not used
+
+			if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
+				bus->channels.write[k].last_mix_with_audio = mix_frames;
+			} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
+				bus->channels.write[k].active = false; //went inactive, don't send.
 			}
 		}
 	}
-
-	mix_frames += buffer_size;
-	to_mix = buffer_size;
 }
 
 void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r) {
@@ -675,11 +820,8 @@ void AudioServer::_mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_sou
 		}
 
 	} else {
-		for (unsigned int frame_idx = 0; frame_idx < buffer_size; frame_idx++) {
-			// Make this buffer size invariant if buffer_size ever becomes a project setting.
-			float lerp_param = (float)frame_idx / buffer_size;
-			p_out_buf[frame_idx] += (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_source_buf[frame_idx];
-		}
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		mix_ramp_accumulate(p_out_buf, p_source_buf, p_vol_start, p_vol_final, buffer_size);
 	}
 }
 
@@ -719,16 +861,14 @@ bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
 	return true;
 }
 
-AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer) {
-	ERR_FAIL_INDEX_V(p_bus, buses.size(), nullptr);
-	ERR_FAIL_INDEX_V(p_buffer, buses[p_bus]->channels.size(), nullptr);
-
-	AudioFrame *data = buses.write[p_bus]->channels.write[p_buffer].buffer.ptrw();
+AudioFrame *AudioServer::_get_bus_channel_mix_buffer(Bus *p_bus, int p_channel) {
+	Bus::Channel &channel = p_bus->channels.write[p_channel];
+	AudioFrame *data = channel.buffer.ptrw();
 
-	if (!buses[p_bus]->channels[p_buffer].used) {
-		buses.write[p_bus]->channels.write[p_buffer].used = true;
-		buses.write[p_bus]->channels.write[p_buffer].active = true;
-		buses.write[p_bus]->channels.write[p_buffer].last_mix_with_audio = mix_frames;
+	if (!channel.used) {
+		channel.used = true;
+		channel.active = true;
+		channel.last_mix_with_audio = mix_frames;
 		for (uint32_t i = 0; i < buffer_size; i++) {
 			data[i] = AudioFrame(0, 0);
 		}
@@ -737,6 +877,13 @@ AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer)
 	return data;
 }
 
+AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer) {
+	ERR_FAIL_INDEX_V(p_bus, buses.size(), nullptr);
+	ERR_FAIL_INDEX_V(p_buffer, buses[p_bus]->channels.size(), nullptr);
+
+	return _get_bus_channel_mix_buffer(buses[p_bus], p_buffer);
+}
+
 int AudioServer::thread_get_mix_buffer_size() const {
 	return buffer_size;
 }
@@ -791,6 +938,7 @@ void AudioServer::set_bus_count(int p_count) {
 		buses.write[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		buses[i]->name = attempt;
 		buses[i]->solo = false;
@@ -864,6 +1012,7 @@ void AudioServer::add_bus(int p_at_pos) {
 	bus->channels.resize(channel_count);
 	for (int j = 0; j < channel_count; j++) {
 		bus->channels.write[j].buffer.resize(buffer_size);
+		bus->channels.write[j].temp_buffer.resize(buffer_size);
 	}
 	bus->name = attempt;
 	bus->solo = false;
@@ -1448,17 +1597,13 @@ void AudioServer::notify_listener_changed() {
 
 void AudioServer::init_channels_and_buffers() {
 	channel_count = get_channel_count();
-	temp_buffer.resize(channel_count);
 	mix_buffer.resize(buffer_size + LOOKAHEAD_BUFFER_SIZE);
 
-	for (int i = 0; i < temp_buffer.size(); i++) {
-		temp_buffer.write[i].resize(buffer_size);
-	}
-
 	for (int i = 0; i < buses.size(); i++) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
 			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses.write[i]->channels.write[j].temp_buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
@@ -1467,6 +1612,7 @@ void AudioServer::init_channels_and_buffers() {
 void AudioServer::init() {
 	channel_disable_threshold_db = GLOBAL_DEF_RST("audio/buses/channel_disable_threshold_db", -60.0);
 	channel_disable_frames = float(GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "audio/buses/channel_disable_time", PROPERTY_HINT_RANGE, "0,5,0.01,or_greater"), 2.0)) * get_mix_rate();
+	threaded_bus_mixing = GLOBAL_DEF_RST("audio/buses/threaded_mixing", false);
 	buffer_size = 512; //hardcoded for now
 
 	init_channels_and_buffers();
@@ -1795,6 +1941,16 @@ void AudioServer::set_enable_tagging_used_audio_streams(bool p_enable) {
 	tag_used_audio_streams = p_enable;
 }
 
+void AudioServer::set_threaded_bus_mixing(bool p_enable) {
+	lock();
+	threaded_bus_mixing = p_enable;
+	unlock();
+}
+
+bool AudioServer::is_threaded_bus_mixing() const {
+	return threaded_bus_mixing;
+}
+
 #ifdef TOOLS_ENABLED
 void AudioServer::get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const {
 	const String pf = p_function;
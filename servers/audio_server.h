@@ -34,6 +34,7 @@
 #include "core/math/audio_frame.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_list.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
@@ -242,6 +243,7 @@ private:
 			bool active = false;
 			AudioFrame peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
 			Vector<AudioFrame> buffer;
+			Vector<AudioFrame> temp_buffer; // Effect output, swapped with buffer after each effect.
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio = 0;
 			Channel() {}
@@ -303,11 +305,19 @@ private:
 	// TODO document if this is necessary.
 	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard_frame_old;
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
 	Vector<AudioFrame> mix_buffer;
 	Vector<Bus *> buses;
 	HashMap<StringName, Bus *> bus_map;
 
+	// Send graph, rebuilt every mix step. Buses only send to buses with a lower index,
+	// so buses on the same level don't depend on each other and can be mixed in parallel.
+	LocalVector<LocalVector<int>> bus_mix_sources;
+	LocalVector<int> bus_mix_level;
+	LocalVector<int> bus_mix_order;
+	LocalVector<uint32_t> bus_mix_level_offsets;
+	bool bus_mix_solo_mode = false;
+	bool threaded_bus_mixing = false;
+
 	void _update_bus_effects(int p_bus);
 
 	static AudioServer *singleton;
@@ -315,6 +325,9 @@ private:
 	void init_channels_and_buffers();
 
 	void _mix_step();
+	void _mix_bus(int p_bus, bool p_solo_mode);
+	void _mix_bus_task(uint32_t p_index, const int *p_buses);
+	AudioFrame *_get_bus_channel_mix_buffer(Bus *p_bus, int p_channel);
 	void _mix_step_for_channel(AudioFrame *p_out_buf, AudioFrame *p_source_buf, AudioFrame p_vol_start, AudioFrame p_vol_final, float p_attenuation_filter_cutoff_hz, float p_highshelf_gain, AudioFilterSW::Processor *p_processor_l, AudioFilterSW::Processor *p_processor_r);
 
 	// Should only be called on the main thread.
@@ -472,6 +485,15 @@ public:
 
 	void set_enable_tagging_used_audio_streams(bool p_enable);
 
+	// Buses on the same send level are mixed on the WorkerThreadPool when enabled.
+	void set_threaded_bus_mixing(bool p_enable);
+	bool is_threaded_bus_mixing() const;
+
+	// Mixing kernels. Frames are interleaved stereo pairs, so one 4-wide vector holds two frames.
+	static void mix_ramp_accumulate(AudioFrame *p_out, const AudioFrame *p_source, AudioFrame p_vol_start, AudioFrame p_vol_final, uint32_t p_frames);
+	static void mix_accumulate(AudioFrame *p_out, const AudioFrame *p_source, uint32_t p_frames);
+	static AudioFrame mix_apply_volume(AudioFrame *p_buf, float p_volume, uint32_t p_frames);
+
 #ifdef TOOLS_ENABLED
 	virtual void get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const override;
 #endif
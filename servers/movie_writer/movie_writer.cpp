@@ -31,6 +31,7 @@
 #include "movie_writer.h"
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/os/os.h"
 #include "core/os/time.h"
 #include "servers/display_server.h"
 #include "servers/rendering_server.h"
@@ -124,9 +125,63 @@ void MovieWriter::begin(const Size2i &p_movie_size, uint32_t p_fps, const String
 	audio_channels = AudioDriverDummy::get_dummy_singleton()->get_channels();
 	audio_mix_buffer.resize(mix_rate * audio_channels / fps);
 
+	encoded_frames = 0;
+	encode_usec_total = 0;
+	encode_usec_max = 0;
+	encode_queue_depth_total = 0;
+	encode_queue_depth_max = 0;
+
+	async_encoding = GLOBAL_GET("editor/movie_writer/async_encoding") && is_frame_encoding_thread_safe();
+	encode_slot_first = 0;
+	encode_slot_count = 0;
+	encode_slots.clear();
+	last_encoded_frame.clear();
+	if (async_encoding) {
+		encode_slots.resize(MAX(1, int(GLOBAL_GET("editor/movie_writer/max_queued_frames"))));
+		print_line(vformat("Encoding frames asynchronously, with up to %d frames queued.", encode_slots.size()));
+	}
+
 	write_begin(p_movie_size, p_fps, p_base_path);
 }
 
+void MovieWriter::_encode_frame_task(EncodeSlot *p_slot) {
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	if (p_slot->hdr_to_srgb) {
+		p_slot->image->convert(Image::FORMAT_RGBA8);
+		p_slot->image->linear_to_srgb();
+	}
+	p_slot->error = encode_frame(p_slot->image, p_slot->encoded);
+	p_slot->image.unref();
+	p_slot->encode_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+}
+
+bool MovieWriter::_write_encoded_slot(bool p_wait) {
+	// Frames are muxed in submission order, so only the oldest slot can be written.
+	EncodeSlot &slot = encode_slots[encode_slot_first];
+	if (!p_wait && !WorkerThreadPool::get_singleton()->is_task_completed(slot.task_id)) {
+		return false;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(slot.task_id);
+	slot.task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	if (slot.error == OK) {
+		last_encoded_frame = slot.encoded;
+	} else {
+		// Still write the audio block, or audio drifts ahead of the video for the rest of the movie.
+		ERR_PRINT(vformat("MovieWriter failed to encode frame (error %d), repeating the previous frame.", slot.error));
+	}
+	write_encoded_frame(last_encoded_frame, slot.audio.ptr());
+	slot.encoded.clear();
+
+	encoded_frames++;
+	encode_usec_total += slot.encode_usec;
+	encode_usec_max = MAX(encode_usec_max, slot.encode_usec);
+
+	encode_slot_first = (encode_slot_first + 1) % encode_slots.size();
+	encode_slot_count--;
+	return true;
+}
+
 void MovieWriter::_bind_methods() {
 	ClassDB::bind_static_method("MovieWriter", D_METHOD("add_writer", "writer"), &MovieWriter::add_writer);
 
@@ -142,6 +197,8 @@ void MovieWriter::_bind_methods() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/movie_writer/mix_rate", PROPERTY_HINT_RANGE, "8000,192000,1,suffix:Hz"), 48000);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/movie_writer/speaker_mode", PROPERTY_HINT_ENUM, "Stereo,3.1,5.1,7.1"), 0);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "editor/movie_writer/mjpeg_quality", PROPERTY_HINT_RANGE, "0.01,1.0,0.01"), 0.75);
+	GLOBAL_DEF("editor/movie_writer/async_encoding", true);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/movie_writer/max_queued_frames", PROPERTY_HINT_RANGE, "1,64,1"), 8);
 	// Used by the editor.
 	GLOBAL_DEF_BASIC("editor/movie_writer/movie_file", "");
 	GLOBAL_DEF_BASIC("editor/movie_writer/disable_vsync", false);
@@ -185,10 +242,7 @@ void MovieWriter::add_frame() {
 	RID main_vp_rid = RenderingServer::get_singleton()->viewport_find_from_screen_attachment(DisplayServer::MAIN_WINDOW_ID);
 	RID main_vp_texture = RenderingServer::get_singleton()->viewport_get_texture(main_vp_rid);
 	Ref<Image> vp_tex = RenderingServer::get_singleton()->texture_2d_get(main_vp_texture);
-	if (RenderingServer::get_singleton()->viewport_is_using_hdr_2d(main_vp_rid)) {
-		vp_tex->convert(Image::FORMAT_RGBA8);
-		vp_tex->linear_to_srgb();
-	}
+	const bool hdr_to_srgb = RenderingServer::get_singleton()->viewport_is_using_hdr_2d(main_vp_rid);
 
 	RenderingServer::get_singleton()->viewport_set_measure_render_time(main_vp_rid, true);
 	cpu_time += RenderingServer::get_singleton()->viewport_get_measured_render_time_cpu(main_vp_rid);
@@ -196,10 +250,56 @@ void MovieWriter::add_frame() {
 	gpu_time += RenderingServer::get_singleton()->viewport_get_measured_render_time_gpu(main_vp_rid);
 
 	AudioDriverDummy::get_dummy_singleton()->mix_audio(mix_rate / fps, audio_mix_buffer.ptr());
-	write_frame(vp_tex, audio_mix_buffer.ptr());
+
+	add_frame_image(vp_tex, hdr_to_srgb, audio_mix_buffer.ptr());
+}
+
+void MovieWriter::add_frame_image(const Ref<Image> &p_image, bool p_hdr_to_srgb, const int32_t *p_audio_data) {
+	if (!async_encoding) {
+		if (p_hdr_to_srgb) {
+			p_image->convert(Image::FORMAT_RGBA8);
+			p_image->linear_to_srgb();
+		}
+		uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+		write_frame(p_image, p_audio_data);
+		uint64_t encode_usec = OS::get_singleton()->get_ticks_usec() - begin_usec;
+		encoded_frames++;
+		encode_usec_total += encode_usec;
+		encode_usec_max = MAX(encode_usec_max, encode_usec);
+		return;
+	}
+
+	if (encode_slot_count == encode_slots.size()) {
+		// Queue is full, block until the oldest frame is encoded.
+		_write_encoded_slot(true);
+	}
+
+	EncodeSlot &slot = encode_slots[(encode_slot_first + encode_slot_count) % encode_slots.size()];
+	slot.image = p_image;
+	slot.hdr_to_srgb = p_hdr_to_srgb;
+	slot.audio.resize(audio_mix_buffer.size());
+	memcpy(slot.audio.ptr(), p_audio_data, audio_mix_buffer.size() * sizeof(int32_t));
+	slot.error = OK;
+	slot.encode_usec = 0;
+	slot.task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &MovieWriter::_encode_frame_task, &slot, false, SNAME("MovieWriterEncodeFrame"));
+	encode_slot_count++;
+
+	encode_queue_depth_total += encode_slot_count;
+	encode_queue_depth_max = MAX(encode_queue_depth_max, encode_slot_count);
+
+	// Write whatever is already encoded without stalling the main loop.
+	while (encode_slot_count > 0 && _write_encoded_slot(false)) {
+	}
 }
 
 void MovieWriter::end() {
+	while (encode_slot_count > 0) {
+		_write_encoded_slot(true);
+	}
+	const uint32_t encode_slots_size = encode_slots.size();
+	encode_slots.clear();
+	last_encoded_frame.clear();
+
 	write_end();
 
 	// Print a report with various statistics.
@@ -227,5 +327,11 @@ void MovieWriter::end() {
 	print_line(vformat("%d frames at %d FPS (movie length: %s), recorded in %s (%d%% of real-time speed).", Engine::get_singleton()->get_frames_drawn(), fps, movie_time, real_time, (float(movie_time_seconds) / real_time_seconds) * 100));
 	print_line(vformat("CPU time: %.2f seconds (average: %.2f ms/frame)", cpu_time / 1000, cpu_time / Engine::get_singleton()->get_frames_drawn()));
 	print_line(vformat("GPU time: %.2f seconds (average: %.2f ms/frame)", gpu_time / 1000, gpu_time / Engine::get_singleton()->get_frames_drawn()));
+	if (encoded_frames > 0) {
+		print_line(vformat("Encoding time: %.2f seconds (average: %.2f ms/frame, maximum: %.2f ms/frame)", encode_usec_total / 1000000.0, encode_usec_total / 1000.0 / encoded_frames, encode_usec_max / 1000.0));
+		if (async_encoding) {
+			print_line(vformat("Encoding queue depth: %.1f frames on average (maximum: %d of %d)", double(encode_queue_depth_total) / encoded_frames, encode_queue_depth_max, encode_slots_size));
+		}
+	}
 	print_line("----------------");
 }
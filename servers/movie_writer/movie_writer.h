@@ -31,6 +31,7 @@
 #ifndef MOVIE_WRITER_H
 #define MOVIE_WRITER_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "servers/audio/audio_driver_dummy.h"
 #include "servers/audio_server.h"
@@ -49,6 +50,32 @@ class MovieWriter : public Object {
 
 	LocalVector<int32_t> audio_mix_buffer;
 
+	// Frames are encoded on the WorkerThreadPool and written in order from a ring of slots.
+	struct EncodeSlot {
+		Ref<Image> image;
+		bool hdr_to_srgb = false;
+		LocalVector<int32_t> audio;
+		Vector<uint8_t> encoded;
+		Error error = OK;
+		uint64_t encode_usec = 0;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	bool async_encoding = false;
+	LocalVector<EncodeSlot> encode_slots;
+	uint32_t encode_slot_first = 0;
+	uint32_t encode_slot_count = 0;
+	Vector<uint8_t> last_encoded_frame; // Repeated when a frame fails to encode.
+
+	uint64_t encoded_frames = 0;
+	uint64_t encode_usec_total = 0;
+	uint64_t encode_usec_max = 0;
+	uint64_t encode_queue_depth_total = 0;
+	uint32_t encode_queue_depth_max = 0;
+
+	void _encode_frame_task(EncodeSlot *p_slot);
+	bool _write_encoded_slot(bool p_wait);
+
 	enum {
 		MAX_WRITERS = 8
 	};
@@ -63,6 +90,12 @@ protected:
 	virtual Error write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data);
 	virtual void write_end();
 
+	// Writers that can encode frames from any thread implement these, write_frame() is then split in two:
+	// encode_frame() runs on the WorkerThreadPool and write_encoded_frame() writes the results in order.
+	virtual bool is_frame_encoding_thread_safe() const { return false; }
+	virtual Error encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_encoded) const { return ERR_UNAVAILABLE; }
+	virtual Error write_encoded_frame(const Vector<uint8_t> &p_encoded, const int32_t *p_audio_data) { return ERR_UNAVAILABLE; }
+
 	GDVIRTUAL0RC_REQUIRED(uint32_t, _get_audio_mix_rate)
 	GDVIRTUAL0RC_REQUIRED(AudioServer::SpeakerMode, _get_audio_speaker_mode)
 
@@ -84,6 +117,8 @@ public:
 
 	void begin(const Size2i &p_movie_size, uint32_t p_fps, const String &p_base_path);
 	void add_frame();
+	// Adds a frame from an image, with one frame of audio. The image is converted in place if p_hdr_to_srgb is true.
+	void add_frame_image(const Ref<Image> &p_image, bool p_hdr_to_srgb, const int32_t *p_audio_data);
 
 	static void set_extensions_hint();
 
@@ -193,7 +193,21 @@ Error MovieWriterMJPEG::write_begin(const Size2i &p_movie_size, uint32_t p_fps,
 Error MovieWriterMJPEG::write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) {
 	ERR_FAIL_COND_V(!f.is_valid(), ERR_UNCONFIGURED);
 
-	Vector<uint8_t> jpg_buffer = p_image->save_jpg_to_buffer(quality);
+	Vector<uint8_t> jpg_buffer;
+	Error err = encode_frame(p_image, jpg_buffer);
+	ERR_FAIL_COND_V(err != OK, err);
+	return write_encoded_frame(jpg_buffer, p_audio_data);
+}
+
+Error MovieWriterMJPEG::encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_encoded) const {
+	r_encoded = p_image->save_jpg_to_buffer(quality);
+	return r_encoded.is_empty() ? FAILED : OK;
+}
+
+Error MovieWriterMJPEG::write_encoded_frame(const Vector<uint8_t> &p_encoded, const int32_t *p_audio_data) {
+	ERR_FAIL_COND_V(!f.is_valid(), ERR_UNCONFIGURED);
+
+	const Vector<uint8_t> &jpg_buffer = p_encoded;
 	uint32_t s = jpg_buffer.size();
 
 	f->store_buffer((const uint8_t *)"00db", 4); // Stream 0, Video
@@ -142,8 +142,21 @@ Error MovieWriterPNGWAV::write_begin(const Size2i &p_movie_size, uint32_t p_fps,
 Error MovieWriterPNGWAV::write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) {
 	ERR_FAIL_COND_V(!f_wav.is_valid(), ERR_UNCONFIGURED);
 
-	Vector<uint8_t> png_buffer = p_image->save_png_to_buffer();
+	Vector<uint8_t> png_buffer;
+	Error err = encode_frame(p_image, png_buffer);
+	ERR_FAIL_COND_V(err != OK, err);
+	return write_encoded_frame(png_buffer, p_audio_data);
+}
+
+Error MovieWriterPNGWAV::encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_encoded) const {
+	r_encoded = p_image->save_png_to_buffer();
+	return r_encoded.is_empty() ? FAILED : OK;
+}
+
+Error MovieWriterPNGWAV::write_encoded_frame(const Vector<uint8_t> &p_encoded, const int32_t *p_audio_data) {
+	ERR_FAIL_COND_V(!f_wav.is_valid(), ERR_UNCONFIGURED);
 
+	const Vector<uint8_t> &png_buffer = p_encoded;
 	Ref<FileAccess> fi = FileAccess::open(base_path + zeros_str(frame_count) + ".png", FileAccess::WRITE);
 	fi->store_buffer(png_buffer.ptr(), png_buffer.size());
 	f_wav->store_buffer((const uint8_t *)p_audio_data, audio_block_size);
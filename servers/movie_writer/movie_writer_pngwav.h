@@ -62,6 +62,10 @@ protected:
 	virtual Error write_frame(const Ref<Image> &p_image, const int32_t *p_audio_data) override;
 	virtual void write_end() override;
 
+	virtual bool is_frame_encoding_thread_safe() const override { return true; }
+	virtual Error encode_frame(const Ref<Image> &p_image, Vector<uint8_t> &r_encoded) const override;
+	virtual Error write_encoded_frame(const Vector<uint8_t> &p_encoded, const int32_t *p_audio_data) override;
+
 	virtual bool handles_file(const String &p_path) const override;
 
 public:
@@ -377,6 +377,92 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 	return d;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_directions) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V(p_origins.size() != p_directions.size(), Dictionary());
+
+	int count = p_origins.size();
+
+	Vector<Vector3> to;
+	to.resize(count);
+	{
+		Vector3 *w = to.ptrw();
+		const Vector3 *origins = p_origins.ptr();
+		const Vector3 *directions = p_directions.ptr();
+		for (int i = 0; i < count; i++) {
+			w[i] = origins[i] + directions[i];
+		}
+	}
+
+	LocalVector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> collided;
+	collided.resize(count);
+
+	intersect_rays(p_ray_query->get_parameters(), p_origins.ptr(), to.ptr(), count, results.ptr(), collided.ptr());
+
+	PackedVector3Array positions;
+	PackedVector3Array normals;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	PackedInt32Array face_indices;
+	positions.resize(count);
+	normals.resize(count);
+	collider_ids.resize(count);
+	shapes.resize(count);
+	face_indices.resize(count);
+
+	{
+		Vector3 *position_w = positions.ptrw();
+		Vector3 *normal_w = normals.ptrw();
+		int64_t *collider_id_w = collider_ids.ptrw();
+		int32_t *shape_w = shapes.ptrw();
+		int32_t *face_index_w = face_indices.ptrw();
+
+		for (int i = 0; i < count; i++) {
+			if (collided[i]) {
+				position_w[i] = results[i].position;
+				normal_w[i] = results[i].normal;
+				collider_id_w[i] = (int64_t)results[i].collider_id;
+				shape_w[i] = results[i].shape;
+				face_index_w[i] = results[i].face_index;
+			} else {
+				position_w[i] = Vector3();
+				normal_w[i] = Vector3();
+				collider_id_w[i] = 0;
+				shape_w[i] = -1;
+				face_index_w[i] = -1;
+			}
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["face_index"] = face_indices;
+
+	return d;
+}
+
+int PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_collided) {
+	// Servers without a batched implementation cast the rays one at a time.
+	RayParameters parameters = p_parameters;
+	int collided_count = 0;
+
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_collided[i] = intersect_ray(parameters, r_results[i]);
+		if (r_collided[i]) {
+			collided_count++;
+		}
+	}
+
+	return collided_count;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
 	ERR_FAIL_COND_V(p_point_query.is_null(), TypedArray<Dictionary>());
 
@@ -482,6 +568,7 @@ PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "origins", "directions"), &PhysicsDirectSpaceState3D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -1139,6 +1226,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/parallel_body_integration", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
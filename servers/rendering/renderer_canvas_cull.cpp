@@ -47,35 +47,131 @@ const static float FEATHER_SIZE = 1.25f;
 void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("Cull CanvasItem Tree");
 
-	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
-	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	RendererCanvasRender::Item *list = _cull_canvas_item_tree(p_child_items, p_child_item_count, p_transform, p_clip_rect, p_canvas_cull_mask, true);
 
-	for (int i = 0; i < p_child_item_count; i++) {
-		_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+	RENDER_TIMESTAMP("Render CanvasItems");
+
+	bool sdf_flag;
+	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
+	if (sdf_flag) {
+		sdf_used = true;
 	}
+}
+
+uint32_t RendererCanvasCull::_count_canvas_items(Item *p_canvas_item) {
+	if (!p_canvas_item->visible) {
+		return 0;
+	}
+	if (p_canvas_item->rect_from_storage) {
+		p_canvas_item->get_rect();
+	}
+	uint32_t count = 1;
+	for (Item *child : p_canvas_item->child_items) {
+		count += _count_canvas_items(child);
+	}
+	return count;
+}
+
+RendererCanvasRender::Item *RendererCanvasCull::_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask, bool p_allow_threads) {
+	WorkerThreadPool *thread_pool = WorkerThreadPool::get_singleton();
+	const uint32_t thread_count = thread_pool->get_thread_count();
 
 	RendererCanvasRender::Item *list = nullptr;
 	RendererCanvasRender::Item *list_end = nullptr;
 
-	for (int i = 0; i < z_range; i++) {
-		if (!z_list[i]) {
-			continue;
+	// Only the items of this tree matter, other canvases may hold most of the items in the server.
+	uint32_t total_items = 0;
+	bool threaded = p_allow_threads && p_child_item_count > 1 && thread_count > 1;
+	if (threaded) {
+		cull_subtree_sizes.resize(p_child_item_count);
+		for (int i = 0; i < p_child_item_count; i++) {
+			cull_subtree_sizes[i] = _count_canvas_items(p_child_items[i].item);
+			total_items += cull_subtree_sizes[i];
+		}
+		threaded = total_items >= CULL_THREADED_MIN_ITEMS;
+	}
+
+	if (threaded) {
+		const uint32_t task_count = MIN(uint32_t(p_child_item_count), thread_count);
+		while (cull_tasks.size() < task_count) {
+			CullTask task;
+			task.z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+			task.z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+			cull_tasks.push_back(task);
+		}
+		// Split the subtrees so every range holds about the same amount of items.
+		int from = 0;
+		uint64_t accumulated = 0;
+		for (uint32_t i = 0; i < task_count; i++) {
+			const uint64_t target = uint64_t(total_items) * (i + 1) / task_count;
+			int to = from;
+			while (to < p_child_item_count && (i == task_count - 1 || accumulated + cull_subtree_sizes[to] <= target || to == from)) {
+				accumulated += cull_subtree_sizes[to];
+				to++;
+			}
+			cull_tasks[i].from = from;
+			cull_tasks[i].to = to;
+			from = to;
+		}
+
+		CullTreeData data;
+		data.child_items = p_child_items;
+		data.transform = p_transform;
+		data.clip_rect = p_clip_rect;
+		data.canvas_cull_mask = p_canvas_cull_mask;
+
+		cull_rects_resolved = true;
+		WorkerThreadPool::GroupID group_task = thread_pool->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_range, &data, task_count, -1, true, SNAME("CanvasCullItems"));
+		thread_pool->wait_for_group_task_completion(group_task);
+		cull_rects_resolved = false;
+
+		// Chain the lists of every Z index in the order of the subtrees, as serial culling would have.
+		for (int i = 0; i < z_range; i++) {
+			for (uint32_t j = 0; j < task_count; j++) {
+				const CullTask &task = cull_tasks[j];
+				if (!task.z_list[i]) {
+					continue;
+				}
+				if (!list) {
+					list = task.z_list[i];
+				} else {
+					list_end->next = task.z_list[i];
+				}
+				list_end = task.z_last_list[i];
+			}
 		}
-		if (!list) {
-			list = z_list[i];
-			list_end = z_last_list[i];
-		} else {
-			list_end->next = z_list[i];
-			list_end = z_last_list[i];
+	} else {
+		memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+		memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+
+		for (int i = 0; i < p_child_item_count; i++) {
+			_cull_canvas_item(p_child_items[i].item, p_transform, p_clip_rect, Color(1, 1, 1, 1), 0, z_list, z_last_list, nullptr, nullptr, false, p_canvas_cull_mask, Point2(), 1, nullptr);
+		}
+
+		for (int i = 0; i < z_range; i++) {
+			if (!z_list[i]) {
+				continue;
+			}
+			if (!list) {
+				list = z_list[i];
+				list_end = z_last_list[i];
+			} else {
+				list_end->next = z_list[i];
+				list_end = z_last_list[i];
+			}
 		}
 	}
 
-	RENDER_TIMESTAMP("Render CanvasItems");
+	return list;
+}
 
-	bool sdf_flag;
-	RSG::canvas_render->canvas_render_items(p_to_render_target, list, p_modulate, p_lights, p_directional_lights, p_transform, p_default_filter, p_default_repeat, p_snap_2d_vertices_to_pixel, sdf_flag, r_render_info);
-	if (sdf_flag) {
-		sdf_used = true;
+void RendererCanvasCull::_cull_canvas_item_range(uint32_t p_index, const CullTreeData *p_data) {
+	CullTask &task = cull_tasks[p_index];
+	memset(task.z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	memset(task.z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+
+	for (int i = task.from; i < task.to; i++) {
+		_cull_canvas_item(p_data->child_items[i].item, p_data->transform, p_data->clip_rect, Color(1, 1, 1, 1), 0, task.z_list, task.z_last_list, nullptr, nullptr, false, p_data->canvas_cull_mask, Point2(), 1, nullptr);
 	}
 }
 
@@ -98,7 +194,9 @@ void RendererCanvasCull::_collect_ysort_children(RendererCanvasCull::Item *p_can
 				child_xform.columns[2] = (child_xform.columns[2] + Point2(0.5, 0.5)).floor();
 			}
 
-			r_items[r_index] = child_items[i];
+			if (r_items) {
+				r_items[r_index] = child_items[i];
+			}
 			child_items[i]->ysort_xform = p_canvas_item->ysort_xform * child_xform;
 			child_items[i]->material_owner = child_items[i]->use_parent_material ? p_material_owner : nullptr;
 			child_items[i]->ysort_modulate = p_modulate;
@@ -222,6 +320,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
+			MutexLock lock(cull_mutex);
 			RenderingServerDefault::redraw_request();
 		}
 
@@ -249,6 +348,7 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		}
 
 		if (ci->visibility_notifier) {
+			MutexLock lock(cull_mutex);
 			if (!ci->visibility_notifier->visible_element.in_list()) {
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
 				ci->visibility_notifier->just_visible = true;
@@ -278,7 +378,7 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 		ci->children_order_dirty = false;
 	}
 
-	Rect2 rect = ci->get_rect();
+	Rect2 rect = (cull_rects_resolved && ci->rect_from_storage) ? ci->rect : ci->get_rect();
 
 	if (ci->visibility_notifier) {
 		if (ci->visibility_notifier->area.size != Vector2()) {
@@ -389,12 +489,19 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 
 	if (ci->sort_y) {
 		if (!p_is_already_y_sorted) {
-			if (ci->ysort_children_count == -1) {
+			// The flattened subtree only changes when `ysort_children_count` is invalidated.
+			// Otherwise the items sorted last frame are reused, and only re-sorted if they moved out of order.
+			bool rebuild = ci->ysort_children_count == -1;
+			if (rebuild) {
 				ci->ysort_children_count = _count_ysort_children(ci);
 			}
 
 			child_item_count = ci->ysort_children_count + 1;
-			child_items = (Item **)alloca(child_item_count * sizeof(Item *));
+			rebuild = rebuild || ci->ysort_items.size() != uint32_t(child_item_count);
+			if (rebuild) {
+				ci->ysort_items.resize(child_item_count);
+			}
+			child_items = ci->ysort_items.ptr();
 
 			ci->ysort_xform = Transform2D();
 			ci->ysort_modulate = Color(1, 1, 1, 1);
@@ -402,10 +509,27 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			ci->ysort_parent_abs_z_index = parent_z;
 			child_items[0] = ci;
 			int i = 1;
-			_collect_ysort_children(ci, p_material_owner, Color(1, 1, 1, 1), child_items, i, p_z);
+			_collect_ysort_children(ci, p_material_owner, Color(1, 1, 1, 1), rebuild ? child_items : nullptr, i, p_z);
 
 			SortArray<Item *, ItemYSort> sorter;
-			sorter.sort(child_items, child_item_count);
+			if (rebuild) {
+				sorter.sort(child_items, child_item_count);
+			} else {
+				int out_of_order = 0;
+				for (i = 1; i < child_item_count; i++) {
+					if (sorter.compare(child_items[i], child_items[i - 1])) {
+						out_of_order++;
+					}
+				}
+				if (out_of_order > 0) {
+					// Few items swapping places is the common case, insertion sort handles it in close to linear time.
+					if (out_of_order <= child_item_count / 32) {
+						sorter.insertion_sort(0, child_item_count, child_items);
+					} else {
+						sorter.sort(child_items, child_item_count);
+					}
+				}
+			}
 
 			for (i = 0; i < child_item_count; i++) {
 				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
@@ -1709,6 +1833,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
 	ERR_FAIL_NULL(m);
+	canvas_item->rect_from_storage = true;
 	m->mesh = p_mesh;
 	if (canvas_item->skeleton.is_valid()) {
 		m->mesh_instance = RSG::mesh_storage->mesh_instance_create(p_mesh);
@@ -1727,6 +1852,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_NULL(part);
+	canvas_item->rect_from_storage = true;
 	part->particles = p_particles;
 
 	part->texture = p_texture;
@@ -1741,6 +1867,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_NULL(mm);
+	canvas_item->rect_from_storage = true;
 	mm->multimesh = p_mesh;
 
 	mm->texture = p_texture;
@@ -1843,6 +1970,7 @@ void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->clear();
+	canvas_item->rect_from_storage = false;
 #ifdef DEBUG_ENABLED
 	if (debug_redraw) {
 		canvas_item->debug_redraw_time = debug_redraw_time;
@@ -2645,4 +2773,8 @@ RendererCanvasCull::RendererCanvasCull() {
 RendererCanvasCull::~RendererCanvasCull() {
 	memfree(z_list);
 	memfree(z_last_list);
+	for (CullTask &task : cull_tasks) {
+		memfree(task.z_list);
+		memfree(task.z_last_list);
+	}
 }
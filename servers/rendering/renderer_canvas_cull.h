@@ -31,11 +31,13 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 
 class RendererCanvasCull {
+
 public:
 	struct Item : public RendererCanvasRender::Item {
 		RID parent; // canvas it belongs to
@@ -53,7 +55,9 @@ public:
 		Transform2D ysort_xform; // Relative to y-sorted subtree's root item (identity for such root). Its `origin.y` is used for sorting.
 		int ysort_index;
 		int ysort_parent_abs_z_index; // Absolute Z index of parent. Only populated and used when y-sorting.
+		LocalVector<Item *> ysort_items; // Flattened y-sorted subtree (including this item), in the order of the last sort. Valid while `ysort_children_count` is not -1.
 		uint32_t visibility_layer = 0xffffffff;
+		bool rect_from_storage = false; // Has mesh, multimesh or particles commands, so `get_rect()` reads their AABBs from storage.
 
 		Vector<Item *> child_items;
 
@@ -98,7 +102,7 @@ public:
 		_FORCE_INLINE_ bool operator()(const Item *p_left, const Item *p_right) const {
 			const real_t left_y = p_left->ysort_xform.columns[2].y;
 			const real_t right_y = p_right->ysort_xform.columns[2].y;
-			if (Math::is_equal_approx(left_y, right_y)) {
+			if (left_y == right_y) {
 				return p_left->ysort_index < p_right->ysort_index;
 			}
 
@@ -183,6 +187,8 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
+	BinaryMutex cull_mutex; // Protects the state shared by canvas subtrees culled in parallel.
+
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
 private:
@@ -198,6 +204,32 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// Top-level canvas items are independent subtrees. When the tree has enough visible items, contiguous ranges
+	// of them are culled in parallel into their own z lists, which are then chained in order.
+	static constexpr uint32_t CULL_THREADED_MIN_ITEMS = 2048;
+
+	struct CullTask {
+		RendererCanvasRender::Item **z_list = nullptr;
+		RendererCanvasRender::Item **z_last_list = nullptr;
+		int from = 0;
+		int to = 0;
+	};
+
+	struct CullTreeData {
+		Canvas::ChildItem *child_items = nullptr;
+		Transform2D transform;
+		Rect2 clip_rect;
+		uint32_t canvas_cull_mask = 0;
+	};
+
+	LocalVector<CullTask> cull_tasks;
+	LocalVector<uint32_t> cull_subtree_sizes; // Visible items in each top-level subtree, to balance the ranges.
+	bool cull_rects_resolved = false; // Rects read from storage were resolved before culling in parallel, as storage isn't thread-safe.
+
+	RendererCanvasRender::Item *_cull_canvas_item_tree(Canvas::ChildItem *p_child_items, int p_child_item_count, const Transform2D &p_transform, const Rect2 &p_clip_rect, uint32_t p_canvas_cull_mask, bool p_allow_threads);
+	uint32_t _count_canvas_items(Item *p_canvas_item); // Also resolves the rects read from storage.
+	void _cull_canvas_item_range(uint32_t p_index, const CullTreeData *p_data);
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t p_canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info = nullptr);
 
@@ -32,6 +32,7 @@
 #define TEST_IMAGE_H
 
 #include "core/io/image.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -442,6 +443,163 @@ TEST_CASE("[Image] Convert image") {
 	CHECK_MESSAGE(image2->get_data() == image_data, "Image conversion to invalid type (Image::FORMAT_MAX + 1) should not alter image.");
 }
 
+// The images below are large enough to be split across worker threads and to use the vectorized mipmap kernels.
+static Ref<Image> _make_pattern_image(int p_width, int p_height, Image::Format p_format) {
+	Ref<Image> image = memnew(Image(p_width, p_height, false, p_format));
+	Vector<uint8_t> data = image->get_data();
+	uint8_t *w = data.ptrw();
+	if (p_format == Image::FORMAT_RGBAF) {
+		float *wf = reinterpret_cast<float *>(w);
+		for (int i = 0; i < data.size() / 4; i++) {
+			wf[i] = float((i * 2654435761u) >> 20) / 4096.0f;
+		}
+	} else {
+		for (int i = 0; i < data.size(); i++) {
+			w[i] = uint8_t((i * 2654435761u) >> 13);
+		}
+	}
+	image->set_data(p_width, p_height, false, p_format, data);
+	return image;
+}
+
+TEST_CASE("[Image] Large mipmap generation matches per-pixel averaging") {
+	Ref<Image> image = _make_pattern_image(512, 384, Image::FORMAT_RGBA8);
+	CHECK(image->generate_mipmaps() == OK);
+	const Vector<uint8_t> data = image->get_data();
+	bool matches = true;
+	for (int mip = 1; mip <= image->get_mipmap_count() && matches; mip++) {
+		int prev_w = 0;
+		int prev_h = 0;
+		int64_t prev_ofs = 0;
+		int64_t prev_size = 0;
+		int w = 0;
+		int h = 0;
+		int64_t ofs = 0;
+		int64_t size = 0;
+		image->get_mipmap_offset_size_and_dimensions(mip - 1, prev_ofs, prev_size, prev_w, prev_h);
+		image->get_mipmap_offset_size_and_dimensions(mip, ofs, size, w, h);
+		const uint8_t *src = data.ptr() + prev_ofs;
+		const uint8_t *dst = data.ptr() + ofs;
+		const int right = prev_w > 1 ? 4 : 0;
+		const int down = prev_h > 1 ? prev_w * 4 : 0;
+		for (int y = 0; y < h && matches; y++) {
+			for (int x = 0; x < w * 4; x++) {
+				const uint8_t *s = src + y * 2 * down + (x / 4) * right * 2 + (x % 4);
+				const uint8_t expected = (s[0] + s[right] + s[down] + s[down + right] + 2) >> 2;
+				if (dst[y * w * 4 + x] != expected) {
+					matches = false;
+					break;
+				}
+			}
+		}
+	}
+	CHECK_MESSAGE(matches, "RGBA8 mipmaps should be bit-exact with the (a + b + c + d + 2) >> 2 average.");
+
+	Ref<Image> image_float = _make_pattern_image(256, 256, Image::FORMAT_RGBAF);
+	CHECK(image_float->generate_mipmaps() == OK);
+	int64_t ofs = 0;
+	int64_t size = 0;
+	int w = 0;
+	int h = 0;
+	image_float->get_mipmap_offset_size_and_dimensions(1, ofs, size, w, h);
+	const Vector<uint8_t> data_float = image_float->get_data();
+	const float *src = reinterpret_cast<const float *>(data_float.ptr());
+	const float *dst = reinterpret_cast<const float *>(data_float.ptr() + ofs);
+	matches = true;
+	for (int y = 0; y < h && matches; y++) {
+		for (int x = 0; x < w * 4; x++) {
+			const float *s = src + y * 2 * 256 * 4 + (x / 4) * 8 + (x % 4);
+			const float expected = (s[0] + s[4] + s[256 * 4] + s[256 * 4 + 4]) * 0.25f;
+			if (dst[y * w * 4 + x] != expected) {
+				matches = false;
+				break;
+			}
+		}
+	}
+	CHECK_MESSAGE(matches, "RGBAF mipmaps should be bit-exact with the per-channel float average.");
+}
+
+TEST_CASE("[Image] Large resize and conversion match per-pixel results") {
+	Ref<Image> image = _make_pattern_image(1024, 768, Image::FORMAT_RGBA8);
+
+	Ref<Image> nearest = memnew(Image);
+	nearest->copy_internals_from(image);
+	nearest->resize(700, 500, Image::INTERPOLATE_NEAREST);
+	bool matches = true;
+	for (int y = 0; y < 500 && matches; y++) {
+		for (int x = 0; x < 700; x++) {
+			if (nearest->get_pixel(x, y) != image->get_pixel(x * 1024 / 700, y * 768 / 500)) {
+				matches = false;
+				break;
+			}
+		}
+	}
+	CHECK_MESSAGE(matches, "Nearest resizing should pick the same source pixel for every row.");
+
+	Ref<Image> rgb = memnew(Image);
+	rgb->copy_internals_from(image);
+	rgb->convert(Image::FORMAT_RGB8);
+	const Vector<uint8_t> rgba_vector = image->get_data();
+	const Vector<uint8_t> rgb_vector = rgb->get_data();
+	const uint8_t *rgba_data = rgba_vector.ptr();
+	const uint8_t *rgb_data = rgb_vector.ptr();
+	matches = true;
+	for (int i = 0; i < 1024 * 768; i++) {
+		if (rgb_data[i * 3 + 0] != rgba_data[i * 4 + 0] || rgb_data[i * 3 + 1] != rgba_data[i * 4 + 1] || rgb_data[i * 3 + 2] != rgba_data[i * 4 + 2]) {
+			matches = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(matches, "Converting RGBA8 to RGB8 should drop the alpha channel of every pixel.");
+}
+
+struct SerialResize {
+	Ref<Image> image;
+	int width = 0;
+	int height = 0;
+	Image::Interpolation interpolation = Image::INTERPOLATE_NEAREST;
+};
+
+static void _resize_on_pool_thread(void *p_userdata) {
+	SerialResize *resize = static_cast<SerialResize *>(p_userdata);
+	resize->image->resize(resize->width, resize->height, resize->interpolation);
+}
+
+// Images resized from a pool thread are processed serially, which gives the reference to compare against.
+static void _check_parallel_resize_matches_serial(Image::Format p_format, int p_width, int p_height, Image::Interpolation p_interpolation) {
+	Ref<Image> source = _make_pattern_image(640, 480, p_format);
+
+	Ref<Image> parallel = memnew(Image);
+	parallel->copy_internals_from(source);
+	parallel->resize(p_width, p_height, p_interpolation);
+
+	SerialResize serial;
+	serial.image.instantiate();
+	serial.image->copy_internals_from(source);
+	serial.width = p_width;
+	serial.height = p_height;
+	serial.interpolation = p_interpolation;
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&_resize_on_pool_thread, &serial);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+
+	CHECK(parallel->get_width() == p_width);
+	CHECK(parallel->get_height() == p_height);
+	CHECK_MESSAGE(parallel->get_data() == serial.image->get_data(), vformat("Resizing %s to %dx%d with interpolation %d should give the same result in parallel and serially.", Image::get_format_name(p_format), p_width, p_height, p_interpolation));
+}
+
+TEST_CASE("[Image] Parallel resize matches serial resize") {
+	const Image::Interpolation interpolations[] = { Image::INTERPOLATE_BILINEAR, Image::INTERPOLATE_CUBIC, Image::INTERPOLATE_LANCZOS };
+	const Image::Format formats[] = { Image::FORMAT_L8, Image::FORMAT_RGB8, Image::FORMAT_RGBA8, Image::FORMAT_RGBAF };
+	for (Image::Interpolation interpolation : interpolations) {
+		for (Image::Format format : formats) {
+			// 16384 / 300 gives 54 rows per task, so 301 rows leave a partial last task.
+			_check_parallel_resize_matches_serial(format, 300, 301, interpolation);
+			// Upscaling, with a row count that doesn't divide evenly either.
+			_check_parallel_resize_matches_serial(format, 997, 643, interpolation);
+		}
+	}
+}
+
 } // namespace TestImage
 
 #endif // TEST_IMAGE_H
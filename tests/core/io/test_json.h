@@ -31,8 +31,11 @@
 #ifndef TEST_JSON_H
 #define TEST_JSON_H
 
+#include "core/io/file_access.h"
 #include "core/io/json.h"
+#include "core/io/resource_loader.h"
 
+#include "tests/test_utils.h"
 #include "thirdparty/doctest/doctest.h"
 
 namespace TestJSON {
@@ -232,6 +235,99 @@ TEST_CASE("[JSON] Parsing escape sequences") {
 		ERR_PRINT_ON
 	}
 }
+
+TEST_CASE("[JSON] Parsing UTF-8 buffers") {
+	const String json_string = String::utf8(R"({"name": "Gôdot 日本 😀", "escaped": "é\u00e9\ud83d\ude00\n", "numbers": [1, -2.5, 3e2], "nested": {"empty": [], "null": null, "bool": true}})");
+
+	JSON json_from_string;
+	REQUIRE(json_from_string.parse(json_string) == OK);
+
+	JSON json;
+	CHECK_MESSAGE(
+			json.parse_utf8_buffer(json_string.to_utf8_buffer()) == OK,
+			"Parsing a UTF-8 buffer should parse successfully.");
+	CHECK_MESSAGE(
+			JSON::stringify(json.get_data()) == JSON::stringify(json_from_string.get_data()),
+			"Parsing a UTF-8 buffer should give the same result as parsing the decoded string.");
+
+	PackedByteArray buffer_with_bom;
+	buffer_with_bom.push_back(0xef);
+	buffer_with_bom.push_back(0xbb);
+	buffer_with_bom.push_back(0xbf);
+	buffer_with_bom.append_array(json_string.to_utf8_buffer());
+	CHECK_MESSAGE(
+			json.parse_utf8_buffer(buffer_with_bom, true) == OK,
+			"Parsing a UTF-8 buffer starting with a byte order mark should parse successfully.");
+	CHECK_MESSAGE(
+			json.get_parsed_text() == json_string,
+			"The kept text should be the decoded buffer without the byte order mark.");
+
+	ERR_PRINT_OFF
+	// Invalid continuation byte, overlong encoding, and encoded surrogate.
+	const uint8_t invalid_sequences[3][2] = { { 0xc3, 0x28 }, { 0xc0, 0xaf }, { 0xed, 0xa0 } };
+	for (int i = 0; i < 3; i++) {
+		PackedByteArray buffer = String("\"a").to_utf8_buffer();
+		buffer.push_back(invalid_sequences[i][0]);
+		buffer.push_back(invalid_sequences[i][1]);
+		buffer.append_array(String("b\"").to_utf8_buffer());
+		CHECK_MESSAGE(
+				json.parse_utf8_buffer(buffer) == ERR_PARSE_ERROR,
+				"Parsing a UTF-8 buffer with an invalid sequence in a string should fail to parse.");
+	}
+
+	CHECK_MESSAGE(
+			json.parse_utf8_buffer(String("[\"unterminated").to_utf8_buffer()) == ERR_PARSE_ERROR,
+			"Parsing a truncated UTF-8 buffer should fail to parse.");
+	ERR_PRINT_ON
+}
+
+TEST_CASE("[JSON] Stringify to UTF-8 buffers") {
+	Dictionary dictionary;
+	dictionary["name"] = String::utf8("Gôdot 日本 😀");
+	dictionary["escaped"] = "\"\\\n\t";
+	Array array;
+	array.push_back(1);
+	array.push_back(-2.5);
+	array.push_back(Variant());
+	array.push_back(Array());
+	dictionary["array"] = array;
+	dictionary["empty"] = Dictionary();
+
+	CHECK_MESSAGE(
+			JSON::stringify_to_utf8_buffer(dictionary) == JSON::stringify(dictionary).to_utf8_buffer(),
+			"Stringifying to a UTF-8 buffer should give the same result as encoding the stringified text.");
+	CHECK_MESSAGE(
+			JSON::stringify_to_utf8_buffer(dictionary, "\t", false, true) == JSON::stringify(dictionary, "\t", false, true).to_utf8_buffer(),
+			"Stringifying to a UTF-8 buffer should give the same result as encoding the stringified text.");
+
+	JSON json;
+	REQUIRE(json.parse_utf8_buffer(JSON::stringify_to_utf8_buffer(dictionary)) == OK);
+	CHECK_MESSAGE(
+			JSON::stringify(json.get_data()) == JSON::stringify(dictionary),
+			"Parsing a stringified UTF-8 buffer should give back the same data.");
+}
+
+TEST_CASE("[JSON] Loading a JSON resource with invalid UTF-8") {
+	// Invalid UTF-8 in a string is decoded leniently when loading a file, as it was before
+	// the loader parsed the bytes directly.
+	const String path = TestUtils::get_temp_path("invalid_utf8.json");
+	PackedByteArray buffer = String("{\"key\": \"a").to_utf8_buffer();
+	buffer.push_back(0xc3);
+	buffer.push_back(0x28);
+	buffer.append_array(String("b\"}").to_utf8_buffer());
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(buffer);
+	}
+
+	ERR_PRINT_OFF;
+	Ref<JSON> json = ResourceLoader::load(path, "JSON", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	ERR_PRINT_ON;
+	REQUIRE(json.is_valid());
+	Dictionary data = json->get_data();
+	CHECK(data.has("key"));
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
@@ -117,6 +117,54 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Read pack files from a memory mapped pack") {
+	// Files inside a pack are read the same way, whether the pack is memory mapped or not.
+	const String pack_path = TestUtils::get_temp_path("mapped.pck");
+	{
+		Ref<FileAccess> f = FileAccess::open(pack_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (int i = 0; i < 4096; i++) {
+			f->store_8(i * 7);
+		}
+	}
+
+	Ref<FileAccess> mapped_pack = FileAccess::open(pack_path, FileAccess::READ);
+	REQUIRE(mapped_pack.is_valid());
+	if (mapped_pack->map_read_only() != OK) {
+		// Not supported on this platform, packs are read through regular file accesses.
+		CHECK(mapped_pack->get_mapped_data() == nullptr);
+		return;
+	}
+	REQUIRE(mapped_pack->get_mapped_data() != nullptr);
+
+	PackedData::PackedFile pf;
+	pf.pack = pack_path;
+	pf.offset = 100;
+	pf.size = 1000;
+	pf.encrypted = false;
+
+	Ref<FileAccess> mapped_file = memnew(FileAccessPack(pack_path, pf, mapped_pack));
+	Ref<FileAccess> file = memnew(FileAccessPack(pack_path, pf));
+	REQUIRE(mapped_file->is_open());
+	REQUIRE(file->is_open());
+	CHECK(mapped_file->get_length() == file->get_length());
+	CHECK(mapped_file->get_mapped_data() == mapped_pack->get_mapped_data() + pf.offset);
+
+	CHECK(mapped_file->get_buffer(500) == file->get_buffer(500));
+	CHECK(mapped_file->get_32() == file->get_32());
+	mapped_file->seek(900);
+	file->seek(900);
+	// Reading past the end of the file stops at its end.
+	CHECK(mapped_file->get_buffer(500).size() == 100);
+	CHECK(file->get_buffer(500).size() == 100);
+	CHECK(mapped_file->eof_reached());
+	CHECK(file->eof_reached());
+
+	mapped_file->seek(0);
+	file->seek(0);
+	CHECK(mapped_file->get_buffer(pf.size) == file->get_buffer(pf.size));
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
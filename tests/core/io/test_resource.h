@@ -166,6 +166,97 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading many binary sub-resources") {
+	// Enough sub-resources and data for the binary loader to decode them on the WorkerThreadPool.
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < 64; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedInt32Array data;
+		data.resize(256);
+		for (int j = 0; j < data.size(); j++) {
+			data.set(j, i * 1000 + j);
+		}
+		child->set_meta("data", data);
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+
+	const String save_path_binary = TestUtils::get_temp_path("resource_many.res");
+	ResourceSaver::save(resource, save_path_binary);
+
+	const Ref<Resource> loaded = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_name() == "Root");
+	const Array loaded_children = loaded->get_meta("children");
+	REQUIRE(loaded_children.size() == 64);
+
+	bool names_match = true;
+	bool data_matches = true;
+	bool links_match = true;
+	for (int i = 0; i < loaded_children.size(); i++) {
+		const Ref<Resource> child = loaded_children[i];
+		names_match = names_match && child->get_name() == vformat("Child %d", i);
+		const PackedInt32Array data = child->get_meta("data");
+		data_matches = data_matches && data.size() == 256 && data[0] == i * 1000 && data[255] == i * 1000 + 255;
+		if (i > 0) {
+			// The referenced sub-resource must be the very instance loaded for the previous child.
+			const Ref<Resource> linked = child->get_meta("previous");
+			links_match = links_match && linked == Ref<Resource>(loaded_children[i - 1]);
+		}
+	}
+	CHECK_MESSAGE(names_match, "Every loaded child resource should keep its name.");
+	CHECK_MESSAGE(data_matches, "Every loaded child resource should keep its data.");
+	CHECK_MESSAGE(links_match, "References between sub-resources should resolve to the loaded instances.");
+}
+
+TEST_CASE("[Resource] Loading many binary sub-resources on a thread") {
+	// A threaded load runs as a WorkerThreadPool task, which can still decode in parallel.
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Array children;
+	for (int i = 0; i < 64; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedInt32Array data;
+		data.resize(256);
+		data.fill(i);
+		child->set_meta("data", data);
+		children.push_back(child);
+	}
+	resource->set_meta("children", children);
+
+	const String save_path_binary = TestUtils::get_temp_path("resource_many_threaded.res");
+	ResourceSaver::save(resource, save_path_binary);
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path_binary) == OK);
+	Error err = ERR_BUG;
+	const Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path_binary, &err);
+	CHECK(err == OK);
+	REQUIRE(loaded.is_valid());
+	const Array loaded_children = loaded->get_meta("children");
+	REQUIRE(loaded_children.size() == 64);
+
+	bool data_matches = true;
+	bool cache_matches = true;
+	for (int i = 0; i < loaded_children.size(); i++) {
+		const Ref<Resource> child = loaded_children[i];
+		const PackedInt32Array data = child->get_meta("data");
+		data_matches = data_matches && child->get_name() == vformat("Child %d", i) && data.size() == 256 && data[255] == i;
+		// Sub-resources are registered in the cache once their properties are set.
+		cache_matches = cache_matches && !child->get_path().is_empty() && ResourceCache::get_ref(child->get_path()) == child;
+	}
+	CHECK_MESSAGE(data_matches, "Every child resource loaded on a thread should keep its name and data.");
+	CHECK_MESSAGE(cache_matches, "Every child resource loaded on a thread should be cached under its path.");
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -32,6 +32,7 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 
 #include "tests/test_macros.h"
 
@@ -213,6 +214,125 @@ TEST_CASE("[AStar3D] Add/Remove") {
 	// It's been great work, cheers. \(^ ^)/
 }
 
+TEST_CASE("[AStar3D] Batch id paths") {
+	// Grid graph with a few disabled points, so some pairs are unreachable.
+	const int W = 8;
+	AStar3D a;
+	for (int y = 0; y < W; y++) {
+		for (int x = 0; x < W; x++) {
+			const int id = y * W + x;
+			a.add_point(id, Vector3(x, y, 0));
+			if (x > 0) {
+				a.connect_points(id, id - 1);
+			}
+			if (y > 0) {
+				a.connect_points(id, id - W);
+			}
+		}
+	}
+	for (int y = 0; y < W; y++) {
+		a.set_point_disabled(y * W + W / 2);
+	}
+
+	PackedInt64Array from_ids;
+	PackedInt64Array to_ids;
+	Math::seed(0);
+	for (int i = 0; i < 64; i++) {
+		from_ids.push_back(Math::rand() % (W * W));
+		to_ids.push_back(Math::rand() % (W * W));
+	}
+
+	for (int partial = 0; partial < 2; partial++) {
+		TypedArray<PackedInt64Array> paths = a.get_id_paths(from_ids, to_ids, partial);
+		REQUIRE(paths.size() == from_ids.size());
+		for (int i = 0; i < from_ids.size(); i++) {
+			CHECK(PackedInt64Array(paths[i]) == a.get_id_path(from_ids[i], to_ids[i], partial));
+		}
+	}
+
+	ERR_PRINT_OFF;
+	CHECK(a.get_id_paths(from_ids, PackedInt64Array()).is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[AStar2D] Batch id paths and partial paths") {
+	// Two rows of points with the link between them cut at x = 4.
+	const int W = 8;
+	AStar2D a;
+	for (int y = 0; y < 2; y++) {
+		for (int x = 0; x < W; x++) {
+			const int id = y * W + x;
+			a.add_point(id, Vector2(x, y));
+			if (x > 0 && x != W / 2) {
+				a.connect_points(id, id - 1);
+			}
+			if (y > 0) {
+				a.connect_points(id, id - W);
+			}
+		}
+	}
+
+	// The end point is unreachable, so a partial path stops at the reachable point closest to it.
+	CHECK(a.get_id_path(0, W - 1).is_empty());
+	const PackedInt64Array partial_path = a.get_id_path(0, W - 1, true);
+	REQUIRE_FALSE(partial_path.is_empty());
+	CHECK(partial_path[0] == 0);
+	CHECK(partial_path[partial_path.size() - 1] == W / 2 - 1);
+
+	PackedInt64Array from_ids;
+	PackedInt64Array to_ids;
+	for (int i = 0; i < 2 * W; i++) {
+		from_ids.push_back(i);
+		to_ids.push_back(2 * W - 1 - i);
+	}
+
+	for (int partial = 0; partial < 2; partial++) {
+		TypedArray<PackedInt64Array> paths = a.get_id_paths(from_ids, to_ids, partial);
+		REQUIRE(paths.size() == from_ids.size());
+		for (int i = 0; i < from_ids.size(); i++) {
+			CHECK(PackedInt64Array(paths[i]) == a.get_id_path(from_ids[i], to_ids[i], partial));
+		}
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Batch id paths and partial paths") {
+	// Grid with a solid wall at x = 4, only open at the bottom row.
+	AStarGrid2D a;
+	a.set_region(Rect2i(0, 0, 8, 8));
+	a.update();
+	for (int y = 0; y < 7; y++) {
+		a.set_point_solid(Vector2i(4, y));
+	}
+
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(7, 0)).size() > 0);
+
+	// Closing the wall makes the right side unreachable.
+	a.set_point_solid(Vector2i(4, 7));
+	CHECK(a.get_id_path(Vector2i(0, 0), Vector2i(7, 0)).is_empty());
+	const TypedArray<Vector2i> partial_path = a.get_id_path(Vector2i(0, 0), Vector2i(7, 0), true);
+	REQUIRE_FALSE(partial_path.is_empty());
+	CHECK(Vector2i(partial_path[0]) == Vector2i(0, 0));
+	CHECK(Vector2i(partial_path[partial_path.size() - 1]) == Vector2i(3, 0));
+
+	TypedArray<Vector2i> from;
+	TypedArray<Vector2i> to;
+	for (int i = 0; i < 8; i++) {
+		from.push_back(Vector2i(i, 7 - i));
+		to.push_back(Vector2i(7 - i, i));
+	}
+	// A solid point as end point gives an empty path.
+	from.push_back(Vector2i(0, 0));
+	to.push_back(Vector2i(4, 3));
+
+	for (int partial = 0; partial < 2; partial++) {
+		TypedArray<Array> paths = a.get_id_paths(from, to, partial);
+		REQUIRE(paths.size() == from.size());
+		for (int i = 0; i < from.size(); i++) {
+			CHECK(Array(paths[i]) == Array(a.get_id_path(from[i], to[i], partial)));
+		}
+	}
+}
+
 TEST_CASE("[Stress][AStar3D] Find paths") {
 	// Random stress tests with Floyd-Warshall.
 	const int N = 30;
@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct PairingTestItem {
+	uint32_t id = 0;
+	uint32_t layer = 0;
+};
+
+class PairingTestPairFunction {
+public:
+	static bool user_pair_check(const PairingTestItem *p_a, const PairingTestItem *p_b) {
+		return (p_a->layer & p_b->layer) != 0;
+	}
+};
+
+class PairingTestCullFunction {
+public:
+	static bool user_cull_check(const PairingTestItem *p_a, const PairingTestItem *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<PairingTestItem, 2, true, 32, PairingTestPairFunction, PairingTestCullFunction, Rect2, Vector2> PairingTestBVH;
+
+struct PairingLog {
+	LocalVector<Vector3i> events;
+
+	static void *pair(void *p_self, uint32_t, PairingTestItem *p_a, int, uint32_t, PairingTestItem *p_b, int) {
+		static_cast<PairingLog *>(p_self)->events.push_back(Vector3i(p_a->id, p_b->id, 1));
+		return nullptr;
+	}
+
+	static void unpair(void *p_self, uint32_t, PairingTestItem *p_a, int, uint32_t, PairingTestItem *p_b, int, void *) {
+		static_cast<PairingLog *>(p_self)->events.push_back(Vector3i(p_a->id, p_b->id, -1));
+	}
+};
+
+TEST_CASE("[BVH] Parallel pairing should send the same callbacks as serial pairing") {
+	const uint32_t item_count = 2000;
+
+	LocalVector<PairingTestItem> items;
+	items.resize(item_count);
+	for (uint32_t i = 0; i < item_count; i++) {
+		items[i].id = i;
+		items[i].layer = 1 << (i % 3);
+	}
+
+	PairingLog serial_log;
+	PairingLog parallel_log;
+
+	PairingTestBVH serial_bvh;
+	serial_bvh.set_pair_callback(PairingLog::pair, &serial_log);
+	serial_bvh.set_unpair_callback(PairingLog::unpair, &serial_log);
+
+	PairingTestBVH parallel_bvh;
+	parallel_bvh.params_set_parallel_pairing(true);
+	parallel_bvh.set_pair_callback(PairingLog::pair, &parallel_log);
+	parallel_bvh.set_unpair_callback(PairingLog::unpair, &parallel_log);
+
+	RandomPCG rng(1234);
+	LocalVector<Vector2> positions;
+	positions.resize(item_count);
+	LocalVector<BVHHandle> serial_handles;
+	LocalVector<BVHHandle> parallel_handles;
+	for (uint32_t i = 0; i < item_count; i++) {
+		positions[i] = Vector2(rng.random(0.0f, 1000.0f), rng.random(0.0f, 1000.0f));
+		// A few static items in the first tree, the rest are moving in the second one.
+		const bool is_static = i % 10 == 0;
+		const uint32_t tree_id = is_static ? 0 : 1;
+		const uint32_t tree_collision_mask = is_static ? 2 : 3;
+		const Rect2 rect = Rect2(positions[i], Vector2(10, 10));
+		serial_handles.push_back(serial_bvh.create(&items[i], true, tree_id, tree_collision_mask, rect));
+		parallel_handles.push_back(parallel_bvh.create(&items[i], true, tree_id, tree_collision_mask, rect));
+	}
+	serial_bvh.update();
+	parallel_bvh.update();
+
+	CHECK_GT(serial_log.events.size(), 0u);
+
+	for (int step = 0; step < 20; step++) {
+		for (uint32_t i = 0; i < item_count; i++) {
+			if (i % 10 == 0) {
+				continue;
+			}
+			positions[i] += Vector2(rng.random(-8.0f, 8.0f), rng.random(-8.0f, 8.0f));
+			const Rect2 rect = Rect2(positions[i], Vector2(10, 10));
+			serial_bvh.move(serial_handles[i], rect);
+			parallel_bvh.move(parallel_handles[i], rect);
+		}
+		serial_bvh.update();
+		parallel_bvh.update();
+	}
+
+	CHECK_EQ(parallel_log.events.size(), serial_log.events.size());
+	bool same_events = parallel_log.events.size() == serial_log.events.size();
+	for (uint32_t i = 0; same_events && i < serial_log.events.size(); i++) {
+		same_events = parallel_log.events[i] == serial_log.events[i];
+	}
+	CHECK_MESSAGE(same_events, "Callbacks should be sent in the same order.");
+
+	for (uint32_t i = 0; i < item_count; i++) {
+		serial_bvh.erase(serial_handles[i]);
+		parallel_bvh.erase(parallel_handles[i]);
+	}
+}
+
+typedef BVH_Manager<PairingTestItem, 2, true, 32, PairingTestPairFunction, PairingTestCullFunction> CullTestBVH;
+
+TEST_CASE("[BVH] Segment packet culling should find the same hits as single segment culling") {
+	const uint32_t item_count = 1000;
+	const uint32_t segment_count = BVHCommon::PACKET_SIZE_MAX;
+	const int result_max = 1024;
+
+	LocalVector<PairingTestItem> items;
+	items.resize(item_count);
+
+	CullTestBVH bvh;
+	RandomPCG rng(4321);
+	LocalVector<BVHHandle> handles;
+	for (uint32_t i = 0; i < item_count; i++) {
+		items[i].id = i;
+		const bool is_static = i % 4 == 0;
+		const Vector3 position = Vector3(rng.random(-50.0f, 50.0f), rng.random(-50.0f, 50.0f), rng.random(-50.0f, 50.0f));
+		const AABB aabb = AABB(position, Vector3(rng.random(1.0f, 10.0f), rng.random(1.0f, 10.0f), rng.random(1.0f, 10.0f)));
+		handles.push_back(bvh.create(&items[i], true, is_static ? 0 : 1, is_static ? 2 : 3, aabb, i));
+	}
+	bvh.update();
+
+	Vector3 from[segment_count];
+	Vector3 to[segment_count];
+	for (uint32_t s = 0; s < segment_count; s++) {
+		from[s] = Vector3(rng.random(-10.0f, 10.0f), rng.random(-10.0f, 10.0f), rng.random(-10.0f, 10.0f));
+		Vector3 dir = Vector3(rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f), rng.random(-1.0f, 1.0f));
+		// Some segments are parallel to an axis plane, which the packet test handles separately.
+		if (s % 4 == 0) {
+			dir[s % 3] = 0;
+		}
+		to[s] = from[s] + dir * 150;
+	}
+
+	PairingTestItem *packet_results[result_max];
+	int packet_subindices[result_max];
+	uint32_t packet_segments[result_max];
+	const int packet_count = bvh.cull_segment_packet(from, to, segment_count, packet_results, packet_segments, result_max, nullptr, 0xFFFFFFFF, packet_subindices);
+	REQUIRE_GT(packet_count, 0);
+
+	bool same_hits = true;
+	int total_count = 0;
+	for (uint32_t s = 0; s < segment_count; s++) {
+		PairingTestItem *results[result_max];
+		int subindices[result_max];
+		const int count = bvh.cull_segment(from[s], to[s], results, result_max, nullptr, 0xFFFFFFFF, subindices);
+		total_count += count;
+
+		// The hits of each segment should come out in the same order as when culled alone.
+		int hit = 0;
+		for (int n = 0; n < packet_count; n++) {
+			if (packet_segments[n] != s) {
+				continue;
+			}
+			if (hit >= count || packet_results[n] != results[hit] || packet_subindices[n] != subindices[hit]) {
+				same_hits = false;
+			}
+			hit++;
+		}
+		if (hit != count) {
+			same_hits = false;
+		}
+	}
+	CHECK_EQ(packet_count, total_count);
+	CHECK_MESSAGE(same_hits, "Each segment of the packet should have the same hits as when culled on its own.");
+
+	// Running out of results should be reported rather than silently dropping hits.
+	CHECK_EQ(bvh.cull_segment_packet(from, to, segment_count, packet_results, packet_segments, packet_count - 1, nullptr), -1);
+
+	for (uint32_t i = 0; i < item_count; i++) {
+		bvh.erase(handles[i]);
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+struct ConcurrentInterningData {
+	int name_count = 0;
+	int iterations = 0;
+	// Names in this list are kept alive by the main thread, so every thread must intern them to the same data.
+	LocalVector<StringName> kept_names;
+	SafeNumeric<uint32_t> mismatches;
+};
+
+static void concurrent_interning_test(void *p_userdata, uint32_t p_index) {
+	ConcurrentInterningData *data = (ConcurrentInterningData *)p_userdata;
+	for (int i = 0; i < data->iterations; i++) {
+		// Each thread walks the names from a different starting point to make collisions on the same buckets likely.
+		const int name_index = (i + p_index * 7) % data->name_count;
+		const String name = vformat("__test_string_name_%d", name_index);
+
+		StringName from_string = name;
+		StringName from_cstring = name.utf8().get_data();
+		if (from_string != from_cstring || from_string != name) {
+			data->mismatches.increment();
+		}
+
+		if (name_index < (int)data->kept_names.size() && from_string != data->kept_names[name_index]) {
+			data->mismatches.increment();
+		}
+	}
+}
+
+static uint32_t run_concurrent_interning(ConcurrentInterningData &r_data, int p_tasks) {
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(concurrent_interning_test, &r_data, p_tasks, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	return r_data.mismatches.get();
+}
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name";
+	const StringName b = String("test_string_name");
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(StringName::search("test_string_name") == a);
+	CHECK(StringName("other_test_string_name") != a);
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	ConcurrentInterningData data;
+	data.name_count = 512;
+	data.iterations = 2000;
+	for (int i = 0; i < data.name_count / 2; i++) {
+		data.kept_names.push_back(StringName(vformat("__test_string_name_%d", i)));
+	}
+
+	CHECK_MESSAGE(run_concurrent_interning(data, 32) == 0, "All threads should intern the same name to the same data.");
+
+	// Names that were not kept alive must have been freed once all threads were done with them.
+	CHECK(StringName::search(String("__test_string_name_" + itos(data.name_count - 1))) == StringName());
+}
+
+TEST_CASE("[Stress][StringName] Concurrent interning") {
+	ConcurrentInterningData data;
+	data.name_count = 4096;
+	data.iterations = 100000;
+
+	const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	CHECK(run_concurrent_interning(data, WorkerThreadPool::get_singleton()->get_thread_count()) == 0);
+	print_verbose(vformat("StringName: %d threads interned %d names each in %d usec.", WorkerThreadPool::get_singleton()->get_thread_count(), data.iterations * 2, OS::get_singleton()->get_ticks_usec() - begin_usec));
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -244,6 +244,25 @@ TEST_CASE("[LocalVector] Size / Resize / Reserve.") {
 	CHECK(vector.size() == 4);
 	CHECK(vector.get_capacity() >= 4);
 }
+
+TEST_CASE("[LocalVector] Move.") {
+	LocalVector<int> vector;
+	vector.push_back(1);
+	vector.push_back(2);
+	const int *data = vector.ptr();
+
+	LocalVector<int> moved(std::move(vector));
+	CHECK(moved.size() == 2);
+	CHECK(moved.ptr() == data);
+	CHECK(moved[1] == 2);
+
+	LocalVector<int> assigned;
+	assigned.push_back(3);
+	assigned = std::move(moved);
+	CHECK(assigned.size() == 2);
+	CHECK(assigned.ptr() == data);
+	CHECK(assigned[0] == 1);
+}
 } // namespace TestLocalVector
 
 #endif // TEST_LOCAL_VECTOR_H
@@ -107,6 +107,191 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_child_task(void *p_arg) {
+	counter[(uintptr_t)p_arg].increment();
+}
+
+static void static_parent_task(void *p_arg) {
+	// Children posted from a pool thread go to its own deque and may be stolen by others.
+	uint32_t children = (uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> child_ids;
+	child_ids.resize(children);
+	for (uint32_t i = 0; i < children; i++) {
+		child_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_child_task, (void *)(uintptr_t)i, true);
+	}
+	for (uint32_t i = 0; i < children; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(child_ids[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	const int parents = 8;
+	const int children = 64;
+
+	counter.clear();
+	counter.resize(children);
+
+	LocalVector<WorkerThreadPool::TaskID> parent_ids;
+	for (int i = 0; i < parents; i++) {
+		parent_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_parent_task, (void *)(uintptr_t)children, true));
+	}
+	for (uint32_t i = 0; i < parent_ids.size(); i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(parent_ids[i]);
+	}
+
+	bool all_run = true;
+	for (int i = 0; i < children; i++) {
+		all_run &= counter[i].get() == parents;
+	}
+	CHECK_MESSAGE(all_run, "Every child task should have run once per parent.");
+}
+
+static void static_child_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+static void static_group_parent_task(void *p_arg) {
+	// Waiting pool threads run pending tasks, so the group progresses even if every thread is a parent.
+	uint32_t elements = (uintptr_t)p_arg;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_child_group_test, nullptr, elements, -1, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+}
+
+TEST_CASE("[WorkerThreadPool] Wait for group tasks from pool threads") {
+	const int parents = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()) * 2;
+	const int elements = 256;
+
+	counter.clear();
+	counter.resize(elements);
+
+	LocalVector<WorkerThreadPool::TaskID> parent_ids;
+	for (int i = 0; i < parents; i++) {
+		parent_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_group_parent_task, (void *)(uintptr_t)elements, true));
+	}
+	for (uint32_t i = 0; i < parent_ids.size(); i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(parent_ids[i]);
+	}
+
+	bool all_run = true;
+	for (int i = 0; i < elements; i++) {
+		all_run &= counter[i].get() == parents;
+	}
+	CHECK_MESSAGE(all_run, "Every group element should have run once per parent.");
+}
+
+struct GroupWaitData {
+	SafeNumeric<int> waiting_thread;
+	SafeFlag ran_while_waiting;
+};
+
+static void static_unrelated_task(void *p_arg) {
+	GroupWaitData *data = (GroupWaitData *)p_arg;
+	if (data->waiting_thread.get() == WorkerThreadPool::get_thread_index()) {
+		data->ran_while_waiting.set();
+	}
+}
+
+static void static_group_wait_task(void *p_arg) {
+	// Unrelated tasks go to the same deque before the group, so a waiter that took any pending task would find them.
+	GroupWaitData *data = (GroupWaitData *)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> unrelated_ids;
+	for (int i = 0; i < 16; i++) {
+		unrelated_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_unrelated_task, data, true));
+	}
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_child_group_test, nullptr, counter.size(), -1, true);
+	data->waiting_thread.set(WorkerThreadPool::get_thread_index());
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	data->waiting_thread.set(-1);
+	for (uint32_t i = 0; i < unrelated_ids.size(); i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(unrelated_ids[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Waiting for a group from a pool thread only runs its tasks") {
+	const int elements = 256;
+
+	counter.clear();
+	counter.resize(elements);
+
+	GroupWaitData data;
+	data.waiting_thread.set(-1);
+	WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(static_group_wait_task, &data, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+
+	bool all_run = true;
+	for (int i = 0; i < elements; i++) {
+		all_run &= counter[i].get() == 1;
+	}
+	CHECK_MESSAGE(all_run, "Every group element should have run once.");
+	CHECK_FALSE_MESSAGE(data.ran_while_waiting.is_set(), "The waiting thread should not run tasks outside the awaited group.");
+}
+
+static void static_count_task(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_count_group_test(void *p_arg, uint32_t p_index) {
+	counter[0].increment();
+}
+
+static void static_count_parent_task(void *p_arg) {
+	uint32_t children = (uintptr_t)p_arg;
+	LocalVector<WorkerThreadPool::TaskID> child_ids;
+	child_ids.resize(children);
+	for (uint32_t i = 0; i < children; i++) {
+		child_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_count_task, nullptr, true);
+	}
+	for (uint32_t i = 0; i < children; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(child_ids[i]);
+	}
+}
+
+TEST_CASE("[Stress][WorkerThreadPool] Task scaling" * doctest::skip()) {
+	const int thread_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+
+	for (int task_count = 1000; task_count <= 1000000; task_count *= 10) {
+		counter.clear();
+		counter.resize(1);
+
+		// Individual tasks posted from the calling thread, through the shared queue.
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		LocalVector<WorkerThreadPool::TaskID> task_ids;
+		task_ids.resize(task_count);
+		for (int i = 0; i < task_count; i++) {
+			task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_count_task, nullptr, true);
+		}
+		for (int i = 0; i < task_count; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task_ids[i]);
+		}
+		uint64_t queue_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(counter[0].get() == task_count);
+
+		// Individual tasks posted from pool threads, through their deques.
+		counter[0].set(0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		LocalVector<WorkerThreadPool::TaskID> parent_ids;
+		for (int i = 0; i < thread_count; i++) {
+			int children = task_count / thread_count + (i < task_count % thread_count ? 1 : 0);
+			parent_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_count_parent_task, (void *)(uintptr_t)children, true));
+		}
+		for (uint32_t i = 0; i < parent_ids.size(); i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(parent_ids[i]);
+		}
+		uint64_t deque_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(counter[0].get() == task_count);
+
+		// Elements of a single group.
+		counter[0].set(0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_count_group_test, nullptr, task_count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		uint64_t group_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(counter[0].get() == task_count);
+
+		MESSAGE(vformat("WorkerThreadPool, %d threads, %d tasks: %d usec from the caller, %d usec from pool threads, %d usec as group elements.", thread_count, task_count, queue_usec, deque_usec, group_usec));
+	}
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -31,8 +31,14 @@
 #ifndef TEST_ANIMATION_H
 #define TEST_ANIMATION_H
 
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
 #include "scene/resources/animation.h"
 
+#ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
+#endif // _3D_DISABLED
+
 #include "tests/test_macros.h"
 
 namespace TestAnimation {
@@ -309,6 +315,102 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+#ifndef _3D_DISABLED
+static Ref<Animation> create_blend_test_animation(int p_node_count, real_t p_offset) {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(1.0);
+	for (int i = 0; i < p_node_count; i++) {
+		NodePath path = NodePath(vformat("Node%d", i));
+		real_t value = p_offset + i;
+
+		int track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(track, path);
+		animation->position_track_insert_key(track, 0.0, Vector3(value, 0, -value));
+		animation->position_track_insert_key(track, 1.0, Vector3(-value, value * 2, 1));
+
+		track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(track, path);
+		animation->rotation_track_insert_key(track, 0.0, Quaternion(Vector3(0, 1, 0), value * 0.1));
+		animation->rotation_track_insert_key(track, 1.0, Quaternion(Vector3(1, 0, 0), -value * 0.2));
+
+		track = animation->add_track(Animation::TYPE_SCALE_3D);
+		animation->track_set_path(track, path);
+		animation->scale_track_insert_key(track, 0.0, Vector3(1, 1, 1));
+		animation->scale_track_insert_key(track, 1.0, Vector3(1, 1, 1) * (1 + value * 0.5));
+	}
+
+	int track = animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(track, NodePath("Extra:scale"));
+	animation->value_track_set_update_mode(track, Animation::UPDATE_CONTINUOUS);
+	animation->track_insert_key(track, 0.0, Vector3(1, 2, 3) * p_offset);
+	animation->track_insert_key(track, 1.0, Vector3(3, 2, 1));
+
+	track = animation->add_track(Animation::TYPE_BEZIER);
+	animation->track_set_path(track, NodePath("Extra:position:x"));
+	animation->bezier_track_insert_key(track, 0.0, -p_offset, Vector2(-0.2, 0), Vector2(0.2, 1));
+	animation->bezier_track_insert_key(track, 1.0, p_offset, Vector2(-0.2, -1), Vector2(0.2, 0));
+
+	return animation;
+}
+
+// Crossfades two animations with several tracks each and returns the resulting transforms.
+static Vector<Transform3D> blend_test_animations(bool p_parallel) {
+	const int node_count = 8;
+
+	Node3D *root = memnew(Node3D);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	for (int i = 0; i < node_count; i++) {
+		Node3D *node = memnew(Node3D);
+		node->set_name(vformat("Node%d", i));
+		root->add_child(node);
+	}
+	Node3D *extra = memnew(Node3D);
+	extra->set_name("Extra");
+	root->add_child(extra);
+
+	Ref<AnimationLibrary> library = memnew(AnimationLibrary);
+	library->add_animation("first", create_blend_test_animation(node_count, 1.0));
+	library->add_animation("second", create_blend_test_animation(node_count, -2.5));
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	root->add_child(player);
+	player->set_callback_mode_process(AnimationMixer::ANIMATION_CALLBACK_MODE_PROCESS_MANUAL);
+	player->set_parallel_blending_enabled(p_parallel);
+	player->add_animation_library("", library);
+
+	Vector<Transform3D> result;
+	player->play("first");
+	player->advance(0.3);
+	player->play("second", 0.5);
+	for (int step = 0; step < 4; step++) {
+		player->advance(0.1);
+		for (int i = 0; i < root->get_child_count(); i++) {
+			Node3D *node = Object::cast_to<Node3D>(root->get_child(i));
+			if (node) {
+				result.push_back(node->get_transform());
+			}
+		}
+	}
+
+	SceneTree::get_singleton()->get_root()->remove_child(root);
+	memdelete(root);
+	return result;
+}
+
+TEST_CASE("[SceneTree][Animation] Parallel blending gives the same result as serial blending") {
+	Vector<Transform3D> serial = blend_test_animations(false);
+	Vector<Transform3D> parallel = blend_test_animations(true);
+
+	REQUIRE(serial.size() == 4 * 9);
+	for (int i = 0; i < serial.size(); i++) {
+		CHECK_MESSAGE(serial[i] == parallel[i], vformat("Transform %d should be the same when tracks are blended in parallel.", i));
+	}
+
+	// Make sure the crossfade actually moved things.
+	CHECK(serial[0] != serial[3 * 9]);
+}
+#endif // _3D_DISABLED
+
 } // namespace TestAnimation
 
 #endif // TEST_ANIMATION_H
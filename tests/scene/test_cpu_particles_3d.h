@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  test_cpu_particles_3d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_CPU_PARTICLES_3D_H
+#define TEST_CPU_PARTICLES_3D_H
+
+#include "core/config/project_settings.h"
+#include "scene/3d/cpu_particles_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/gradient.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCPUParticles3D {
+
+// Runs a few frames of a randomized particle system and returns the buffer sent to the multimesh.
+static Vector<float> simulate_particles(bool p_threaded, uint64_t p_seed) {
+	ProjectSettings::get_singleton()->set_setting("rendering/particles/cpu_particles/threaded_processing", p_threaded);
+	Math::seed(p_seed);
+
+	Ref<Gradient> ramp;
+	ramp.instantiate();
+	ramp->add_point(0.5, Color(0.2, 0.8, 0.4));
+
+	CPUParticles3D *particles = memnew(CPUParticles3D);
+	particles->set_amount(4000);
+	particles->set_lifetime(0.5);
+	particles->set_randomness_ratio(0.5);
+	particles->set_lifetime_randomness(0.3);
+	particles->set_spread(60.0);
+	particles->set_emission_shape(CPUParticles3D::EMISSION_SHAPE_SPHERE);
+	particles->set_emission_sphere_radius(2.0);
+	particles->set_param_min(CPUParticles3D::PARAM_INITIAL_LINEAR_VELOCITY, 1.0);
+	particles->set_param_max(CPUParticles3D::PARAM_INITIAL_LINEAR_VELOCITY, 5.0);
+	particles->set_param_max(CPUParticles3D::PARAM_ANGULAR_VELOCITY, 90.0);
+	particles->set_param_max(CPUParticles3D::PARAM_DAMPING, 2.0);
+	particles->set_param_max(CPUParticles3D::PARAM_SCALE, 2.0);
+	particles->set_color_ramp(ramp);
+	particles->set_emitting(true);
+	SceneTree::get_singleton()->get_root()->add_child(particles);
+
+	// Long enough for particles to expire and be emitted again.
+	for (int i = 0; i < 24; i++) {
+		SceneTree::get_singleton()->process(1.0 / 30.0);
+	}
+	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
+	Vector<float> buffer = RS::get_singleton()->multimesh_get_buffer(particles->get_base());
+
+	SceneTree::get_singleton()->get_root()->remove_child(particles);
+	memdelete(particles);
+	return buffer;
+}
+
+TEST_CASE("[SceneTree][CPUParticles3D] Threaded processing matches serial processing") {
+	bool threaded_processing = GLOBAL_GET("rendering/particles/cpu_particles/threaded_processing");
+
+	Vector<float> serial = simulate_particles(false, 1234);
+	Vector<float> threaded = simulate_particles(true, 1234);
+
+	REQUIRE(serial.size() == 4000 * 20);
+	CHECK_MESSAGE(serial == threaded, "Processing particles on several threads should give the same result as processing them in order.");
+
+	ProjectSettings::get_singleton()->set_setting("rendering/particles/cpu_particles/threaded_processing", threaded_processing);
+}
+
+TEST_CASE("[SceneTree][CPUParticles3D] Emission is deterministic for a fixed seed") {
+	bool threaded_processing = GLOBAL_GET("rendering/particles/cpu_particles/threaded_processing");
+
+	Vector<float> first = simulate_particles(true, 5678);
+	Vector<float> second = simulate_particles(true, 5678);
+	Vector<float> other = simulate_particles(true, 91011);
+
+	REQUIRE(first.size() == 4000 * 20);
+	CHECK_MESSAGE(first == second, "Runs with the same seed should emit the same particles.");
+	CHECK_MESSAGE(first != other, "Runs with different seeds should emit different particles.");
+
+	ProjectSettings::get_singleton()->set_setting("rendering/particles/cpu_particles/threaded_processing", threaded_processing);
+}
+
+} // namespace TestCPUParticles3D
+
+#endif // TEST_CPU_PARTICLES_3D_H
@@ -31,6 +31,8 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "scene/2d/node_2d.h"
+#include "scene/main/timer.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -150,6 +152,53 @@ TEST_CASE("[PackedScene] Instantiate Packed Scene With Children") {
 	memdelete(instance);
 }
 
+TEST_CASE("[PackedScene] Instantiate Packed Scene Repeatedly") {
+	// Create a scene to pack.
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	scene->set_position(Vector2(10, 20));
+	scene->set_z_index(3);
+
+	Timer *timer = memnew(Timer);
+	timer->set_name("Timer");
+	timer->set_wait_time(0.25);
+	scene->add_child(timer);
+	timer->set_owner(scene);
+	timer->connect("timeout", Callable(scene, "set_meta").bind("timed_out", 7), Object::CONNECT_PERSIST);
+
+	// Pack the scene.
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	// Later instances reuse what the first one resolved, all of them must match.
+	for (int i = 0; i < 3; i++) {
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene.instantiate());
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_position() == Vector2(10, 20));
+		CHECK(instance->get_z_index() == 3);
+
+		Timer *instance_timer = Object::cast_to<Timer>(instance->get_node_or_null(NodePath("Timer")));
+		REQUIRE(instance_timer != nullptr);
+		CHECK(instance_timer->get_wait_time() == doctest::Approx(0.25));
+		CHECK(instance_timer->get_owner() == instance);
+
+		instance_timer->emit_signal("timeout");
+		CHECK(instance->get_meta("timed_out", 0) == Variant(7));
+
+		memdelete(instance);
+	}
+
+	// Packing again must not reuse anything from the previous contents.
+	scene->set_position(Vector2(-5, 5));
+	packed_scene.pack(scene);
+	Node2D *instance = Object::cast_to<Node2D>(packed_scene.instantiate());
+	REQUIRE(instance != nullptr);
+	CHECK(instance->get_position() == Vector2(-5, 5));
+
+	memdelete(instance);
+	memdelete(scene);
+}
+
 TEST_CASE("[PackedScene] Set Path") {
 	// Create a scene to pack.
 	Node *scene = memnew(Node);
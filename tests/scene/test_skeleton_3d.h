@@ -33,7 +33,9 @@
 
 #include "tests/test_macros.h"
 
+#include "core/math/random_pcg.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/main/window.h"
 
 namespace TestSkeleton3D {
 
@@ -73,6 +75,113 @@ TEST_CASE("[Skeleton3D] Test per-bone meta") {
 	skeleton->set_bone_meta(0, "non-existing-key", Variant());
 	memdelete(skeleton);
 }
+
+TEST_CASE("[SceneTree][Skeleton3D] Global poses follow the bone hierarchy") {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	// Pose changes only invalidate global poses inside the tree.
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	// Add the child before its parent, so that process order differs from bone order.
+	skeleton->add_bone("child");
+	skeleton->add_bone("root");
+	skeleton->add_bone("other_root");
+	skeleton->set_bone_parent(0, 1);
+	skeleton->set_bone_pose_position(1, Vector3(1, 0, 0));
+	skeleton->set_bone_pose_position(0, Vector3(0, 2, 0));
+	skeleton->set_bone_pose_position(2, Vector3(0, 0, 3));
+
+	CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(1, 2, 0)));
+	CHECK(skeleton->get_bone_global_pose(1).origin.is_equal_approx(Vector3(1, 0, 0)));
+	CHECK(skeleton->get_bone_global_pose(2).origin.is_equal_approx(Vector3(0, 0, 3)));
+
+	// Changing the parent pose only updates the global pose of the subtree.
+	skeleton->set_bone_pose_rotation(1, Quaternion(Vector3(0, 0, 1), Math_PI / 2));
+	CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(-1, 0, 0)));
+	CHECK(skeleton->get_bone_global_pose(2).origin.is_equal_approx(Vector3(0, 0, 3)));
+
+	// Reparenting rebuilds the process order.
+	skeleton->set_bone_parent(0, 2);
+	skeleton->force_update_all_bone_transforms();
+	CHECK(skeleton->get_bone_global_pose(0).origin.is_equal_approx(Vector3(0, 2, 3)));
+	memdelete(skeleton);
+}
+
+// Reference for the global pose pass: walk up the hierarchy through the public pose getters.
+static Transform3D get_reference_global_pose(const Skeleton3D *p_skeleton, int p_bone) {
+	Transform3D pose = p_skeleton->is_bone_enabled(p_bone) ? p_skeleton->get_bone_pose(p_bone) : p_skeleton->get_bone_rest(p_bone);
+	int parent = p_skeleton->get_bone_parent(p_bone);
+	return parent >= 0 ? get_reference_global_pose(p_skeleton, parent) * pose : pose;
+}
+
+static void check_global_poses_match_reference(Skeleton3D *p_skeleton) {
+	for (int i = 0; i < p_skeleton->get_bone_count(); i++) {
+		CHECK_MESSAGE(p_skeleton->get_bone_global_pose(i).is_equal_approx(get_reference_global_pose(p_skeleton, i)), vformat("Global pose of bone %d should match the reference.", i));
+	}
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Global pose pass matches composing poses bone by bone") {
+	const int bone_count = 64;
+	RandomPCG rng(42);
+
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+	for (int i = 0; i < bone_count; i++) {
+		skeleton->add_bone(vformat("bone_%d", i));
+	}
+	// New bones start from the identity pose.
+	CHECK(skeleton->get_bone_pose(bone_count - 1) == Transform3D());
+	CHECK(skeleton->get_bone_pose_scale(bone_count - 1) == Vector3(1, 1, 1));
+
+	// Build the hierarchy in shuffled order, so parents often have a higher index than their children.
+	LocalVector<int> order;
+	for (int i = 0; i < bone_count; i++) {
+		order.push_back(i);
+	}
+	for (int i = bone_count - 1; i > 0; i--) {
+		SWAP(order[i], order[rng.rand(i + 1)]);
+	}
+	for (int i = 1; i < bone_count; i++) {
+		// Leave a few extra roots.
+		if (i % 16 != 0) {
+			skeleton->set_bone_parent(order[i], order[rng.rand(i)]);
+		}
+	}
+
+	for (int i = 0; i < bone_count; i++) {
+		skeleton->set_bone_rest(i, Transform3D(Basis(Vector3(0, 1, 0), rng.random(-1.0, 1.0)), Vector3(rng.random(-1.0, 1.0), rng.random(0.5, 1.5), 0)));
+		skeleton->set_bone_pose_position(i, Vector3(rng.random(-1.0, 1.0), rng.random(-1.0, 1.0), rng.random(-1.0, 1.0)));
+		skeleton->set_bone_pose_rotation(i, Quaternion(Vector3(rng.random(-1.0, 1.0), rng.random(-1.0, 1.0), 1).normalized(), rng.random(-Math_PI, Math_PI)));
+		skeleton->set_bone_pose_scale(i, Vector3(1, 1, 1) * rng.random(0.5, 1.5));
+		if (i % 7 == 3) {
+			skeleton->set_bone_enabled(i, false);
+		}
+	}
+
+	SUBCASE("Full pass") {
+		skeleton->force_update_all_bone_transforms();
+		check_global_poses_match_reference(skeleton);
+	}
+
+	SUBCASE("On-demand updates") {
+		// Query leaves first, so each query computes its parents from dirty state.
+		for (int i = bone_count - 1; i >= 0; i--) {
+			CHECK(skeleton->get_bone_global_pose(order[i]).is_equal_approx(get_reference_global_pose(skeleton, order[i])));
+		}
+	}
+
+	SUBCASE("Partial updates") {
+		skeleton->force_update_all_bone_transforms();
+		skeleton->set_bone_pose_rotation(order[1], Quaternion(Vector3(1, 0, 0), 0.5));
+		skeleton->set_bone_enabled(order[2], !skeleton->is_bone_enabled(order[2]));
+		check_global_poses_match_reference(skeleton);
+
+		skeleton->set_bone_pose_position(order[bone_count / 2], Vector3(2, 0, 0));
+		skeleton->force_update_all_bone_transforms();
+		check_global_poses_match_reference(skeleton);
+	}
+
+	memdelete(skeleton);
+}
+
 } // namespace TestSkeleton3D
 
 #endif // TEST_SKELETON_3D_H
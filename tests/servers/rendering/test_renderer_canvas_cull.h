@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/dummy/rasterizer_canvas_dummy.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+// Stands in for the canvas renderer to record the draw list it is given.
+class RecordingCanvasRender : public RasterizerCanvasDummy {
+public:
+	Vector<Vector2> positions;
+
+	void canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_list, const Transform2D &p_canvas_transform, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used, RenderingMethod::RenderInfo *r_render_info = nullptr) override {
+		for (Item *ci = p_item_list; ci; ci = ci->next) {
+			positions.push_back(ci->final_transform.get_origin());
+		}
+		r_sdf_used = false;
+	}
+};
+
+// Renders the canvas and returns the global position of every item in draw order.
+Vector<Vector2> render_canvas(RID p_canvas) {
+	RendererCanvasRender *canvas_render = RSG::canvas_render;
+	RendererCanvasRender::singleton = nullptr;
+	RecordingCanvasRender *recorder = memnew(RecordingCanvasRender);
+	RSG::canvas_render = recorder;
+
+	RendererCanvasCull::Canvas *canvas = RSG::canvas->canvas_owner.get_or_null(p_canvas);
+	RSG::canvas->render_canvas(RID(), canvas, Transform2D(), nullptr, nullptr, Rect2(-100000, -100000, 200000, 200000), RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT, RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT, false, false, 0xFFFFFFFF);
+	const Vector<Vector2> positions = recorder->positions;
+
+	memdelete(recorder);
+	RendererCanvasRender::singleton = canvas_render;
+	RSG::canvas_render = canvas_render;
+	return positions;
+}
+
+RID create_rect_item(RID p_parent, const Vector2 &p_position) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID item = rs->canvas_item_create();
+	rs->canvas_item_set_parent(item, p_parent);
+	rs->canvas_item_set_transform(item, Transform2D(0, p_position));
+	rs->canvas_item_add_rect(item, Rect2(0, 0, 8, 8), Color(1, 1, 1));
+	return item;
+}
+
+// Fills the parent with the same items, whether it is a canvas or a canvas item.
+int create_item_tree(RID p_parent, RID p_mesh, Vector<RID> &r_items) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	int visible_count = 0;
+
+	// Subtrees of very different sizes so the ranges have to be balanced, and a mix of
+	// Z indices, Y-sorting, hidden items and meshes, whose rects are read from storage.
+	for (int i = 0; i < 64; i++) {
+		RID parent = create_rect_item(p_parent, Vector2(i * 1000, i % 3));
+		rs->canvas_item_set_draw_index(parent, i);
+		rs->canvas_item_set_z_index(parent, i % 4 - 1);
+		if (i % 7 == 0) {
+			rs->canvas_item_set_sort_children_by_y(parent, true);
+		}
+		if (i % 5 == 0) {
+			rs->canvas_item_add_mesh(parent, p_mesh);
+		}
+		r_items.push_back(parent);
+		visible_count++;
+
+		const int child_count = i % 8 == 0 ? 200 : 20;
+		for (int j = 0; j < child_count; j++) {
+			RID child = create_rect_item(parent, Vector2(j * 3, (j * 37) % 101));
+			rs->canvas_item_set_z_index(child, (i + j) % 5 - 2);
+			if (j % 11 == 5) {
+				rs->canvas_item_set_visible(child, false);
+			} else {
+				visible_count++;
+			}
+			r_items.push_back(child);
+		}
+	}
+	return visible_count;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling keeps the serial draw order") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID mesh = rs->mesh_create();
+	Vector<RID> items;
+
+	// Many top-level items can be culled in parallel.
+	RID canvas = rs->canvas_create();
+	const int visible_count = create_item_tree(canvas, mesh, items);
+
+	// A single top-level item is always culled serially.
+	RID serial_canvas = rs->canvas_create();
+	RID root = rs->canvas_item_create();
+	rs->canvas_item_set_parent(root, serial_canvas);
+	create_item_tree(root, mesh, items);
+	items.push_back(root);
+
+	const Vector<Vector2> threaded = render_canvas(canvas);
+	const Vector<Vector2> serial = render_canvas(serial_canvas);
+	// Y-sorted subtrees reuse their cached order on the second pass, the result must not change.
+	const Vector<Vector2> threaded_again = render_canvas(canvas);
+
+	CHECK(threaded.size() == visible_count);
+	CHECK_MESSAGE(threaded == serial, "Threaded culling should give the same draw list as serial culling.");
+	CHECK(threaded_again == threaded);
+
+	for (int i = items.size() - 1; i >= 0; i--) {
+		rs->free(items[i]);
+	}
+	rs->free(serial_canvas);
+	rs->free(canvas);
+	rs->free(mesh);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Y-sorted items reuse the cached order until the subtree changes") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	RID parent = create_rect_item(canvas, Vector2());
+	rs->canvas_item_set_sort_children_by_y(parent, true);
+
+	RID children[4];
+	const Vector2 child_positions[4] = { Vector2(0, 30), Vector2(10, 10), Vector2(20, 40), Vector2(30, 20) };
+	for (int i = 0; i < 4; i++) {
+		children[i] = create_rect_item(parent, child_positions[i]);
+	}
+
+	Vector<Vector2> expected = { Vector2(), child_positions[1], child_positions[3], child_positions[0], child_positions[2] };
+	CHECK(render_canvas(canvas) == expected);
+
+	SUBCASE("Moving a child re-sorts the cached items") {
+		rs->canvas_item_set_transform(children[2], Transform2D(0, Vector2(20, 5)));
+
+		expected = { Vector2(), Vector2(20, 5), child_positions[1], child_positions[3], child_positions[0] };
+		CHECK(render_canvas(canvas) == expected);
+	}
+
+	SUBCASE("Children at the same height keep their draw order") {
+		rs->canvas_item_set_transform(children[2], Transform2D(0, Vector2(20, 10)));
+		rs->canvas_item_set_transform(children[0], Transform2D(0, Vector2(0, 10.00005)));
+
+		expected = { Vector2(), Vector2(10, 10), Vector2(20, 10), Vector2(0, 10.00005), child_positions[3] };
+		CHECK(render_canvas(canvas) == expected);
+	}
+
+	SUBCASE("Hiding a child rebuilds the cached items") {
+		rs->canvas_item_set_visible(children[3], false);
+
+		expected = { Vector2(), child_positions[1], child_positions[0], child_positions[2] };
+		CHECK(render_canvas(canvas) == expected);
+	}
+
+	SUBCASE("Adding a child rebuilds the cached items") {
+		RID new_child = create_rect_item(parent, Vector2(50, 15));
+
+		expected = { Vector2(), child_positions[1], Vector2(50, 15), child_positions[3], child_positions[0], child_positions[2] };
+		CHECK(render_canvas(canvas) == expected);
+
+		rs->free(new_child);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		rs->free(children[i]);
+	}
+	rs->free(parent);
+	rs->free(canvas);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
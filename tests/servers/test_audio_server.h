@@ -0,0 +1,264 @@
+/**************************************************************************/
+/*  test_audio_server.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_SERVER_H
+#define TEST_AUDIO_SERVER_H
+
+#include "core/math/math_funcs.h"
+#include "scene/resources/audio_stream_wav.h"
+#include "servers/audio/effects/audio_effect_amplify.h"
+#include "servers/audio/effects/audio_effect_filter.h"
+#include "servers/audio_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioServer {
+
+// Runs the audio server's mix step on request. The test keeps the server locked
+// while mixing, so the real driver's thread can't mix at the same time.
+class MixStepAudioDriver : public AudioDriver {
+public:
+	const char *get_name() const override { return "MixStep"; }
+	Error init() override { return OK; }
+	void start() override {}
+	int get_mix_rate() const override { return AudioDriver::get_singleton()->get_mix_rate(); }
+	SpeakerMode get_speaker_mode() const override { return AudioDriver::get_singleton()->get_speaker_mode(); }
+	void lock() override {}
+	void unlock() override {}
+	void finish() override {}
+
+	void mix(int p_frames, int32_t *p_buffer) {
+		audio_server_process(p_frames, p_buffer, false);
+	}
+};
+
+// Lengths around the vector width of two frames, so the scalar tail is exercised too.
+const uint32_t kernel_test_lengths[] = { 0, 1, 2, 3, 4, 5, 7, 16, 31, 33, 512, 513 };
+
+Vector<AudioFrame> gen_frames(uint32_t p_frames, float p_phase) {
+	Vector<AudioFrame> frames;
+	frames.resize(p_frames);
+	for (uint32_t i = 0; i < p_frames; i++) {
+		frames.write[i] = AudioFrame(Math::sin(i * 0.37f + p_phase), Math::cos(i * 0.11f - p_phase) * 0.8f);
+	}
+	return frames;
+}
+
+// Vector and scalar code may round differently when the compiler contracts the scalar multiply-adds.
+void check_frames_match(const AudioFrame *p_result, const AudioFrame *p_expected, uint32_t p_frames) {
+	int mismatch = -1;
+	for (uint32_t i = 0; i < p_frames; i++) {
+		if (!Math::is_equal_approx(p_result[i].left, p_expected[i].left) || !Math::is_equal_approx(p_result[i].right, p_expected[i].right)) {
+			mismatch = i;
+			break;
+		}
+	}
+	CHECK_MESSAGE(mismatch == -1, vformat("Frame %d of %d should match the scalar mix.", mismatch, p_frames));
+}
+
+TEST_CASE("[AudioServer] Volume ramp kernel matches the scalar mix") {
+	const AudioFrame vol_start = AudioFrame(0.25, 1.0);
+	const AudioFrame vol_final = AudioFrame(0.75, 0.1);
+
+	for (uint32_t frames : kernel_test_lengths) {
+		// Offset by one frame so the buffers aren't aligned to the vector size.
+		Vector<AudioFrame> source = gen_frames(frames + 1, 0.5);
+		Vector<AudioFrame> out = gen_frames(frames + 1, 2.0);
+		Vector<AudioFrame> expected = out;
+
+		for (uint32_t i = 0; i < frames; i++) {
+			float lerp_param = (float)i / frames;
+			expected.write[i + 1] += (vol_final * lerp_param + (1 - lerp_param) * vol_start) * source[i + 1];
+		}
+
+		AudioServer::mix_ramp_accumulate(out.ptrw() + 1, source.ptr() + 1, vol_start, vol_final, frames);
+		check_frames_match(out.ptr(), expected.ptr(), frames + 1);
+	}
+}
+
+TEST_CASE("[AudioServer] Accumulate kernel matches the scalar mix") {
+	for (uint32_t frames : kernel_test_lengths) {
+		Vector<AudioFrame> source = gen_frames(frames + 1, 1.0);
+		Vector<AudioFrame> out = gen_frames(frames + 1, 3.0);
+		Vector<AudioFrame> expected = out;
+
+		for (uint32_t i = 0; i < frames; i++) {
+			expected.write[i + 1] += source[i + 1];
+		}
+
+		AudioServer::mix_accumulate(out.ptrw() + 1, source.ptr() + 1, frames);
+		check_frames_match(out.ptr(), expected.ptr(), frames + 1);
+	}
+}
+
+TEST_CASE("[AudioServer] Volume and peak kernel matches the scalar mix") {
+	for (uint32_t frames : kernel_test_lengths) {
+		Vector<AudioFrame> buf = gen_frames(frames + 1, 0.3);
+		if (frames > 0) {
+			// Put the loudest frame in the tail, past the last full vector.
+			buf.write[frames] = AudioFrame(-1.5, 1.25);
+		}
+		Vector<AudioFrame> expected = buf;
+
+		AudioFrame expected_peak = AudioFrame(0, 0);
+		for (uint32_t i = 0; i < frames; i++) {
+			expected.write[i + 1] *= 0.6f;
+			expected_peak.left = MAX(expected_peak.left, ABS(expected[i + 1].left));
+			expected_peak.right = MAX(expected_peak.right, ABS(expected[i + 1].right));
+		}
+
+		AudioFrame peak = AudioServer::mix_apply_volume(buf.ptrw() + 1, 0.6f, frames);
+		check_frames_match(buf.ptr(), expected.ptr(), frames + 1);
+		CHECK(peak.left == expected_peak.left);
+		CHECK(peak.right == expected_peak.right);
+	}
+}
+
+Ref<AudioStreamWAV> gen_stream(float p_frequency) {
+	const int frames = 4096;
+	Vector<uint8_t> data;
+	data.resize(frames * 4);
+	int16_t *samples = (int16_t *)data.ptrw();
+	for (int i = 0; i < frames; i++) {
+		samples[i * 2] = int16_t(Math::sin(Math_TAU * p_frequency * i / 44100.0) * 20000);
+		samples[i * 2 + 1] = int16_t(Math::sin(Math_TAU * p_frequency * 1.5 * i / 44100.0) * 12000);
+	}
+
+	Ref<AudioStreamWAV> stream;
+	stream.instantiate();
+	stream->set_format(AudioStreamWAV::FORMAT_16_BITS);
+	stream->set_stereo(true);
+	stream->set_mix_rate(44100);
+	stream->set_data(data);
+	stream->set_loop_mode(AudioStreamWAV::LOOP_FORWARD);
+	stream->set_loop_end(frames);
+	return stream;
+}
+
+// Builds a bus layout where several buses share a dependency level, mixes a few
+// steps and returns the driver output.
+Vector<int32_t> mix_bus_layout(bool p_threaded) {
+	AudioServer *audio_server = AudioServer::get_singleton();
+	audio_server->lock();
+
+	const bool was_threaded = audio_server->is_threaded_bus_mixing();
+	audio_server->set_threaded_bus_mixing(p_threaded);
+
+	// Master <- A <- C, D
+	//        <- B <- E
+	//        <- F (invalid send, goes to master)
+	const char *names[] = { "A", "B", "C", "D", "E", "F" };
+	const char *sends[] = { "Master", "Master", "A", "A", "B", "Missing" };
+	audio_server->set_bus_count(7);
+	for (int i = 0; i < 6; i++) {
+		audio_server->set_bus_name(i + 1, names[i]);
+	}
+	for (int i = 0; i < 6; i++) {
+		audio_server->set_bus_send(i + 1, sends[i]);
+		audio_server->set_bus_volume_db(i + 1, -1.5 * i);
+	}
+
+	Ref<AudioEffectAmplify> amplify;
+	amplify.instantiate();
+	amplify->set_volume_db(-4);
+	audio_server->add_bus_effect(1, amplify);
+	Ref<AudioEffectLowPassFilter> low_pass;
+	low_pass.instantiate();
+	low_pass->set_cutoff(1200);
+	audio_server->add_bus_effect(3, low_pass);
+	audio_server->add_bus_effect(5, low_pass);
+
+	Vector<Ref<AudioStreamPlayback>> playbacks;
+	const char *playback_buses[] = { "A", "C", "D", "E", "F" };
+	for (int i = 0; i < 5; i++) {
+		Ref<AudioStreamPlayback> playback = gen_stream(220 + 110 * i)->instantiate_playback();
+		Vector<AudioFrame> volumes;
+		volumes.resize(AudioServer::MAX_CHANNELS_PER_BUS);
+		volumes.fill(AudioFrame(0.4 + 0.1 * i, 0.8 - 0.1 * i));
+		audio_server->start_playback_stream(playback, playback_buses[i], volumes);
+		playbacks.push_back(playback);
+	}
+
+	// Enough room for every speaker mode.
+	const int frames = 4096;
+	const int samples = frames * AudioServer::MAX_CHANNELS_PER_BUS * 2;
+	MixStepAudioDriver driver;
+	Vector<int32_t> mixed;
+	mixed.resize(samples);
+	mixed.fill(0);
+	driver.mix(frames, mixed.ptrw());
+
+	for (const Ref<AudioStreamPlayback> &playback : playbacks) {
+		audio_server->stop_playback_stream(playback);
+	}
+	// Let the stopped playbacks fade out and be removed.
+	Vector<int32_t> fade_out;
+	fade_out.resize(samples);
+	fade_out.fill(0);
+	driver.mix(frames, fade_out.ptrw());
+
+	audio_server->set_bus_count(1);
+	audio_server->set_threaded_bus_mixing(was_threaded);
+	audio_server->unlock();
+	audio_server->update();
+
+	return mixed;
+}
+
+TEST_CASE("[Audio][AudioServer] Threaded bus mixing matches serial mixing") {
+	const Vector<int32_t> serial = mix_bus_layout(false);
+	const Vector<int32_t> threaded = mix_bus_layout(true);
+
+	REQUIRE(serial.size() == threaded.size());
+	REQUIRE(serial.size() > 0);
+
+	bool has_audio = false;
+	for (int32_t sample : serial) {
+		if (sample != 0) {
+			has_audio = true;
+			break;
+		}
+	}
+	CHECK_MESSAGE(has_audio, "The mixed buses should reach the master bus.");
+
+	// Every bus is mixed with the same operations in both cases, only on other threads.
+	bool matches = true;
+	for (int i = 0; i < serial.size(); i++) {
+		if (serial[i] != threaded[i]) {
+			matches = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(matches, "Threaded bus mixing should give the same output as serial mixing.");
+}
+
+} // namespace TestAudioServer
+
+#endif // TEST_AUDIO_SERVER_H
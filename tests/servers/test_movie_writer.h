@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  test_movie_writer.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MOVIE_WRITER_H
+#define TEST_MOVIE_WRITER_H
+
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/image.h"
+#include "core/io/marshalls.h"
+#include "servers/movie_writer/movie_writer_pngwav.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestMovieWriter {
+
+const int FRAME_COUNT = 12;
+const int FPS = 30;
+
+static Ref<Image> make_frame_image(int p_frame) {
+	Ref<Image> image = Image::create_empty(32, 16, false, Image::FORMAT_RGBA8);
+	for (int y = 0; y < image->get_height(); y++) {
+		for (int x = 0; x < image->get_width(); x++) {
+			image->set_pixel(x, y, Color(((x + p_frame) % 32) / 31.0, y / 15.0, p_frame / float(FRAME_COUNT), 1.0));
+		}
+	}
+	return image;
+}
+
+// Records the frames to PNG files and a WAV file at p_dir/movie.png.
+// Each audio block starts with its frame index. A frame listed in p_failed_frames has no image data.
+static String record_movie(const String &p_dir, bool p_async, const Vector<int> &p_failed_frames = Vector<int>()) {
+	ProjectSettings::get_singleton()->set_setting("editor/movie_writer/async_encoding", p_async);
+	ProjectSettings::get_singleton()->set_setting("editor/movie_writer/max_queued_frames", 3);
+	DirAccess::make_dir_recursive_absolute(p_dir);
+	const String path = p_dir.path_join("movie.png");
+
+	MovieWriterPNGWAV *writer = memnew(MovieWriterPNGWAV);
+	writer->begin(Size2i(32, 16), FPS, path);
+	LocalVector<int32_t> audio;
+	audio.resize(int(GLOBAL_GET("editor/movie_writer/mix_rate")) / FPS * 2);
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		for (uint32_t i = 0; i < audio.size(); i++) {
+			audio[i] = i == 0 ? frame : int32_t(i);
+		}
+		Ref<Image> image = p_failed_frames.has(frame) ? memnew(Image) : make_frame_image(frame);
+		writer->add_frame_image(image, false, audio.ptr());
+	}
+	writer->end();
+	memdelete(writer);
+
+	ProjectSettings::get_singleton()->set_setting("editor/movie_writer/async_encoding", true);
+	ProjectSettings::get_singleton()->set_setting("editor/movie_writer/max_queued_frames", 8);
+	return p_dir.path_join("movie");
+}
+
+static String frame_path(const String &p_base, int p_frame) {
+	return p_base + String::num_int64(p_frame).pad_zeros(8) + ".png";
+}
+
+static void check_audio_blocks(const Vector<uint8_t> &p_wav) {
+	const int header_size = 44;
+	const int block_size = int(GLOBAL_GET("editor/movie_writer/mix_rate")) / FPS * 2 * 4;
+	REQUIRE_EQ(p_wav.size(), header_size + FRAME_COUNT * block_size);
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		CHECK_EQ(int32_t(decode_uint32(&p_wav[header_size + frame * block_size])), frame);
+	}
+}
+
+TEST_CASE("[MovieWriter] Asynchronous encoding writes the same files as synchronous encoding") {
+	const String sync_base = record_movie(TestUtils::get_temp_path("movie_writer_sync"), false);
+	const String async_base = record_movie(TestUtils::get_temp_path("movie_writer_async"), true);
+
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		const Vector<uint8_t> sync_png = FileAccess::get_file_as_bytes(frame_path(sync_base, frame));
+		const Vector<uint8_t> async_png = FileAccess::get_file_as_bytes(frame_path(async_base, frame));
+		REQUIRE_FALSE(sync_png.is_empty());
+		CHECK(sync_png == async_png);
+
+		// Frames are written in submission order.
+		Ref<Image> image;
+		image.instantiate();
+		REQUIRE_EQ(image->load_png_from_buffer(async_png), OK);
+		CHECK(image->get_data() == make_frame_image(frame)->get_data());
+	}
+	CHECK_FALSE(FileAccess::exists(frame_path(async_base, FRAME_COUNT)));
+
+	const Vector<uint8_t> sync_wav = FileAccess::get_file_as_bytes(sync_base + ".wav");
+	const Vector<uint8_t> async_wav = FileAccess::get_file_as_bytes(async_base + ".wav");
+	CHECK(sync_wav == async_wav);
+	check_audio_blocks(async_wav);
+}
+
+TEST_CASE("[MovieWriter] A frame that fails to encode keeps the audio in sync") {
+	Vector<int> failed_frames;
+	failed_frames.push_back(5);
+	ERR_PRINT_OFF;
+	const String base = record_movie(TestUtils::get_temp_path("movie_writer_failed_frame"), true, failed_frames);
+	ERR_PRINT_ON;
+
+	// The previous frame is repeated in its place.
+	CHECK(FileAccess::get_file_as_bytes(frame_path(base, 5)) == FileAccess::get_file_as_bytes(frame_path(base, 4)));
+	CHECK(FileAccess::get_file_as_bytes(frame_path(base, 6)) != FileAccess::get_file_as_bytes(frame_path(base, 4)));
+	CHECK_FALSE(FileAccess::exists(frame_path(base, FRAME_COUNT)));
+	check_audio_blocks(FileAccess::get_file_as_bytes(base + ".wav"));
+}
+
+} // namespace TestMovieWriter
+
+#endif // TEST_MOVIE_WRITER_H
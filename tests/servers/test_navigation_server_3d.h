@@ -31,6 +31,7 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "modules/navigation/nav_polygon_bvh.h"
 #include "modules/navigation/nav_utils.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
@@ -88,6 +89,122 @@ struct RegisterHeapIndexes {
 	}
 };
 
+static inline LocalVector<gd::Polygon> build_grid_polygons(int p_size, real_t p_cell_size) {
+	LocalVector<gd::Polygon> polygons;
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			// Vary the height a bit so the polygons are not all coplanar.
+			const real_t y = (x * 7 + z * 3) % 5 * 0.1;
+			gd::Polygon polygon;
+			polygon.id = polygons.size();
+			polygon.points.push_back({ Vector3(x, y, z) * p_cell_size, gd::PointKey() });
+			polygon.points.push_back({ Vector3(x + 1, y, z) * p_cell_size, gd::PointKey() });
+			polygon.points.push_back({ Vector3(x + 1, y, z + 1) * p_cell_size, gd::PointKey() });
+			polygon.points.push_back({ Vector3(x, y, z + 1) * p_cell_size, gd::PointKey() });
+			polygons.push_back(polygon);
+		}
+	}
+	return polygons;
+}
+
+static inline NavPolygonBVH::ClosestPolygonResult get_closest_polygon_linear(const LocalVector<gd::Polygon> &p_polygons, const Vector3 &p_point, real_t p_max_distance_squared = FLT_MAX) {
+	NavPolygonBVH::ClosestPolygonResult result;
+	result.distance_squared = p_max_distance_squared;
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const gd::Polygon &polygon = p_polygons[i];
+		for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+			const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+			const Vector3 point = face.get_closest_point_to(p_point);
+			const real_t distance_squared = point.distance_squared_to(p_point);
+			if (distance_squared < result.distance_squared) {
+				result.polygon_index = i;
+				result.point = point;
+				result.distance_squared = distance_squared;
+			}
+		}
+	}
+	return result;
+}
+
+struct NavMapSyncState {
+	int polygon_count = 0;
+	int edge_count = 0;
+	int edge_merge_count = 0;
+	int edge_connection_count = 0;
+	int edge_free_count = 0;
+	// Pathways of every region's edge connections, sorted since the order depends on the relink order.
+	Vector<String> region_connections;
+	Vector<Vector<Vector3>> paths;
+};
+
+static inline NavMapSyncState get_map_sync_state(RID p_map, const LocalVector<RID> &p_regions, const Vector<Vector3> &p_path_points) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	NavMapSyncState state;
+	state.polygon_count = navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT);
+	state.edge_count = navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT);
+	state.edge_merge_count = navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT);
+	state.edge_connection_count = navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
+	state.edge_free_count = navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+
+	for (uint32_t i = 0; i < p_regions.size(); i++) {
+		Vector<String> connections;
+		for (int c = 0; c < navigation_server->region_get_connections_count(p_regions[i]); c++) {
+			connections.push_back(vformat("%s-%s", navigation_server->region_get_connection_pathway_start(p_regions[i], c), navigation_server->region_get_connection_pathway_end(p_regions[i], c)));
+		}
+		connections.sort();
+		state.region_connections.push_back(vformat("%d: %s", i, String(", ").join(connections)));
+	}
+
+	for (int i = 0; i + 1 < p_path_points.size(); i += 2) {
+		state.paths.push_back(navigation_server->map_get_path(p_map, p_path_points[i], p_path_points[i + 1], true));
+	}
+	return state;
+}
+
+static inline real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
+// Compares the map after an incremental sync with the same map after relinking everything.
+static inline void check_map_matches_full_relink(RID p_map, const LocalVector<RID> &p_regions, const Vector<Vector3> &p_path_points) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+	const NavMapSyncState incremental = get_map_sync_state(p_map, p_regions, p_path_points);
+
+	// Changing a map setting relinks all regions.
+	const real_t edge_connection_margin = navigation_server->map_get_edge_connection_margin(p_map);
+	navigation_server->map_set_edge_connection_margin(p_map, edge_connection_margin * 2.0);
+	navigation_server->process(0.0);
+	navigation_server->map_set_edge_connection_margin(p_map, edge_connection_margin);
+	navigation_server->process(0.0);
+	const NavMapSyncState full = get_map_sync_state(p_map, p_regions, p_path_points);
+
+	CHECK_EQ(incremental.polygon_count, full.polygon_count);
+	CHECK_EQ(incremental.edge_count, full.edge_count);
+	CHECK_EQ(incremental.edge_merge_count, full.edge_merge_count);
+	CHECK_EQ(incremental.edge_connection_count, full.edge_connection_count);
+	CHECK_EQ(incremental.edge_free_count, full.edge_free_count);
+	for (int i = 0; i < full.region_connections.size(); i++) {
+		CHECK_EQ(incremental.region_connections[i], full.region_connections[i]);
+	}
+
+	// Equally short corridors may be picked in another order, so only the outcome of the paths is compared.
+	for (int i = 0; i < full.paths.size(); i++) {
+		const Vector<Vector3> &incremental_path = incremental.paths[i];
+		const Vector<Vector3> &full_path = full.paths[i];
+		REQUIRE_EQ(incremental_path.is_empty(), full_path.is_empty());
+		if (full_path.is_empty()) {
+			continue;
+		}
+		CHECK(incremental_path[0].is_equal_approx(full_path[0]));
+		CHECK(incremental_path[incremental_path.size() - 1].is_equal_approx(full_path[full_path.size() - 1]));
+		CHECK(get_path_length(incremental_path) == doctest::Approx(get_path_length(full_path)).epsilon(0.01));
+	}
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -816,6 +933,255 @@ TEST_SUITE("[Navigation]") {
 	}
 	*/
 
+	TEST_CASE("[NavigationServer3D] Streaming regions should relink the map consistently") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// One quad per region. Every other row is shifted by half a quad, so regions share full edges
+		// along a row, but only half edges across rows, which are joined by edge connections instead.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_vertices({ Vector3(0, 0, 0), Vector3(2, 0, 0), Vector3(2, 0, 2), Vector3(0, 0, 2) });
+		navigation_mesh->add_polygon({ 0, 1, 2, 3 });
+
+		const int grid_size = 8;
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		LocalVector<RID> regions;
+		LocalVector<Transform3D> region_transforms;
+		for (int i = 0; i < grid_size * grid_size; i++) {
+			const int x = i % grid_size;
+			const int z = i / grid_size;
+			RID region = navigation_server->region_create();
+			region_transforms.push_back(Transform3D(Basis(), Vector3(x * 2.0 + (z % 2), 0, z * 2.0)));
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_transform(region, region_transforms[i]);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			regions.push_back(region);
+		}
+
+		// An island that can only be reached through a link.
+		RID island = navigation_server->region_create();
+		navigation_server->region_set_map(island, map);
+		navigation_server->region_set_transform(island, Transform3D(Basis(), Vector3(0, 0, -6)));
+		navigation_server->region_set_navigation_mesh(island, navigation_mesh);
+		regions.push_back(island);
+
+		RID link = navigation_server->link_create();
+		navigation_server->link_set_map(link, map);
+		navigation_server->link_set_start_position(link, Vector3(1, 0, 1));
+		navigation_server->link_set_end_position(link, Vector3(1, 0, -5));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector<Vector3> path_points = {
+			Vector3(0.5, 0, 0.5), Vector3(grid_size * 2.0 - 0.5, 0, grid_size * 2.0 - 0.5),
+			Vector3(grid_size * 2.0 - 0.5, 0, 0.5), Vector3(0.5, 0, grid_size * 2.0 - 0.5),
+			Vector3(grid_size * 2.0 - 0.5, 0, grid_size * 2.0 - 0.5), Vector3(1, 0, -5),
+		};
+
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), grid_size * grid_size + 1);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), grid_size * (grid_size - 1));
+		CHECK_GT(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT), 0);
+		const Vector<Vector3> island_path = navigation_server->map_get_path(map, path_points[4], path_points[5], true);
+		REQUIRE_FALSE(island_path.is_empty());
+		CHECK(island_path[island_path.size() - 1].is_equal_approx(path_points[5]));
+		check_map_matches_full_relink(map, regions, path_points);
+
+		// Relinked regions only reach their direct neighbors, the ring around those only
+		// has its connections towards them rebuilt, and everything else is kept and remapped.
+		SUBCASE("Streaming rows out and back in") {
+			for (int row = 0; row < grid_size; row += 3) {
+				for (int x = 0; x < grid_size; x++) {
+					navigation_server->region_set_map(regions[row * grid_size + x], RID());
+				}
+				navigation_server->process(0.0);
+				check_map_matches_full_relink(map, regions, path_points);
+
+				for (int x = 0; x < grid_size; x++) {
+					navigation_server->region_set_map(regions[row * grid_size + x], map);
+				}
+				navigation_server->process(0.0);
+				check_map_matches_full_relink(map, regions, path_points);
+			}
+		}
+
+		SUBCASE("Removing a region shifts the polygons of the regions after it") {
+			navigation_server->region_set_map(regions[1], RID());
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+
+			navigation_server->region_set_map(regions[1], map);
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+		}
+
+		SUBCASE("Moving regions") {
+			const int region_index = 3 * grid_size + 4;
+			// Half a quad along the row only overlaps part of the edges of its old neighbors.
+			navigation_server->region_set_transform(regions[region_index], region_transforms[region_index].translated(Vector3(1, 0, 0)));
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+
+			navigation_server->region_set_transform(regions[region_index], region_transforms[region_index].translated(Vector3(0, 0, 40)));
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+
+			navigation_server->region_set_transform(regions[region_index], region_transforms[region_index]);
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+		}
+
+		SUBCASE("Changing links") {
+			navigation_server->link_set_start_position(link, Vector3(grid_size * 2.0 - 1.0, 0, 1));
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+
+			// The link ends on a region that is streamed out and back in.
+			navigation_server->region_set_map(regions[grid_size - 1], RID());
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+
+			navigation_server->region_set_map(regions[grid_size - 1], map);
+			navigation_server->process(0.0);
+			check_map_matches_full_relink(map, regions, path_points);
+			CHECK_FALSE(navigation_server->map_get_path(map, path_points[4], path_points[5], true).is_empty());
+		}
+
+		navigation_server->free(link);
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Tiled navigation mesh should rebake only dirty tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		Array floor_arr;
+		floor_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(floor_arr, Vector3(32.0, 0.001, 32.0));
+		Array box_arr;
+		box_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(box_arr, Vector3(2.0, 2.0, 2.0));
+		const Transform3D box_transform = Transform3D(Basis(), Vector3(3.0, 1.0, 3.0));
+
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		source_geometry->add_mesh_array(floor_arr, Transform3D());
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(8.0);
+
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		const int polygon_count = navigation_mesh->get_polygon_count();
+		const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+		Vector<Vector<int>> polygons;
+		for (int i = 0; i < polygon_count; i++) {
+			polygons.push_back(navigation_mesh->get_polygon(i));
+		}
+		CHECK_GT(polygon_count, 0);
+
+		SUBCASE("Rebaking unchanged geometry should give the same navigation mesh") {
+			navigation_server->rebake_from_source_geometry_data(navigation_mesh, source_geometry, AABB(Vector3(-1.0, -1.0, -1.0), Vector3(2.0, 2.0, 2.0)), Callable());
+			CHECK(navigation_mesh->get_vertices() == vertices);
+			REQUIRE_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+			for (int i = 0; i < polygon_count; i++) {
+				CHECK(navigation_mesh->get_polygon(i) == polygons[i]);
+			}
+		}
+
+		SUBCASE("Rebaking dirty tiles should match a full bake") {
+			source_geometry->add_mesh_array(box_arr, box_transform);
+
+			navigation_server->rebake_from_source_geometry_data(navigation_mesh, source_geometry, box_transform.xform(AABB(Vector3(-1.0, -1.0, -1.0), Vector3(2.0, 2.0, 2.0))), Callable());
+
+			Ref<NavigationMesh> full_navigation_mesh = memnew(NavigationMesh);
+			full_navigation_mesh->set_tile_size(8.0);
+			navigation_server->bake_from_source_geometry_data(full_navigation_mesh, source_geometry, Callable());
+			CHECK(navigation_mesh->get_vertices() == full_navigation_mesh->get_vertices());
+			REQUIRE_EQ(navigation_mesh->get_polygon_count(), full_navigation_mesh->get_polygon_count());
+			for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+				CHECK(navigation_mesh->get_polygon(i) == full_navigation_mesh->get_polygon(i));
+			}
+
+			RID map = navigation_server->map_create();
+			navigation_server->map_set_active(map, true);
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			// From a tile that was kept into the rebaked one, around the new box.
+			const Vector3 path_end = Vector3(4.5, 0.0, 5.0);
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-5.0, 0.0, -2.0), path_end, true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].distance_to(path_end) < 0.5);
+			CHECK(get_path_length(path) > Vector3(-5.0, 0.0, -2.0).distance_to(path_end));
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Paths should cross the seams of a tiled navigation mesh") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		Array floor_arr;
+		floor_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(floor_arr, Vector3(32.0, 0.001, 32.0));
+		Array box_arr;
+		box_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(box_arr, Vector3(3.0, 2.0, 3.0));
+
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		source_geometry->add_mesh_array(floor_arr, Transform3D());
+		// An obstacle on a tile corner, so the polygons along the seams are cut differently on each side.
+		source_geometry->add_mesh_array(box_arr, Transform3D(Basis(), Vector3(0.3, 1.0, 0.7)));
+
+		Ref<NavigationMesh> tiled_navigation_mesh = memnew(NavigationMesh);
+		tiled_navigation_mesh->set_tile_size(8.0);
+		navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE_GT(tiled_navigation_mesh->get_polygon_count(), 0);
+		REQUIRE_GT(navigation_mesh->get_polygon_count(), 0);
+
+		RID tiled_map = navigation_server->map_create();
+		navigation_server->map_set_active(tiled_map, true);
+		RID tiled_region = navigation_server->region_create();
+		navigation_server->region_set_map(tiled_region, tiled_map);
+		navigation_server->region_set_navigation_mesh(tiled_region, tiled_navigation_mesh);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		RID region = navigation_server->region_create();
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 path_points[] = {
+			Vector3(-14.0, 0.0, -14.0), Vector3(14.0, 0.0, 14.0),
+			Vector3(-14.0, 0.0, 3.0), Vector3(14.0, 0.0, -3.0),
+			Vector3(-3.0, 0.0, 1.0), Vector3(3.0, 0.0, 1.0),
+			Vector3(-9.0, 0.0, -7.0), Vector3(-7.0, 0.0, -9.0),
+		};
+		for (int i = 0; i < 8; i += 2) {
+			const Vector<Vector3> tiled_path = navigation_server->map_get_path(tiled_map, path_points[i], path_points[i + 1], true);
+			const Vector<Vector3> path = navigation_server->map_get_path(map, path_points[i], path_points[i + 1], true);
+			REQUIRE_FALSE(tiled_path.is_empty());
+			REQUIRE_FALSE(path.is_empty());
+
+			// Without the seams connected the path would stop at the closest reachable point in the first tile.
+			CHECK(tiled_path[tiled_path.size() - 1].distance_to(path[path.size() - 1]) < 0.5);
+			CHECK(get_path_length(tiled_path) == doctest::Approx(get_path_length(path)).epsilon(0.05));
+		}
+
+		navigation_server->free(tiled_region);
+		navigation_server->free(tiled_map);
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[Heap] size") {
 		gd::Heap<int> heap;
 
@@ -948,6 +1314,59 @@ TEST_SUITE("[Navigation]") {
 		CHECK(heap_indexes[2] == UINT32_MAX);
 		CHECK(heap_indexes[3] == UINT32_MAX);
 	}
+
+	TEST_CASE("[NavPolygonBVH] Empty BVH should not find any polygon") {
+		LocalVector<gd::Polygon> polygons;
+		NavPolygonBVH bvh;
+		bvh.build(polygons);
+
+		CHECK(bvh.is_empty());
+		CHECK_EQ(bvh.get_closest_polygon(polygons, Vector3(1, 2, 3)).polygon_index, -1);
+	}
+
+	TEST_CASE("[NavPolygonBVH] Closest polygon queries should match a linear scan") {
+		LocalVector<gd::Polygon> polygons = build_grid_polygons(32, 0.5);
+		NavPolygonBVH bvh;
+		bvh.build(polygons);
+		CHECK_FALSE(bvh.is_empty());
+
+		SUBCASE("Points inside and outside of the grid") {
+			for (int i = 0; i < 200; i++) {
+				const Vector3 point((i * 37) % 113 * 0.2 - 3.0, (i % 7) * 0.5 - 1.0, (i * 53) % 97 * 0.2 - 3.0);
+				const NavPolygonBVH::ClosestPolygonResult expected = get_closest_polygon_linear(polygons, point);
+				const NavPolygonBVH::ClosestPolygonResult result = bvh.get_closest_polygon(polygons, point);
+				CHECK_EQ(result.polygon_index, expected.polygon_index);
+				CHECK(result.point.is_equal_approx(expected.point));
+			}
+		}
+
+		SUBCASE("Queries limited by distance") {
+			const Vector3 far_point(100, 0, 100);
+			CHECK_EQ(bvh.get_closest_polygon(polygons, far_point, false, 0, 1.0).polygon_index, -1);
+
+			const Vector3 near_point(2.2, 1.0, 3.4);
+			const NavPolygonBVH::ClosestPolygonResult expected = get_closest_polygon_linear(polygons, near_point, 4.0);
+			CHECK_NE(expected.polygon_index, -1);
+			CHECK_EQ(bvh.get_closest_polygon(polygons, near_point, false, 0, 4.0).polygon_index, expected.polygon_index);
+		}
+
+		SUBCASE("Ties should resolve to the lowest polygon index") {
+			// Shared corner of four flat polygons.
+			LocalVector<gd::Polygon> flat_polygons;
+			for (int i = 0; i < 4; i++) {
+				const Vector3 offset((i % 2) - 1, 0, (i / 2) - 1);
+				gd::Polygon polygon;
+				polygon.points.push_back({ offset, gd::PointKey() });
+				polygon.points.push_back({ offset + Vector3(1, 0, 0), gd::PointKey() });
+				polygon.points.push_back({ offset + Vector3(1, 0, 1), gd::PointKey() });
+				polygon.points.push_back({ offset + Vector3(0, 0, 1), gd::PointKey() });
+				flat_polygons.push_back(polygon);
+			}
+			NavPolygonBVH flat_bvh;
+			flat_bvh.build(flat_polygons);
+			CHECK_EQ(flat_bvh.get_closest_polygon(flat_polygons, Vector3(0, 1, 0)).polygon_index, 0);
+		}
+	}
 }
 } //namespace TestNavigationServer3D
 